@@ -197,6 +197,17 @@ public:
     ////////////////////////////////////////////////////////////
     float getKerning(Uint32 first, Uint32 second, unsigned int characterSize) const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the font has a kerning table
+    ///
+    /// When it has none, getKerning always returns 0 and the
+    /// callers can skip it.
+    ///
+    /// \return True if the font provides kerning offsets
+    ///
+    ////////////////////////////////////////////////////////////
+    bool hasKerning() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Get the line spacing
     ///
@@ -295,8 +306,23 @@ private:
         Texture          texture; ///< Texture containing the pixels of the glyphs
         unsigned int     nextRow; ///< Y position of the next new row in the texture
         std::vector<Row> rows;    ///< List containing the position of all the existing rows
+        Glyph            asciiGlyphs[2][128]; ///< Copies of the regular and bold ASCII glyphs without outline, indexed by code point
+        bool             asciiLoaded[2][128]; ///< Which entries of asciiGlyphs are filled
     };
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the page of a character size (created if needed)
+    ///
+    /// The last page used is remembered, as the texts usually
+    /// ask many times in a row for the same size.
+    ///
+    /// \param characterSize Reference character size
+    ///
+    /// \return The page of glyphs
+    ///
+    ////////////////////////////////////////////////////////////
+    Page& getPage(unsigned int characterSize) const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Free all the internal resources
     ///
@@ -353,6 +379,8 @@ private:
     int*                       m_refCount;    ///< Reference counter used by implicit sharing
     Info                       m_info;        ///< Information about the font
     mutable PageTable          m_pages;       ///< Table containing the glyphs pages by character size
+    mutable Page*              m_lastPage;    ///< Last page returned by getPage (the pages never move in the table)
+    mutable unsigned int       m_lastPageSize;///< Character size of m_lastPage
     mutable std::vector<Uint8> m_pixelBuffer; ///< Pixel buffer holding a glyph's pixels before being written to the texture
     #ifdef SFML_SYSTEM_ANDROID
     void*                      m_stream; ///< Asset file streamer (if loaded from file)
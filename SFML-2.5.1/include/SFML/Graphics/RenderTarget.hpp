@@ -38,6 +38,7 @@
 #include <SFML/Graphics/PrimitiveType.hpp>
 #include <SFML/Graphics/Vertex.hpp>
 #include <SFML/System/NonCopyable.hpp>
+#include <vector>
 
 
 namespace sf
@@ -366,6 +367,137 @@ public:
     ////////////////////////////////////////////////////////////
     void resetGLStates();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Rendering statistics of the target
+    ///
+    /// The counters grow with each draw until resetStatistics
+    /// is called (usually once per frame).
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Statistics
+    {
+        Uint64 drawCalls;        ///< Primitives drawn (glDrawArrays calls)
+        Uint64 vertices;         ///< Vertices submitted to OpenGL
+        Uint64 quadsExpanded;    ///< Quads converted to two triangles by the quad emulation
+        Uint64 textureChanges;   ///< Texture binds
+        Uint64 blendChanges;     ///< Blend mode changes
+        Uint64 transformChanges; ///< Model-view matrix loads
+        Uint64 viewChanges;      ///< View (viewport and projection) changes
+        Uint64 shaderChanges;    ///< Shader binds (and unbinds)
+        Uint64 stateResets;      ///< Full OpenGL state resets (resetGLStates)
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the rendering statistics since the last reset
+    ///
+    /// \return Statistics of the target
+    ///
+    /// \see resetStatistics
+    ///
+    ////////////////////////////////////////////////////////////
+    const Statistics& getStatistics() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Reset the rendering statistics to zero
+    ///
+    /// \see getStatistics
+    ///
+    ////////////////////////////////////////////////////////////
+    void resetStatistics();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw calls recorded by a render target
+    ///
+    /// While a target records (startRecording), its draw calls
+    /// only copy their vertices, render states and view into the
+    /// recording, without any OpenGL call. The recording is then
+    /// an immutable snapshot of the frame, that can be drawn later
+    /// with draw(const Recording&).
+    ///
+    /// The textures and shaders are referenced, not copied: they
+    /// must stay alive until the recording is drawn, and they are
+    /// used with their content at that time.
+    ///
+    ////////////////////////////////////////////////////////////
+    class SFML_GRAPHICS_API Recording
+    {
+    public:
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Remove all the recorded draw calls
+        ///
+        /// The memory is kept for the next recording.
+        ///
+        ////////////////////////////////////////////////////////////
+        void clear();
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Get the number of recorded draw calls
+        ///
+        /// \return Number of draw calls
+        ///
+        ////////////////////////////////////////////////////////////
+        std::size_t getDrawCount() const;
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Get the total number of recorded vertices
+        ///
+        /// \return Number of vertices
+        ///
+        ////////////////////////////////////////////////////////////
+        std::size_t getVertexCount() const;
+
+    private:
+
+        friend class RenderTarget;
+
+        struct Command
+        {
+            PrimitiveType type;        ///< Type of primitives
+            std::size_t   firstVertex; ///< Index of the first vertex in m_vertices
+            std::size_t   vertexCount; ///< Number of vertices
+            std::size_t   view;        ///< Index of the view in m_views
+            RenderStates  states;      ///< Render states of the draw call
+        };
+
+        std::vector<Vertex>  m_vertices; ///< Vertices of all the draw calls
+        std::vector<Command> m_commands; ///< Draw calls, in order
+        std::vector<View>    m_views;    ///< Views used by the draw calls
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start recording the draw calls instead of drawing
+    ///
+    /// The recording is cleared first. The vertex buffers cannot
+    /// be recorded: they are skipped while recording.
+    /// clear() and display() are not recorded either.
+    ///
+    /// \param recording Recording to fill
+    ///
+    /// \see stopRecording
+    ///
+    ////////////////////////////////////////////////////////////
+    void startRecording(Recording& recording);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Stop recording, the next draw calls are drawn again
+    ///
+    /// \see startRecording
+    ///
+    ////////////////////////////////////////////////////////////
+    void stopRecording();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw all the draw calls of a recording
+    ///
+    /// Each draw call is done with its recorded view. The current
+    /// view of the target is restored at the end.
+    ///
+    /// \param recording Recording to draw
+    ///
+    ////////////////////////////////////////////////////////////
+    void draw(const Recording& recording);
+
 protected:
 
     ////////////////////////////////////////////////////////////
@@ -474,6 +606,9 @@ private:
     View        m_defaultView; ///< Default view
     View        m_view;        ///< Current view
     StatesCache m_cache;       ///< Render states cache
+    Statistics  m_statistics;  ///< Rendering statistics
+    Recording*  m_recording;   ///< Recording in progress, if any
+    bool        m_recordView;  ///< Must the current view be added to the recording?
     Uint64      m_id;          ///< Unique number that identifies the RenderTarget
 };
 
@@ -214,6 +214,40 @@ public:
     ////////////////////////////////////////////////////////////
     bool loadFromImage(const Image& image, const IntRect& area = IntRect());
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Load the texture from an image, without waiting for the upload
+    ///
+    /// The texture is created with the size of the image and
+    /// the pixels are copied to a pixel buffer object: OpenGL
+    /// transfers them to the texture while the program goes on.
+    /// The texture can be drawn right away (the OpenGL commands
+    /// are ordered). Use isUploadComplete to know when the
+    /// transfer is finished (a fence is used when supported).
+    ///
+    /// Without pixel buffer objects (OpenGL < 2.1, OpenGL ES),
+    /// the image is uploaded like with loadFromImage.
+    ///
+    /// \param image Image to load into the texture
+    ///
+    /// \return True if loading was successful
+    ///
+    /// \see isUploadComplete, loadFromImage
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadFromImageAsync(const Image& image);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the last asynchronous upload is finished
+    ///
+    /// When it is, the pixel buffer used by the upload is released.
+    ///
+    /// \return True if no upload is pending
+    ///
+    /// \see loadFromImageAsync
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isUploadComplete();
+
     ////////////////////////////////////////////////////////////
     /// \brief Return the size of the texture
     ///
@@ -613,6 +647,12 @@ private:
     ////////////////////////////////////////////////////////////
     void invalidateMipmap();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Release the pixel buffer and the fence of the last asynchronous upload
+    ///
+    ////////////////////////////////////////////////////////////
+    void releaseUpload();
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
@@ -626,6 +666,8 @@ private:
     bool         m_fboAttachment; ///< Is this texture owned by a framebuffer object?
     bool         m_hasMipmap;     ///< Has the mipmap been generated?
     Uint64       m_cacheId;       ///< Unique number that identifies the texture to the render target's cache
+    unsigned int m_pixelBuffer;   ///< Pixel buffer object of the pending asynchronous upload
+    void*        m_uploadFence;   ///< Fence signaled when the asynchronous upload is finished
 };
 
 } // namespace sf
@@ -88,7 +88,9 @@ m_face     (NULL),
 m_streamRec(NULL),
 m_stroker  (NULL),
 m_refCount (NULL),
-m_info     ()
+m_info     (),
+m_lastPage (NULL),
+m_lastPageSize(0)
 {
     #ifdef SFML_SYSTEM_ANDROID
         m_stream = NULL;
@@ -105,6 +107,8 @@ m_stroker    (copy.m_stroker),
 m_refCount   (copy.m_refCount),
 m_info       (copy.m_info),
 m_pages      (copy.m_pages),
+m_lastPage   (NULL),
+m_lastPageSize(0),
 m_pixelBuffer(copy.m_pixelBuffer)
 {
     #ifdef SFML_SYSTEM_ANDROID
@@ -344,24 +348,34 @@ const Font::Info& Font::getInfo() const
 const Glyph& Font::getGlyph(Uint32 codePoint, unsigned int characterSize, bool bold, float outlineThickness) const
 {
     // Get the page corresponding to the character size
-    GlyphTable& glyphs = m_pages[characterSize].glyphs;
+    Page& page = getPage(characterSize);
+
+    // ASCII characters without outline (most texts): direct access, no search
+    bool ascii = (codePoint < 128) && (outlineThickness == 0);
+    if (ascii && page.asciiLoaded[bold][codePoint])
+        return page.asciiGlyphs[bold][codePoint];
+
+    GlyphTable& glyphs = page.glyphs;
 
     // Build the key by combining the glyph index (based on code point), bold flag, and outline thickness
     Uint64 key = combine(outlineThickness, bold, FT_Get_Char_Index(static_cast<FT_Face>(m_face), codePoint));
 
     // Search the glyph into the cache
     GlyphTable::const_iterator it = glyphs.find(key);
-    if (it != glyphs.end())
-    {
-        // Found: just return it
-        return it->second;
-    }
-    else
+    if (it == glyphs.end())
     {
         // Not found: we have to load it
         Glyph glyph = loadGlyph(codePoint, characterSize, bold, outlineThickness);
-        return glyphs.insert(std::make_pair(key, glyph)).first->second;
+        it = glyphs.insert(std::make_pair(key, glyph)).first;
+    }
+
+    if (ascii)
+    {
+        page.asciiGlyphs[bold][codePoint] = it->second;
+        page.asciiLoaded[bold][codePoint] = true;
     }
+
+    return it->second;
 }
 
 
@@ -399,6 +413,14 @@ float Font::getKerning(Uint32 first, Uint32 second, unsigned int characterSize)
 }
 
 
+////////////////////////////////////////////////////////////
+bool Font::hasKerning() const
+{
+    FT_Face face = static_cast<FT_Face>(m_face);
+    return face && FT_HAS_KERNING(face);
+}
+
+
 ////////////////////////////////////////////////////////////
 float Font::getLineSpacing(unsigned int characterSize) const
 {
@@ -458,7 +480,7 @@ float Font::getUnderlineThickness(unsigned int characterSize) const
 ////////////////////////////////////////////////////////////
 const Texture& Font::getTexture(unsigned int characterSize) const
 {
-    return m_pages[characterSize].texture;
+    return getPage(characterSize).texture;
 }
 
 
@@ -475,6 +497,7 @@ Font& Font::operator =(const Font& right)
     std::swap(m_info,        temp.m_info);
     std::swap(m_pages,       temp.m_pages);
     std::swap(m_pixelBuffer, temp.m_pixelBuffer);
+    m_lastPage = NULL;
 
     #ifdef SFML_SYSTEM_ANDROID
         std::swap(m_stream, temp.m_stream);
@@ -524,6 +547,7 @@ void Font::cleanup()
     m_streamRec = NULL;
     m_refCount  = NULL;
     m_pages.clear();
+    m_lastPage = NULL;
     std::vector<Uint8>().swap(m_pixelBuffer);
 }
 
@@ -607,7 +631,7 @@ Glyph Font::loadGlyph(Uint32 codePoint, unsigned int characterSize, bool bold, f
         height += 2 * padding;
 
         // Get the glyphs page corresponding to the character size
-        Page& page = m_pages[characterSize];
+        Page& page = getPage(characterSize);
 
         // Find a good position for the new glyph into the texture
         glyph.textureRect = findGlyphRect(page, width, height);
@@ -796,10 +820,26 @@ bool Font::setCurrentSize(unsigned int characterSize) const
 }
 
 
+////////////////////////////////////////////////////////////
+Font::Page& Font::getPage(unsigned int characterSize) const
+{
+    if (!m_lastPage || m_lastPageSize != characterSize)
+    {
+        m_lastPage = &m_pages[characterSize];
+        m_lastPageSize = characterSize;
+    }
+
+    return *m_lastPage;
+}
+
+
 ////////////////////////////////////////////////////////////
 Font::Page::Page() :
 nextRow(3)
 {
+    for (int i = 0; i < 128; ++i)
+        asciiLoaded[0][i] = asciiLoaded[1][i] = false;
+
     // Make sure that the texture is initialized by default
     sf::Image image;
     image.create(128, 128, Color(255, 255, 255, 0));
@@ -129,6 +129,9 @@ RenderTarget::RenderTarget() :
 m_defaultView(),
 m_view       (),
 m_cache      (),
+m_statistics (),
+m_recording  (NULL),
+m_recordView (false),
 m_id         (0)
 {
     m_cache.glStatesSet = false;
@@ -160,6 +163,7 @@ void RenderTarget::setView(const View& view)
 {
     m_view = view;
     m_cache.viewChanged = true;
+    m_recordView = true;
 }
 
 
@@ -254,6 +258,26 @@ void RenderTarget::draw(const Vertex* vertices, std::size_t vertexCount,
     if (!vertices || (vertexCount == 0))
         return;
 
+    // Recording: copy the draw call, it will be drawn later
+    if (m_recording)
+    {
+        if (m_recordView)
+        {
+            m_recording->m_views.push_back(m_view);
+            m_recordView = false;
+        }
+
+        Recording::Command command;
+        command.type        = type;
+        command.firstVertex = m_recording->m_vertices.size();
+        command.vertexCount = vertexCount;
+        command.view        = m_recording->m_views.size() - 1;
+        command.states      = states;
+        m_recording->m_commands.push_back(command);
+        m_recording->m_vertices.insert(m_recording->m_vertices.end(), vertices, vertices + vertexCount);
+        return;
+    }
+
     bool _bQuad = false;
     // GL_QUADS is unavailable on OpenGL ES
   //  #ifdef SFML_OPENGL_ES
@@ -383,6 +407,7 @@ void RenderTarget::draw(const Vertex* vertices, std::size_t vertexCount,
                     }
                 }
                     
+                m_statistics.quadsExpanded += vertexCount / 4;
                 vertexCount= quadtri_vertexCount;
                 data = reinterpret_cast<const char*>(quad_vertexCache);
             }
@@ -424,6 +449,13 @@ void RenderTarget::draw(const VertexBuffer& vertexBuffer, const RenderStates& st
 void RenderTarget::draw(const VertexBuffer& vertexBuffer, std::size_t firstVertex,
                         std::size_t vertexCount, const RenderStates& states)
 {
+    // Its content may change before the recording is drawn
+    if (m_recording)
+    {
+        err() << "sf::VertexBuffer cannot be recorded, drawing skipped" << std::endl;
+        return;
+    }
+
     // VertexBuffer not supported?
     if (!VertexBuffer::isAvailable())
     {
@@ -608,6 +640,7 @@ void RenderTarget::resetGLStates()
         glCheck(glEnableClientState(GL_COLOR_ARRAY));
         glCheck(glEnableClientState(GL_TEXTURE_COORD_ARRAY));
         m_cache.glStatesSet = true;
+        ++m_statistics.stateResets;
 
         // Apply the default SFML states
         applyBlendMode(BlendAlpha);
@@ -630,6 +663,85 @@ void RenderTarget::resetGLStates()
 }
 
 
+////////////////////////////////////////////////////////////
+const RenderTarget::Statistics& RenderTarget::getStatistics() const
+{
+    return m_statistics;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::resetStatistics()
+{
+    m_statistics = Statistics();
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::startRecording(Recording& recording)
+{
+    recording.clear();
+    m_recording = &recording;
+    m_recordView = true;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::stopRecording()
+{
+    m_recording = NULL;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::draw(const Recording& recording)
+{
+    if (recording.m_commands.empty())
+        return;
+
+    View currentView = m_view;
+    std::size_t view = recording.m_views.size();
+
+    for (std::size_t i = 0; i < recording.m_commands.size(); ++i)
+    {
+        const Recording::Command& command = recording.m_commands[i];
+
+        if (command.view != view)
+        {
+            view = command.view;
+            setView(recording.m_views[view]);
+        }
+
+        draw(&recording.m_vertices[command.firstVertex], command.vertexCount, command.type, command.states);
+    }
+
+    setView(currentView);
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::Recording::clear()
+{
+    m_vertices.clear();
+    m_commands.clear();
+    m_views.clear();
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t RenderTarget::Recording::getDrawCount() const
+{
+    return m_commands.size();
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t RenderTarget::Recording::getVertexCount() const
+{
+    return m_vertices.size();
+}
+
+
 ////////////////////////////////////////////////////////////
 void RenderTarget::initialize()
 {
@@ -662,6 +774,7 @@ void RenderTarget::applyCurrentView()
     glCheck(glMatrixMode(GL_MODELVIEW));
 
     m_cache.viewChanged = false;
+    ++m_statistics.viewChanges;
 }
 
 
@@ -710,6 +823,7 @@ void RenderTarget::applyBlendMode(const BlendMode& mode)
     }
 
     m_cache.lastBlendMode = mode;
+    ++m_statistics.blendChanges;
 }
 
 
@@ -722,6 +836,8 @@ void RenderTarget::applyTransform(const Transform& transform)
         glCheck(glLoadIdentity());
     else
         glCheck(glLoadMatrixf(transform.getMatrix()));
+
+    ++m_statistics.transformChanges;
 }
 
 
@@ -731,6 +847,7 @@ void RenderTarget::applyTexture(const Texture* texture)
     Texture::bind(texture, Texture::Pixels);
 
     m_cache.lastTextureId = texture ? texture->m_cacheId : 0;
+    ++m_statistics.textureChanges;
 }
 
 
@@ -738,6 +855,7 @@ void RenderTarget::applyTexture(const Texture* texture)
 void RenderTarget::applyShader(const Shader* shader)
 {
     Shader::bind(shader);
+    ++m_statistics.shaderChanges;
 }
 
 
@@ -752,7 +870,10 @@ void RenderTarget::setupDraw(bool useVertexCache, const RenderStates& states)
     {
         // Since vertices are transformed, we must use an identity transform to render them
         if (!m_cache.enable || !m_cache.useVertexCache)
+        {
             glCheck(glLoadIdentity());
+            ++m_statistics.transformChanges;
+        }
     }
     else
     {
@@ -801,6 +922,9 @@ void RenderTarget::drawPrimitives(PrimitiveType type, std::size_t firstVertex, s
 
     // Draw the primitives
     glCheck(glDrawArrays(mode, static_cast<GLint>(firstVertex), static_cast<GLsizei>(vertexCount)));
+
+    ++m_statistics.drawCalls;
+    m_statistics.vertices += vertexCount;
 }
 
 
@@ -396,16 +396,17 @@ void Text::ensureGeometryUpdate() const
         return;
 
     // Do nothing, if geometry has not changed and the font texture has not changed
-    if (!m_geometryNeedUpdate && m_font->getTexture(m_characterSize).m_cacheId == m_fontTextureId)
+    Uint64 fontTextureId = m_font->getTexture(m_characterSize).m_cacheId;
+    if (!m_geometryNeedUpdate && fontTextureId == m_fontTextureId)
         return;
 
     // Save the current fonts texture id
-    m_fontTextureId = m_font->getTexture(m_characterSize).m_cacheId;
+    m_fontTextureId = fontTextureId;
 
     // Mark geometry as updated
     m_geometryNeedUpdate = false;
 
-    // Clear the previous geometry
+    // Clear the previous geometry (the allocations are kept for the new one)
     m_vertices.clear();
     m_outlineVertices.clear();
     m_bounds = FloatRect();
@@ -435,6 +436,7 @@ void Text::ensureGeometryUpdate() const
     float lineSpacing     = m_font->getLineSpacing(m_characterSize) * m_lineSpacingFactor;
     float x               = 0.f;
     float y               = static_cast<float>(m_characterSize);
+    bool  hasKerning      = m_font->hasKerning();
 
     // Create one quad for each character
     float minX = static_cast<float>(m_characterSize);
@@ -451,7 +453,8 @@ void Text::ensureGeometryUpdate() const
             continue;
 
         // Apply the kerning offset
-        x += m_font->getKerning(prevChar, curChar, m_characterSize);
+        if (hasKerning)
+            x += m_font->getKerning(prevChar, curChar, m_characterSize);
 
         // If we're using the underlined style and there's a new line, draw a line
         if (isUnderlined && (curChar == L'\n' && prevChar != L'\n'))
@@ -53,6 +53,67 @@ namespace
 
         return id++;
     }
+
+#ifndef SFML_OPENGL_ES
+
+    // Pixel buffer objects (core since 2.1) and fences (core since 3.2) are not
+    // in the loader of sfml-graphics: they are checked and loaded here
+    const GLenum pixelUnpackBuffer  = 0x88EC; // GL_PIXEL_UNPACK_BUFFER
+    const GLenum syncGpuCommands    = 0x9117; // GL_SYNC_GPU_COMMANDS_COMPLETE
+    const GLenum syncTimeoutExpired = 0x911B; // GL_TIMEOUT_EXPIRED
+
+    typedef void*  (APIENTRY *FenceSyncFunc)(GLenum, GLbitfield);
+    typedef GLenum (APIENTRY *ClientWaitSyncFunc)(void*, GLbitfield, sf::Uint64);
+    typedef void   (APIENTRY *DeleteSyncFunc)(void*);
+
+    struct UploadSupport
+    {
+        bool               pixelBuffer;
+        FenceSyncFunc      fenceSync;
+        ClientWaitSyncFunc clientWaitSync;
+        DeleteSyncFunc     deleteSync;
+    };
+
+    // Must be called with an active context
+    const UploadSupport& getUploadSupport()
+    {
+        static bool checked = false;
+        static UploadSupport support = {false, NULL, NULL, NULL};
+
+        if (!checked)
+        {
+            checked = true;
+
+            int majorVersion = 0;
+            int minorVersion = 0;
+            const GLubyte* version = glGetString(GL_VERSION);
+            if (version)
+            {
+                majorVersion = version[0] - '0';
+                minorVersion = version[2] - '0';
+            }
+
+            support.pixelBuffer = GLEXT_vertex_buffer_object &&
+                                  ((majorVersion > 2) || ((majorVersion == 2) && (minorVersion >= 1)) ||
+                                   sf::Context::isExtensionAvailable("GL_ARB_pixel_buffer_object"));
+
+            if (support.pixelBuffer &&
+                ((majorVersion > 3) || ((majorVersion == 3) && (minorVersion >= 2)) ||
+                 sf::Context::isExtensionAvailable("GL_ARB_sync")))
+            {
+                support.fenceSync      = reinterpret_cast<FenceSyncFunc>(sf::Context::getFunction("glFenceSync"));
+                support.clientWaitSync = reinterpret_cast<ClientWaitSyncFunc>(sf::Context::getFunction("glClientWaitSync"));
+                support.deleteSync     = reinterpret_cast<DeleteSyncFunc>(sf::Context::getFunction("glDeleteSync"));
+
+                if (!support.fenceSync || !support.clientWaitSync || !support.deleteSync)
+                    support.fenceSync = NULL;
+            }
+        }
+
+        return support;
+    }
+
+#endif
 }
 
 
@@ -69,7 +130,9 @@ m_isRepeated   (false),
 m_pixelsFlipped(false),
 m_fboAttachment(false),
 m_hasMipmap    (false),
-m_cacheId      (getUniqueId())
+m_cacheId      (getUniqueId()),
+m_pixelBuffer  (0),
+m_uploadFence  (NULL)
 {
 }
 
@@ -85,7 +148,9 @@ m_isRepeated   (copy.m_isRepeated),
 m_pixelsFlipped(false),
 m_fboAttachment(false),
 m_hasMipmap    (false),
-m_cacheId      (getUniqueId())
+m_cacheId      (getUniqueId()),
+m_pixelBuffer  (0),
+m_uploadFence  (NULL)
 {
     if (copy.m_texture)
     {
@@ -108,6 +173,8 @@ m_cacheId      (getUniqueId())
 ////////////////////////////////////////////////////////////
 Texture::~Texture()
 {
+    releaseUpload();
+
     // Destroy the OpenGL texture
     if (m_texture)
     {
@@ -310,6 +377,121 @@ bool Texture::loadFromImage(const Image& image, const IntRect& area)
 }
 
 
+////////////////////////////////////////////////////////////
+bool Texture::loadFromImageAsync(const Image& image)
+{
+    if (!create(image.getSize().x, image.getSize().y))
+        return false;
+
+#ifndef SFML_OPENGL_ES
+
+    TransientContextLock lock;
+
+    if (getUploadSupport().pixelBuffer)
+    {
+        releaseUpload();
+
+        GLsizeiptr size = 4 * m_size.x * m_size.y;
+        GLuint buffer = 0;
+        glCheck(GLEXT_glGenBuffers(1, &buffer));
+        glCheck(GLEXT_glBindBuffer(pixelUnpackBuffer, buffer));
+        glCheck(GLEXT_glBufferData(pixelUnpackBuffer, size, NULL, GLEXT_GL_STREAM_DRAW));
+
+        void* data = NULL;
+        glCheck(data = GLEXT_glMapBuffer(pixelUnpackBuffer, GLEXT_GL_WRITE_ONLY));
+        if (data)
+        {
+            std::memcpy(data, image.getPixelsPtr(), size);
+            glCheck(GLEXT_glUnmapBuffer(pixelUnpackBuffer));
+
+            // Make sure that the current texture binding will be preserved
+            priv::TextureSaver save;
+
+            // The pixels are read from the bound buffer (offset 0): the call
+            // returns before the transfer, which is done by the driver
+            glCheck(glBindTexture(GL_TEXTURE_2D, m_texture));
+            glCheck(glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, m_size.x, m_size.y, GL_RGBA, GL_UNSIGNED_BYTE, NULL));
+            glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, m_isSmooth ? GL_LINEAR : GL_NEAREST));
+            glCheck(GLEXT_glBindBuffer(pixelUnpackBuffer, 0));
+
+            m_hasMipmap = false;
+            m_pixelsFlipped = false;
+            m_cacheId = getUniqueId();
+            m_pixelBuffer = static_cast<unsigned int>(buffer);
+
+            if (getUploadSupport().fenceSync)
+                m_uploadFence = getUploadSupport().fenceSync(syncGpuCommands, 0);
+
+            glCheck(glFlush());
+            return true;
+        }
+
+        // The buffer could not be mapped: synchronous upload
+        glCheck(GLEXT_glBindBuffer(pixelUnpackBuffer, 0));
+        glCheck(GLEXT_glDeleteBuffers(1, &buffer));
+    }
+
+#endif
+
+    update(image);
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Texture::isUploadComplete()
+{
+#ifndef SFML_OPENGL_ES
+
+    if (!m_pixelBuffer)
+        return true;
+
+    if (m_uploadFence)
+    {
+        TransientContextLock lock;
+
+        // Poll the fence (no wait)
+        if (getUploadSupport().clientWaitSync(m_uploadFence, 0, 0) == syncTimeoutExpired)
+            return false;
+    }
+
+    // Without fence, the transfer is ordered before the next commands using the
+    // texture, and the driver keeps the buffer alive until it is done
+    releaseUpload();
+
+#endif
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void Texture::releaseUpload()
+{
+#ifndef SFML_OPENGL_ES
+
+    if (!m_pixelBuffer && !m_uploadFence)
+        return;
+
+    TransientContextLock lock;
+
+    if (m_uploadFence)
+    {
+        getUploadSupport().deleteSync(m_uploadFence);
+        m_uploadFence = NULL;
+    }
+
+    if (m_pixelBuffer)
+    {
+        GLuint buffer = static_cast<GLuint>(m_pixelBuffer);
+        glCheck(GLEXT_glDeleteBuffers(1, &buffer));
+        m_pixelBuffer = 0;
+    }
+
+#endif
+}
+
+
 ////////////////////////////////////////////////////////////
 Vector2u Texture::getSize() const
 {
@@ -835,6 +1017,8 @@ void Texture::swap(Texture& right)
     std::swap(m_pixelsFlipped, right.m_pixelsFlipped);
     std::swap(m_fboAttachment, right.m_fboAttachment);
     std::swap(m_hasMipmap,     right.m_hasMipmap);
+    std::swap(m_pixelBuffer,   right.m_pixelBuffer);
+    std::swap(m_uploadFence,   right.m_uploadFence);
 
     m_cacheId = getUniqueId();
     right.m_cacheId = getUniqueId();
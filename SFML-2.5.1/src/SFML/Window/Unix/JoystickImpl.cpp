@@ -27,11 +27,15 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Window/JoystickImpl.hpp>
 #include <SFML/System/Err.hpp>
+#include <SFML/System/Thread.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Lock.hpp>
 #include <linux/joystick.h>
 #include <libudev.h>
 #include <unistd.h>
 #include <fcntl.h>
 #include <errno.h>
+#include <poll.h>
 #include <vector>
 #include <string>
 #include <cstring>
@@ -51,6 +55,15 @@ namespace
     typedef std::vector<JoystickRecord> JoystickList;
     JoystickList joystickList;
 
+    // The device list is maintained by a watcher thread, so that the main thread never
+    // scans the devices: isConnected only reads the published plugged mask
+    sf::Mutex     joystickListMutex;     // joystickList and the udev context (watcher thread / open)
+    unsigned int  pluggedMask = 0;       // bit i set: joystick i plugged (atomic, written by the watcher)
+    sf::Thread*   watcherThread = NULL;
+    int           wakePipe[2] = {-1, -1};
+    unsigned int  scanCount = 0;         // full rescans of the devices
+    unsigned int  eventCount = 0;        // udev monitor events
+
     bool isJoystick(udev_device* udevDevice)
     {
         // If anything goes wrong, we go safe and return true
@@ -176,6 +189,8 @@ namespace
             // Do a full rescan if there was no action just to be sure
         }
 
+        ++scanCount;
+
         // Reset the plugged status of each mapping since we are doing a full rescan
         for (JoystickList::iterator record = joystickList.begin(); record != joystickList.end(); ++record)
             record->plugged = false;
@@ -248,18 +263,75 @@ namespace
         udev_enumerate_unref(udevEnumerator);
     }
 
-    bool hasMonitorEvent()
+    // Publish the plugged status of the joysticks for isConnected
+    void publishPluggedList()
     {
-        // This will not fail since we make sure udevMonitor is valid
-        int monitorFd = udev_monitor_get_fd(udevMonitor);
+        unsigned int mask = 0;
 
-        fd_set descriptorSet;
-        FD_ZERO(&descriptorSet);
-        FD_SET(monitorFd, &descriptorSet);
-        timeval timeout = {0, 0};
+        for (std::size_t i = 0; (i < joystickList.size()) && (i < sf::Joystick::Count); ++i)
+        {
+            if (joystickList[i].plugged)
+                mask |= 1u << i;
+        }
 
-        return (select(monitorFd + 1, &descriptorSet, NULL, NULL, &timeout) > 0) &&
-               FD_ISSET(monitorFd, &descriptorSet);
+        __atomic_store_n(&pluggedMask, mask, __ATOMIC_RELEASE);
+    }
+
+    // Watcher thread: waits for the udev monitor events (or rescans the devices
+    // every second without monitor) until cleanup writes to the wake pipe
+    void watchDevices()
+    {
+        pollfd descriptors[2];
+        descriptors[0].fd = wakePipe[0];
+        descriptors[0].events = POLLIN;
+        nfds_t count = 1;
+
+        if (udevMonitor)
+        {
+            // This will not fail since we make sure udevMonitor is valid
+            descriptors[1].fd = udev_monitor_get_fd(udevMonitor);
+            descriptors[1].events = POLLIN;
+            count = 2;
+        }
+
+        for (;;)
+        {
+            int result = poll(descriptors, count, udevMonitor ? -1 : 1000);
+
+            if ((result < 0) && (errno != EINTR))
+            {
+                sf::err() << "Failed to wait for udev events, joystick connections and disconnections won't be notified: " << errno << std::endl;
+                return;
+            }
+
+            if ((result > 0) && descriptors[0].revents)
+                return;
+
+            sf::Lock lock(joystickListMutex);
+
+            if (!udevMonitor)
+            {
+                updatePluggedList();
+            }
+            else if ((result > 0) && (descriptors[1].revents & POLLIN))
+            {
+                // If we can get the specific device, we check that,
+                // otherwise just do a full scan if udevDevice == NULL
+                udev_device* udevDevice = udev_monitor_receive_device(udevMonitor);
+                ++eventCount;
+
+                updatePluggedList(udevDevice);
+
+                if (udevDevice)
+                    udev_device_unref(udevDevice);
+            }
+            else
+            {
+                continue;
+            }
+
+            publishPluggedList();
+        }
     }
 
     // Get a property value from a udev device
@@ -491,12 +563,47 @@ void JoystickImpl::initialize()
 
     // Do an initial scan
     updatePluggedList();
+    publishPluggedList();
+
+    // Then follow the connections and disconnections in the watcher thread
+    if (pipe(wakePipe) < 0)
+    {
+        err() << "Failed to create joystick watcher pipe, joystick connections and disconnections won't be notified: " << errno << std::endl;
+        wakePipe[0] = wakePipe[1] = -1;
+        return;
+    }
+
+    watcherThread = new Thread(&watchDevices);
+    watcherThread->launch();
 }
 
 
 ////////////////////////////////////////////////////////////
 void JoystickImpl::cleanup()
 {
+    // Stop the watcher thread
+    if (watcherThread)
+    {
+        char wake = 0;
+        if (write(wakePipe[1], &wake, 1) < 0)
+            err() << "Failed to stop the joystick watcher thread: " << errno << std::endl;
+
+        watcherThread->wait();
+        delete watcherThread;
+        watcherThread = NULL;
+    }
+
+    if (wakePipe[0] >= 0)
+    {
+        ::close(wakePipe[0]);
+        ::close(wakePipe[1]);
+        wakePipe[0] = wakePipe[1] = -1;
+    }
+
+    unsigned int scans, events;
+    getScanStats(scans, events);
+    err() << "Joysticks: " << scans << " device scans, " << events << " udev events" << std::endl;
+
     // Unreference the udev monitor to destroy it
     if (udevMonitor)
     {
@@ -514,37 +621,30 @@ void JoystickImpl::cleanup()
 
 
 ////////////////////////////////////////////////////////////
-bool JoystickImpl::isConnected(unsigned int index)
+void JoystickImpl::getScanStats(unsigned int& scans, unsigned int& events)
 {
-    // See if we can skip scanning if udev monitor is available
-    if (!udevMonitor)
-    {
-        // udev monitor is not available, perform a scan every query
-        updatePluggedList();
-    }
-    else if (hasMonitorEvent())
-    {
-        // Check if new joysticks were added/removed since last update
-        udev_device* udevDevice = udev_monitor_receive_device(udevMonitor);
+    Lock lock(joystickListMutex);
 
-        // If we can get the specific device, we check that,
-        // otherwise just do a full scan if udevDevice == NULL
-        updatePluggedList(udevDevice);
+    scans = scanCount;
+    events = eventCount;
+}
 
-        if (udevDevice)
-            udev_device_unref(udevDevice);
-    }
 
-    if (index >= joystickList.size())
+////////////////////////////////////////////////////////////
+bool JoystickImpl::isConnected(unsigned int index)
+{
+    // Maintained by the watcher thread: no scan here
+    if (index >= Joystick::Count)
         return false;
 
-    // Then check if the joystick is connected
-    return joystickList[index].plugged;
+    return (__atomic_load_n(&pluggedMask, __ATOMIC_ACQUIRE) >> index) & 1;
 }
 
 ////////////////////////////////////////////////////////////
 bool JoystickImpl::open(unsigned int index)
 {
+    Lock lock(joystickListMutex);
+
     if (index >= joystickList.size())
         return false;
 
@@ -62,6 +62,15 @@ public:
     ////////////////////////////////////////////////////////////
     static void cleanup();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the activity of the device watcher thread
+    ///
+    /// \param scans  Number of full rescans of the devices
+    /// \param events Number of udev monitor events
+    ///
+    ////////////////////////////////////////////////////////////
+    static void getScanStats(unsigned int& scans, unsigned int& events);
+
     ////////////////////////////////////////////////////////////
     /// \brief Check if a joystick is currently connected
     ///
@@ -0,0 +1,160 @@
+/**  This file is part of Witch Blast.
+  *
+  *  Witch Blast is free software: you can redistribute it and/or modify
+  *  it under the terms of the GNU General Public License as published by
+  *  the Free Software Foundation, either version 3 of the License, or
+  *  (at your option) any later version.
+  *
+  *  Witch Blast is distributed in the hope that it will be useful,
+  *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  *  GNU General Public License for more details.
+  *
+  *  You should have received a copy of the GNU General Public License
+  *  along with Witch Blast.  If not, see <http://www.gnu.org/licenses/>.
+  */
+
+#include "AiScheduler.h"
+
+#include <iostream>
+#include <sstream>
+#include <algorithm>
+#include <vector>
+
+// golden ratio conjugate, to spread the phases
+const float PHASE_STEP = 0.618034f;
+
+AiScheduler::AiScheduler()
+{
+  setThinkRate(AI_THINK_RATE);
+  setBudget(AI_THINK_BUDGET);
+  phaseCounter = 0;
+  allPromoted = false;
+  promoteNextFrame = false;
+  frameCost = 0;
+  frameThinkCount = 0;
+  frameDeferredCount = 0;
+  resetThinkCosts();
+}
+
+void AiScheduler::setThinkRate(int rate)
+{
+  if (rate < 1) rate = 1;
+  thinkPeriod = 1.0f / rate;
+}
+
+void AiScheduler::setBudget(int budget)
+{
+  this->budget = budget;
+}
+
+float AiScheduler::getThinkPeriod()
+{
+  return thinkPeriod;
+}
+
+float AiScheduler::getStartPhase()
+{
+  phaseCounter++;
+  float phase = phaseCounter * PHASE_STEP;
+  phase -= (int)phase;
+  return phase * thinkPeriod;
+}
+
+void AiScheduler::beginFrame()
+{
+  allPromoted = promoteNextFrame;
+  promoteNextFrame = false;
+  frameCost = 0;
+  frameThinkCount = 0;
+  frameDeferredCount = 0;
+}
+
+void AiScheduler::promoteAll()
+{
+  promoteNextFrame = true;
+}
+
+bool AiScheduler::canThink(float thinkTimer, bool promoted)
+{
+  if (promoted || allPromoted) return true;
+  if (thinkTimer < thinkPeriod) return false;
+
+  if (frameCost >= budget && thinkTimer < thinkPeriod * AI_THINK_MAX_LATE)
+  {
+    frameDeferredCount++;
+    return false;
+  }
+  return true;
+}
+
+void AiScheduler::addThinkCost(enemyTypeEnum enemyType, sf::Int64 cost)
+{
+  frameCost += cost;
+  frameThinkCount++;
+
+  if (enemyType < 0 || enemyType >= NB_ENEMY) return;
+  thinkCost[enemyType].count++;
+  thinkCost[enemyType].totalCost += cost;
+  if (cost > thinkCost[enemyType].maxCost) thinkCost[enemyType].maxCost = cost;
+}
+
+AiScheduler::thinkCostStruct AiScheduler::getThinkCost(enemyTypeEnum enemyType)
+{
+  return thinkCost[enemyType];
+}
+
+void AiScheduler::resetThinkCosts()
+{
+  for (int i = 0; i < NB_ENEMY; i++)
+  {
+    thinkCost[i].count = 0;
+    thinkCost[i].totalCost = 0;
+    thinkCost[i].maxCost = 0;
+  }
+}
+
+int AiScheduler::getFrameThinkCount()
+{
+  return frameThinkCount;
+}
+
+int AiScheduler::getFrameDeferredCount()
+{
+  return frameDeferredCount;
+}
+
+sf::Int64 AiScheduler::getFrameCost()
+{
+  return frameCost;
+}
+
+static bool compareThinkCosts(std::pair<sf::Int64, int> c1, std::pair<sf::Int64, int> c2)
+{
+  return c1.first > c2.first;
+}
+
+std::string AiScheduler::getReport(int lines)
+{
+  std::vector<std::pair<sf::Int64, int> > costs;
+  for (int i = 0; i < NB_ENEMY; i++)
+    if (thinkCost[i].count > 0) costs.push_back(std::pair<sf::Int64, int>(thinkCost[i].totalCost, i));
+  std::sort(costs.begin(), costs.end(), compareThinkCosts);
+
+  std::ostringstream oss;
+  oss << "AI: " << frameThinkCount << " steps, " << frameDeferredCount << " deferred, "
+      << frameCost << " us / " << budget << " us";
+
+  for (int i = 0; i < lines && i < (int)costs.size(); i++)
+  {
+    thinkCostStruct cost = thinkCost[costs[i].second];
+    oss << "\n" << enemyString[costs[i].second] << ": " << cost.count << " steps, avg "
+        << cost.totalCost / cost.count << " us, max " << cost.maxCost << " us";
+  }
+  return oss.str();
+}
+
+void AiScheduler::displayToConsole()
+{
+  std::cout << getReport(NB_ENEMY) << std::endl;
+}
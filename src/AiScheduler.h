@@ -0,0 +1,121 @@
+/**  This file is part of Witch Blast.
+  *
+  *  Witch Blast is free software: you can redistribute it and/or modify
+  *  it under the terms of the GNU General Public License as published by
+  *  the Free Software Foundation, either version 3 of the License, or
+  *  (at your option) any later version.
+  *
+  *  Witch Blast is distributed in the hope that it will be useful,
+  *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  *  GNU General Public License for more details.
+  *
+  *  You should have received a copy of the GNU General Public License
+  *  along with Witch Blast.  If not, see <http://www.gnu.org/licenses/>.
+  */
+
+#ifndef AISCHEDULER_H
+#define AISCHEDULER_H
+
+#include "BaseCreatureEntity.h"
+#include <string>
+
+/*! \class AiScheduler
+* \brief Schedules the "think" steps of the enemies
+*
+*  The enemies split their logic between "move" (physics, animation, timers), done every frame
+*  in animate(), and "think" (target acquisition, line of sight, attack decisions), done by
+*  EnemyEntity::think() at a lower rate.
+*  The think steps are spread over the frames (each enemy gets its own phase) and stop
+*  for the frame when the time budget is spent. A deferred step is forced when it is
+*  too late, and a promoted step (enemy hurt, player entering the room) runs immediately.
+*  Zombies, witches, the bosses and their invocated minions (slimes, bats, little spiders, green rats)
+*  have a think step; the other enemies still decide in animate().
+*/
+class AiScheduler
+{
+  public:
+    AiScheduler();
+
+    /*!
+     *  \brief sets the think rate
+     *  \param rate : think steps per second
+     */
+    void setThinkRate(int rate);
+
+    /*!
+     *  \brief sets the time budget of the think steps
+     *  \param budget : budget per frame (microseconds)
+     */
+    void setBudget(int budget);
+
+    float getThinkPeriod();
+
+    /*!
+     *  \brief returns a starting phase (time before the first think step)
+     *
+     *  The phases are spread over the period, so the enemies created together don't think on the same frame.
+     */
+    float getStartPhase();
+
+    /*!
+     *  \brief starts a new frame (resets the budget)
+     */
+    void beginFrame();
+
+    /*!
+     *  \brief promotes every think step of the next frame (ie the player enters the room)
+     */
+    void promoteAll();
+
+    /*!
+     *  \brief checks if an enemy can think now
+     *  \param thinkTimer : time elapsed since the last think step of the enemy
+     *  \param promoted : true if the think step has been promoted
+     *  \return true if the think step must be done
+     */
+    bool canThink(float thinkTimer, bool promoted);
+
+    /*!
+     *  \brief registers the cost of a think step
+     *  \param enemyType : type of the enemy
+     *  \param cost : cost of the step (microseconds)
+     */
+    void addThinkCost(enemyTypeEnum enemyType, sf::Int64 cost);
+
+    struct thinkCostStruct
+    {
+      int count;            /**< number of think steps */
+      sf::Int64 totalCost;  /**< total cost (microseconds) */
+      sf::Int64 maxCost;    /**< max cost of a step (microseconds) */
+    };
+    thinkCostStruct getThinkCost(enemyTypeEnum enemyType);
+    void resetThinkCosts();
+
+    int getFrameThinkCount();
+    int getFrameDeferredCount();
+    sf::Int64 getFrameCost();
+
+    /*!
+     *  \brief returns a short report of the think costs (most expensive types first)
+     *  \param lines : max number of enemy types
+     */
+    std::string getReport(int lines);
+    void displayToConsole();
+
+  private:
+    float thinkPeriod;
+    sf::Int64 budget;
+    int phaseCounter;
+
+    bool allPromoted;
+    bool promoteNextFrame;
+
+    sf::Int64 frameCost;
+    int frameThinkCount;
+    int frameDeferredCount;
+
+    thinkCostStruct thinkCost[NB_ENEMY];
+};
+
+#endif // AISCHEDULER_H
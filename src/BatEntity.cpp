@@ -19,6 +19,7 @@ BatEntity::BatEntity(float x, float y, EnumBatType batType, bool invocated)
   this->batType = batType;
 
   changingDelay = -0.5f;
+  hasThinkStep = true;
   shadowFrame = 9;
   movingStyle = movFlying;
 
@@ -51,31 +52,6 @@ void BatEntity::animate(float delay)
   if (!isAgonising)
   {
     changingDelay -= delay;
-    if (changingDelay < 0.0f)
-    {
-      if (batType != BatSkeleton || rand() % 3 == 0)
-      {
-        velocity = Vector2D(creatureSpeed);
-        acceleration.x = velocity.x / BAT_ACCELERATION;
-        acceleration.y = velocity.y / BAT_ACCELERATION;
-        computeFacingDirection();
-        velocity = Vector2D {0, 0};
-        doesAccelerate = true;
-      }
-
-      else
-      {
-        setVelocity(Vector2D(x, y).vectorTo(game().getPlayerPosition(), creatureSpeed ));
-        acceleration.x = velocity.x / BAT_ACCELERATION;
-        acceleration.y = velocity.y / BAT_ACCELERATION;
-        computeFacingDirection();
-        velocity = Vector2D {0, 0};
-        doesAccelerate = true;
-      }
-
-      changingDelay = 0.5f + (float)(rand() % 2500) / 1000.0f;
-
-    }
 
     if (age < 0.0f)
       frame = 1;
@@ -95,6 +71,33 @@ void BatEntity::animate(float delay)
   EnemyEntity::animate(delay);
 }
 
+void BatEntity::think(float delay)
+{
+  if (changingDelay >= 0.0f) return;
+
+  if (batType != BatSkeleton || rand() % 3 == 0)
+  {
+    velocity = Vector2D(creatureSpeed);
+    acceleration.x = velocity.x / BAT_ACCELERATION;
+    acceleration.y = velocity.y / BAT_ACCELERATION;
+    computeFacingDirection();
+    velocity = Vector2D {0, 0};
+    doesAccelerate = true;
+  }
+
+  else
+  {
+    setVelocity(Vector2D(x, y).vectorTo(game().getPlayerPosition(), creatureSpeed ));
+    acceleration.x = velocity.x / BAT_ACCELERATION;
+    acceleration.y = velocity.y / BAT_ACCELERATION;
+    computeFacingDirection();
+    velocity = Vector2D {0, 0};
+    doesAccelerate = true;
+  }
+
+  changingDelay = 0.5f + (float)(rand() % 2500) / 1000.0f;
+}
+
 void BatEntity::calculateBB()
 {
     boundingBox.left = (int)x - 16;
@@ -10,6 +10,7 @@ class BatEntity : public EnemyEntity
   public:
     BatEntity(float x, float y, EnumBatType batType, bool invocated);
     virtual void animate(float delay);
+    virtual void think(float delay) override;
     virtual void calculateBB();
   protected:
     virtual void collideMapRight();
@@ -50,16 +50,8 @@ void ButcherEntity::animate(float delay)
     sprite.setColor(sf::Color(255,255,255,255));
 
     timer = timer - delay;
-    if (timer <= 0.0f)
-    {
-      creatureSpeed = BUTCHER_VELOCITY + (hpMax - hp) * 0.8f;
-      timer = (rand() % 50) / 10.0f;
-      setVelocity(Vector2D(x, y).vectorTo(game().getPlayerPosition(), creatureSpeed ));
-      if (rand()%2 == 0)
-        SoundManager::getInstance().playSound(SOUND_BUTCHER_00);
-      else
-        SoundManager::getInstance().playSound(SOUND_BUTCHER_01);
-    }
+    if (timer <= 0.0f) promoteThink();
+    updateThink(delay);
 
     frame = ((int)(age * creatureSpeed / 25)) % 4;
     if (frame == 3) frame = 1;
@@ -72,6 +64,20 @@ void ButcherEntity::animate(float delay)
   z = y + 30;
 }
 
+void ButcherEntity::think(float delay)
+{
+  if (timer <= 0.0f)
+  {
+    creatureSpeed = BUTCHER_VELOCITY + (hpMax - hp) * 0.8f;
+    timer = (rand() % 50) / 10.0f;
+    setVelocity(Vector2D(x, y).vectorTo(game().getPlayerPosition(), creatureSpeed ));
+    if (rand()%2 == 0)
+      SoundManager::getInstance().playSound(SOUND_BUTCHER_00);
+    else
+      SoundManager::getInstance().playSound(SOUND_BUTCHER_01);
+  }
+}
+
 void ButcherEntity::calculateBB()
 {
     boundingBox.left = (int)x - 22;
@@ -22,6 +22,7 @@ class ButcherEntity : public EnemyEntity
     virtual void collideWithEnemy(EnemyEntity* entity) override;
 
 	  virtual void drop();
+    virtual void think(float delay) override;
   private:
     float timer;
     int sausages;
@@ -15,12 +15,110 @@
   */
 
 #include <cstdlib>
+#include <climits>
 #include <ostream>
 #include <fstream>
+#include <sstream>
 #include <string>
 #include <iostream>
 
+#include <SFML/Window/Keyboard.hpp>
+#include <SFML/Window/Joystick.hpp>
+
 #include "Config.h"
+#include "sfml_game/SoundManager.h"
+#include "sfml_game/MusicPlayer.h"
+#include "sfml_game/InputManager.h"
+
+struct configSchemaStruct
+{
+  const char* name;         /**< name in the config file */
+  configTypeEnum type;
+  int defaultValue;
+  int minValue;             /**< a value out of the bounds is ignored when loading, clamped when set */
+  int maxValue;
+};
+
+#define CONFIG_KEYBOARD(name, key) { name, ConfigTypeInt, sf::Keyboard::key, 0, sf::Keyboard::KeyCount - 1 }
+#define CONFIG_JOYSTICK(name, isButton, value, axis) \
+  { "joy_" name "_button", ConfigTypeBool, isButton, -999, INT_MAX }, \
+  { "joy_" name "_value", ConfigTypeInt, value, -999, INT_MAX }, \
+  { "joy_" name "_axis", ConfigTypeInt, sf::Joystick::axis, sf::Joystick::X, sf::Joystick::PovY }
+
+/** The settings, in the order of configKeyEnum */
+static const configSchemaStruct schema[] =
+{
+  { "language",               ConfigTypeInt,    0,    0, NB_LANGUAGES - 1 },
+  { "player_name",            ConfigTypeString, 0,    0, 0 },
+  { "volume_sound",           ConfigTypeInt,    80,   0, 100 },
+  { "volume_music",           ConfigTypeInt,    80,   0, 100 },
+  { "zoom_enabled",           ConfigTypeBool,   1,    0, INT_MAX },
+  { "vsync_enabled",          ConfigTypeBool,   1,    0, INT_MAX },
+  { "blood_spreading",        ConfigTypeBool,   1,    0, INT_MAX },
+  { "fullscreen",             ConfigTypeBool,   0,    0, INT_MAX },
+  { "pause_on_focus_lost",    ConfigTypeBool,   1,    0, INT_MAX },
+  { "particles_batching",     ConfigTypeBool,   1,    0, INT_MAX },
+  { "low_particles",          ConfigTypeBool,   0,    0, INT_MAX },
+  { "display_boss_portrait",  ConfigTypeBool,   0,    0, INT_MAX },
+  { "ai_think_rate",          ConfigTypeInt,    AI_THINK_RATE,    1, INT_MAX },
+  { "ai_think_budget",        ConfigTypeInt,    AI_THINK_BUDGET,  1, INT_MAX },
+  { "sound_memory",           ConfigTypeInt,    SOUND_MEMORY_BUDGET / (1024 * 1024), 1, INT_MAX },
+  { "music_buffer",           ConfigTypeInt,    MUSIC_BUFFER_DURATION, 1, INT_MAX },
+  { "joystick_dead_zone",     ConfigTypeInt,    INPUT_DEAD_ZONE,  0, 99 },
+  { "pipelined_update",       ConfigTypeBool,   0,    0, INT_MAX },
+  { "frame_timing_log",       ConfigTypeBool,   0,    0, INT_MAX },
+  { "job_threads",            ConfigTypeInt,    0,    0, 64 },
+  { "particle_budget",        ConfigTypeBool,   1,    0, INT_MAX },
+  { "particle_frame_target",  ConfigTypeInt,    PARTICLE_FRAME_TARGET, 1, INT_MAX },
+  { "particle_scale_min",     ConfigTypeInt,    PARTICLE_SCALE_MIN,    1, 100 },
+  { "particle_scale_max",     ConfigTypeInt,    PARTICLE_SCALE_MAX,    1, 100 },
+  { "particle_live_max",      ConfigTypeInt,    PARTICLE_LIVE_MAX,     1, INT_MAX },
+  { "particle_budget_log",    ConfigTypeBool,   0,    0, INT_MAX },
+
+  // keyboard, in the order of the input keys
+  CONFIG_KEYBOARD("keyboard_move_up",       W),
+  CONFIG_KEYBOARD("keyboard_move_down",     S),
+  CONFIG_KEYBOARD("keyboard_move_left",     A),
+  CONFIG_KEYBOARD("keyboard_move_right",    D),
+  CONFIG_KEYBOARD("keyboard_fire_up",       Up),
+  CONFIG_KEYBOARD("keyboard_fire_down",     Down),
+  CONFIG_KEYBOARD("keyboard_fire_left",     Left),
+  CONFIG_KEYBOARD("keyboard_fire_right",    Right),
+  CONFIG_KEYBOARD("keyboard_fire_select",   Tab),
+  CONFIG_KEYBOARD("keyboard_spell",         Space),
+  CONFIG_KEYBOARD("keyboard_interact",      E),
+  CONFIG_KEYBOARD("keyboard_time_control",  RShift),
+  CONFIG_KEYBOARD("keyboard_fire",          RControl),
+
+  // joystick, in the order of the input keys
+  // (the names of the last five ones do not match their input: kept for the existing files)
+  CONFIG_JOYSTICK("_move_up",       0, -1, Y),
+  CONFIG_JOYSTICK("_move_down",     0, 1,  Y),
+  CONFIG_JOYSTICK("_move_left",     0, -1, X),
+  CONFIG_JOYSTICK("_move_right",    0, 1,  X),
+  CONFIG_JOYSTICK("_fire_up",       1, 3,  X),
+  CONFIG_JOYSTICK("_fire_down",     1, 0,  X),
+  CONFIG_JOYSTICK("_fire_left",     1, 2,  X),
+  CONFIG_JOYSTICK("_fire_right",    1, 1,  X),
+  CONFIG_JOYSTICK("_spell",         1, 4,  X),
+  CONFIG_JOYSTICK("_interact",      1, 5,  X),
+  CONFIG_JOYSTICK("_fire",          1, 6,  X),
+  CONFIG_JOYSTICK("_time_control",  1, 7,  X),
+  CONFIG_JOYSTICK("_fire_select",   1, 8,  X),
+};
+
+static_assert(sizeof(schema) / sizeof(schema[0]) == NB_CONFIG_KEYS, "config schema and configKeyEnum mismatch");
+
+/** Finds a setting from its name (-1 if unknown) */
+static int findConfigKey(const std::string& name)
+{
+  static std::map<std::string, int> index;
+  if (index.empty())
+    for (int i = 0; i < NB_CONFIG_KEYS; i++) index[schema[i].name] = i;
+
+  std::map<std::string, int>::const_iterator it = index.find(name);
+  return it == index.end() ? -1 : it->second;
+}
 
 Config::Config()
 {
@@ -32,8 +130,31 @@ bool Config::configFileExists()
   return configFileExistsFlag;
 }
 
+const char* Config::getName(configKeyEnum key)
+{
+  return schema[key].name;
+}
+
+configTypeEnum Config::getType(configKeyEnum key)
+{
+  return schema[key].type;
+}
+
+void Config::setDefaults()
+{
+  for (int i = 0; i < NB_CONFIG_KEYS; i++)
+  {
+    values[i] = schema[i].defaultValue;
+    strings[i].clear();
+    dirty[i] = false;
+  }
+  unknownSettings.clear();
+}
+
 void Config::loadFromFile(std::string file)
 {
+  setDefaults();
+
   std::ifstream f(file.c_str());
   if (!f.is_open())
   {
@@ -42,14 +163,30 @@ void Config::loadFromFile(std::string file)
   else
   {
     configFileExistsFlag = true;
-    std::string key;
+    std::string name;
+    std::string data;
 
-    while (f >> key)
+    // one pass: each value is converted when it is read
+    while (f >> name && f >> data)
     {
-      std::string data;
-      if (f >> data)
+      int key = findConfigKey(name);
+      if (key < 0)
+      {
+        unknownSettings[name] = data;
+      }
+      else if (schema[key].type == ConfigTypeString)
       {
-        configMap[key] = data;
+        strings[key] = data;
+      }
+      else
+      {
+        char* end;
+        long value = strtol(data.c_str(), &end, 10);
+        if (end != data.c_str() && value >= schema[key].minValue && value <= schema[key].maxValue)
+        {
+          if (schema[key].type == ConfigTypeBool) value = (value != 0);
+          values[key] = (int)value;
+        }
       }
     }
 
@@ -57,59 +194,99 @@ void Config::loadFromFile(std::string file)
   }
 }
 
-void Config::saveToFile(std::string fileName, std::map<std::string, std::string> newMap)
+bool Config::saveToFile(std::string fileName)
 {
-  std::ofstream file(fileName.c_str(), std::ios::out | std::ios::trunc);
-  if (file)
-  {
-    configFileExistsFlag = true;
-    std::map<std::string, std::string>::iterator it;
+  bool mustSave = !configFileExistsFlag;
+  for (int i = 0; i < NB_CONFIG_KEYS && !mustSave; i++) mustSave = dirty[i];
+  if (!mustSave) return false;
 
-    for(it = newMap.begin(); it != newMap.end(); it++)
-    {
-      file << it->first << " " << it->second << std::endl;
-    }
-    file.close();
+  // the text file cannot be changed in place: it is written again
+  std::ostringstream oss;
+  for (int i = 0; i < NB_CONFIG_KEYS; i++)
+  {
+    oss << schema[i].name << " ";
+    if (schema[i].type == ConfigTypeString)
+      oss << strings[i];
+    else
+      oss << values[i];
+    oss << std::endl;
   }
+  std::map<std::string, std::string>::iterator it;
+  for (it = unknownSettings.begin(); it != unknownSettings.end(); it++)
+  {
+    oss << it->first << " " << it->second << std::endl;
+  }
+
+  std::ofstream file(fileName.c_str(), std::ios::out | std::ios::trunc);
+  if (!file) return false;
+  file << oss.str();
+  file.close();
+
+  configFileExistsFlag = true;
+  for (int i = 0; i < NB_CONFIG_KEYS; i++) dirty[i] = false;
+  return true;
 }
 
 void Config::displayMap()
 {
-  std::map<std::string, std::string>::const_iterator
-  mit (configMap.begin()),
-      mend(configMap.end());
-  for(; mit!=mend; ++mit)
+  for (int i = 0; i < NB_CONFIG_KEYS; i++)
   {
-    std::cout << "\"" << mit->first << "\"" << '\t' << mit->second << std::endl;
+    std::cout << "\"" << schema[i].name << "\"" << '\t';
+    if (schema[i].type == ConfigTypeString)
+      std::cout << strings[i] << std::endl;
+    else
+      std::cout << values[i] << std::endl;
   }
 }
 
-int Config::findInt(std::string key)
+int Config::getInt(configKeyEnum key) const
 {
-  std::map<std::string, std::string>::const_iterator
-  mit(configMap.find(key)),
-      mend(configMap.end());
-  if(mit!=mend)
-  {
-    int value = atoi(mit->second.c_str());
-    return value;
-  }
-  else
-  {
-    return -99999;
-  }
+  return values[key];
+}
 
-  return atoi(mit->second.c_str());
+bool Config::getBool(configKeyEnum key) const
+{
+  return values[key] != 0;
 }
 
-std::string Config::findString(std::string key)
+const std::string& Config::getString(configKeyEnum key) const
 {
-  std::map<std::string, std::string>::const_iterator
-  mit(configMap.find(key)),
-      mend(configMap.end());
-  std::string result = "";
-  if(mit!=mend)
-    result = mit->second.c_str();
+  return strings[key];
+}
+
+void Config::setInt(configKeyEnum key, int value)
+{
+  if (schema[key].type == ConfigTypeBool)
+    value = (value != 0);
+  else if (value < schema[key].minValue)
+    value = schema[key].minValue;
+  else if (value > schema[key].maxValue)
+    value = schema[key].maxValue;
+
+  if (values[key] == value) return;
+  values[key] = value;
+  changed(key);
+}
+
+void Config::setBool(configKeyEnum key, bool value)
+{
+  setInt(key, value ? 1 : 0);
+}
 
-  return result;
+void Config::setString(configKeyEnum key, const std::string& value)
+{
+  if (strings[key] == value) return;
+  strings[key] = value;
+  changed(key);
+}
+
+void Config::addListener(std::function<void(configKeyEnum)> listener)
+{
+  listeners.push_back(listener);
+}
+
+void Config::changed(configKeyEnum key)
+{
+  dirty[key] = true;
+  for (unsigned int i = 0; i < listeners.size(); i++) listeners[i](key);
 }
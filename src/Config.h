@@ -18,23 +18,128 @@
 #define CONFIG_H_INCLUDED
 
 #include <map>
+#include <string>
+#include <vector>
+#include <functional>
 #include "Constants.h"
 
+/** Type of a setting */
+enum configTypeEnum
+{
+  ConfigTypeInt,
+  ConfigTypeBool,
+  ConfigTypeString
+};
+
+/** The settings of the config file
+ *  Their names, types, defaults and bounds are in the schema (Config.cpp).
+ */
+enum configKeyEnum
+{
+  ConfigLanguage,
+  ConfigPlayerName,
+  ConfigVolumeSound,
+  ConfigVolumeMusic,
+  ConfigZoom,
+  ConfigVsync,
+  ConfigBloodSpread,
+  ConfigFullscreen,
+  ConfigPauseOnFocusLost,
+  ConfigParticlesBatching,
+  ConfigLowParticles,
+  ConfigDisplayBossPortrait,
+  ConfigAiThinkRate,
+  ConfigAiThinkBudget,
+  ConfigSoundMemory,
+  ConfigMusicBuffer,
+  ConfigJoystickDeadZone,
+  ConfigPipelinedUpdate,
+  ConfigFrameTimingLog,
+  ConfigJobThreads,
+  ConfigParticleBudget,
+  ConfigParticleFrameTarget,
+  ConfigParticleScaleMin,
+  ConfigParticleScaleMax,
+  ConfigParticleLiveMax,
+  ConfigParticleBudgetLog,
+
+  ConfigKeyboard,                                     /**< keyboard key of the first input (NumberKeys settings) */
+  ConfigJoystick = ConfigKeyboard + NumberKeys,       /**< joystick of the first input: button, value, axis (3 * NumberKeys settings) */
+
+  NB_CONFIG_KEYS = ConfigJoystick + 3 * NumberKeys
+};
+
+/** Joystick settings of an input */
+enum configJoystickEnum
+{
+  ConfigJoystickButton,
+  ConfigJoystickValue,
+  ConfigJoystickAxis,
+  NB_CONFIG_JOYSTICK
+};
+
+/** Keyboard setting of an input (inputKeyEnum) */
+inline configKeyEnum getKeyboardConfigKey(int input)
+{
+  return (configKeyEnum)(ConfigKeyboard + input);
+}
+
+/** Joystick setting of an input (inputKeyEnum) */
+inline configKeyEnum getJoystickConfigKey(int input, configJoystickEnum setting)
+{
+  return (configKeyEnum)(ConfigJoystick + input * NB_CONFIG_JOYSTICK + setting);
+}
+
+/*! \class Config
+* \brief Typed settings of the game, read from and saved to the config file
+*
+*  The file is parsed once into a flat array of values (out of bounds values are replaced by the
+*  default). The values changed since the last save are marked dirty, and the listeners are
+*  notified of each change, so the game applies a setting where it is changed.
+*/
 class Config
 {
 public:
   Config();
   void loadFromFile(std::string file);
-  void saveToFile(std::string file, std::map<std::string, std::string> newMap);
-  void displayMap();
 
-  int findInt(std::string key);
-  std::string findString(std::string key);
+  /*!
+   *  \brief saves the settings, if any of them changed
+   *  \return true if the file has been written
+   */
+  bool saveToFile(std::string file);
+  void displayMap();
   bool configFileExists();
 
+  int getInt(configKeyEnum key) const;
+  bool getBool(configKeyEnum key) const;
+  const std::string& getString(configKeyEnum key) const;
+
+  /*!
+   *  \brief changes a setting (bounded by the schema) and notifies the listeners if it changed
+   */
+  void setInt(configKeyEnum key, int value);
+  void setBool(configKeyEnum key, bool value);
+  void setString(configKeyEnum key, const std::string& value);
+
+  /*!
+   *  \brief adds a listener, called with the key of each changed setting
+   */
+  void addListener(std::function<void(configKeyEnum)> listener);
+
+  static const char* getName(configKeyEnum key);
+  static configTypeEnum getType(configKeyEnum key);
+
 private:
-  std::map<std::string, std::string> configMap;
+  int values[NB_CONFIG_KEYS];
+  std::string strings[NB_CONFIG_KEYS];
+  bool dirty[NB_CONFIG_KEYS];
+  std::map<std::string, std::string> unknownSettings; /**< settings of other versions, kept in the file */
+  std::vector<std::function<void(configKeyEnum)> > listeners;
   bool configFileExistsFlag;
+
+  void setDefaults();
+  void changed(configKeyEnum key);
 };
 
 #endif // CONFIG_H_INCLUDED
@@ -26,14 +26,24 @@ const std::string CONFIG_FILE =     "config.dat";
 const std::string SAVE_FILE =       "game.sav";
 const std::string SAVE_DATA_FILE =  "data/data.sav";
 const std::string HISCORES_FILE =   "data/scores.dat";
+const std::string RECORDS_FILE =    "data/records.log";
+const std::string ASSET_ARCHIVE_FILE = "assets.pak";  // media/ and data/ packed (optional)
+const std::string IMAGE_CACHE_NAME = "witchblast";    // decoded images, in the per-user cache directory
 
 const std::string SAVE_VERSION =    "SAVE_0.8";
+const int SAVE_CHUNK_HEAD_VERSION = 1;   // save file chunks (to increase when their content changes)
+const int SAVE_CHUNK_FLOOR_VERSION = 1;
+const int SAVE_CHUNK_ROOM_VERSION = 1;
+const int SAVE_CHUNK_GAME_VERSION = 1;
+const int SAVE_CHUNK_PLAYER_VERSION = 1;
 const std::string SCORE_VERSION =   "V075_DEV";
 
 const int NB_LANGUAGES = 5;
 const std::string languageString[NB_LANGUAGES] = { "english", "french", "german", "spanish", "russian" };
 const std::string languageState[NB_LANGUAGES] = { "", "", "", "", "" };
 
+unsigned const int NumberKeys = 13; /*!< Number of input keys on the game */
+
 const unsigned int SCORES_MAX    = 10;
 
 const int LAST_LEVEL = 8;
@@ -83,6 +93,35 @@ const float ACHIEVEMENT_DELAY_MAX = 15.0f;
 
 const float KeyRoomFXDelay = 2.0f;
 
+const float MUSIC_CROSSFADE_DELAY = 1.0f;
+
+// glyphs pre-bake
+const int GLYPH_BAKE_BUDGET = 2000;     // glyphs rendered per frame before they are displayed (microseconds)
+const int GLYPH_BAKE_MIN_SIZE = 5;      // smallest size of the texts (shrunk to fit)
+const int GLYPH_BAKE_MAX_SIZE = 32;
+
+// particles (job system)
+const int PARTICLE_JOB_GRAIN = 256;     // particles per chunk (a smaller set is animated in place)
+
+// adaptive particle budget
+const int PARTICLE_FRAME_TARGET = 12000;      // busy time targeted per frame (microseconds, default)
+const int PARTICLE_SCALE_MIN = 25;            // floor of the emission scale (percent, default)
+const int PARTICLE_SCALE_MAX = 100;           // ceiling of the emission scale (percent, default)
+const int PARTICLE_LIVE_MAX = 3000;           // live particles above which the emission is reduced (default)
+const float PARTICLE_SCALE_STEP = 0.05f;
+const float PARTICLE_DOWN_DELAY = 0.25f;      // min delay between two reductions (seconds)
+const float PARTICLE_UP_DELAY = 1.0f;         // min delay between two increases (seconds)
+const float PARTICLE_UP_THRESHOLD = 0.75f;    // the scale increases under this part of the targets
+const float PARTICLE_FRAME_SMOOTHING = 0.1f;  // weight of the last frame in the average frame time
+
+// AI scheduler
+const int AI_THINK_RATE = 15;           // think steps per second (default)
+const int AI_THINK_BUDGET = 2000;       // think budget per frame (microseconds, default)
+const float AI_THINK_MAX_LATE = 3.0f;   // a deferred think step is forced after this number of periods
+
+// frame timing
+const int FRAME_TIMING_PERIOD = 600;    // frames averaged in the timing log (sequential or pipelined)
+
 enum enum_images {
   IMAGE_PLAYER_0,
   IMAGE_PLAYER_1,
@@ -503,6 +542,7 @@ const float FAIRY_BOLT_LIFE = 0.4f;
 const int FAIRY_BOLT_DAMAGES = 8;
 const int FAIRY_FIRE_DAMAGES = 12;
 const float FAIRY_BOLT_VELOCITY = 700.0f;
+const float FAIRY_AIM_HALF_ANGLE = 1.05f;   // cone of the target fairy shots, around the fire direction (radians)
 
 // Rat
 const float RAT_SPEED = 195.0f;
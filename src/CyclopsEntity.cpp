@@ -100,10 +100,8 @@ void CyclopsEntity::computeNextRockMissile()
     nextRockMissile = rand()%3 == 0 ? 0 : 1;
 }
 
-void CyclopsEntity::computeStates(float delay)
+void CyclopsEntity::think(float delay)
 {
-  timer -= delay;
-
   if (timer <= 0.0f)
   {
     if (state == 0) // walking
@@ -217,7 +215,9 @@ void CyclopsEntity::animate(float delay)
   if (specialState[SpecialStateIce].active) delay *= specialState[SpecialStateIce].param1;
 
   // IA
-  computeStates(delay);
+  timer -= delay;
+  if (timer <= 0.0f) promoteThink();
+  updateThink(delay);
 
   // collisions
   if (canCollide()) testSpriteCollisions();
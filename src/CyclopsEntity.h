@@ -23,7 +23,7 @@ class CyclopsEntity : public EnemyEntity
 	  virtual void collideWithEnemy(EnemyEntity* entity) override;
 	  virtual void drop();
 
-	  void computeStates(float delay);
+    virtual void think(float delay) override;
 	  int getHealthLevel();
   private:
     float timer;
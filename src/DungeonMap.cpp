@@ -1,8 +1,5 @@
 #include "DungeonMap.h"
 #include "GameFloor.h"
-#include "ItemEntity.h"
-#include "ChestEntity.h"
-#include "sfml_game/ImageManager.h"
 #include <cstdlib>
 #include <stdio.h>
 #include <iostream>
@@ -89,23 +86,23 @@ void DungeonMap::setRoomType(roomTypeEnum roomType)
 
 int DungeonMap::getObjectTile(int x, int y)
 {
-  return objectsMap[x][y];
+  return tileAt(x, y).object;
 }
 
 logicalMapStateEnum DungeonMap::getLogicalTile(int x, int y)
 {
-  return logicalMap[x][y];
+  return (logicalMapStateEnum)tileAt(x, y).logical;
 }
 
 void DungeonMap::setObjectTile(int x, int y, int n)
 {
-  objectsMap[x][y] = n;
+  tileAt(x, y).object = n;
   hasChanged = true;
 }
 
 void DungeonMap::setLogicalTile(int x, int y, logicalMapStateEnum state)
 {
-  logicalMap[x][y] = state;
+  tileAt(x, y).logical = state;
   hasChanged = true;
 }
 
@@ -136,17 +133,17 @@ void DungeonMap::setDoorType(int direction, doorEnum type)
   doorType[direction] = type;
 }
 
-std::list<DungeonMap::itemListElement> DungeonMap::getItemList()
+const DungeonMap::ItemList& DungeonMap::getItemList()
 {
   return (itemList);
 }
 
-std::list<DungeonMap::chestListElement> DungeonMap::getChestList()
+const DungeonMap::ChestList& DungeonMap::getChestList()
 {
   return (chestList);
 }
 
-std::list<DungeonMap::spriteListElement> DungeonMap::getSpriteList()
+const DungeonMap::SpriteList& DungeonMap::getSpriteList()
 {
   return (spriteList);
 }
@@ -170,7 +167,7 @@ void DungeonMap::displayToConsole()
   {
     for (int i=0; i < MAP_WIDTH; i++)
     {
-      printf("%d", map[i][j]);
+      printf("%d", tileAt(i, j).tile);
     }
     printf("\n");
   }
@@ -180,25 +177,25 @@ void DungeonMap::displayToConsole()
 bool DungeonMap::isDownBlocking(int x, int y)
 {
   if (!inMap(x, y)) return false;
-  return (logicalMap[x][y] != LogicalFloor);
+  return (tileAt(x, y).logical != LogicalFloor);
 }
 
 bool DungeonMap::isUpBlocking(int x, int y)
 {
   if (!inMap(x, y)) return false;
-  return (logicalMap[x][y] != LogicalFloor);
+  return (tileAt(x, y).logical != LogicalFloor);
 }
 
 bool DungeonMap::isLeftBlocking(int x, int y)
 {
   if (!inMap(x, y)) return false;
-  return (logicalMap[x][y] != LogicalFloor);
+  return (tileAt(x, y).logical != LogicalFloor);
 }
 
 bool DungeonMap::isRightBlocking(int x, int y)
 {
   if (!inMap(x, y)) return false;
-  return (logicalMap[x][y] != LogicalFloor);
+  return (tileAt(x, y).logical != LogicalFloor);
 }
 
 bool DungeonMap::isWalkable(int x, int y)
@@ -211,7 +208,7 @@ bool DungeonMap::isWalkable(int x, int y)
     if (x >= x0 - 1 && x <= x0 +1 && y >= y0 - 1 && y <= y0 + 1)
       return false;
   }
-  return (logicalMap[x][y] == LogicalFloor);
+  return (tileAt(x, y).logical == LogicalFloor);
 }
 
 bool DungeonMap::isFlyable(int x, int y)
@@ -221,13 +218,13 @@ bool DungeonMap::isFlyable(int x, int y)
   if (y < 0) return true;
   if (y > MAP_HEIGHT - 1) return true;
 
-  return (logicalMap[x][y] != LogicalWall);
+  return (tileAt(x, y).logical != LogicalWall);
 }
 
 bool DungeonMap::isShootable(int x, int y)
 {
   if (!inMap(x, y)) return true;
-  return (logicalMap[x][y] != LogicalWall && logicalMap[x][y] != LogicalObstacle);
+  return (tileAt(x, y).logical != LogicalWall && tileAt(x, y).logical != LogicalObstacle);
 }
 
 bool DungeonMap::containsHealth()
@@ -265,24 +262,24 @@ void DungeonMap::randomize(int n)
 
     if (r == 0) // corner blocks
     {
-      map[1][1] = 4;
-      map[1][MAP_HEIGHT -2] = 4;
-      map[MAP_WIDTH - 2][1] = 4;
-      map[MAP_WIDTH - 2][MAP_HEIGHT -2] = 4;
+      tileAt(1, 1).tile = 4;
+      tileAt(1, MAP_HEIGHT -2).tile = 4;
+      tileAt(MAP_WIDTH - 2, 1).tile = 4;
+      tileAt(MAP_WIDTH - 2, MAP_HEIGHT -2).tile = 4;
     }
 
     else if (r == 1) // bloc in the middle
     {
       for (i = x0-1; i <= x0+1; i++)
         for (j = y0-1; j <= y0+1; j++)
-          map[i][j] = 4;
+          tileAt(i, j).tile = 4;
     }
 
     else if (r == 2) // checker
     {
       for (i = 2; i < MAP_WIDTH - 2; i = i + 2)
         for (j = 2; j < MAP_HEIGHT - 2; j = j + 2)
-          map[i][j] = 4;
+          tileAt(i, j).tile = 4;
     }
 
     cleared = false;
@@ -404,8 +401,8 @@ int DungeonMap::getDivinity(int x, int y)
 {
   if (x <= 0 || (x >= MAP_WIDTH - 1) || y <= 0 || (y >= MAP_HEIGHT - 1)) return -1;
 
-  if (map[x][y] >= MAP_TEMPLE && map[x][y] < MAP_TEMPLE + NB_DIVINITY)
-    return (map[x][y] - MAP_TEMPLE);
+  if (tileAt(x, y).tile >= MAP_TEMPLE && tileAt(x, y).tile < MAP_TEMPLE + NB_DIVINITY)
+    return (tileAt(x, y).tile - MAP_TEMPLE);
   else
     return -1;
 }
@@ -477,55 +474,55 @@ void DungeonMap::initRoom(int floorN, int wallN)
   for (i = 0; i < 4; i++) doorType[i] = DoorNone;
 
   // outer walls
-  map[0][0] = wallOffset + MAP_WALL_7 + rand() % 2;
+  tileAt(0, 0).tile = wallOffset + MAP_WALL_7 + rand() % 2;
   for ( i = 1 ; i < width -1 ; i++)
   {
     if (i == width / 2)
     {
-      map[i][0] = wallOffset + MAP_WALL_8 + rand() % 2;
-      map[i][height - 1] = wallOffset + MAP_WALL_8 + rand() % 2;
+      tileAt(i, 0).tile = wallOffset + MAP_WALL_8 + rand() % 2;
+      tileAt(i, height - 1).tile = wallOffset + MAP_WALL_8 + rand() % 2;
     }
     else if (i < width / 2)
     {
-      map[i][0] = wallOffset + MAP_WALL_87 + rand() % 8;
-      map[i][height - 1] = wallOffset + MAP_WALL_87 + rand() % 8;
+      tileAt(i, 0).tile = wallOffset + MAP_WALL_87 + rand() % 8;
+      tileAt(i, height - 1).tile = wallOffset + MAP_WALL_87 + rand() % 8;
     }
     else
     {
-      map[i][0] = wallOffset + MAP_WALL_87 + rand() % 8;
-      map[i][height - 1] = wallOffset + MAP_WALL_87 + rand() % 8;
+      tileAt(i, 0).tile = wallOffset + MAP_WALL_87 + rand() % 8;
+      tileAt(i, height - 1).tile = wallOffset + MAP_WALL_87 + rand() % 8;
     }
   }
-  map[width - 1][0] = wallOffset + MAP_WALL_7 + rand() % 2;
+  tileAt(width - 1, 0).tile = wallOffset + MAP_WALL_7 + rand() % 2;
   for ( int i = 1 ; i < height -1 ; i++)
   {
     if (i == height / 2)
     {
-      map[0][i] = wallOffset + MAP_WALL_8 + rand() % 2;
-      map[width - 1][i] = wallOffset + MAP_WALL_8 + rand() % 2;
+      tileAt(0, i).tile = wallOffset + MAP_WALL_8 + rand() % 2;
+      tileAt(width - 1, i).tile = wallOffset + MAP_WALL_8 + rand() % 2;
     }
     else if (i < height / 2)
     {
-      map[0][i] = wallOffset + MAP_WALL_87 + rand() % 8;
-      map[width - 1][i] = wallOffset + MAP_WALL_87 + rand() % 8;
+      tileAt(0, i).tile = wallOffset + MAP_WALL_87 + rand() % 8;
+      tileAt(width - 1, i).tile = wallOffset + MAP_WALL_87 + rand() % 8;
     }
     else
     {
-      map[0][i] = wallOffset + MAP_WALL_87 + rand() % 8;
-      map[width - 1][i] = wallOffset + MAP_WALL_87 + rand() % 8;
+      tileAt(0, i).tile = wallOffset + MAP_WALL_87 + rand() % 8;
+      tileAt(width - 1, i).tile = wallOffset + MAP_WALL_87 + rand() % 8;
     }
   }
-  map[0][height - 1] = wallOffset + MAP_WALL_7 + rand() % 2;
-  map[width - 1][height - 1] = wallOffset + MAP_WALL_7 + rand() % 2;
+  tileAt(0, height - 1).tile = wallOffset + MAP_WALL_7 + rand() % 2;
+  tileAt(width - 1, height - 1).tile = wallOffset + MAP_WALL_7 + rand() % 2;
 
   // floor
   for ( j = 1 ; j < height - 1 ; j++)
   {
     for ( i = 1 ; i < width - 1 ; i++)
     {
-      map[i][j] = floorOffset + rand()%(MAP_NORMAL_FLOOR);
-      while (map[i][j] == map[i - 1][j] || map[i][j] == map[i][j - 1] || map[i][j] == map[i - 1][j - 1] || map[i][j] == map[i + 1][j - 1])
-        map[i][j] = floorOffset + rand()%(MAP_NORMAL_FLOOR);
+      tileAt(i, j).tile = floorOffset + rand()%(MAP_NORMAL_FLOOR);
+      while (tileAt(i, j).tile == tileAt(i - 1, j).tile || tileAt(i, j).tile == tileAt(i, j - 1).tile || tileAt(i, j).tile == tileAt(i - 1, j - 1).tile || tileAt(i, j).tile == tileAt(i + 1, j - 1).tile)
+        tileAt(i, j).tile = floorOffset + rand()%(MAP_NORMAL_FLOOR);
     }
   }
 
@@ -534,11 +531,11 @@ void DungeonMap::initRoom(int floorN, int wallN)
   {
     for ( i = 0 ; i < width; i++)
     {
-      objectsMap[i][j] = 0;
+      tileAt(i, j).object = 0;
       if (i == 0 || j == 0 || i == width - 1 || j == height - 1)
-        logicalMap[i][j] = LogicalWall;
+        tileAt(i, j).logical = LogicalWall;
       else
-        logicalMap[i][j] = LogicalFloor;
+        tileAt(i, j).logical = LogicalFloor;
     }
   }
 
@@ -547,7 +544,7 @@ void DungeonMap::initRoom(int floorN, int wallN)
   {
     if (rand() % 2 > 0)
     {
-      map[1 + rand() % (MAP_WIDTH - 2)][1 + rand() % (MAP_HEIGHT - 2)] = floorOffset + 16 + i;
+      tileAt(1 + rand() % (MAP_WIDTH - 2), 1 + rand() % (MAP_HEIGHT - 2)).tile = floorOffset + 16 + i;
     }
   }
 
@@ -571,7 +568,7 @@ void DungeonMap::initRoom(int floorN, int wallN)
         yTile = 1 + rand() % 6;
         if (yTile > 3) yTile++;
       }
-      map[xTile][yTile] = i + wallOffset + MAP_WALL_87 + 8;
+      tileAt(xTile, yTile).tile = i + wallOffset + MAP_WALL_87 + 8;
     }
   }
 
@@ -582,9 +579,9 @@ void DungeonMap::initRoom(int floorN, int wallN)
     {
       if (gameFloor->getRoom(x - 1, y) != roomTypeSecret)
       {
-        map[0][MAP_HEIGHT / 2] = floorOffset;
-        map[0][MAP_HEIGHT / 2 - 1] = floorOffset;
-        map[0][MAP_HEIGHT / 2 + 1] = floorOffset;
+        tileAt(0, MAP_HEIGHT / 2).tile = floorOffset;
+        tileAt(0, MAP_HEIGHT / 2 - 1).tile = floorOffset;
+        tileAt(0, MAP_HEIGHT / 2 + 1).tile = floorOffset;
         openDoor(0, y0);
 
         if (roomType == roomTypeBoss || gameFloor->getRoom(x - 1, y) == roomTypeBoss)
@@ -615,9 +612,9 @@ void DungeonMap::initRoom(int floorN, int wallN)
     {
       if (gameFloor->getRoom(x + 1, y) != roomTypeSecret)
       {
-        map[MAP_WIDTH - 1][MAP_HEIGHT / 2] = floorOffset;
-        map[MAP_WIDTH - 1][MAP_HEIGHT / 2 - 1] = floorOffset;
-        map[MAP_WIDTH - 1][MAP_HEIGHT / 2 + 1] = floorOffset;
+        tileAt(MAP_WIDTH - 1, MAP_HEIGHT / 2).tile = floorOffset;
+        tileAt(MAP_WIDTH - 1, MAP_HEIGHT / 2 - 1).tile = floorOffset;
+        tileAt(MAP_WIDTH - 1, MAP_HEIGHT / 2 + 1).tile = floorOffset;
         openDoor(MAP_WIDTH - 1, y0);
 
         if (roomType == roomTypeBoss || gameFloor->getRoom(x + 1, y) == roomTypeBoss)
@@ -648,9 +645,9 @@ void DungeonMap::initRoom(int floorN, int wallN)
     {
       if (gameFloor->getRoom(x, y - 1) != roomTypeSecret)
       {
-        map[MAP_WIDTH / 2][0] = floorOffset;
-        map[MAP_WIDTH / 2 - 1][0] = floorOffset;
-        map[MAP_WIDTH / 2 + 1][0] = floorOffset;
+        tileAt(MAP_WIDTH / 2, 0).tile = floorOffset;
+        tileAt(MAP_WIDTH / 2 - 1, 0).tile = floorOffset;
+        tileAt(MAP_WIDTH / 2 + 1, 0).tile = floorOffset;
         openDoor(x0, 0);
 
         if (roomType == roomTypeBoss || gameFloor->getRoom(x, y - 1) == roomTypeBoss)
@@ -681,9 +678,9 @@ void DungeonMap::initRoom(int floorN, int wallN)
     {
       if (gameFloor->getRoom(x, y + 1) != roomTypeSecret)
       {
-        map[MAP_WIDTH / 2][MAP_HEIGHT - 1] = floorOffset;
-        map[MAP_WIDTH / 2 - 1][MAP_HEIGHT - 1] = floorOffset;
-        map[MAP_WIDTH / 2 + 1][MAP_HEIGHT - 1] = floorOffset;
+        tileAt(MAP_WIDTH / 2, MAP_HEIGHT - 1).tile = floorOffset;
+        tileAt(MAP_WIDTH / 2 - 1, MAP_HEIGHT - 1).tile = floorOffset;
+        tileAt(MAP_WIDTH / 2 + 1, MAP_HEIGHT - 1).tile = floorOffset;
         openDoor(x0, MAP_HEIGHT -1);
 
         if (roomType == roomTypeBoss || gameFloor->getRoom(x, y + 1) == roomTypeBoss)
@@ -732,33 +729,33 @@ void DungeonMap::addDestroyableObject(int x, int y, int obj)
   if (y == MAP_HEIGHT / 2 && (x == 1 || x == MAP_WIDTH - 2)) return;
 
   // wall
-  if (logicalMap[x][y] != LogicalFloor) return;
+  if (tileAt(x, y).logical != LogicalFloor) return;
 
-  objectsMap[x][y] = obj;
-  logicalMap[x][y] = LogicalDestroyable;
+  tileAt(x, y).object = obj;
+  tileAt(x, y).logical = LogicalDestroyable;
 }
 
 void DungeonMap::openDoor(int x, int y)
 {
-  objectsMap[x][y] = MAPOBJ_DOOR_OPEN;
-  logicalMap[x][y] = LogicalFloor;
+  tileAt(x, y).object = MAPOBJ_DOOR_OPEN;
+  tileAt(x, y).logical = LogicalFloor;
 }
 
 void DungeonMap::closeDoor(int x, int y)
 {
-  objectsMap[x][y] = MAPOBJ_DOOR_CLOSED;
-  logicalMap[x][y] = LogicalWall;
+  tileAt(x, y).object = MAPOBJ_DOOR_CLOSED;
+  tileAt(x, y).logical = LogicalWall;
 }
 
 bool DungeonMap::isDoor(int x, int y)
 {
-  return objectsMap[x][y] == MAPOBJ_DOOR_OPEN || objectsMap[x][y] == MAPOBJ_DOOR_CLOSED;
+  return tileAt(x, y).object == MAPOBJ_DOOR_OPEN || tileAt(x, y).object == MAPOBJ_DOOR_CLOSED;
 }
 
 void DungeonMap::makePatternTile(int x, int y)
 {
-  if (map[x][y] < 24 * MAP_NB_FLOORS && (map[x][y] % 24) < 8) map[x][y] += 8;
-  else map[x][y] = floorOffset + 8 + rand() % 8;
+  if (tileAt(x, y).tile < 24 * MAP_NB_FLOORS && (tileAt(x, y).tile % 24) < 8) tileAt(x, y).tile += 8;
+  else tileAt(x, y).tile = floorOffset + 8 + rand() % 8;
 }
 
 void DungeonMap::initPattern(patternEnum n)
@@ -831,24 +828,24 @@ void DungeonMap::generateCarpet(int x0, int y0, int w, int h, int n)
   int xf = x0 + w - 1;
   int yf = y0 + h - 1;
 
-  map[x0][y0] = n;
-  map[x0][yf] = n + 6;
-  map[xf][y0] = n + 2;
-  map[xf][yf] = n + 8;
+  tileAt(x0, y0).tile = n;
+  tileAt(x0, yf).tile = n + 6;
+  tileAt(xf, y0).tile = n + 2;
+  tileAt(xf, yf).tile = n + 8;
 
   int i, j;
   for (i = x0 + 1; i <= xf - 1; i++)
   {
-    map[i][y0] = n + 1;
-    map[i][yf] = n + 7;
+    tileAt(i, y0).tile = n + 1;
+    tileAt(i, yf).tile = n + 7;
     for (j = y0 + 1; j <= yf - 1; j++)
-      map[i][j] = n + 4;
+      tileAt(i, j).tile = n + 4;
   }
 
   for (j = y0 + 1; j <= yf - 1; j++)
   {
-    map[x0][j] = n + 3;
-    map[xf][j] = n + 5;
+    tileAt(x0, j).tile = n + 3;
+    tileAt(xf, j).tile = n + 5;
   }
 }
 
@@ -857,43 +854,43 @@ void DungeonMap::generateTable(int x0, int y0, int w, int h, int n)
   int xf = x0 + w - 1;
   int yf = y0 + h - 1;
 
-  objectsMap[x0][y0] = n;
-  objectsMap[x0][yf] = n + 6;
-  objectsMap[xf][y0] = n + 2;
-  objectsMap[xf][yf] = n + 8;
+  tileAt(x0, y0).object = n;
+  tileAt(x0, yf).object = n + 6;
+  tileAt(xf, y0).object = n + 2;
+  tileAt(xf, yf).object = n + 8;
 
   int i, j;
   for (i = x0 + 1; i <= xf - 1; i++)
   {
-    objectsMap[i][y0] = n + 1;
-    objectsMap[i][yf] = n + 7;
+    tileAt(i, y0).object = n + 1;
+    tileAt(i, yf).object = n + 7;
     for (j = y0 + 1; j <= yf - 1; j++)
-      objectsMap[i][j] = n + 4;
+      tileAt(i, j).object = n + 4;
   }
 
   for (j = y0 + 1; j <= yf - 1; j++)
   {
-    objectsMap[x0][j] = n + 3;
-    objectsMap[xf][j] = n + 5;
+    tileAt(x0, j).object = n + 3;
+    tileAt(xf, j).object = n + 5;
   }
 
   for (i = x0; i <= xf; i++)
     for (j = y0; j <= yf; j++)
-      logicalMap[i][j] = LogicalObstacle;
+      tileAt(i, j).logical = LogicalObstacle;
 }
 
 void DungeonMap::generateLongObject(int x0, int y0, int w, int n)
 {
   int xf = x0 + w - 1;
-  objectsMap[x0][y0] = n;
-  logicalMap[x0][y0] = LogicalObstacle;
+  tileAt(x0, y0).object = n;
+  tileAt(x0, y0).logical = LogicalObstacle;
   for (int i = x0 + 1; i <= xf - 1; i++)
   {
-    objectsMap[i][y0] = n + 1;
-    logicalMap[i][y0] = LogicalObstacle;
+    tileAt(i, y0).object = n + 1;
+    tileAt(i, y0).logical = LogicalObstacle;
   }
-  objectsMap[xf][y0] = n + 2;
-  logicalMap[xf][y0] = LogicalObstacle;
+  tileAt(xf, y0).object = n + 2;
+  tileAt(xf, y0).logical = LogicalObstacle;
 }
 
 void DungeonMap::generateInselRoom()
@@ -909,25 +906,25 @@ void DungeonMap::generateInselRoom()
             )
         addHole(i, j);
     }
-  objectsMap[MAP_WIDTH / 2 - 2][MAP_HEIGHT / 2 - 1] = MAPOBJ_WALL_SPECIAL;
-  objectsMap[MAP_WIDTH / 2 - 1][MAP_HEIGHT / 2 - 2] = MAPOBJ_WALL_SPECIAL;
-  logicalMap[MAP_WIDTH / 2 - 2][MAP_HEIGHT / 2 - 1] = LogicalObstacle;
-  logicalMap[MAP_WIDTH / 2 - 1][MAP_HEIGHT / 2 - 2] = LogicalObstacle;
-
-  objectsMap[MAP_WIDTH / 2 + 2][MAP_HEIGHT / 2 - 1] = MAPOBJ_WALL_SPECIAL + 1;
-  objectsMap[MAP_WIDTH / 2 + 1][MAP_HEIGHT / 2 - 2] = MAPOBJ_WALL_SPECIAL + 1;
-  logicalMap[MAP_WIDTH / 2 + 2][MAP_HEIGHT / 2 - 1] = LogicalObstacle;
-  logicalMap[MAP_WIDTH / 2 + 1][MAP_HEIGHT / 2 - 2] = LogicalObstacle;
-
-  objectsMap[MAP_WIDTH / 2 - 2][MAP_HEIGHT / 2 + 1] = MAPOBJ_WALL_SPECIAL + 2;
-  objectsMap[MAP_WIDTH / 2 - 1][MAP_HEIGHT / 2 + 2] = MAPOBJ_WALL_SPECIAL + 2;
-  logicalMap[MAP_WIDTH / 2 - 2][MAP_HEIGHT / 2 + 1] = LogicalObstacle;
-  logicalMap[MAP_WIDTH / 2 - 1][MAP_HEIGHT / 2 + 2] = LogicalObstacle;
-
-  objectsMap[MAP_WIDTH / 2 + 2][MAP_HEIGHT / 2 + 1] = MAPOBJ_WALL_SPECIAL + 3;
-  objectsMap[MAP_WIDTH / 2 + 1][MAP_HEIGHT / 2 + 2] = MAPOBJ_WALL_SPECIAL + 3;
-  logicalMap[MAP_WIDTH / 2 + 2][MAP_HEIGHT / 2 + 1] = LogicalObstacle;
-  logicalMap[MAP_WIDTH / 2 + 1][MAP_HEIGHT / 2 + 2] = LogicalObstacle;
+  tileAt(MAP_WIDTH / 2 - 2, MAP_HEIGHT / 2 - 1).object = MAPOBJ_WALL_SPECIAL;
+  tileAt(MAP_WIDTH / 2 - 1, MAP_HEIGHT / 2 - 2).object = MAPOBJ_WALL_SPECIAL;
+  tileAt(MAP_WIDTH / 2 - 2, MAP_HEIGHT / 2 - 1).logical = LogicalObstacle;
+  tileAt(MAP_WIDTH / 2 - 1, MAP_HEIGHT / 2 - 2).logical = LogicalObstacle;
+
+  tileAt(MAP_WIDTH / 2 + 2, MAP_HEIGHT / 2 - 1).object = MAPOBJ_WALL_SPECIAL + 1;
+  tileAt(MAP_WIDTH / 2 + 1, MAP_HEIGHT / 2 - 2).object = MAPOBJ_WALL_SPECIAL + 1;
+  tileAt(MAP_WIDTH / 2 + 2, MAP_HEIGHT / 2 - 1).logical = LogicalObstacle;
+  tileAt(MAP_WIDTH / 2 + 1, MAP_HEIGHT / 2 - 2).logical = LogicalObstacle;
+
+  tileAt(MAP_WIDTH / 2 - 2, MAP_HEIGHT / 2 + 1).object = MAPOBJ_WALL_SPECIAL + 2;
+  tileAt(MAP_WIDTH / 2 - 1, MAP_HEIGHT / 2 + 2).object = MAPOBJ_WALL_SPECIAL + 2;
+  tileAt(MAP_WIDTH / 2 - 2, MAP_HEIGHT / 2 + 1).logical = LogicalObstacle;
+  tileAt(MAP_WIDTH / 2 - 1, MAP_HEIGHT / 2 + 2).logical = LogicalObstacle;
+
+  tileAt(MAP_WIDTH / 2 + 2, MAP_HEIGHT / 2 + 1).object = MAPOBJ_WALL_SPECIAL + 3;
+  tileAt(MAP_WIDTH / 2 + 1, MAP_HEIGHT / 2 + 2).object = MAPOBJ_WALL_SPECIAL + 3;
+  tileAt(MAP_WIDTH / 2 + 2, MAP_HEIGHT / 2 + 1).logical = LogicalObstacle;
+  tileAt(MAP_WIDTH / 2 + 1, MAP_HEIGHT / 2 + 2).logical = LogicalObstacle;
 
   if (!hasNeighbourUp())
     addHole(MAP_WIDTH / 2, 1);
@@ -956,7 +953,7 @@ void DungeonMap::generateInselRoom()
 
 void DungeonMap::generateTemple(int x, int y, enumDivinityType type)
 {
-  map[x][y] = MAP_TEMPLE + (int)type;
+  tileAt(x, y).tile = MAP_TEMPLE + (int)type;
   addHole(x - 1, y - 2);
   addHole(x - 1, y - 1);
   addHole(x - 1, y);
@@ -964,10 +961,10 @@ void DungeonMap::generateTemple(int x, int y, enumDivinityType type)
   addHole(x + 1, y - 1);
   addHole(x + 1, y );
 
-  objectsMap[x][y - 2] = MAPOBJ_TEMPLE_WALL + (int)type;
-  objectsMap[x][y - 1] = MAPOBJ_TEMPLE_WALL + 10 + (int)type;
-  logicalMap[x][y - 2] = LogicalObstacle;
-  logicalMap[x][y - 1] = LogicalObstacle;
+  tileAt(x, y - 2).object = MAPOBJ_TEMPLE_WALL + (int)type;
+  tileAt(x, y - 1).object = MAPOBJ_TEMPLE_WALL + 10 + (int)type;
+  tileAt(x, y - 2).logical = LogicalObstacle;
+  tileAt(x, y - 1).logical = LogicalObstacle;
 }
 
 ///// ROOMS GENERATION
@@ -986,15 +983,15 @@ Vector2D DungeonMap::generateBonusRoom()
       else initPattern(PatternSmallStar);
     }
 
-    objectsMap[x0 - 1][y0 - 1] = MAPOBJ_WALL_SPECIAL;
-    objectsMap[x0 - 1][y0 + 1] = MAPOBJ_WALL_SPECIAL + 2;
-    objectsMap[x0 + 1][y0 - 1] = MAPOBJ_WALL_SPECIAL + 1;
-    objectsMap[x0 + 1][y0 + 1] = MAPOBJ_WALL_SPECIAL + 3;
+    tileAt(x0 - 1, y0 - 1).object = MAPOBJ_WALL_SPECIAL;
+    tileAt(x0 - 1, y0 + 1).object = MAPOBJ_WALL_SPECIAL + 2;
+    tileAt(x0 + 1, y0 - 1).object = MAPOBJ_WALL_SPECIAL + 1;
+    tileAt(x0 + 1, y0 + 1).object = MAPOBJ_WALL_SPECIAL + 3;
 
-    logicalMap[x0 - 1][y0 - 1] = LogicalObstacle;
-    logicalMap[x0 - 1][y0 + 1] = LogicalObstacle;
-    logicalMap[x0 + 1][y0 - 1] = LogicalObstacle;
-    logicalMap[x0 + 1][y0 + 1] = LogicalObstacle;
+    tileAt(x0 - 1, y0 - 1).logical = LogicalObstacle;
+    tileAt(x0 - 1, y0 + 1).logical = LogicalObstacle;
+    tileAt(x0 + 1, y0 - 1).logical = LogicalObstacle;
+    tileAt(x0 + 1, y0 + 1).logical = LogicalObstacle;
 
     if (rand() % 2 == 0)
     {
@@ -1113,24 +1110,24 @@ Vector2D DungeonMap::generateMerchantRoom()
 
   for (int i = x0 - 3; i <= x0 + 3; i++)
   {
-    if (i == x0 - 3) objectsMap[i][y0] = MAPOBJ_SHOP_LEFT;
-    else if (i == x0 + 3) objectsMap[i][y0] = MAPOBJ_SHOP_RIGHT;
-    else objectsMap[i][y0] = MAPOBJ_SHOP;
+    if (i == x0 - 3) tileAt(i, y0).object = MAPOBJ_SHOP_LEFT;
+    else if (i == x0 + 3) tileAt(i, y0).object = MAPOBJ_SHOP_RIGHT;
+    else tileAt(i, y0).object = MAPOBJ_SHOP;
 
-    logicalMap[i][y0] = LogicalObstacle;
+    tileAt(i, y0).logical = LogicalObstacle;
   }
 
   if (!hasNeighbourUp())
   {
-    objectsMap[x0 - 1][0] = MAPOBJ_PNW;
-    objectsMap[x0][0] = MAPOBJ_PNW + 1;
-    objectsMap[x0 + 1][0] = MAPOBJ_PNW + 2;
+    tileAt(x0 - 1, 0).object = MAPOBJ_PNW;
+    tileAt(x0, 0).object = MAPOBJ_PNW + 1;
+    tileAt(x0 + 1, 0).object = MAPOBJ_PNW + 2;
   }
   else
   {
-    objectsMap[x0 - 1][MAP_HEIGHT - 1] = MAPOBJ_PNW +3;
-    objectsMap[x0][MAP_HEIGHT - 1] = MAPOBJ_PNW + 4;
-    objectsMap[x0 + 1][MAP_HEIGHT - 1] = MAPOBJ_PNW + 5;
+    tileAt(x0 - 1, MAP_HEIGHT - 1).object = MAPOBJ_PNW +3;
+    tileAt(x0, MAP_HEIGHT - 1).object = MAPOBJ_PNW + 4;
+    tileAt(x0 + 1, MAP_HEIGHT - 1).object = MAPOBJ_PNW + 5;
   }
 
   generateRandomTiles();
@@ -1152,15 +1149,15 @@ Vector2D DungeonMap::generateKeyRoom()
   int x0 = MAP_WIDTH / 2;
   int y0 = MAP_HEIGHT / 2;
 
-  objectsMap[x0 - 1][y0 - 1] = MAPOBJ_WALL_SPECIAL;
-  objectsMap[x0 - 1][y0 + 1] = MAPOBJ_WALL_SPECIAL + 2;
-  objectsMap[x0 + 1][y0 - 1] = MAPOBJ_WALL_SPECIAL + 1;
-  objectsMap[x0 + 1][y0 + 1] = MAPOBJ_WALL_SPECIAL + 3;
+  tileAt(x0 - 1, y0 - 1).object = MAPOBJ_WALL_SPECIAL;
+  tileAt(x0 - 1, y0 + 1).object = MAPOBJ_WALL_SPECIAL + 2;
+  tileAt(x0 + 1, y0 - 1).object = MAPOBJ_WALL_SPECIAL + 1;
+  tileAt(x0 + 1, y0 + 1).object = MAPOBJ_WALL_SPECIAL + 3;
 
-  logicalMap[x0 - 1][y0 - 1] = LogicalObstacle;
-  logicalMap[x0 - 1][y0 + 1] = LogicalObstacle;
-  logicalMap[x0 + 1][y0 - 1] = LogicalObstacle;
-  logicalMap[x0 + 1][y0 + 1] = LogicalObstacle;
+  tileAt(x0 - 1, y0 - 1).logical = LogicalObstacle;
+  tileAt(x0 - 1, y0 + 1).logical = LogicalObstacle;
+  tileAt(x0 + 1, y0 - 1).logical = LogicalObstacle;
+  tileAt(x0 + 1, y0 + 1).logical = LogicalObstacle;
 
   if (rand() % 3 == 0)
   {
@@ -1179,10 +1176,10 @@ void DungeonMap::generateExitRoom()
   int x0 = MAP_WIDTH / 2;
   if (game().getLevel() < LAST_LEVEL)
   {
-    map[x0][0] = floorOffset;
-    map[x0 - 1][0] = floorOffset;
-    map[x0 + 1][0] = floorOffset;
-    logicalMap[x0][0] = LogicalFloor;
+    tileAt(x0, 0).tile = floorOffset;
+    tileAt(x0 - 1, 0).tile = floorOffset;
+    tileAt(x0 + 1, 0).tile = floorOffset;
+    tileAt(x0, 0).logical = LogicalFloor;
   }
 
   if (rand() % 3 == 0) initPattern(PatternBorder);
@@ -1219,7 +1216,7 @@ void DungeonMap::generateRoomWithoutHoles(int type)
 
       if (game().getLevel() > 1)
       {
-        map[x0][MAP_HEIGHT - 1]     = floorOffset;
+        tileAt(x0, MAP_HEIGHT - 1).tile     = floorOffset;
       }
     }
     else if (roomType == roomTypeBoss)
@@ -1233,10 +1230,10 @@ void DungeonMap::generateRoomWithoutHoles(int type)
       }
       else if (game().getLevel() == 2) // giant slime
       {
-        objectsMap[1][1] = MAPOBJ_GRID;
-        objectsMap[1][MAP_HEIGHT -2] = MAPOBJ_GRID;
-        objectsMap[MAP_WIDTH - 2][1] = MAPOBJ_GRID;
-        objectsMap[MAP_WIDTH - 2][MAP_HEIGHT -2] = MAPOBJ_GRID;
+        tileAt(1, 1).object = MAPOBJ_GRID;
+        tileAt(1, MAP_HEIGHT -2).object = MAPOBJ_GRID;
+        tileAt(MAP_WIDTH - 2, 1).object = MAPOBJ_GRID;
+        tileAt(MAP_WIDTH - 2, MAP_HEIGHT -2).object = MAPOBJ_GRID;
       }
     }
     if (roomType == roomTypeStandard)
@@ -1305,29 +1302,29 @@ void DungeonMap::generateRoomWithoutHoles(int type)
     if (rand() % 3 == 0) initPattern(PatternSmallChecker);
     int wallOffset = wallType * 24;
 
-    map[0][0] = MAP_WALL_X;
-    map[0][1] = wallOffset + MAP_WALL_7;
-    map[1][1] = wallOffset + MAP_WALL_77;
-    map[1][0] = wallOffset + MAP_WALL_7;
-    logicalMap[1][1] = LogicalWall;
-
-    map[0][MAP_HEIGHT - 1] = MAP_WALL_X;
-    map[0][MAP_HEIGHT - 2] = wallOffset + MAP_WALL_7;
-    map[1][MAP_HEIGHT - 2] = wallOffset + MAP_WALL_77;
-    map[1][MAP_HEIGHT - 1] = wallOffset + MAP_WALL_7;
-    logicalMap[1][MAP_HEIGHT -2] = LogicalWall;
-
-    map[MAP_WIDTH - 1][0] = MAP_WALL_X;
-    map[MAP_WIDTH - 1][1] = wallOffset + MAP_WALL_7;
-    map[MAP_WIDTH - 2][1] = wallOffset + MAP_WALL_77;
-    map[MAP_WIDTH - 2][0] = wallOffset + MAP_WALL_7;
-    logicalMap[MAP_WIDTH - 2][1] = LogicalWall;
-
-    map[MAP_WIDTH - 1][MAP_HEIGHT -1] = MAP_WALL_X;
-    map[MAP_WIDTH - 1][MAP_HEIGHT -2] = wallOffset + MAP_WALL_7;
-    map[MAP_WIDTH - 2][MAP_HEIGHT -2] = wallOffset + MAP_WALL_77;
-    map[MAP_WIDTH - 2][MAP_HEIGHT -1] = wallOffset + MAP_WALL_7;
-    logicalMap[MAP_WIDTH - 2][MAP_HEIGHT -2] = LogicalWall;
+    tileAt(0, 0).tile = MAP_WALL_X;
+    tileAt(0, 1).tile = wallOffset + MAP_WALL_7;
+    tileAt(1, 1).tile = wallOffset + MAP_WALL_77;
+    tileAt(1, 0).tile = wallOffset + MAP_WALL_7;
+    tileAt(1, 1).logical = LogicalWall;
+
+    tileAt(0, MAP_HEIGHT - 1).tile = MAP_WALL_X;
+    tileAt(0, MAP_HEIGHT - 2).tile = wallOffset + MAP_WALL_7;
+    tileAt(1, MAP_HEIGHT - 2).tile = wallOffset + MAP_WALL_77;
+    tileAt(1, MAP_HEIGHT - 1).tile = wallOffset + MAP_WALL_7;
+    tileAt(1, MAP_HEIGHT -2).logical = LogicalWall;
+
+    tileAt(MAP_WIDTH - 1, 0).tile = MAP_WALL_X;
+    tileAt(MAP_WIDTH - 1, 1).tile = wallOffset + MAP_WALL_7;
+    tileAt(MAP_WIDTH - 2, 1).tile = wallOffset + MAP_WALL_77;
+    tileAt(MAP_WIDTH - 2, 0).tile = wallOffset + MAP_WALL_7;
+    tileAt(MAP_WIDTH - 2, 1).logical = LogicalWall;
+
+    tileAt(MAP_WIDTH - 1, MAP_HEIGHT -1).tile = MAP_WALL_X;
+    tileAt(MAP_WIDTH - 1, MAP_HEIGHT -2).tile = wallOffset + MAP_WALL_7;
+    tileAt(MAP_WIDTH - 2, MAP_HEIGHT -2).tile = wallOffset + MAP_WALL_77;
+    tileAt(MAP_WIDTH - 2, MAP_HEIGHT -1).tile = wallOffset + MAP_WALL_7;
+    tileAt(MAP_WIDTH - 2, MAP_HEIGHT -2).logical = LogicalWall;
 
     if (rand() % 4 == 0)
     {
@@ -1386,15 +1383,15 @@ void DungeonMap::generateRoomWithoutHoles(int type)
 
       if (leftOriented)
       {
-        objectsMap[2][4] = MAPOBJ_CHURCH_FURN_L;
-        logicalMap[2][4] = LogicalObstacle;
+        tileAt(2, 4).object = MAPOBJ_CHURCH_FURN_L;
+        tileAt(2, 4).logical = LogicalObstacle;
         if (rand() % 2 == 0) addDestroyableObject(1, 1, MAPOBJ_BARREL);
         else addDestroyableObject(1, MAP_HEIGHT - 2, MAPOBJ_BARREL);
       }
       else
       {
-        objectsMap[12][4] = MAPOBJ_CHURCH_FURN_R;
-        logicalMap[12][4] = LogicalObstacle;
+        tileAt(12, 4).object = MAPOBJ_CHURCH_FURN_R;
+        tileAt(12, 4).logical = LogicalObstacle;
         if (rand() % 2 == 0) addDestroyableObject(MAP_WIDTH - 2, 1, MAPOBJ_BARREL);
         else addDestroyableObject(MAP_WIDTH - 2, MAP_HEIGHT - 2, MAPOBJ_BARREL);
       }
@@ -1405,30 +1402,30 @@ void DungeonMap::generateRoomWithoutHoles(int type)
         switch (bankType)
         {
           case 0:
-            objectsMap[xPos][2] = MAPOBJ_BANK_TOP;
-            objectsMap[xPos][3] = MAPOBJ_BANK_BOTTOM;
-            objectsMap[xPos][5] = MAPOBJ_BANK_TOP;
-            objectsMap[xPos][6] = MAPOBJ_BANK_BOTTOM;
-            for (int j = 2; j <= 6; j++) if (j != 4) logicalMap[xPos][j] = LogicalObstacle;
+            tileAt(xPos, 2).object = MAPOBJ_BANK_TOP;
+            tileAt(xPos, 3).object = MAPOBJ_BANK_BOTTOM;
+            tileAt(xPos, 5).object = MAPOBJ_BANK_TOP;
+            tileAt(xPos, 6).object = MAPOBJ_BANK_BOTTOM;
+            for (int j = 2; j <= 6; j++) if (j != 4) tileAt(xPos, j).logical = LogicalObstacle;
             break;
 
           case 1:
-            objectsMap[xPos][2] = MAPOBJ_BANK_TOP;
-            objectsMap[xPos][3] = MAPOBJ_BANK;
-            objectsMap[xPos][4] = MAPOBJ_BANK;
-            objectsMap[xPos][5] = MAPOBJ_BANK;
-            objectsMap[xPos][6] = MAPOBJ_BANK_BOTTOM;
-            for (int j = 2; j <= 6; j++) logicalMap[xPos][j] = LogicalObstacle;
+            tileAt(xPos, 2).object = MAPOBJ_BANK_TOP;
+            tileAt(xPos, 3).object = MAPOBJ_BANK;
+            tileAt(xPos, 4).object = MAPOBJ_BANK;
+            tileAt(xPos, 5).object = MAPOBJ_BANK;
+            tileAt(xPos, 6).object = MAPOBJ_BANK_BOTTOM;
+            for (int j = 2; j <= 6; j++) tileAt(xPos, j).logical = LogicalObstacle;
             break;
 
           default:
-            objectsMap[xPos][1] = MAPOBJ_BANK_TOP;
-            objectsMap[xPos][2] = MAPOBJ_BANK;
-            objectsMap[xPos][3] = MAPOBJ_BANK_BOTTOM;
-            objectsMap[xPos][5] = MAPOBJ_BANK_TOP;
-            objectsMap[xPos][6] = MAPOBJ_BANK;
-            objectsMap[xPos][7] = MAPOBJ_BANK_BOTTOM;
-            for (int j = 1; j <= 7; j++) if (j != 4) logicalMap[xPos][j] = LogicalObstacle;
+            tileAt(xPos, 1).object = MAPOBJ_BANK_TOP;
+            tileAt(xPos, 2).object = MAPOBJ_BANK;
+            tileAt(xPos, 3).object = MAPOBJ_BANK_BOTTOM;
+            tileAt(xPos, 5).object = MAPOBJ_BANK_TOP;
+            tileAt(xPos, 6).object = MAPOBJ_BANK;
+            tileAt(xPos, 7).object = MAPOBJ_BANK_BOTTOM;
+            for (int j = 1; j <= 7; j++) if (j != 4) tileAt(xPos, j).logical = LogicalObstacle;
             break;
         }
       }
@@ -1451,8 +1448,8 @@ void DungeonMap::generateRoomWithoutHoles(int type)
     for (i = 2; i < MAP_WIDTH - 2; i = i + 2)
       for (j = 2; j < MAP_HEIGHT - 2; j = j + 2)
       {
-        objectsMap[i][j] = game().getLevel() >= 6 ? MAPOBJ_TOMB : MAPOBJ_OBSTACLE;
-        logicalMap[i][j] = LogicalObstacle;
+        tileAt(i, j).object = game().getLevel() >= 6 ? MAPOBJ_TOMB : MAPOBJ_OBSTACLE;
+        tileAt(i, j).logical = LogicalObstacle;
       }
 
     if (game().getLevel() >= 4 || rand() % 4 > 0)
@@ -1477,19 +1474,19 @@ void DungeonMap::generateRoomWithoutHoles(int type)
 void DungeonMap::addHole(int x, int y)
 {
   int n = MAPOBJ_HOLE;
-  if (y > 0 && logicalMap[x][y - 1] == LogicalHole)
+  if (y > 0 && tileAt(x, y - 1).logical == LogicalHole)
     n = MAPOBJ_HOLE_BOTTOM;
-  else if (logicalMap[x - 1][y] == LogicalHole && logicalMap[x - 1][y - 1] == LogicalHole)
+  else if (tileAt(x - 1, y).logical == LogicalHole && tileAt(x - 1, y - 1).logical == LogicalHole)
     n = MAPOBJ_HOLE_LEFT;
-  else if (logicalMap[x + 1][y] == LogicalHole && logicalMap[x + 1][y - 1] == LogicalHole)
+  else if (tileAt(x + 1, y).logical == LogicalHole && tileAt(x + 1, y - 1).logical == LogicalHole)
     n = MAPOBJ_HOLE_RIGHT;
-  objectsMap[x][y] = n;
-  logicalMap[x][y] = LogicalHole;
+  tileAt(x, y).object = n;
+  tileAt(x, y).logical = LogicalHole;
 
-  if (logicalMap[x][y + 1] == LogicalHole && objectsMap[x - 1][y + 1] == MAPOBJ_HOLE_TOP)
-    objectsMap[x - 1][y + 1] = MAPOBJ_HOLE_LEFT;
-  if (logicalMap[x][y + 1] == LogicalHole && objectsMap[x + 1][y + 1] == MAPOBJ_HOLE_TOP)
-    objectsMap[x + 1][y + 1] = MAPOBJ_HOLE_RIGHT;
+  if (tileAt(x, y + 1).logical == LogicalHole && tileAt(x - 1, y + 1).object == MAPOBJ_HOLE_TOP)
+    tileAt(x - 1, y + 1).object = MAPOBJ_HOLE_LEFT;
+  if (tileAt(x, y + 1).logical == LogicalHole && tileAt(x + 1, y + 1).object == MAPOBJ_HOLE_TOP)
+    tileAt(x + 1, y + 1).object = MAPOBJ_HOLE_RIGHT;
 }
 
 void DungeonMap::generateRoomWithHoles(int type)
@@ -1507,9 +1504,9 @@ void DungeonMap::generateRoomWithHoles(int type)
 
       if (game().getLevel() > 1)
       {
-        map[x0 - 1][MAP_HEIGHT - 1] = 62;
-        map[x0][MAP_HEIGHT - 1]     = 63;
-        map[x0 + 1][MAP_HEIGHT - 1] = 64;
+        tileAt(x0 - 1, MAP_HEIGHT - 1).tile = 62;
+        tileAt(x0, MAP_HEIGHT - 1).tile     = 63;
+        tileAt(x0 + 1, MAP_HEIGHT - 1).tile = 64;
       }
     }
     /*else if (rand() % 2 == 0)
@@ -1639,8 +1636,8 @@ void DungeonMap::generateRoomWithHoles(int type)
           for (int ix = -1; ix <= 1; ix++)
             for (int iy = -1; iy <= 1; iy++)
           {
-            ok = ok && logicalMap[rx + ix][ry + iy] != LogicalHole;
-            ok = ok && logicalMap[rx + ix][ry + iy] != LogicalObstacle;
+            ok = ok && tileAt(rx + ix, ry + iy).logical != LogicalHole;
+            ok = ok && tileAt(rx + ix, ry + iy).logical != LogicalObstacle;
           }
         }
 
@@ -1653,8 +1650,8 @@ void DungeonMap::generateRoomWithHoles(int type)
 
           else
           {
-            objectsMap[rx][ry] = MAPOBJ_OBSTACLE;
-            logicalMap[rx][ry] = LogicalObstacle;
+            tileAt(rx, ry).object = MAPOBJ_OBSTACLE;
+            tileAt(rx, ry).logical = LogicalObstacle;
           }
         }
         else
@@ -1747,57 +1744,6 @@ void DungeonMap::addChest(int chestType, bool state,  float x, float y)
   chestList.push_back(clm);
 }
 
-void DungeonMap::restoreItems()
-{
-  ItemList::iterator it;
-  for (it = itemList.begin (); it != itemList.end ();)
-  {
-    itemListElement ilm = *it;
-    it++;
-
-    ItemEntity* itemEntity = new ItemEntity((enumItemType)(ilm.type), ilm.x, ilm.y);
-    itemEntity->setMerchandise(ilm.merch);
-	}
-}
-
-void DungeonMap::restoreSprites()
-{
-	SpriteList::iterator it;
-
-  for (it = spriteList.begin (); it != spriteList.end ();)
-  {
-    spriteListElement ilm = *it;
-    it++;
-
-    if (ilm.type == ENTITY_BLOOD)
-      game().getCurrentMapEntity()->addBlood(ilm.x, ilm.y, ilm.frame, ilm.scale);
-
-    else if (ilm.type == ENTITY_CORPSE)
-      game().getCurrentMapEntity()->addCorpse(ilm.x, ilm.y, ilm.frame);
-  }
-}
-
-void DungeonMap::restoreChests()
-{
-  ChestList::iterator it;
-
-  for (it = chestList.begin (); it != chestList.end ();)
-  {
-    chestListElement clm = *it;
-    it++;
-
-    new ChestEntity(clm.x, clm.y, clm.type, clm.state);
-	}
-}
-
-void DungeonMap::restoreMapObjects()
-{
-  restoreItems();
-  restoreSprites();
-  restoreChests();
-  cleanMapObjects();
-}
-
 void DungeonMap::cleanMapObjects()
 {
 	itemList.clear();
@@ -1805,6 +1751,14 @@ void DungeonMap::cleanMapObjects()
   chestList.clear();
 }
 
+int DungeonMap::getMemorySize()
+{
+  return sizeof(DungeonMap) + tiles.capacity() * sizeof(mapTileStruct)
+         + itemList.capacity() * sizeof(itemListElement)
+         + spriteList.capacity() * sizeof(spriteListElement)
+         + chestList.capacity() * sizeof(chestListElement);
+}
+
 void DungeonMap::addRandomGrids(int n)
 {
   int counter = n;
@@ -1813,10 +1767,10 @@ void DungeonMap::addRandomGrids(int n)
   {
     int rx = 1 + rand() % (MAP_WIDTH - 2);
     int ry = 1 + rand() % (MAP_HEIGHT - 2);
-    if (logicalMap[rx][ry] == LogicalFloor
-        && objectsMap[rx][ry] == 0)
+    if (tileAt(rx, ry).logical == LogicalFloor
+        && tileAt(rx, ry).object == 0)
     {
-      objectsMap[rx][ry] = MAPOBJ_GRID;
+      tileAt(rx, ry).object = MAPOBJ_GRID;
       counter--;
     }
   }
@@ -1834,8 +1788,8 @@ void DungeonMap::generateCorridors()
     for (int i = 0; i < xCor; i++)
       for (int j = 0; j < MAP_HEIGHT; j++)
       {
-        map[i][j] = MAP_WALL_X;
-        logicalMap[i][j] = LogicalWall;
+        tileAt(i, j).tile = MAP_WALL_X;
+        tileAt(i, j).logical = LogicalWall;
       }
 
   }
@@ -1844,8 +1798,8 @@ void DungeonMap::generateCorridors()
     for (int i = MAP_WIDTH - 1; i > MAP_WIDTH - 1 - xCor; i--)
       for (int j = 0; j < MAP_HEIGHT; j++)
       {
-        map[i][j] = MAP_WALL_X;
-        logicalMap[i][j] = LogicalWall;
+        tileAt(i, j).tile = MAP_WALL_X;
+        tileAt(i, j).logical = LogicalWall;
       }
   }
   if (!hasNeighbourUp())
@@ -1853,8 +1807,8 @@ void DungeonMap::generateCorridors()
     for (int i = 0; i < MAP_WIDTH; i++)
       for (int j = 0; j < yCor; j++)
       {
-        map[i][j] = MAP_WALL_X;
-        logicalMap[i][j] = LogicalWall;
+        tileAt(i, j).tile = MAP_WALL_X;
+        tileAt(i, j).logical = LogicalWall;
       }
   }
   if (!hasNeighbourDown())
@@ -1862,8 +1816,8 @@ void DungeonMap::generateCorridors()
     for (int i = 0; i < MAP_WIDTH; i++)
       for (int j = MAP_HEIGHT - 1; j > MAP_HEIGHT - 1 - yCor; j--)
       {
-        map[i][j] = MAP_WALL_X;
-        logicalMap[i][j] = LogicalWall;
+        tileAt(i, j).tile = MAP_WALL_X;
+        tileAt(i, j).logical = LogicalWall;
       }
   }
 
@@ -1872,65 +1826,65 @@ void DungeonMap::generateCorridors()
   {
     for (int j = 0; j < MAP_HEIGHT; j++)
     {
-      if (map[i][j] != MAP_WALL_X)
+      if (tileAt(i, j).tile != MAP_WALL_X)
       {
         if (getTile(i - 1, j) == MAP_WALL_X)
         {
           if (j == 0 || getTile(i, j - 1) == MAP_WALL_X)
           {
-            map[i][j] = wallOffset + MAP_WALL_7;
+            tileAt(i, j).tile = wallOffset + MAP_WALL_7;
           }
           else if (j == MAP_HEIGHT - 1 || getTile(i, j + 1) == MAP_WALL_X)
           {
-            map[i][j] = wallOffset + MAP_WALL_7;
+            tileAt(i, j).tile = wallOffset + MAP_WALL_7;
           }
           else
           {
-            if (j < MAP_HEIGHT / 2) map[i][j] = wallOffset + MAP_WALL_87 + rand() % 8;
-            else if (j > MAP_HEIGHT / 2) map[i][j] = wallOffset + MAP_WALL_87 + rand() % 8;
-            else map[i][j] = wallOffset + MAP_WALL_8;
+            if (j < MAP_HEIGHT / 2) tileAt(i, j).tile = wallOffset + MAP_WALL_87 + rand() % 8;
+            else if (j > MAP_HEIGHT / 2) tileAt(i, j).tile = wallOffset + MAP_WALL_87 + rand() % 8;
+            else tileAt(i, j).tile = wallOffset + MAP_WALL_8;
           }
-          logicalMap[i][j] = LogicalWall;
+          tileAt(i, j).logical = LogicalWall;
         }
         else if (getTile(i + 1, j) == MAP_WALL_X)
         {
           if (j == 0 || getTile(i, j - 1) == MAP_WALL_X)
           {
-            map[i][j] = wallOffset + MAP_WALL_7;
-            map[i][j] = wallOffset + MAP_WALL_7;
+            tileAt(i, j).tile = wallOffset + MAP_WALL_7;
+            tileAt(i, j).tile = wallOffset + MAP_WALL_7;
           }
-          else if (j == MAP_HEIGHT - 1 || getTile(i, j + 1) == MAP_WALL_X) map[i][j] = wallOffset + MAP_WALL_7;
+          else if (j == MAP_HEIGHT - 1 || getTile(i, j + 1) == MAP_WALL_X) tileAt(i, j).tile = wallOffset + MAP_WALL_7;
           else
           {
-            if (j < MAP_HEIGHT / 2) map[i][j] = wallOffset + MAP_WALL_87 + rand() % 8;
-            else if (j > MAP_HEIGHT / 2) map[i][j] = wallOffset + MAP_WALL_87 + rand() % 8;
-            else map[i][j] = wallOffset + MAP_WALL_8;
+            if (j < MAP_HEIGHT / 2) tileAt(i, j).tile = wallOffset + MAP_WALL_87 + rand() % 8;
+            else if (j > MAP_HEIGHT / 2) tileAt(i, j).tile = wallOffset + MAP_WALL_87 + rand() % 8;
+            else tileAt(i, j).tile = wallOffset + MAP_WALL_8;
           }
-          logicalMap[i][j] = LogicalWall;
+          tileAt(i, j).logical = LogicalWall;
         }
         else if (getTile(i, j - 1) == MAP_WALL_X)
         {
-          if (i == 0) map[i][j] = wallOffset + MAP_WALL_7;
-          else if (i == MAP_WIDTH - 1) map[i][j] = wallOffset + MAP_WALL_7;
+          if (i == 0) tileAt(i, j).tile = wallOffset + MAP_WALL_7;
+          else if (i == MAP_WIDTH - 1) tileAt(i, j).tile = wallOffset + MAP_WALL_7;
           else
           {
-            if (i < MAP_WIDTH / 2) map[i][j] = wallOffset + MAP_WALL_87 + rand() % 8;
-            else if (i > MAP_WIDTH / 2) map[i][j] = wallOffset + MAP_WALL_87 + rand() % 8;
-            else map[i][j] = wallOffset + MAP_WALL_8;
+            if (i < MAP_WIDTH / 2) tileAt(i, j).tile = wallOffset + MAP_WALL_87 + rand() % 8;
+            else if (i > MAP_WIDTH / 2) tileAt(i, j).tile = wallOffset + MAP_WALL_87 + rand() % 8;
+            else tileAt(i, j).tile = wallOffset + MAP_WALL_8;
           }
-          logicalMap[i][j] = LogicalWall;
+          tileAt(i, j).logical = LogicalWall;
         }
         else if (getTile(i, j + 1) == MAP_WALL_X)
         {
-          if (i == 0) map[i][j] = wallOffset + MAP_WALL_7;
-          else if (i == MAP_WIDTH - 1) map[i][j] = wallOffset + MAP_WALL_7;
+          if (i == 0) tileAt(i, j).tile = wallOffset + MAP_WALL_7;
+          else if (i == MAP_WIDTH - 1) tileAt(i, j).tile = wallOffset + MAP_WALL_7;
           else
           {
-            if (i < MAP_WIDTH / 2) map[i][j] = wallOffset + MAP_WALL_87 + rand() % 8;
-            else if (i > MAP_WIDTH / 2) map[i][j] = wallOffset + MAP_WALL_87 + rand() % 8;
-            else map[i][j] = wallOffset + MAP_WALL_8;
+            if (i < MAP_WIDTH / 2) tileAt(i, j).tile = wallOffset + MAP_WALL_87 + rand() % 8;
+            else if (i > MAP_WIDTH / 2) tileAt(i, j).tile = wallOffset + MAP_WALL_87 + rand() % 8;
+            else tileAt(i, j).tile = wallOffset + MAP_WALL_8;
           }
-          logicalMap[i][j] = LogicalWall;
+          tileAt(i, j).logical = LogicalWall;
         }
       }
     }
@@ -2012,101 +1966,3 @@ void DungeonMap::generateRandomTile(int index)
     }
   }
 }
-
-bool DungeonMap::callRevelation()
-{
-  if (hasNeighbourRight() && !gameFloor->getMap(x + 1, y)->isRevealed())
-  {
-    map[MAP_WIDTH - 1][MAP_HEIGHT / 2] = floorOffset;
-    map[MAP_WIDTH - 1][MAP_HEIGHT / 2 - 1] = floorOffset;
-    map[MAP_WIDTH - 1][MAP_HEIGHT / 2 + 1] = floorOffset;
-
-    if (cleared)
-      openDoor(MAP_WIDTH - 1, MAP_HEIGHT / 2);
-    else
-      closeDoor(MAP_WIDTH - 1, MAP_HEIGHT / 2);
-
-    game().setDoorVisible(East);
-    gameFloor->getMap(x + 1, y)->setRevealed(true);
-    hasChanged = true;
-
-    for (int i = 0; i < 36; i++)
-      game().generateStar(
-                    (i % 2 == 0) ? sf::Color(50, 50, 255, 255) : sf::Color(200, 200, 255, 255),
-                    (MAP_WIDTH - 1) * TILE_WIDTH + rand() % TILE_WIDTH,
-                     (MAP_HEIGHT / 2 - 1) * TILE_HEIGHT + rand() % (TILE_HEIGHT * 3) );
-
-    return true;
-  }
-  else if (hasNeighbourLeft() && !gameFloor->getMap(x - 1, y)->isRevealed())
-  {
-    map[0][MAP_HEIGHT / 2] = floorOffset;
-    map[0][MAP_HEIGHT / 2 - 1] = floorOffset;
-    map[0][MAP_HEIGHT / 2 + 1] = floorOffset;
-
-    if (cleared)
-      openDoor(0, MAP_HEIGHT / 2);
-    else
-      closeDoor(0, MAP_HEIGHT / 2);
-
-    game().setDoorVisible(West);
-    gameFloor->getMap(x - 1, y)->setRevealed(true);
-    hasChanged = true;
-
-    for (int i = 0; i < 36; i++)
-      game().generateStar(
-                    (i % 2 == 0) ? sf::Color(50, 50, 255, 255) : sf::Color(200, 200, 255, 255),
-                    rand() % TILE_WIDTH,
-                     (MAP_HEIGHT / 2 - 1) * TILE_HEIGHT + rand() % (TILE_HEIGHT * 3) );
-
-    return true;
-  }
-  else if (hasNeighbourUp() && !gameFloor->getMap(x, y - 1)->isRevealed())
-  {
-    map[MAP_WIDTH / 2][0] = floorOffset;
-    map[MAP_WIDTH / 2 - 1][0] = floorOffset;
-    map[MAP_WIDTH / 2 + 1][0] = floorOffset;
-
-    if (cleared)
-      openDoor(MAP_WIDTH / 2, 0);
-    else
-      closeDoor(MAP_WIDTH / 2, 0);
-
-    game().setDoorVisible(North);
-    gameFloor->getMap(x, y - 1)->setRevealed(true);
-    hasChanged = true;
-
-    for (int i = 0; i < 36; i++)
-      game().generateStar(
-                    (i % 2 == 0) ? sf::Color(50, 50, 255, 255) : sf::Color(200, 200, 255, 255),
-                    (MAP_WIDTH / 2 - 1) * TILE_WIDTH + rand() % (TILE_WIDTH * 3),
-                    rand() % TILE_HEIGHT );
-
-    return true;
-  }
-  else if (hasNeighbourDown() && !gameFloor->getMap(x, y + 1)->isRevealed())
-  {
-    map[MAP_WIDTH / 2][MAP_HEIGHT - 1] = floorOffset;
-    map[MAP_WIDTH / 2 - 1][MAP_HEIGHT - 1] = floorOffset;
-    map[MAP_WIDTH / 2 + 1][MAP_HEIGHT - 1] = floorOffset;
-
-    if (cleared)
-      openDoor(MAP_WIDTH / 2, MAP_HEIGHT -1);
-    else
-      closeDoor(MAP_WIDTH / 2, MAP_HEIGHT -1);
-
-    game().setDoorVisible(South);
-    gameFloor->getMap(x, y + 1)->setRevealed(true);
-    hasChanged = true;
-
-    for (int i = 0; i < 36; i++)
-      game().generateStar(
-                    (i % 2 == 0) ? sf::Color(50, 50, 255, 255) : sf::Color(200, 200, 255, 255),
-                    (MAP_WIDTH / 2 - 1) * TILE_WIDTH + rand() % (TILE_WIDTH * 3),
-                    (MAP_HEIGHT - 1) * TILE_HEIGHT + rand() % TILE_HEIGHT );
-
-    return true;
-  }
-
-  return false;
-}
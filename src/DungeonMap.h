@@ -5,7 +5,7 @@
 #include "sfml_game/MyTools.h"
 #include "Constants.h"
 #include "DoorEntity.h"
-#include <list>
+#include <vector>
 
 const int MAPOBJ_NONE          =   0;
 const int MAPOBJ_DOOR_OPEN     =   1;
@@ -226,17 +226,17 @@ class DungeonMap : public GameMap
     void setRoomType(roomTypeEnum roomType);
 
     struct itemListElement { int type; float x; float y; bool merch; };
-    typedef std::list<itemListElement> ItemList;
+    typedef std::vector<itemListElement> ItemList;
 
     struct spriteListElement { int type; int frame; float x; float y; float scale;};
-    typedef std::list<spriteListElement> SpriteList;
+    typedef std::vector<spriteListElement> SpriteList;
 
     struct chestListElement { int type; bool state; float x; float y;};
-    typedef std::list<chestListElement> ChestList;
+    typedef std::vector<chestListElement> ChestList;
 
-    std::list<itemListElement> getItemList();
-    std::list<chestListElement> getChestList();
-    std::list<spriteListElement> getSpriteList();
+    const ItemList& getItemList();
+    const ChestList& getChestList();
+    const SpriteList& getSpriteList();
 
     struct RandomTileElement { int type; float x; float y; float rotation;};
     RandomTileElement getRandomTileElement(int n);
@@ -253,6 +253,8 @@ class DungeonMap : public GameMap
 
     bool callRevelation();
 
+    virtual int getMemorySize();
+
   protected:
   private:
     GameFloor* gameFloor;
@@ -262,9 +264,6 @@ class DungeonMap : public GameMap
     bool revealed;
     bool cleared;
 
-    int objectsMap[MAP_WIDTH][MAP_HEIGHT];
-    logicalMapStateEnum logicalMap[MAP_WIDTH][MAP_HEIGHT];
-
     roomTypeEnum roomType;
     ItemList itemList;
     SpriteList spriteList;
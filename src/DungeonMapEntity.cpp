@@ -4,6 +4,10 @@
 #include "DungeonMapEntity.h"
 #include "Constants.h"
 #include "sfml_game/ImageManager.h"
+#include "sfml_game/JobSystem.h"
+
+#include <algorithm>
+#include <random>
 
 DungeonMapEntity::DungeonMapEntity() : GameEntity (0.0f, 0.0f)
 {
@@ -29,6 +33,12 @@ DungeonMapEntity::DungeonMapEntity() : GameEntity (0.0f, 0.0f)
 
   shadowType = ShadowTypeStandard;
 
+  // decal layers: the size of the room
+  decalBaking = bloodLayer.create(TILE_WIDTH * MAP_WIDTH, TILE_HEIGHT * MAP_HEIGHT)
+                && corpsesLayer.create(TILE_WIDTH * MAP_WIDTH, TILE_HEIGHT * MAP_HEIGHT);
+  if (!decalBaking) std::cout << "[WARNING] Decal layers not available, blood and corpses are not baked" << std::endl;
+  clearDecalLayers = true;
+
   // doors fixed parts
   for (int i = 0; i < 4; i++)
   {
@@ -99,186 +109,193 @@ void DungeonMapEntity::animate(float delay)
     computeDoors();
   }
 
+  // particles are integrated in parallel chunks: the spawns and deaths go to per-worker buffers
+  JobSystem& jobSystem = JobSystem::getInstance();
+  particleBuffers.resize(jobSystem.getThreadCount());
+
   // bolt particles
-  for (unsigned int i = 0; i < backBoltParticles.size(); i++)
-  {
-    backBoltParticles[i].age += delay;
-    if (backBoltParticles[i].age >= backBoltParticles[i].lifetime)
-    {
-      backBoltParticles.erase(backBoltParticles.begin() + i);
-    }
-    else
-    {
-      animateParticle(backBoltParticles[i], delay, 1.0f);
-      float fade = (backBoltParticles[i].lifetime - backBoltParticles[i].age) / backBoltParticles[i].lifetime;
-      if (fade > 1) fade = 1;
-      else if (fade < 0) fade = 0;
-      backBoltParticles[i].scale = backBoltParticles[i].initialScale * fade;
-      backBoltParticles[i].color = sf::Color(255, 255, 255, 255 * fade);
-    }
-  }
-  for (unsigned int i = 0; i < boltParticles.size(); i++)
-  {
-    boltParticles[i].age += delay;
-    if (boltParticles[i].age >= boltParticles[i].lifetime)
-    {
-      boltParticles.erase(boltParticles.begin() + i);
-    }
-    else
-    {
-      animateParticle(boltParticles[i], delay, 1.0f);
-      float fade = (boltParticles[i].lifetime - boltParticles[i].age) / boltParticles[i].lifetime;
-      if (fade > 1) fade = 1;
-      else if (fade < 0) fade = 0;
-      boltParticles[i].scale = boltParticles[i].initialScale * fade;
-      boltParticles[i].color = sf::Color(255, 255, 255, 255 * fade);
-    }
-  }
+  animateBoltParticles(backBoltParticles, delay);
+  animateBoltParticles(boltParticles, delay);
 
   // blood
-  bool moving = false;
-  for (unsigned int i = 0; i < blood.size(); i++)
+  bool bloodSpread = game().getParameters().bloodSpread;
+  unsigned int spreadSeed = rand();   // rand() is not thread safe: drawn here, the chunks have their own generator
+  clearParticleBuffers();
+  jobSystem.parallelFor(blood.size(), PARTICLE_JOB_GRAIN, [&](int begin, int end, int worker)
   {
-    if (blood[i].moving)
+    particleBufferStruct& buffer = particleBuffers[worker];
+    // seeded with the chunk: the spread does not depend on the threads
+    std::mt19937 random(spreadSeed + begin);
+    for (int i = begin; i < end; i++)
     {
-      moving = true;
-      if (checkFalling(blood[i], 16, 16))
+      displayEntityStruct& particle = blood[i];
+      if (!particle.moving) continue;
+
+      buffer.moving = true;
+      bool collide[4];
+      if (checkFalling(particle, 16, 16))
       {
-        SpriteEntity* spriteEntity
-          = new SpriteEntity(ImageManager::getInstance().getImage(IMAGE_BLOOD),
-                             blood[i].x + 8,
-                             blood[i].y + 8,
-                             16, 16, 6);
-        spriteEntity->setAge(0.0f);
-        spriteEntity->setLifetime(3.0f);
-        spriteEntity->setShrinking(true);
-        spriteEntity->setFading(true);
-        spriteEntity->setFrame(blood[i].frame);
-        spriteEntity->setScale(blood[i].scale, blood[i].scale);
-
-        blood.erase(blood.begin() + i);
+        buffer.falling.push_back(particle);
+        buffer.deaths.push_back(i);
       }
-      else if (blood[i].frame >= BaseCreatureEntity::BloodBarrel * 6
-               && blood[i].frame < BaseCreatureEntity::BloodBarrelPowder * 6 + 6
-               && collideWithWall(blood[i], 16, 16, true))
+      else if (particle.frame >= BaseCreatureEntity::BloodBarrel * 6
+               && particle.frame < BaseCreatureEntity::BloodBarrelPowder * 6 + 6
+               && collideWithWall(particle, 16, 16, collide, true))
       {
-        blood[i].moving = false;
-        blood[i].velocity.x = 0.0f;
-        blood[i].velocity.y = 0.0f;
+        particle.moving = false;
+        particle.velocity.x = 0.0f;
+        particle.velocity.y = 0.0f;
       }
       else
       {
-        animateParticle(blood[i], delay, 0.95f);
+        animateParticle(particle, delay, 0.95f);
 
-        if ((game().getParameters().bloodSpread && ((blood[i].frame < 12) || blood[i].frame >= 36) &&  blood[i].frame < 42))
+        if ((bloodSpread && ((particle.frame < 12) || particle.frame >= 36) &&  particle.frame < 42))
         {
-          if (blood[i].velocity.x * blood[i].velocity.x + blood[i].velocity.y * blood[i].velocity.y > 80
-              && rand() % 4 == 0)
+          if (particle.velocity.x * particle.velocity.x + particle.velocity.y * particle.velocity.y > 80
+              && random() % 4 == 0)
           {
-            addBlood(blood[i].x, blood[i].y, blood[i].frame, blood[i].scale);
-            blood[i].scale *= 0.85f;
-
-            bool xPos = blood[i].velocity.x > 0;
-            bool yPos = blood[i].velocity.y > 0;
-
-            float norm = sqrtf(blood[i].velocity.x * blood[i].velocity.x + blood[i].velocity.y * blood[i].velocity.y);
-            blood[i].velocity = Vector2D(norm);
-            if (xPos && blood[i].velocity.x < 0)  blood[i].velocity.x = - blood[i].velocity.x;
-            else if (!xPos && blood[i].velocity.x > 0)  blood[i].velocity.x = - blood[i].velocity.x;
-            if (yPos && blood[i].velocity.y < 0)  blood[i].velocity.y = - blood[i].velocity.y;
-            else if (!yPos && blood[i].velocity.y > 0)  blood[i].velocity.y = - blood[i].velocity.y;
+            buffer.spawns.push_back(particle);
+            particle.scale *= 0.85f;
+
+            bool xPos = particle.velocity.x > 0;
+            bool yPos = particle.velocity.y > 0;
+
+            float norm = sqrtf(particle.velocity.x * particle.velocity.x + particle.velocity.y * particle.velocity.y);
+            float angle = std::uniform_real_distribution<float>(0.0f, 6.283f)(random);
+            particle.velocity = Vector2D(cosf(angle) * norm, sinf(angle) * norm);
+            if (xPos && particle.velocity.x < 0)  particle.velocity.x = - particle.velocity.x;
+            else if (!xPos && particle.velocity.x > 0)  particle.velocity.x = - particle.velocity.x;
+            if (yPos && particle.velocity.y < 0)  particle.velocity.y = - particle.velocity.y;
+            else if (!yPos && particle.velocity.y > 0)  particle.velocity.y = - particle.velocity.y;
           }
         }
       }
     }
+  });
+
+  bool moving = mergeParticleBuffers(blood);
+  for (unsigned int w = 0; w < particleBuffers.size(); w++)
+  {
+    for (auto& particle : particleBuffers[w].falling)
+    {
+      SpriteEntity* spriteEntity
+        = new SpriteEntity(ImageManager::getInstance().getImage(IMAGE_BLOOD),
+                           particle.x + 8,
+                           particle.y + 8,
+                           16, 16, 6);
+      spriteEntity->setAge(0.0f);
+      spriteEntity->setLifetime(3.0f);
+      spriteEntity->setShrinking(true);
+      spriteEntity->setFading(true);
+      spriteEntity->setFrame(particle.frame);
+      spriteEntity->setScale(particle.scale, particle.scale);
+    }
+    for (auto& particle : particleBuffers[w].spawns)
+      addBlood(particle.x, particle.y, particle.frame, particle.scale);
   }
+  if (settleDecals(blood, settledBlood)) moving = true;
   if (moving) computeBloodVertices();
 
   // corpses
-  int CorpsesBox = 38, CorpsesLargeBox = 76;
-  moving = false;
-  for (unsigned int i = 0; i < corpses.size(); i++)
+  const int CorpsesBox = 38, CorpsesLargeBox = 76;
+  clearParticleBuffers();
+  jobSystem.parallelFor(corpses.size(), PARTICLE_JOB_GRAIN, [&](int begin, int end, int worker)
   {
-    if (corpses[i].moving)
+    particleBufferStruct& buffer = particleBuffers[worker];
+    for (int i = begin; i < end; i++)
     {
-      moving = true;
-      if (corpses[i].frame != FRAME_CORPSE_SLIME_VIOLET
-          && collideWithWall(corpses[i], CorpsesBox, CorpsesBox))
+      displayEntityStruct& particle = corpses[i];
+      if (!particle.moving) continue;
+
+      buffer.moving = true;
+      bool collide[4];
+      if (particle.frame != FRAME_CORPSE_SLIME_VIOLET
+          && collideWithWall(particle, CorpsesBox, CorpsesBox, collide))
       {
-        if (checkFalling(corpses[i], 48, 48))
+        if (checkFalling(particle, 48, 48))
         {
-          SpriteEntity* spriteEntity
-            = new SpriteEntity(ImageManager::getInstance().getImage(IMAGE_CORPSES),
-                               corpses[i].x,
-                               corpses[i].y,
-                               64, 64, 10);
-          spriteEntity->setAge(0.0f);
-          spriteEntity->setLifetime(3.0f);
-          spriteEntity->setShrinking(true);
-          spriteEntity->setFading(true);
-          spriteEntity->setFrame(corpses[i].frame);
-
-          corpses.erase(corpses.begin() + i);
+          buffer.falling.push_back(particle);
+          buffer.deaths.push_back(i);
         }
         else
         {
-          if (corpses[i].velocity.x < 15.0f && corpses[i].velocity.x > -15.0f
-              && corpses[i].velocity.y < 15.0f && corpses[i].velocity.y > -15.0f)
-            autoSpeed(corpses[i], 200);
+          if (particle.velocity.x < 15.0f && particle.velocity.x > -15.0f
+              && particle.velocity.y < 15.0f && particle.velocity.y > -15.0f)
+            autoSpeed(particle, 200, collide);
 
-          animateParticle(corpses[i], delay, 1.0f);
+          animateParticle(particle, delay, 1.0f);
         }
       }
       else
       {
-        float oldx = corpses[i].x;
-        float oldy = corpses[i].y;
-        animateParticle(corpses[i], delay, 0.8f);
-        if (corpses[i].frame != FRAME_CORPSE_SLIME_VIOLET
-            && collideWithWall(corpses[i], CorpsesBox, CorpsesBox))
+        float oldx = particle.x;
+        float oldy = particle.y;
+        animateParticle(particle, delay, 0.8f);
+        if (particle.frame != FRAME_CORPSE_SLIME_VIOLET
+            && collideWithWall(particle, CorpsesBox, CorpsesBox, collide))
         {
-          corpses[i].x = oldx;
-          corpses[i].y = oldy;
-          moving = false;
+          particle.x = oldx;
+          particle.y = oldy;
         }
       }
     }
+  });
+
+  moving = mergeParticleBuffers(corpses);
+  for (unsigned int w = 0; w < particleBuffers.size(); w++)
+  {
+    for (auto& particle : particleBuffers[w].falling)
+    {
+      SpriteEntity* spriteEntity
+        = new SpriteEntity(ImageManager::getInstance().getImage(IMAGE_CORPSES),
+                           particle.x,
+                           particle.y,
+                           64, 64, 10);
+      spriteEntity->setAge(0.0f);
+      spriteEntity->setLifetime(3.0f);
+      spriteEntity->setShrinking(true);
+      spriteEntity->setFading(true);
+      spriteEntity->setFrame(particle.frame);
+    }
   }
-  for (unsigned int i = 0; i < corpsesLarge.size(); i++)
+
+  clearParticleBuffers();
+  jobSystem.parallelFor(corpsesLarge.size(), PARTICLE_JOB_GRAIN, [&](int begin, int end, int worker)
   {
-    if (corpsesLarge[i].moving)
+    particleBufferStruct& buffer = particleBuffers[worker];
+    for (int i = begin; i < end; i++)
     {
-      moving = true;
-      if (collideWithWall(corpsesLarge[i], CorpsesLargeBox, CorpsesLargeBox))
+      displayEntityStruct& particle = corpsesLarge[i];
+      if (!particle.moving) continue;
+
+      buffer.moving = true;
+      bool collide[4];
+      if (collideWithWall(particle, CorpsesLargeBox, CorpsesLargeBox, collide))
       {
-        if (corpsesLarge[i].velocity.x < 15.0f && corpsesLarge[i].velocity.x > -15.0f
-            && corpsesLarge[i].velocity.y < 15.0f && corpsesLarge[i].velocity.y > -15.0f)
-          autoSpeed(corpsesLarge[i], 200);
+        if (particle.velocity.x < 15.0f && particle.velocity.x > -15.0f
+            && particle.velocity.y < 15.0f && particle.velocity.y > -15.0f)
+          autoSpeed(particle, 200, collide);
 
-        animateParticle(corpsesLarge[i], delay, 1.0f);
+        animateParticle(particle, delay, 1.0f);
       }
       else
       {
-        float oldx = corpsesLarge[i].x;
-        float oldy = corpsesLarge[i].y;
-        animateParticle(corpsesLarge[i], delay, 0.8f);
-        if (collideWithWall(corpsesLarge[i], CorpsesLargeBox, CorpsesLargeBox))
+        float oldx = particle.x;
+        float oldy = particle.y;
+        animateParticle(particle, delay, 0.8f);
+        if (collideWithWall(particle, CorpsesLargeBox, CorpsesLargeBox, collide))
         {
-          corpsesLarge[i].x = oldx;
-          corpsesLarge[i].y = oldy;
-          moving = false;
+          particle.x = oldx;
+          particle.y = oldy;
         }
       }
+      if (particle.moving) animateParticle(particle, delay, 0.95f);
     }
-  }
-  for (unsigned int i = 0; i < corpsesLarge.size(); i++)
-  {
-    if (corpsesLarge[i].moving)
-    {
-      moving = true;
-      animateParticle(corpsesLarge[i], delay, 0.95f);
-    }
-  }
+  });
+  if (mergeParticleBuffers(corpsesLarge)) moving = true;
+  if (settleDecals(corpses, settledCorpses)) moving = true;
+  if (settleDecals(corpsesLarge, settledCorpses)) moving = true;
   if (moving) computeCorpsesVertices();
 
   if (game().getCurrentMap()->getRoomType() == roomTypeKey && !game().getCurrentMap()->isCleared())
@@ -308,7 +325,71 @@ void DungeonMapEntity::animateParticle(displayEntityStruct &particle, float dela
     particle.moving = false;
 }
 
-bool DungeonMapEntity::collideWithWall(displayEntityStruct &particle, int boxWidth, int boxHeight, bool canGoThroughObstacle)
+void DungeonMapEntity::animateBoltParticles(std::vector<displayEntityStruct>& particles, float delay)
+{
+  clearParticleBuffers();
+  JobSystem::getInstance().parallelFor(particles.size(), PARTICLE_JOB_GRAIN, [&](int begin, int end, int worker)
+  {
+    particleBufferStruct& buffer = particleBuffers[worker];
+    for (int i = begin; i < end; i++)
+    {
+      displayEntityStruct& particle = particles[i];
+      particle.age += delay;
+      if (particle.age >= particle.lifetime)
+      {
+        buffer.deaths.push_back(i);
+      }
+      else
+      {
+        animateParticle(particle, delay, 1.0f);
+        float fade = (particle.lifetime - particle.age) / particle.lifetime;
+        if (fade > 1) fade = 1;
+        else if (fade < 0) fade = 0;
+        particle.scale = particle.initialScale * fade;
+        particle.color = sf::Color(255, 255, 255, 255 * fade);
+      }
+    }
+  });
+  mergeParticleBuffers(particles);
+}
+
+void DungeonMapEntity::clearParticleBuffers()
+{
+  for (unsigned int w = 0; w < particleBuffers.size(); w++)
+  {
+    particleBuffers[w].deaths.clear();
+    particleBuffers[w].spawns.clear();
+    particleBuffers[w].falling.clear();
+    particleBuffers[w].moving = false;
+  }
+}
+
+bool DungeonMapEntity::mergeParticleBuffers(std::vector<displayEntityStruct>& particles)
+{
+  // dead particles of every worker, removed in one pass (the others keep their order)
+  bool moving = false;
+  deadParticles.clear();
+  for (unsigned int w = 0; w < particleBuffers.size(); w++)
+  {
+    moving = moving || particleBuffers[w].moving;
+    deadParticles.insert(deadParticles.end(), particleBuffers[w].deaths.begin(), particleBuffers[w].deaths.end());
+  }
+  if (deadParticles.empty()) return moving;
+
+  std::sort(deadParticles.begin(), deadParticles.end());
+  unsigned int kept = 0, nextDead = 0;
+  for (unsigned int i = 0; i < particles.size(); i++)
+  {
+    if (nextDead < deadParticles.size() && deadParticles[nextDead] == (int)i)
+      nextDead++;
+    else
+      particles[kept++] = particles[i];
+  }
+  particles.resize(kept);
+  return moving;
+}
+
+bool DungeonMapEntity::collideWithWall(displayEntityStruct &particle, int boxWidth, int boxHeight, bool collide[4], bool canGoThroughObstacle)
 {
   float x0 = particle.x - boxWidth / 2;
   float xf = particle.x + boxWidth / 2;
@@ -362,7 +443,7 @@ bool DungeonMapEntity::checkFalling(displayEntityStruct &particle, int boxWidth,
   return true;
 }
 
-void DungeonMapEntity::autoSpeed(displayEntityStruct &particle, float speed)
+void DungeonMapEntity::autoSpeed(displayEntityStruct &particle, float speed, const bool collide[4])
 {
   if (!collide[NordWest] && !collide[NordEast])
   {
@@ -608,6 +689,7 @@ void DungeonMapEntity::renderDoors(sf::RenderTarget* app)
 
 void DungeonMapEntity::renderPost(sf::RenderTarget* app)
 {
+  bakeDecals();
   displayBlood(app);
   displayCorpses(app);
   switch (shadowType)
@@ -631,28 +713,115 @@ void DungeonMapEntity::renderPost(sf::RenderTarget* app)
 void DungeonMapEntity::renderOverlay(sf::RenderTarget* app)
 {
   renderKeyStone(app);
-  app->draw(overlaySprite);
+  // hidden until the overlay of the room is uploaded (the texture has the previous one)
+  if (!ImageManager::getInstance().isImageLoading(IMAGE_OVERLAY))
+    app->draw(overlaySprite);
 }
 
 std::vector <displayEntityStruct> DungeonMapEntity::getBlood()
 {
-  return blood;
+  // the baked ones too: the room keeps them as sprites, baked again at the next visit
+  auto result = bakedBlood;
+  result.insert( result.end(), settledBlood.begin(), settledBlood.end() );
+  result.insert( result.end(), blood.begin(), blood.end() );
+  return result;
 }
 
 std::vector <displayEntityStruct> DungeonMapEntity::getCorpses()
 {
-  auto result = corpses;
+  auto result = bakedCorpses;
+  result.insert( result.end(), settledCorpses.begin(), settledCorpses.end() );
+  result.insert( result.end(), corpses.begin(), corpses.end() );
   result.insert( result.end(), corpsesLarge.begin(), corpsesLarge.end() );
   return result;
 }
 
+bool DungeonMapEntity::settleDecals(std::vector<displayEntityStruct>& decals, std::vector<displayEntityStruct>& settled)
+{
+  if (!decalBaking) return false;
+
+  unsigned int kept = 0;
+  for (unsigned int i = 0; i < decals.size(); i++)
+  {
+    if (decals[i].moving) decals[kept++] = decals[i];
+    else settled.push_back(decals[i]);
+  }
+  if (kept == decals.size()) return false;
+  decals.resize(kept);
+  return true;
+}
+
+void DungeonMapEntity::bakeDecals()
+{
+  if (!decalBaking) return;
+
+  bool bloodChanged = false, corpsesChanged = false;
+  if (clearDecalLayers)
+  {
+    bloodLayer.clear(sf::Color::Transparent);
+    corpsesLayer.clear(sf::Color::Transparent);
+    clearDecalLayers = false;
+    bloodChanged = corpsesChanged = true;
+  }
+
+  // the layers are premultiplied by the alpha blending (see displayBlood)
+  bakeVertices.setPrimitiveType(sf::Quads);
+  if (!settledBlood.empty())
+  {
+    bakeVertices.resize(settledBlood.size() * 4);
+    for (unsigned int i = 0; i < settledBlood.size(); i++)
+      computeBloodQuad(&bakeVertices[i * 4], settledBlood[i]);
+    bloodLayer.draw(bakeVertices, ImageManager::getInstance().getImage(IMAGE_BLOOD));
+
+    bakedBlood.insert(bakedBlood.end(), settledBlood.begin(), settledBlood.end());
+    settledBlood.clear();
+    bloodChanged = true;
+  }
+
+  if (!settledCorpses.empty())
+  {
+    for (int large = 0; large < 2; large++)
+    {
+      bakeVertices.clear();
+      for (unsigned int i = 0; i < settledCorpses.size(); i++)
+      {
+        if ((settledCorpses[i].frame >= FRAME_CORPSE_KING_RAT) != (large == 1)) continue;
+        bakeVertices.resize(bakeVertices.getVertexCount() + 4);
+        sf::Vertex* quad = &bakeVertices[bakeVertices.getVertexCount() - 4];
+        if (large) computeCorpseLargeQuad(quad, settledCorpses[i]);
+        else computeCorpseQuad(quad, settledCorpses[i]);
+      }
+      if (bakeVertices.getVertexCount() > 0)
+        corpsesLayer.draw(bakeVertices, ImageManager::getInstance().getImage(large ? IMAGE_CORPSES_BIG : IMAGE_CORPSES));
+    }
+
+    bakedCorpses.insert(bakedCorpses.end(), settledCorpses.begin(), settledCorpses.end());
+    settledCorpses.clear();
+    corpsesChanged = true;
+  }
+
+  if (bloodChanged) bloodLayer.display();
+  if (corpsesChanged) corpsesLayer.display();
+}
+
 void DungeonMapEntity::displayBlood(sf::RenderTarget* app)
 {
+  if (decalBaking)
+  {
+    // premultiplied alpha
+    sf::Sprite layer(bloodLayer.getTexture());
+    app->draw(layer, sf::BlendMode(sf::BlendMode::One, sf::BlendMode::OneMinusSrcAlpha));
+  }
   app->draw(bloodVertices, ImageManager::getInstance().getImage(IMAGE_BLOOD));
 }
 
 void DungeonMapEntity::displayCorpses(sf::RenderTarget* app)
 {
+  if (decalBaking)
+  {
+    sf::Sprite layer(corpsesLayer.getTexture());
+    app->draw(layer, sf::BlendMode(sf::BlendMode::One, sf::BlendMode::OneMinusSrcAlpha));
+  }
   app->draw(corpsesVertices, ImageManager::getInstance().getImage(IMAGE_CORPSES));
   app->draw(corpsesLargeVertices, ImageManager::getInstance().getImage(IMAGE_CORPSES_BIG));
 }
@@ -677,6 +846,12 @@ void DungeonMapEntity::refreshMap()
   boltParticles.clear();
   backBoltParticles.clear();
 
+  bakedBlood.clear();
+  bakedCorpses.clear();
+  settledBlood.clear();
+  settledCorpses.clear();
+  clearDecalLayers = true;
+
   computeBloodVertices();
   computeCorpsesVertices();
   computeBoltParticulesVertices();
@@ -848,17 +1023,16 @@ void DungeonMapEntity::computeVertices()
     switch (roomType)
     {
     case roomTypeChallenge:
-      ImageManager::getInstance().getImage(IMAGE_OVERLAY)->loadFromFile("media/overlay_boss_01.png");
+      ss << "media/overlay_boss_01.png";
       break;
     case roomTypeTemple:
-      ImageManager::getInstance().getImage(IMAGE_OVERLAY)->loadFromFile("media/overlay_temple.png");
+      ss << "media/overlay_temple.png";
       break;
     case roomTypeMerchant:
-      ImageManager::getInstance().getImage(IMAGE_OVERLAY)->loadFromFile("media/overlay_shop.png");
+      ss << "media/overlay_shop.png";
       break;
     case roomTypeBoss:
       ss << "media/overlay_boss_0" << game().getLevel() << ".png";
-      ImageManager::getInstance().getImage(IMAGE_OVERLAY)->loadFromFile(ss.str());
       break;
     default:
       if ( gameMap->getObjectTile(6, 2) == MAPOBJ_BANK_TOP
@@ -868,11 +1042,17 @@ void DungeonMapEntity::computeVertices()
            || gameMap->getObjectTile(8, 2) == MAPOBJ_BANK
            || gameMap->getObjectTile(8, 2) == MAPOBJ_BANK_BOTTOM
          )
-        ImageManager::getInstance().getImage(IMAGE_OVERLAY)->loadFromFile("media/overlay_temple.png");
+        ss << "media/overlay_temple.png";
       else
-        ImageManager::getInstance().getImage(IMAGE_OVERLAY)->loadFromFile("media/overlay_00.png");
+        ss << "media/overlay_00.png";
       break;
     }
+    // decoded in the background, the room change is not delayed (most rooms keep the same overlay)
+    if (ss.str() != overlayFile)
+    {
+      overlayFile = ss.str();
+      ImageManager::getInstance().loadImageAsync(IMAGE_OVERLAY, overlayFile);
+    }
     overlaySprite.setTexture(*ImageManager::getInstance().getImage(IMAGE_OVERLAY));
   }
 
@@ -1096,31 +1276,38 @@ void DungeonMapEntity::computeShadowVertices()
   }
 }
 
+int DungeonMapEntity::getBoltParticleCount()
+{
+  return boltParticles.size() + backBoltParticles.size();
+}
+
+void DungeonMapEntity::computeBloodQuad(sf::Vertex* quad, const displayEntityStruct& particle)
+{
+  float middle = 8.0f * particle.scale;
+  int nx = particle.frame % 6;
+  int ny = particle.frame / 6;
+
+  quad[0].position = sf::Vector2f(particle.x - middle, particle.y - middle);
+  quad[1].position = sf::Vector2f(particle.x + middle, particle.y - middle);
+  quad[2].position = sf::Vector2f(particle.x + middle, particle.y + middle);
+  quad[3].position = sf::Vector2f(particle.x - middle, particle.y + middle);
+
+  quad[0].texCoords = sf::Vector2f(nx * 16, ny * 16);
+  quad[1].texCoords = sf::Vector2f((nx + 1) * 16, ny * 16);
+  quad[2].texCoords = sf::Vector2f((nx + 1) * 16, (ny + 1) * 16);
+  quad[3].texCoords = sf::Vector2f(nx * 16, (ny + 1) * 16);
+}
+
 void DungeonMapEntity::computeBloodVertices()
 {
   bloodVertices.setPrimitiveType(sf::Quads);
   bloodVertices.resize(blood.size() * 4);
 
-  for (unsigned int i = 0; i < blood.size(); i++)
+  JobSystem::getInstance().parallelFor(blood.size(), PARTICLE_JOB_GRAIN, [&](int begin, int end, int)
   {
-    auto particle = blood[i];
-
-    sf::Vertex* quad = &bloodVertices[i * 4];
-
-    float middle = 8.0f * particle.scale;
-    int nx = particle.frame % 6;
-    int ny = particle.frame / 6;
-
-    quad[0].position = sf::Vector2f(particle.x - middle, particle.y - middle);
-    quad[1].position = sf::Vector2f(particle.x + middle, particle.y - middle);
-    quad[2].position = sf::Vector2f(particle.x + middle, particle.y + middle);
-    quad[3].position = sf::Vector2f(particle.x - middle, particle.y + middle);
-
-    quad[0].texCoords = sf::Vector2f(nx * 16, ny * 16);
-    quad[1].texCoords = sf::Vector2f((nx + 1) * 16, ny * 16);
-    quad[2].texCoords = sf::Vector2f((nx + 1) * 16, (ny + 1) * 16);
-    quad[3].texCoords = sf::Vector2f(nx * 16, (ny + 1) * 16);
-  }
+    for (int i = begin; i < end; i++)
+      computeBloodQuad(&bloodVertices[i * 4], blood[i]);
+  });
 }
 
 void DungeonMapEntity::computeBoltParticulesVertices()
@@ -1128,109 +1315,119 @@ void DungeonMapEntity::computeBoltParticulesVertices()
   boltParticlesVertices.setPrimitiveType(sf::Quads);
   boltParticlesVertices.resize(boltParticles.size() * 4);
 
-  for (unsigned int i = 0; i < boltParticles.size(); i++)
+  JobSystem::getInstance().parallelFor(boltParticles.size(), PARTICLE_JOB_GRAIN, [&](int begin, int end, int)
   {
-    auto particle = boltParticles[i];
+    for (int i = begin; i < end; i++)
+    {
+      const displayEntityStruct& particle = boltParticles[i];
 
-    sf::Vertex* quad = &boltParticlesVertices[i * 4];
+      sf::Vertex* quad = &boltParticlesVertices[i * 4];
 
-    float middle = 12.0f * particle.scale;
-    int nx = particle.frame % BOLT_PRO_LINE;
-    int ny = particle.frame / BOLT_PRO_LINE;
+      float middle = 12.0f * particle.scale;
+      int nx = particle.frame % BOLT_PRO_LINE;
+      int ny = particle.frame / BOLT_PRO_LINE;
 
-    quad[0].position = sf::Vector2f(particle.x - middle, particle.y - middle);
-    quad[1].position = sf::Vector2f(particle.x + middle, particle.y - middle);
-    quad[2].position = sf::Vector2f(particle.x + middle, particle.y + middle);
-    quad[3].position = sf::Vector2f(particle.x - middle, particle.y + middle);
+      quad[0].position = sf::Vector2f(particle.x - middle, particle.y - middle);
+      quad[1].position = sf::Vector2f(particle.x + middle, particle.y - middle);
+      quad[2].position = sf::Vector2f(particle.x + middle, particle.y + middle);
+      quad[3].position = sf::Vector2f(particle.x - middle, particle.y + middle);
 
-    quad[0].texCoords = sf::Vector2f(nx * 24, ny * 24);
-    quad[1].texCoords = sf::Vector2f((nx + 1) * 24, ny * 24);
-    quad[2].texCoords = sf::Vector2f((nx + 1) * 24, (ny + 1) * 24);
-    quad[3].texCoords = sf::Vector2f(nx * 24, (ny + 1) * 24);
+      quad[0].texCoords = sf::Vector2f(nx * 24, ny * 24);
+      quad[1].texCoords = sf::Vector2f((nx + 1) * 24, ny * 24);
+      quad[2].texCoords = sf::Vector2f((nx + 1) * 24, (ny + 1) * 24);
+      quad[3].texCoords = sf::Vector2f(nx * 24, (ny + 1) * 24);
 
-    quad[0].color = particle.color;
-    quad[1].color = particle.color;
-    quad[2].color = particle.color;
-    quad[3].color = particle.color;
-  }
+      quad[0].color = particle.color;
+      quad[1].color = particle.color;
+      quad[2].color = particle.color;
+      quad[3].color = particle.color;
+    }
+  });
 
   backBoltParticlesVertices.setPrimitiveType(sf::Quads);
   backBoltParticlesVertices.resize(backBoltParticles.size() * 4);
 
-  for (unsigned int i = 0; i < backBoltParticles.size(); i++)
+  JobSystem::getInstance().parallelFor(backBoltParticles.size(), PARTICLE_JOB_GRAIN, [&](int begin, int end, int)
   {
-    auto particle = backBoltParticles[i];
+    for (int i = begin; i < end; i++)
+    {
+      const displayEntityStruct& particle = backBoltParticles[i];
 
-    sf::Vertex* quad = &backBoltParticlesVertices[i * 4];
+      sf::Vertex* quad = &backBoltParticlesVertices[i * 4];
 
-    float middle = 12.0f * particle.scale;
-    int nx = particle.frame % BOLT_PRO_LINE;
-    int ny = particle.frame / BOLT_PRO_LINE;
+      float middle = 12.0f * particle.scale;
+      int nx = particle.frame % BOLT_PRO_LINE;
+      int ny = particle.frame / BOLT_PRO_LINE;
 
-    quad[0].position = sf::Vector2f(particle.x - middle, particle.y - middle);
-    quad[1].position = sf::Vector2f(particle.x + middle, particle.y - middle);
-    quad[2].position = sf::Vector2f(particle.x + middle, particle.y + middle);
-    quad[3].position = sf::Vector2f(particle.x - middle, particle.y + middle);
+      quad[0].position = sf::Vector2f(particle.x - middle, particle.y - middle);
+      quad[1].position = sf::Vector2f(particle.x + middle, particle.y - middle);
+      quad[2].position = sf::Vector2f(particle.x + middle, particle.y + middle);
+      quad[3].position = sf::Vector2f(particle.x - middle, particle.y + middle);
 
-    quad[0].texCoords = sf::Vector2f(nx * 24, ny * 24);
-    quad[1].texCoords = sf::Vector2f((nx + 1) * 24, ny * 24);
-    quad[2].texCoords = sf::Vector2f((nx + 1) * 24, (ny + 1) * 24);
-    quad[3].texCoords = sf::Vector2f(nx * 24, (ny + 1) * 24);
+      quad[0].texCoords = sf::Vector2f(nx * 24, ny * 24);
+      quad[1].texCoords = sf::Vector2f((nx + 1) * 24, ny * 24);
+      quad[2].texCoords = sf::Vector2f((nx + 1) * 24, (ny + 1) * 24);
+      quad[3].texCoords = sf::Vector2f(nx * 24, (ny + 1) * 24);
 
-    quad[0].color = particle.color;
-    quad[1].color = particle.color;
-    quad[2].color = particle.color;
-    quad[3].color = particle.color;
-  }
+      quad[0].color = particle.color;
+      quad[1].color = particle.color;
+      quad[2].color = particle.color;
+      quad[3].color = particle.color;
+    }
+  });
+}
+
+void DungeonMapEntity::computeCorpseQuad(sf::Vertex* quad, const displayEntityStruct& particle)
+{
+  float middle = 32;
+  int nx = particle.frame % 10;
+  int ny = particle.frame / 10;
+
+  quad[0].position = sf::Vector2f(particle.x - middle, particle.y - middle);
+  quad[1].position = sf::Vector2f(particle.x + middle, particle.y - middle);
+  quad[2].position = sf::Vector2f(particle.x + middle, particle.y + middle);
+  quad[3].position = sf::Vector2f(particle.x - middle, particle.y + middle);
+
+  quad[0].texCoords = sf::Vector2f(nx * 64, ny * 64);
+  quad[1].texCoords = sf::Vector2f((nx + 1) * 64, ny * 64);
+  quad[2].texCoords = sf::Vector2f((nx + 1) * 64, (ny + 1) * 64);
+  quad[3].texCoords = sf::Vector2f(nx * 64, (ny + 1) * 64);
+}
+
+void DungeonMapEntity::computeCorpseLargeQuad(sf::Vertex* quad, const displayEntityStruct& particle)
+{
+  float middle = 64;
+  int nx = (particle.frame - FRAME_CORPSE_KING_RAT) % 8;
+  int ny = (particle.frame - FRAME_CORPSE_KING_RAT) / 8;
+
+  quad[0].position = sf::Vector2f(particle.x - middle, particle.y - middle);
+  quad[1].position = sf::Vector2f(particle.x + middle, particle.y - middle);
+  quad[2].position = sf::Vector2f(particle.x + middle, particle.y + middle);
+  quad[3].position = sf::Vector2f(particle.x - middle, particle.y + middle);
+
+  quad[0].texCoords = sf::Vector2f(nx * 128, ny * 128);
+  quad[1].texCoords = sf::Vector2f((nx + 1) * 128, ny * 128);
+  quad[2].texCoords = sf::Vector2f((nx + 1) * 128, (ny + 1) * 128);
+  quad[3].texCoords = sf::Vector2f(nx * 128, (ny + 1) * 128);
 }
 
 void DungeonMapEntity::computeCorpsesVertices()
 {
   corpsesVertices.setPrimitiveType(sf::Quads);
   corpsesVertices.resize(corpses.size() * 4);
-  for (unsigned int i = 0; i < corpses.size(); i++)
+  JobSystem::getInstance().parallelFor(corpses.size(), PARTICLE_JOB_GRAIN, [&](int begin, int end, int)
   {
-    auto particle = corpses[i];
-
-    sf::Vertex* quad = &corpsesVertices[i * 4];
-
-    float middle = 32;
-    int nx = particle.frame % 10;
-    int ny = particle.frame / 10;
-
-    quad[0].position = sf::Vector2f(particle.x - middle, particle.y - middle);
-    quad[1].position = sf::Vector2f(particle.x + middle, particle.y - middle);
-    quad[2].position = sf::Vector2f(particle.x + middle, particle.y + middle);
-    quad[3].position = sf::Vector2f(particle.x - middle, particle.y + middle);
-
-    quad[0].texCoords = sf::Vector2f(nx * 64, ny * 64);
-    quad[1].texCoords = sf::Vector2f((nx + 1) * 64, ny * 64);
-    quad[2].texCoords = sf::Vector2f((nx + 1) * 64, (ny + 1) * 64);
-    quad[3].texCoords = sf::Vector2f(nx * 64, (ny + 1) * 64);
-  }
+    for (int i = begin; i < end; i++)
+      computeCorpseQuad(&corpsesVertices[i * 4], corpses[i]);
+  });
 
   corpsesLargeVertices.setPrimitiveType(sf::Quads);
   corpsesLargeVertices.resize(corpsesLarge.size() * 4);
-  for (unsigned int i = 0; i < corpsesLarge.size(); i++)
+  JobSystem::getInstance().parallelFor(corpsesLarge.size(), PARTICLE_JOB_GRAIN, [&](int begin, int end, int)
   {
-    auto particle = corpsesLarge[i];
-
-    sf::Vertex* quad = &corpsesLargeVertices[i * 4];
-
-    float middle = 64;
-    int nx = (particle.frame - FRAME_CORPSE_KING_RAT) % 8;
-    int ny = (particle.frame - FRAME_CORPSE_KING_RAT) / 8;
-
-    quad[0].position = sf::Vector2f(particle.x - middle, particle.y - middle);
-    quad[1].position = sf::Vector2f(particle.x + middle, particle.y - middle);
-    quad[2].position = sf::Vector2f(particle.x + middle, particle.y + middle);
-    quad[3].position = sf::Vector2f(particle.x - middle, particle.y + middle);
-
-    quad[0].texCoords = sf::Vector2f(nx * 128, ny * 128);
-    quad[1].texCoords = sf::Vector2f((nx + 1) * 128, ny * 128);
-    quad[2].texCoords = sf::Vector2f((nx + 1) * 128, (ny + 1) * 128);
-    quad[3].texCoords = sf::Vector2f(nx * 128, (ny + 1) * 128);
-  }
+    for (int i = begin; i < end; i++)
+      computeCorpseLargeQuad(&corpsesLargeVertices[i * 4], corpsesLarge[i]);
+  });
 }
 
 displayEntityStruct& DungeonMapEntity::generateBlood(float x, float y, BaseCreatureEntity::enumBloodColor bloodColor)
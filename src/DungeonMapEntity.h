@@ -49,6 +49,7 @@ public:
   std::vector <displayEntityStruct> getBlood();
   std::vector <displayEntityStruct> getCorpses();
   void computeBoltParticulesVertices();
+  int getBoltParticleCount();
 
   void activateKeyRoomEffect();
 
@@ -66,20 +67,40 @@ private:
   sf::VertexArray boltParticlesVertices;
   sf::VertexArray backBoltParticlesVertices;
 
+  // settled (not moving) blood and corpses are baked in layers, drawn as one quad each
+  sf::RenderTexture bloodLayer;
+  sf::RenderTexture corpsesLayer;
+  bool decalBaking;             // false if the layers could not be created
+  bool clearDecalLayers;        // new room: cleared at the next rendering
+  std::vector<displayEntityStruct> bakedBlood;
+  std::vector<displayEntityStruct> bakedCorpses;
+  std::vector<displayEntityStruct> settledBlood;    // baked at the next rendering
+  std::vector<displayEntityStruct> settledCorpses;
+  sf::VertexArray bakeVertices;
+
   bool getChanged();
   void computeVertices();
   void computeOverVertices();
   void computeShadowVertices();
   void computeBloodVertices();
   void computeCorpsesVertices();
+  static void computeBloodQuad(sf::Vertex* quad, const displayEntityStruct& particle);
+  static void computeCorpseQuad(sf::Vertex* quad, const displayEntityStruct& particle);
+  static void computeCorpseLargeQuad(sf::Vertex* quad, const displayEntityStruct& particle);
+
+  /** Moves the decals which stopped to the settled ones, returns true if there was one */
+  bool settleDecals(std::vector<displayEntityStruct>& decals, std::vector<displayEntityStruct>& settled);
+  /** Draws the settled decals in the layers (rendering thread) */
+  void bakeDecals();
 
   void computeDoors();
 
   bool shouldBeTransformed(int part);
 
   void animateParticle(displayEntityStruct &particle, float delay, float viscosity);
-  bool collideWithWall(displayEntityStruct &particle, int boxWidth, int boxHeight, bool canGoThroughObstacle = false);
-  void autoSpeed(displayEntityStruct &particle, float speed);
+  void animateBoltParticles(std::vector<displayEntityStruct>& particles, float delay);
+  bool collideWithWall(displayEntityStruct &particle, int boxWidth, int boxHeight, bool collide[4], bool canGoThroughObstacle = false);
+  void autoSpeed(displayEntityStruct &particle, float speed, const bool collide[4]);
   bool checkFalling(displayEntityStruct &particle, int boxWidth, int boxHeight);
 
   void displayBlood(sf::RenderTarget* app);
@@ -92,7 +113,21 @@ private:
   std::vector<displayEntityStruct> corpses;
   std::vector<displayEntityStruct> corpsesLarge;
 
-  bool collide[4];
+  /** Spawns and deaths of a worker of the job system, merged after each parallel loop */
+  struct particleBufferStruct
+  {
+    std::vector<int> deaths;                    // indexes of the dead particles
+    std::vector<displayEntityStruct> spawns;    // new particles
+    std::vector<displayEntityStruct> falling;   // dead particles fallen in a hole
+    bool moving;
+  };
+  std::vector<particleBufferStruct> particleBuffers;
+  std::vector<int> deadParticles;
+
+  void clearParticleBuffers();
+  /** Removes the dead particles of the buffers, returns true if a particle was moving */
+  bool mergeParticleBuffers(std::vector<displayEntityStruct>& particles);
+
   enum enumCollisionDirection
   {
     NordWest,
@@ -102,6 +137,7 @@ private:
   };
 
   sf::Sprite overlaySprite;
+  std::string overlayFile;    // file of the overlay texture (loaded in the background)
   sf::Sprite randomSprite[NB_RANDOM_TILES_IN_ROOM];
   roomTypeEnum roomType;
 
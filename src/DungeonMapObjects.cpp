@@ -0,0 +1,157 @@
+#include "DungeonMap.h"
+#include "GameFloor.h"
+#include "ItemEntity.h"
+#include "ChestEntity.h"
+#include "WitchBlastGame.h"
+
+// DungeonMap functions acting on the game (entities, doors, stars):
+// apart from DungeonMap.cpp so the room generation links without the game (tools/SpawnPlacementCheck).
+
+void DungeonMap::restoreItems()
+{
+  ItemList::iterator it;
+  for (it = itemList.begin (); it != itemList.end ();)
+  {
+    itemListElement ilm = *it;
+    it++;
+
+    ItemEntity* itemEntity = new ItemEntity((enumItemType)(ilm.type), ilm.x, ilm.y);
+    itemEntity->setMerchandise(ilm.merch);
+	}
+}
+
+void DungeonMap::restoreSprites()
+{
+	SpriteList::iterator it;
+
+  for (it = spriteList.begin (); it != spriteList.end ();)
+  {
+    spriteListElement ilm = *it;
+    it++;
+
+    if (ilm.type == ENTITY_BLOOD)
+      game().getCurrentMapEntity()->addBlood(ilm.x, ilm.y, ilm.frame, ilm.scale);
+
+    else if (ilm.type == ENTITY_CORPSE)
+      game().getCurrentMapEntity()->addCorpse(ilm.x, ilm.y, ilm.frame);
+  }
+}
+
+void DungeonMap::restoreChests()
+{
+  ChestList::iterator it;
+
+  for (it = chestList.begin (); it != chestList.end ();)
+  {
+    chestListElement clm = *it;
+    it++;
+
+    new ChestEntity(clm.x, clm.y, clm.type, clm.state);
+	}
+}
+
+void DungeonMap::restoreMapObjects()
+{
+  restoreItems();
+  restoreSprites();
+  restoreChests();
+  cleanMapObjects();
+}
+
+bool DungeonMap::callRevelation()
+{
+  if (hasNeighbourRight() && !gameFloor->getMap(x + 1, y)->isRevealed())
+  {
+    tileAt(MAP_WIDTH - 1, MAP_HEIGHT / 2).tile = floorOffset;
+    tileAt(MAP_WIDTH - 1, MAP_HEIGHT / 2 - 1).tile = floorOffset;
+    tileAt(MAP_WIDTH - 1, MAP_HEIGHT / 2 + 1).tile = floorOffset;
+
+    if (cleared)
+      openDoor(MAP_WIDTH - 1, MAP_HEIGHT / 2);
+    else
+      closeDoor(MAP_WIDTH - 1, MAP_HEIGHT / 2);
+
+    game().setDoorVisible(East);
+    gameFloor->getMap(x + 1, y)->setRevealed(true);
+    hasChanged = true;
+
+    for (int i = 0; i < 36; i++)
+      game().generateStar(
+                    (i % 2 == 0) ? sf::Color(50, 50, 255, 255) : sf::Color(200, 200, 255, 255),
+                    (MAP_WIDTH - 1) * TILE_WIDTH + rand() % TILE_WIDTH,
+                     (MAP_HEIGHT / 2 - 1) * TILE_HEIGHT + rand() % (TILE_HEIGHT * 3) );
+
+    return true;
+  }
+  else if (hasNeighbourLeft() && !gameFloor->getMap(x - 1, y)->isRevealed())
+  {
+    tileAt(0, MAP_HEIGHT / 2).tile = floorOffset;
+    tileAt(0, MAP_HEIGHT / 2 - 1).tile = floorOffset;
+    tileAt(0, MAP_HEIGHT / 2 + 1).tile = floorOffset;
+
+    if (cleared)
+      openDoor(0, MAP_HEIGHT / 2);
+    else
+      closeDoor(0, MAP_HEIGHT / 2);
+
+    game().setDoorVisible(West);
+    gameFloor->getMap(x - 1, y)->setRevealed(true);
+    hasChanged = true;
+
+    for (int i = 0; i < 36; i++)
+      game().generateStar(
+                    (i % 2 == 0) ? sf::Color(50, 50, 255, 255) : sf::Color(200, 200, 255, 255),
+                    rand() % TILE_WIDTH,
+                     (MAP_HEIGHT / 2 - 1) * TILE_HEIGHT + rand() % (TILE_HEIGHT * 3) );
+
+    return true;
+  }
+  else if (hasNeighbourUp() && !gameFloor->getMap(x, y - 1)->isRevealed())
+  {
+    tileAt(MAP_WIDTH / 2, 0).tile = floorOffset;
+    tileAt(MAP_WIDTH / 2 - 1, 0).tile = floorOffset;
+    tileAt(MAP_WIDTH / 2 + 1, 0).tile = floorOffset;
+
+    if (cleared)
+      openDoor(MAP_WIDTH / 2, 0);
+    else
+      closeDoor(MAP_WIDTH / 2, 0);
+
+    game().setDoorVisible(North);
+    gameFloor->getMap(x, y - 1)->setRevealed(true);
+    hasChanged = true;
+
+    for (int i = 0; i < 36; i++)
+      game().generateStar(
+                    (i % 2 == 0) ? sf::Color(50, 50, 255, 255) : sf::Color(200, 200, 255, 255),
+                    (MAP_WIDTH / 2 - 1) * TILE_WIDTH + rand() % (TILE_WIDTH * 3),
+                    rand() % TILE_HEIGHT );
+
+    return true;
+  }
+  else if (hasNeighbourDown() && !gameFloor->getMap(x, y + 1)->isRevealed())
+  {
+    tileAt(MAP_WIDTH / 2, MAP_HEIGHT - 1).tile = floorOffset;
+    tileAt(MAP_WIDTH / 2 - 1, MAP_HEIGHT - 1).tile = floorOffset;
+    tileAt(MAP_WIDTH / 2 + 1, MAP_HEIGHT - 1).tile = floorOffset;
+
+    if (cleared)
+      openDoor(MAP_WIDTH / 2, MAP_HEIGHT -1);
+    else
+      closeDoor(MAP_WIDTH / 2, MAP_HEIGHT -1);
+
+    game().setDoorVisible(South);
+    gameFloor->getMap(x, y + 1)->setRevealed(true);
+    hasChanged = true;
+
+    for (int i = 0; i < 36; i++)
+      game().generateStar(
+                    (i % 2 == 0) ? sf::Color(50, 50, 255, 255) : sf::Color(200, 200, 255, 255),
+                    (MAP_WIDTH / 2 - 1) * TILE_WIDTH + rand() % (TILE_WIDTH * 3),
+                    (MAP_HEIGHT - 1) * TILE_HEIGHT + rand() % TILE_HEIGHT );
+
+    return true;
+  }
+
+  return false;
+}
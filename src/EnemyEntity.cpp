@@ -35,6 +35,10 @@ EnemyEntity::EnemyEntity(sf::Texture* image, float x, float y)
 
   nextFacingDirection = 0;
   facingTimer = -1.0f;
+
+  hasThinkStep = false;
+  thinkTimer = game().getAiScheduler()->getStartPhase();
+  thinkPromoted = false;
 }
 
 enemyTypeEnum EnemyEntity::getEnemyType()
@@ -52,6 +56,30 @@ void EnemyEntity::checkNextFacing(float dt)
   }
 }
 
+void EnemyEntity::promoteThink()
+{
+  thinkPromoted = true;
+}
+
+void EnemyEntity::think(float delay)
+{
+}
+
+void EnemyEntity::updateThink(float delay)
+{
+  thinkTimer += delay;
+  AiScheduler* scheduler = game().getAiScheduler();
+
+  if (scheduler->canThink(thinkTimer, thinkPromoted))
+  {
+    sf::Clock thinkClock;
+    think(thinkTimer);
+    scheduler->addThinkCost(enemyType, thinkClock.getElapsedTime().asMicroseconds());
+    thinkTimer = 0.0f;
+    thinkPromoted = false;
+  }
+}
+
 void EnemyEntity::setLabelDy(float label_dy)
 {
   this->label_dy = label_dy;
@@ -81,6 +109,7 @@ void EnemyEntity::animate(float delay)
   }
 
   if (canCollide()) testSpriteCollisions();
+  if (hasThinkStep && age > 0.0f) updateThink(delay);
   if (age > 0.0f)
     BaseCreatureEntity::animate(delay);
   else
@@ -268,6 +297,7 @@ void EnemyEntity::collideWithEnemy(EnemyEntity* entity)
 int EnemyEntity::hurt(StructHurt hurtParam)
 {
   int hurtedHp = BaseCreatureEntity::hurt(hurtParam);
+  if (hurtedHp > 0) thinkPromoted = true;
   if (hurtedHp > 0 && hurtingSound != SOUND_NONE && hp > 0)
     SoundManager::getInstance().playSound(hurtingSound);
   return hurtedHp;
@@ -21,6 +21,11 @@ public:
 
   void checkNextFacing(float dt);
 
+  /*!
+   *  \brief promotes the next think step (done at the next frame, whatever the budget)
+   */
+  void promoteThink();
+
 protected:
   virtual void collideMapRight();
   virtual void collideMapLeft();
@@ -37,6 +42,20 @@ protected:
   virtual void collideWithBolt(BoltEntity* boltEntity);
   int getCollisionDirection(BoltEntity* boltEntity);
 
+  /*!
+   *  \brief decision step (target, line of sight, attack...)
+   *
+   *  Called by the AI scheduler at a lower rate than animate(), when hasThinkStep is true.
+   *  The bosses call updateThink() themselves, after their state timers, and promote the
+   *  step when a timer expires so their patterns keep the same timing.
+   *  \param delay : time elapsed since the last think step
+   */
+  virtual void think(float delay);
+  void updateThink(float delay);
+  bool hasThinkStep;  /*!< True if EnemyEntity::animate() runs the think step */
+  float thinkTimer;   /*!< Time elapsed since the last think step */
+  bool thinkPromoted; /*!< True if the next think step has been promoted */
+
   int meleeDamages;
   int meleeLevel;
   enumShotType meleeType;
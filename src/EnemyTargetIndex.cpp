@@ -0,0 +1,223 @@
+/**  This file is part of Witch Blast.
+  *
+  *  Witch Blast is free software: you can redistribute it and/or modify
+  *  it under the terms of the GNU General Public License as published by
+  *  the Free Software Foundation, either version 3 of the License, or
+  *  (at your option) any later version.
+  *
+  *  Witch Blast is distributed in the hope that it will be useful,
+  *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  *  GNU General Public License for more details.
+  *
+  *  You should have received a copy of the GNU General Public License
+  *  along with Witch Blast.  If not, see <http://www.gnu.org/licenses/>.
+  */
+
+#include "EnemyTargetIndex.h"
+#include "EnemyEntity.h"
+#include "sfml_game/EntityManager.h"
+
+#include <algorithm>
+
+const int MAX_RING = MAP_WIDTH > MAP_HEIGHT ? MAP_WIDTH : MAP_HEIGHT;
+const float CELL_SIZE_MIN = TILE_WIDTH < TILE_HEIGHT ? TILE_WIDTH : TILE_HEIGHT;
+
+EnemyTargetIndex::EnemyTargetIndex()
+{
+  isBuilt = false;
+  for (int i = 0; i <= CELLS; i++) cellStart[i] = 0;
+}
+
+void EnemyTargetIndex::invalidate()
+{
+  isBuilt = false;
+}
+
+void EnemyTargetIndex::checkBuilt()
+{
+  if (!isBuilt) build();
+}
+
+int EnemyTargetIndex::getCellX(float x)
+{
+  int cx = (int)(x / TILE_WIDTH);
+  if (x < 0.0f || cx < 0) return 0;
+  if (cx >= MAP_WIDTH) return MAP_WIDTH - 1;
+  return cx;
+}
+
+int EnemyTargetIndex::getCellY(float y)
+{
+  int cy = (int)(y / TILE_HEIGHT);
+  if (y < 0.0f || cy < 0) return 0;
+  if (cy >= MAP_HEIGHT) return MAP_HEIGHT - 1;
+  return cy;
+}
+
+float EnemyTargetIndex::getRingDistance(int ring)
+{
+  // the source can be anywhere in its own cell, and positions out of the map are
+  // clamped to the border cells (so they can only be farther)
+  if (ring <= 1) return 0.0f;
+  return (ring - 1) * CELL_SIZE_MIN;
+}
+
+void EnemyTargetIndex::build()
+{
+  std::vector<targetStruct> unsortedTargets;
+  targetCell.clear();
+
+  for (int i = 0; i <= CELLS; i++) cellStart[i] = 0;
+
+  EntityManager::EntityList* entityList =EntityManager::getInstance().getList();
+  EntityManager::EntityList::iterator it;
+
+  for (it = entityList->begin (); it != entityList->end ();)
+  {
+    GameEntity *e = *it;
+    it++;
+
+    if (e->getType() >= ENTITY_ENEMY && e->getType() <= ENTITY_ENEMY_MAX_COUNT && !e->getDying())
+    {
+      EnemyEntity* enemy = static_cast<EnemyEntity*>(e);
+      if (enemy->canCollide())
+      {
+        targetStruct target;
+        target.x = enemy->getX();
+        target.y = enemy->getY();
+        int cell = getCellX(target.x) + getCellY(target.y) * MAP_WIDTH;
+        unsortedTargets.push_back(target);
+        targetCell.push_back(cell);
+        cellStart[cell + 1]++;
+      }
+    }
+  }
+
+  // counting sort by cell
+  for (int i = 0; i < CELLS; i++) cellStart[i + 1] += cellStart[i];
+
+  targets.resize(unsortedTargets.size());
+  std::vector<int> cellFill(cellStart, cellStart + CELLS);
+  for (unsigned int i = 0; i < unsortedTargets.size(); i++)
+    targets[cellFill[targetCell[i]]++] = unsortedTargets[i];
+
+  isBuilt = true;
+}
+
+int EnemyTargetIndex::getTargetCount()
+{
+  checkBuilt();
+  return targets.size();
+}
+
+Vector2D EnemyTargetIndex::getNearest(float x, float y)
+{
+  return getNearestInCone(x, y, 0.0f, 0.0f, PI);
+}
+
+Vector2D EnemyTargetIndex::getNearestInCone(float x, float y, float dirX, float dirY, float halfAngle, float maxDistance)
+{
+  checkBuilt();
+
+  Vector2D target(-100.0f, -100.0f);
+  if (targets.empty()) return target;
+
+  bool useCone = halfAngle < PI;
+  float dirNorm = sqrtf(dirX * dirX + dirY * dirY);
+  float cosHalfAngle = cosf(halfAngle);
+  if (useCone && dirNorm < 0.0001f) return target;
+
+  float distanceMin = -1.0f;
+  int sx = getCellX(x);
+  int sy = getCellY(y);
+
+  for (int r = 0; r <= MAX_RING; r++)
+  {
+    float ringDistance = getRingDistance(r);
+    if (distanceMin >= 0.0f && ringDistance * ringDistance > distanceMin) break;
+    if (maxDistance > 0.0f && ringDistance > maxDistance) break;
+
+    for (int j = sy - r; j <= sy + r; j++)
+    {
+      if (j < 0 || j >= MAP_HEIGHT) continue;
+      int step = (j == sy - r || j == sy + r) ? 1 : 2 * r;
+
+      for (int i = sx - r; i <= sx + r; i += step)
+      {
+        if (i < 0 || i >= MAP_WIDTH) continue;
+        int cell = i + j * MAP_WIDTH;
+
+        for (int n = cellStart[cell]; n < cellStart[cell + 1]; n++)
+        {
+          float dx = targets[n].x - x;
+          float dy = targets[n].y - y;
+          float d2 = dx * dx + dy * dy;
+
+          if (distanceMin >= 0.0f && d2 >= distanceMin) continue;
+          if (maxDistance > 0.0f && d2 > maxDistance * maxDistance) continue;
+          if (useCone && (dx * dirX + dy * dirY) < sqrtf(d2) * dirNorm * cosHalfAngle) continue;
+
+          distanceMin = d2;
+          target.x = targets[n].x;
+          target.y = targets[n].y;
+        }
+      }
+    }
+  }
+
+  return target;
+}
+
+int EnemyTargetIndex::getKNearest(float x, float y, int k, std::vector<Vector2D>& result)
+{
+  checkBuilt();
+  result.clear();
+  if (k <= 0 || targets.empty()) return 0;
+
+  std::vector<std::pair<float, int> > candidates;
+  int sx = getCellX(x);
+  int sy = getCellY(y);
+
+  for (int r = 0; r <= MAX_RING; r++)
+  {
+    if ((int)candidates.size() >= k)
+    {
+      std::nth_element(candidates.begin(), candidates.begin() + (k - 1), candidates.end());
+      float ringDistance = getRingDistance(r);
+      if (ringDistance * ringDistance > candidates[k - 1].first) break;
+    }
+
+    for (int j = sy - r; j <= sy + r; j++)
+    {
+      if (j < 0 || j >= MAP_HEIGHT) continue;
+      int step = (j == sy - r || j == sy + r) ? 1 : 2 * r;
+
+      for (int i = sx - r; i <= sx + r; i += step)
+      {
+        if (i < 0 || i >= MAP_WIDTH) continue;
+        int cell = i + j * MAP_WIDTH;
+
+        for (int n = cellStart[cell]; n < cellStart[cell + 1]; n++)
+        {
+          float dx = targets[n].x - x;
+          float dy = targets[n].y - y;
+          candidates.push_back(std::pair<float, int>(dx * dx + dy * dy, n));
+        }
+      }
+    }
+  }
+
+  if ((int)candidates.size() > k)
+  {
+    std::partial_sort(candidates.begin(), candidates.begin() + k, candidates.end());
+    candidates.resize(k);
+  }
+  else
+    std::sort(candidates.begin(), candidates.end());
+
+  for (unsigned int i = 0; i < candidates.size(); i++)
+    result.push_back(Vector2D(targets[candidates[i].second].x, targets[candidates[i].second].y));
+
+  return result.size();
+}
@@ -0,0 +1,104 @@
+/**  This file is part of Witch Blast.
+  *
+  *  Witch Blast is free software: you can redistribute it and/or modify
+  *  it under the terms of the GNU General Public License as published by
+  *  the Free Software Foundation, either version 3 of the License, or
+  *  (at your option) any later version.
+  *
+  *  Witch Blast is distributed in the hope that it will be useful,
+  *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  *  GNU General Public License for more details.
+  *
+  *  You should have received a copy of the GNU General Public License
+  *  along with Witch Blast.  If not, see <http://www.gnu.org/licenses/>.
+  */
+
+#ifndef ENEMYTARGETINDEX_H
+#define ENEMYTARGETINDEX_H
+
+#include "sfml_game/MyTools.h"
+#include "Constants.h"
+#include <vector>
+
+/*! \class EnemyTargetIndex
+* \brief Spatial index of the collidable enemies, used for targeting
+*
+*  The enemies are bucketed in a grid of tiles, rebuilt at most once per update step
+*  (the first time a query is done after invalidate()). Queries then walk the grid cells
+*  by rings around the source and stop as soon as no closer enemy can be found.
+*  Only the positions are stored: an enemy killed during the step may still be returned
+*  until the next rebuild, as with the previous full scan.
+*/
+class EnemyTargetIndex
+{
+  public:
+    EnemyTargetIndex();
+
+    /*!
+     *  \brief marks the index as outdated (rebuilt on next query)
+     */
+    void invalidate();
+
+    /*!
+     *  \brief rebuilds the index from the entity manager
+     */
+    void build();
+
+    /*!
+     *  \brief returns the position of the nearest enemy
+     *  \param x : x position of the source
+     *  \param y : y position of the source
+     *  \return position of the nearest enemy (negative position when no enemy found)
+     */
+    Vector2D getNearest(float x, float y);
+
+    /*!
+     *  \brief returns the positions of the k nearest enemies, the nearest first
+     *  \param x : x position of the source
+     *  \param y : y position of the source
+     *  \param k : max number of enemies
+     *  \param result : vector filled with the positions
+     *  \return number of enemies found
+     */
+    int getKNearest(float x, float y, int k, std::vector<Vector2D>& result);
+
+    /*!
+     *  \brief returns the position of the nearest enemy in a cone
+     *  \param x : x position of the source
+     *  \param y : y position of the source
+     *  \param dirX : x component of the cone direction
+     *  \param dirY : y component of the cone direction
+     *  \param halfAngle : half angle of the cone (radians)
+     *  \param maxDistance : max distance of the enemy (0 = no limit)
+     *  \return position of the nearest enemy (negative position when no enemy found)
+     */
+    Vector2D getNearestInCone(float x, float y, float dirX, float dirY, float halfAngle, float maxDistance = 0.0f);
+
+    int getTargetCount();
+
+  private:
+    struct targetStruct
+    {
+      float x;
+      float y;
+    };
+
+    static const int CELLS = MAP_WIDTH * MAP_HEIGHT;
+
+    std::vector<targetStruct> targets;  /*!< targets sorted by cell */
+    std::vector<int> targetCell;        /*!< temporary cell of each target while building */
+    int cellStart[CELLS + 1];           /*!< first target of each cell in targets */
+    bool isBuilt;
+
+    void checkBuilt();
+    int getCellX(float x);
+    int getCellY(float y);
+
+    /*!
+     *  \brief lowest possible distance between the source and a cell of the given ring
+     */
+    float getRingDistance(int ring);
+};
+
+#endif // ENEMYTARGETINDEX_H
@@ -312,7 +312,7 @@ void FairyEntity::fire(int dir, bool bySelf)
 
       if (fairyType == FamiliarFairyTarget)
       {
-        Vector2D target = game().getNearestEnemy(x, y);
+        Vector2D target = getTarget(dir);
         if (target.x > -1.0f)
         {
           bolt->setVelocity(Vector2D(x, y).vectorTo(target, FAIRY_BOLT_VELOCITY));
@@ -335,7 +335,7 @@ void FairyEntity::fire(int dir, bool bySelf)
   {
     if (fairyType == FamiliarFairyTarget)
     {
-      Vector2D target = game().getNearestEnemy(x, y);
+      Vector2D target = getTarget();
       if (target.x > -1.0f)
       {
         if ((target.x - x) * (target.x - x) > (target.y - y) *(target.y - y))
@@ -365,7 +365,7 @@ void FairyEntity::tryToFire()
   {
     if (fairyType == FamiliarFairyTarget)
     {
-      Vector2D target = game().getNearestEnemy(x, y);
+      Vector2D target = getTarget();
       if (target.x > -1.0f)
       {
         BoltEntity* bolt = new BoltEntity(x, y, FAIRY_BOLT_LIFE, shotType, shotLevel);
@@ -397,7 +397,7 @@ void FairyEntity::tryToFire()
   {
     if (fairyType == FamiliarFairyTarget)
     {
-      Vector2D target = game().getNearestEnemy(x, y);
+      Vector2D target = getTarget();
       if (target.x > -1.0f)
       {
         if ((target.x - x) * (target.x - x) > (target.y - y) *(target.y - y))
@@ -416,6 +416,35 @@ void FairyEntity::tryToFire()
   }
 }
 
+Vector2D FairyEntity::getTarget(int dir)
+{
+  // aimed shot: the nearest enemy in front of the fairy
+  if (dir == 4 || dir == 6 || dir == 2 || dir == 8)
+  {
+    Vector2D direction(dir == 4 ? -1.0f : dir == 6 ? 1.0f : 0.0f, dir == 8 ? -1.0f : dir == 2 ? 1.0f : 0.0f);
+    Vector2D target = game().getNearestEnemyInCone(x, y, direction, FAIRY_AIM_HALF_ANGLE);
+    if (target.x > -1.0f) return target;
+  }
+
+  // rank of the fairy among the target fairies
+  int rank = 0;
+  if (parentEntity != NULL)
+  {
+    for (int i = 0; i < parentEntity->getFairieNumber(); i++)
+    {
+      FairyEntity* fairy = parentEntity->getFairy(i);
+      if (fairy == this) break;
+      if (fairy->fairyType == FamiliarFairyTarget) rank++;
+    }
+  }
+  if (rank == 0) return game().getNearestEnemy(x, y);
+
+  // fewer enemies than fairies: the farthest one
+  game().getNearestEnemies(x, y, rank + 1, nearestEnemies);
+  if (nearestEnemies.empty()) return Vector2D(-100.0f, -100.0f);
+  return nearestEnemies[rank < (int)nearestEnemies.size() ? rank : nearestEnemies.size() - 1];
+}
+
 void FairyEntity::computeFacingDirection()
 {
   if (isFiring)
@@ -64,6 +64,16 @@ class FairyEntity : public SpriteEntity
 
     void tryToFire();
 
+    /*!
+     *  \brief target of a target fairy
+     *
+     *  The target fairies spread over the nearest enemies: the n-th one aims at the n-th nearest.
+     *  \param dir : fire direction (the nearest enemy in its cone first), 0 = any direction
+     *  \return position of the target (negative position when no enemy found)
+     */
+    Vector2D getTarget(int dir = 0);
+    std::vector<Vector2D> nearestEnemies;
+
     // Multiplayer
     bool power[LAST_POWER_UP];
 
@@ -59,6 +59,40 @@ void FranckyEntity::animate(float delay)
 
   // IA
   timer -= delay;
+  if (state == 0) followTimer -= delay;
+  if (timer < 0.0f || (state == 0 && followTimer <= 0.0f)) promoteThink();
+  updateThink(delay);
+
+  if (state != 0) SoundManager::getInstance().playSound(SOUND_ELECTRICITY, false);
+
+  // collisions
+  if (canCollide()) testSpriteCollisions();
+  BaseCreatureEntity::animate(delay);
+
+  // current frame
+  if (state == 0)
+  {
+    int r = ((int)(age * 5.0f)) % 4;
+    if (r == 2) frame = 0;
+    else if (r == 3) frame = 2;
+    else frame = r;
+
+    // frame's mirroring
+    if (velocity.x > 1.0f)
+      isMirroring = true;
+    else if (velocity.x < -1.0f)
+      isMirroring = false;
+  }
+  else
+  {
+    frame =  3 +((int)(age * 7.0f)) % 2;
+    isMirroring = game().getPlayer()->getX() > x;
+  }
+  z = y + 36;
+}
+
+void FranckyEntity::think(float delay)
+{
   if (timer < 0.0f)
   {
     state++;
@@ -91,45 +125,12 @@ void FranckyEntity::animate(float delay)
     }
   }
 
-  if (state == 0)
+  if (state == 0 && followTimer <= 0.0f)
   {
     // walking
-    followTimer -= delay;
-    if (followTimer <= 0.0f)
-    {
-      setVelocity(Vector2D(x, y).vectorTo(game().getPlayerPosition(), creatureSpeed ));
-      followTimer = 0.25f;
-    }
-  }
-  else
-  {
-    SoundManager::getInstance().playSound(SOUND_ELECTRICITY, false);
-  }
-
-  // collisions
-  if (canCollide()) testSpriteCollisions();
-  BaseCreatureEntity::animate(delay);
-
-  // current frame
-  if (state == 0)
-  {
-    int r = ((int)(age * 5.0f)) % 4;
-    if (r == 2) frame = 0;
-    else if (r == 3) frame = 2;
-    else frame = r;
-
-    // frame's mirroring
-    if (velocity.x > 1.0f)
-      isMirroring = true;
-    else if (velocity.x < -1.0f)
-      isMirroring = false;
+    setVelocity(Vector2D(x, y).vectorTo(game().getPlayerPosition(), creatureSpeed ));
+    followTimer = 0.25f;
   }
-  else
-  {
-    frame =  3 +((int)(age * 7.0f)) % 2;
-    isMirroring = game().getPlayer()->getX() > x;
-  }
-  z = y + 36;
 }
 
 void FranckyEntity::calculateBB()
@@ -21,6 +21,7 @@ class FranckyEntity : public EnemyEntity
 	  virtual void collideWithEnemy(EnemyEntity* entity) override;
 	  virtual void dying();
 	  virtual void drop();
+    virtual void think(float delay) override;
 
   private:
     float timer;
@@ -86,6 +86,15 @@ DungeonMap* GameFloor::getAndVisitMap(int x, int y)
   return maps[x][y];
 }
 
+int GameFloor::getMemorySize()
+{
+  int size = sizeof(GameFloor);
+  for (int i=0; i < FLOOR_WIDTH; i++)
+    for (int j=0; j < FLOOR_HEIGHT; j++)
+      if (maps[i][j] != NULL) size += maps[i][j]->getMemorySize();
+  return size;
+}
+
 void GameFloor::displayToConsole()
 {
   for (int j=0; j < FLOOR_HEIGHT; j++)
@@ -47,6 +47,11 @@ class GameFloor
 
     int neighboorCount(int x, int y);
 
+    /*!
+     *  \brief returns the memory used by the floor and its rooms (bytes)
+     */
+    int getMemorySize();
+
     /*!
      *  \brief feveals the entire floor map
      */
@@ -162,77 +162,8 @@ void GiantSlimeEntity::animate(float delay)
   if (specialState[SpecialStateIce].active) delay *= specialState[SpecialStateIce].param1;
 
   timer -= delay;
-  if (timer <= 0.0f)
-  {
-    if (state == 0) // walking
-    {
-      counter--;
-      if (counter >= 0)
-      {
-        timer = 0.5f;
-        if (hp <= hpMax / 4)
-          creatureSpeed = GIANT_SLIME_SPEED * 1.4f;
-        if (hp <= hpMax / 2)
-          creatureSpeed = GIANT_SLIME_SPEED * 1.2f;
-        else
-          creatureSpeed = GIANT_SLIME_SPEED;
-
-        setVelocity(Vector2D(x, y).vectorTo(game().getPlayerPosition(), GIANT_SLIME_SPEED ));
-      }
-      else
-      {
-        int r = rand() % 3;
-        if (r == 0) changeToState(1);
-        else if (r == 1) changeToState(3);
-        else changeToState(5);
-      }
-    }
-    else if (state == 1) // waiting for jumping
-    {
-      changeToState(2);
-    }
-    else if (state == 2) // jumping
-    {
-      changeToState(8);
-    }
-    else if (state == 3)
-    {
-      changeToState(4);
-    }
-    else if (state == 4) // walking
-    {
-      counter--;
-      if (counter >= 0)
-      {
-        if (hp <= hpMax / 4)
-          timer = missileDelay * 0.6f;
-        if (hp <= hpMax / 2)
-          timer = missileDelay * 0.8f;
-        else
-          timer = missileDelay;
-        fire();
-      }
-      else
-      {
-        changeToState(8);
-      }
-    }
-    else if (state == 5)
-    {
-      changeToState(6);
-    }
-    else if (state == 6)  // jump
-    {
-      changeToState(7); // fall
-    }
-    else if (state == 7)  // jump
-    {
-    }
-    else if (state == 8)  // jump
-    {
-      changeToState(0); // fall
-    }
-  }
+  if (timer <= 0.0f) promoteThink();
+  updateThink(delay);
 
   if (state == 0) // walking
   {
@@ -331,6 +262,81 @@ void GiantSlimeEntity::animate(float delay)
   z = y + 26;
 }
 
+void GiantSlimeEntity::think(float delay)
+{
+  if (timer <= 0.0f)
+  {
+    if (state == 0) // walking
+    {
+      counter--;
+      if (counter >= 0)
+      {
+        timer = 0.5f;
+        if (hp <= hpMax / 4)
+          creatureSpeed = GIANT_SLIME_SPEED * 1.4f;
+        if (hp <= hpMax / 2)
+          creatureSpeed = GIANT_SLIME_SPEED * 1.2f;
+        else
+          creatureSpeed = GIANT_SLIME_SPEED;
+
+        setVelocity(Vector2D(x, y).vectorTo(game().getPlayerPosition(), GIANT_SLIME_SPEED ));
+      }
+      else
+      {
+        int r = rand() % 3;
+        if (r == 0) changeToState(1);
+        else if (r == 1) changeToState(3);
+        else changeToState(5);
+      }
+    }
+    else if (state == 1) // waiting for jumping
+    {
+      changeToState(2);
+    }
+    else if (state == 2) // jumping
+    {
+      changeToState(8);
+    }
+    else if (state == 3)
+    {
+      changeToState(4);
+    }
+    else if (state == 4) // walking
+    {
+      counter--;
+      if (counter >= 0)
+      {
+        if (hp <= hpMax / 4)
+          timer = missileDelay * 0.6f;
+        if (hp <= hpMax / 2)
+          timer = missileDelay * 0.8f;
+        else
+          timer = missileDelay;
+        fire();
+      }
+      else
+      {
+        changeToState(8);
+      }
+    }
+    else if (state == 5)
+    {
+      changeToState(6);
+    }
+    else if (state == 6)  // jump
+    {
+      changeToState(7); // fall
+    }
+    else if (state == 7)  // jump
+    {
+    }
+    else if (state == 8)  // jump
+    {
+      changeToState(0); // fall
+    }
+  }
+}
+
 void GiantSlimeEntity::calculateBB()
 {
   boundingBox.left = (int)x - width / 2 + GIANT_SLIME_BB_LEFT;
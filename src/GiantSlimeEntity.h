@@ -27,6 +27,7 @@ class GiantSlimeEntity : public EnemyEntity
 	  virtual void dying();
 
 	  virtual enumMovingStyle getMovingStyle();
+    virtual void think(float delay) override;
 
   private:
     float timer;
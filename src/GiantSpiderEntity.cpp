@@ -77,13 +77,6 @@ void GiantSpiderEntity::animate(float delay)
     else if (state == 1) // wait after falling
     {
       timer -= delay;
-      if (timer <= 0.0f)
-      {
-        state = 2;
-        velocity = Vector2D(creatureSpeed);
-        timer = 10.0f;
-        fireDelay = 0.5f;
-      }
     }
     else if (state == 2) // moving
     {
@@ -94,37 +87,11 @@ void GiantSpiderEntity::animate(float delay)
         SoundManager::getInstance().playSound(SOUND_SPIDER_WALKING);
       }
       fireDelay -= delay;
-      if (fireDelay <= 0.0f)
-      {
-        if (rand() % 12 == 0)
-        {
-          SoundManager::getInstance().playSound(SOUND_SPIDER_WEB);
-          for (int i = 0; i < 3; i++) new SpiderWebEntity(x, y, false);
-        }
-        else
-        {
-          for (int i = 0; i < 4; i++) fire(i == 0 ? 1 : 0);
-        }
-
-        fireDelay = GIANT_SPIDER_FIRE_DELAY[hurtLevel];
-      }
-
       timer -= delay;
-
-      if (getHealthLevel() > hurtLevel)
-      {
-        hurtLevel++;
-        state = 3;
-        velocity = Vector2D(0.0f, 0.0f);
-        timer = 1.0f;
-        creatureSpeed = GIANT_SPIDER_SPEED[hurtLevel];
-        SoundManager::getInstance().playSound(SOUND_SPIDER_HURT);
-      }
     }
     else if (state == 3) // wait after falling
     {
       timer -= delay;
-      if (timer <= 0.0f) state = 4;
     }
     else if (state == 4) // moving up
     {
@@ -143,10 +110,12 @@ void GiantSpiderEntity::animate(float delay)
     else if (state == 5) // waiting to fall
     {
       timer -= delay;
-      if (timer <= 0.0f)
-        state = 0;
     }
 
+    if (((state == 1 || state == 3 || state == 5) && timer <= 0.0f) || (state == 2 && fireDelay <= 0.0f))
+      promoteThink();
+    updateThink(delay);
+
     // frame
     frame = 0;
     if (state == 2)
@@ -161,6 +130,55 @@ void GiantSpiderEntity::animate(float delay)
   z = y + 40;
 }
 
+void GiantSpiderEntity::think(float delay)
+{
+  if (state == 1) // wait after falling
+  {
+    if (timer <= 0.0f)
+    {
+      state = 2;
+      velocity = Vector2D(creatureSpeed);
+      timer = 10.0f;
+      fireDelay = 0.5f;
+    }
+  }
+  else if (state == 2) // moving
+  {
+    if (fireDelay <= 0.0f)
+    {
+      if (rand() % 12 == 0)
+      {
+        SoundManager::getInstance().playSound(SOUND_SPIDER_WEB);
+        for (int i = 0; i < 3; i++) new SpiderWebEntity(x, y, false);
+      }
+      else
+      {
+        for (int i = 0; i < 4; i++) fire(i == 0 ? 1 : 0);
+      }
+
+      fireDelay = GIANT_SPIDER_FIRE_DELAY[hurtLevel];
+    }
+
+    if (getHealthLevel() > hurtLevel)
+    {
+      hurtLevel++;
+      state = 3;
+      velocity = Vector2D(0.0f, 0.0f);
+      timer = 1.0f;
+      creatureSpeed = GIANT_SPIDER_SPEED[hurtLevel];
+      SoundManager::getInstance().playSound(SOUND_SPIDER_HURT);
+    }
+  }
+  else if (state == 3) // wait after falling
+  {
+    if (timer <= 0.0f) state = 4;
+  }
+  else if (state == 5) // waiting to fall
+  {
+    if (timer <= 0.0f) state = 0;
+  }
+}
+
 int GiantSpiderEntity::hurt(StructHurt hurtParam)
 {
   if (hurtLevel < getHealthLevel()) hurtParam.damage /= 5;
@@ -21,6 +21,7 @@ class GiantSpiderEntity : public EnemyEntity
     virtual void collideWithEnemy(EnemyEntity* entity) override;
     virtual int hurt(StructHurt hurtParam) override;
     virtual void drop();
+    virtual void think(float delay) override;
 
     int getHealthLevel();
   private:
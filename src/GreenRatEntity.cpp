@@ -31,6 +31,7 @@ GreenRatEntity::GreenRatEntity(float x, float y)
   sprite.setOrigin(32.0f, 38.0f);
 
   canExplode = false; // TO SEE
+  hasThinkStep = true;
 }
 
 void GreenRatEntity::animate(float delay)
@@ -42,13 +43,6 @@ void GreenRatEntity::animate(float delay)
     sprite.setColor(sf::Color(255,255,255,255));
 
     timer = timer - delay;
-    if (timer <= 0.0f)
-    {
-      timer = (rand() % 50) / 10.0f;
-
-      setVelocity(Vector2D(x, y).vectorTo(game().getPlayerPosition(), GREEN_RAT_SPEED ));
-      computeFacingDirection();
-    }
 
     frame = 8 + ((int)(age * 5.0f)) % 2;
     if (facingDirection == 4 || facingDirection == 6) frame += 2;
@@ -81,6 +75,16 @@ void GreenRatEntity::animate(float delay)
   z = y + 17;
 }
 
+void GreenRatEntity::think(float delay)
+{
+  if (timer > 0.0f) return;
+
+  timer = (rand() % 50) / 10.0f;
+
+  setVelocity(Vector2D(x, y).vectorTo(game().getPlayerPosition(), GREEN_RAT_SPEED ));
+  computeFacingDirection();
+}
+
 void GreenRatEntity::calculateBB()
 {
   boundingBox.left = (int)x - width / 2 + RAT_BB_LEFT;
@@ -9,6 +9,7 @@ class GreenRatEntity : public EnemyEntity
   public:
     GreenRatEntity(float x, float y);
     virtual void animate(float delay);
+    virtual void think(float delay) override;
     virtual void calculateBB();
   protected:
     virtual void collideMapRight();
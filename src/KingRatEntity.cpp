@@ -78,21 +78,12 @@ void KingRatEntity::animate(float delay)
   EnemyEntity::animate(delay);
   if (specialState[SpecialStateIce].active) delay *= specialState[SpecialStateIce].param1;
 
-  float timerMult = 1.0f;
   if (hp <= hpMax / 4)
-  {
     creatureSpeed = KING_RAT_SPEED * 1.4f;
-    timerMult = 0.7f;
-  }
   else if (hp <= hpMax / 2)
-  {
     creatureSpeed = KING_RAT_SPEED * 1.2f;
-    timerMult = 0.85f;
-  }
   else
-  {
     creatureSpeed = KING_RAT_SPEED;
-  }
 
   if (state == 5)
   {
@@ -108,6 +99,50 @@ void KingRatEntity::animate(float delay)
 
 
   timer -= delay;
+  if (state == 6) berserkDelay -= delay;
+  if (timer <= 0.0f || (state == 6 && berserkDelay <= 0.0f)) promoteThink();
+  updateThink(delay);
+
+  frame = 0;
+
+  if (state == 1)
+    frame = 3;
+  else if (state == 3 || state == 6)
+  {
+    frame = 3; //0;
+    int r = ((int)(age * 10.0f)) % 2;
+    if (r == 0)
+      sprite.setScale(-1.0f, 1.0f);
+    else
+      sprite.setScale(1.0f, 1.0f);
+  }
+  else if (state == 4)
+  {
+    int r = ((int)(age * 7.5f)) % 4;
+    if (r == 1) frame = 1;
+    else if (r == 3) frame = 2;
+  }
+  else if (state == 5)
+  {
+    frame = 0;
+  }
+  else
+  {
+    int r = ((int)(age * 5.0f)) % 4;
+    if (r == 1) frame = 1;
+    else if (r == 3) frame = 2;
+  }
+
+  z = y + 48;
+}
+
+void KingRatEntity::think(float delay)
+{
+  float timerMult = 1.0f;
+  if (hp <= hpMax / 4)
+    timerMult = 0.7f;
+  else if (hp <= hpMax / 2)
+    timerMult = 0.85f;
 
   if (timer <= 0.0f)
   {
@@ -196,50 +231,13 @@ void KingRatEntity::animate(float delay)
     }
   }
 
-  if (state == 6)
+  if (state == 6 && berserkDelay <= 0.0f)
   {
-    berserkDelay -= delay;
+    berserkDelay = 0.6f + (rand()%10) / 20.0f;
+    SoundManager::getInstance().playSound(SOUND_KING_RAT_2);
 
-    if (berserkDelay <= 0.0f)
-    {
-      berserkDelay = 0.6f + (rand()%10) / 20.0f;
-      SoundManager::getInstance().playSound(SOUND_KING_RAT_2);
-
-      setVelocity(Vector2D(x, y).vectorTo(game().getPlayerPosition(),KING_RAT_BERSERK_SPEED ));
-    }
+    setVelocity(Vector2D(x, y).vectorTo(game().getPlayerPosition(),KING_RAT_BERSERK_SPEED ));
   }
-
-  frame = 0;
-
-  if (state == 1)
-    frame = 3;
-  else if (state == 3 || state == 6)
-  {
-    frame = 3; //0;
-    int r = ((int)(age * 10.0f)) % 2;
-    if (r == 0)
-      sprite.setScale(-1.0f, 1.0f);
-    else
-      sprite.setScale(1.0f, 1.0f);
-  }
-  else if (state == 4)
-  {
-    int r = ((int)(age * 7.5f)) % 4;
-    if (r == 1) frame = 1;
-    else if (r == 3) frame = 2;
-  }
-  else if (state == 5)
-  {
-    frame = 0;
-  }
-  else
-  {
-    int r = ((int)(age * 5.0f)) % 4;
-    if (r == 1) frame = 1;
-    else if (r == 3) frame = 2;
-  }
-
-  z = y + 48;
 }
 
 int KingRatEntity::hurt(StructHurt hurtParam)
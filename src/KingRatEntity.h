@@ -24,6 +24,7 @@ class KingRatEntity : public EnemyEntity
 
 	  virtual void collideWithEnemy(EnemyEntity* entity) override;
 	  virtual void drop();
+    virtual void think(float delay) override;
   private:
     float timer;
     float berserkDelay;
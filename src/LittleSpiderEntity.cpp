@@ -54,6 +54,7 @@ LittleSpiderEntity::LittleSpiderEntity(float x, float y, EnumSpiderType spideTyp
 
   resistance[ResistancePoison] = ResistanceImmune;
   roaming = true;
+  hasThinkStep = true;
 }
 
 void LittleSpiderEntity::animate(float delay)
@@ -61,12 +62,6 @@ void LittleSpiderEntity::animate(float delay)
   if (age > 0.0f && !isAgonising)
   {
     timer = timer - delay;
-    if (timer <= 0.0f)
-    {
-      timer = (rand() % 50) / 10.0f;
-      setVelocity(Vector2D(x, y).vectorTo(game().getPlayerPosition(), creatureSpeed ));
-      roaming = false;
-    }
     frame = ((int)(age * (roaming ? 1.5f : 5.0f))) % 3;
     if (spideType == SpiderTypeTarantula)
       frame += 8;
@@ -86,6 +81,15 @@ void LittleSpiderEntity::animate(float delay)
   z = y + 21;
 }
 
+void LittleSpiderEntity::think(float delay)
+{
+  if (timer > 0.0f) return;
+
+  timer = (rand() % 50) / 10.0f;
+  setVelocity(Vector2D(x, y).vectorTo(game().getPlayerPosition(), creatureSpeed ));
+  roaming = false;
+}
+
 void LittleSpiderEntity::calculateBB()
 {
     boundingBox.left = (int)x - 18;
@@ -11,6 +11,7 @@ class LittleSpiderEntity : public EnemyEntity
   public:
     LittleSpiderEntity(float x, float y, EnumSpiderType spideType, bool invocated);
     virtual void animate(float delay);
+    virtual void think(float delay) override;
     virtual void calculateBB();
   protected:
     virtual void collideMapRight();
@@ -0,0 +1,136 @@
+/**  This file is part of Witch Blast.
+  *
+  *  Witch Blast is free software: you can redistribute it and/or modify
+  *  it under the terms of the GNU General Public License as published by
+  *  the Free Software Foundation, either version 3 of the License, or
+  *  (at your option) any later version.
+  *
+  *  Witch Blast is distributed in the hope that it will be useful,
+  *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  *  GNU General Public License for more details.
+  *
+  *  You should have received a copy of the GNU General Public License
+  *  along with Witch Blast.  If not, see <http://www.gnu.org/licenses/>.
+  */
+
+#include "ParticleBudget.h"
+#include "Constants.h"
+
+#include <iostream>
+#include <sstream>
+
+ParticleBudget::ParticleBudget()
+{
+  enabled = true;
+  logEnabled = false;
+  setFrameTarget(PARTICLE_FRAME_TARGET);
+  minScale = PARTICLE_SCALE_MIN / 100.0f;
+  maxScale = PARTICLE_SCALE_MAX / 100.0f;
+  maxLiveParticles = PARTICLE_LIVE_MAX;
+
+  scale = maxScale;
+  averageFrameTime = 0.0f;
+  liveParticles = 0;
+  stepTimer = 0.0f;
+}
+
+void ParticleBudget::setEnabled(bool enabled)
+{
+  this->enabled = enabled;
+  stepTimer = 0.0f;
+}
+
+void ParticleBudget::setFrameTarget(int target)
+{
+  frameTarget = target / 1000.0f;
+}
+
+void ParticleBudget::setScaleRange(int minScale, int maxScale)
+{
+  if (maxScale < minScale) maxScale = minScale;
+  this->minScale = minScale / 100.0f;
+  this->maxScale = maxScale / 100.0f;
+
+  if (scale < this->minScale) scale = this->minScale;
+  else if (scale > this->maxScale) scale = this->maxScale;
+}
+
+void ParticleBudget::setMaxLiveParticles(int maxParticles)
+{
+  maxLiveParticles = maxParticles;
+}
+
+void ParticleBudget::setLogEnabled(bool logEnabled)
+{
+  this->logEnabled = logEnabled;
+}
+
+void ParticleBudget::update(float frameTime, float delay, int liveParticles)
+{
+  if (averageFrameTime <= 0.0f) averageFrameTime = frameTime;
+  else averageFrameTime += (frameTime - averageFrameTime) * PARTICLE_FRAME_SMOOTHING;
+  this->liveParticles = liveParticles;
+  stepTimer += delay;
+
+  if (!enabled) return;
+
+  if (averageFrameTime > frameTarget || liveParticles > maxLiveParticles)
+  {
+    if (scale > minScale && stepTimer >= PARTICLE_DOWN_DELAY) setScale(scale - PARTICLE_SCALE_STEP);
+  }
+  else if (averageFrameTime < frameTarget * PARTICLE_UP_THRESHOLD
+           && liveParticles < maxLiveParticles * PARTICLE_UP_THRESHOLD)
+  {
+    if (scale < maxScale && stepTimer >= PARTICLE_UP_DELAY) setScale(scale + PARTICLE_SCALE_STEP);
+  }
+}
+
+void ParticleBudget::setScale(float newScale)
+{
+  if (newScale < minScale) newScale = minScale;
+  else if (newScale > maxScale) newScale = maxScale;
+  scale = newScale;
+  stepTimer = 0.0f;
+
+  // a step every few frames at most: the log of a run shows how the scale followed the load
+  if (logEnabled)
+    std::cout << "Particles: scale " << (int)(scale * 100.0f + 0.5f) << "% (frame "
+              << averageFrameTime << " ms, " << liveParticles << " particles)" << std::endl;
+}
+
+float ParticleBudget::getScale()
+{
+  return enabled ? scale : 1.0f;
+}
+
+float ParticleBudget::getEmissionScale()
+{
+  return getScale();
+}
+
+float ParticleBudget::getLifetimeScale()
+{
+  // shorter lifetime under half scale: down to 0.75
+  float lifetimeScale = 0.5f + getScale();
+  return lifetimeScale > 1.0f ? 1.0f : (lifetimeScale < 0.75f ? 0.75f : lifetimeScale);
+}
+
+float ParticleBudget::getBackLayerScale()
+{
+  // the background particles go first: none from half scale
+  float backScale = 2.0f * getScale() - 1.0f;
+  return backScale > 1.0f ? 1.0f : (backScale < 0.0f ? 0.0f : backScale);
+}
+
+std::string ParticleBudget::getReport()
+{
+  std::ostringstream oss;
+  oss.setf(std::ios::fixed);
+  oss.precision(1);
+  oss << "Particles: scale " << (int)(getScale() * 100.0f + 0.5f) << "%" << (enabled ? "" : " (fixed)")
+      << ", back layer " << (int)(getBackLayerScale() * 100.0f + 0.5f) << "%, "
+      << liveParticles << " live / " << maxLiveParticles << ", frame "
+      << averageFrameTime << " ms / " << frameTarget << " ms";
+  return oss.str();
+}
@@ -0,0 +1,101 @@
+/**  This file is part of Witch Blast.
+  *
+  *  Witch Blast is free software: you can redistribute it and/or modify
+  *  it under the terms of the GNU General Public License as published by
+  *  the Free Software Foundation, either version 3 of the License, or
+  *  (at your option) any later version.
+  *
+  *  Witch Blast is distributed in the hope that it will be useful,
+  *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  *  GNU General Public License for more details.
+  *
+  *  You should have received a copy of the GNU General Public License
+  *  along with Witch Blast.  If not, see <http://www.gnu.org/licenses/>.
+  */
+
+#ifndef PARTICLEBUDGET_H
+#define PARTICLEBUDGET_H
+
+#include <string>
+
+/*! \class ParticleBudget
+* \brief Scales the emission of the bolt particles to the measured frame time
+*
+*  The busy time of the frames (without the wait for the display) is averaged. When it goes
+*  over the target, or when too many particles are alive, the scale is lowered by one step;
+*  when both are well under (PARTICLE_UP_THRESHOLD), it is raised by one step. Between the
+*  two thresholds the scale does not change, and the steps are spaced out (quick reductions,
+*  slow increases), so the scale does not oscillate.
+*  The scale reduces the number of emitted particles, then their lifetime and the "background"
+*  particles (the first to go).
+*/
+class ParticleBudget
+{
+  public:
+    ParticleBudget();
+
+    /*!
+     *  \brief enables the adaptation (disabled: full emission)
+     */
+    void setEnabled(bool enabled);
+
+    /*!
+     *  \brief sets the busy time targeted
+     *  \param target : busy time per frame (microseconds)
+     */
+    void setFrameTarget(int target);
+
+    /*!
+     *  \brief sets the floor and the ceiling of the scale
+     *  \param minScale : lowest scale (percent)
+     *  \param maxScale : highest scale (percent)
+     */
+    void setScaleRange(int minScale, int maxScale);
+
+    /*!
+     *  \brief sets the number of live particles above which the emission is reduced
+     */
+    void setMaxLiveParticles(int maxParticles);
+
+    /*!
+     *  \brief writes the scale steps to the standard output (disabled by default)
+     */
+    void setLogEnabled(bool logEnabled);
+
+    /*!
+     *  \brief updates the scale (once per frame)
+     *  \param frameTime : busy time of the last frame (ms)
+     *  \param delay : duration of the last frame (s)
+     *  \param liveParticles : particles alive
+     */
+    void update(float frameTime, float delay, int liveParticles);
+
+    float getScale();
+    float getEmissionScale();
+    float getLifetimeScale();
+
+    /*!
+     *  \brief returns the part of the "background" particles emitted (0 to 1)
+     */
+    float getBackLayerScale();
+
+    std::string getReport();
+
+  private:
+    bool enabled;
+    bool logEnabled;
+    float frameTarget;      /**< ms */
+    float minScale;
+    float maxScale;
+    int maxLiveParticles;
+
+    float scale;
+    float averageFrameTime; /**< ms */
+    int liveParticles;
+    float stepTimer;        /**< time since the last step (s) */
+
+    void setScale(float newScale);
+};
+
+#endif // PARTICLEBUDGET_H
@@ -14,10 +14,16 @@ ParticleGenerator::ParticleGenerator()
 , sizeDistribution(std::uniform_int_distribution<>(10, 20))
 , colorDistribution(std::uniform_int_distribution<>(0, 20))
 , dice6Distribution(std::uniform_int_distribution<>(0,6))
+, unitDistribution(std::uniform_real_distribution<float>(0.0f, 1.0f))
+, emissionRemainder(0.0f)
 {}
 
 void ParticleGenerator::GenerateParticles(int frame, int imageId, float posX, float posY, int width, int height, const Vector2D & velocity, int nOfParticles, float scale)
 {
+	// adaptive budget: the fractions of particles add up over the frames
+	float emission = nOfParticles * game().getParticleBudget()->getEmissionScale() + emissionRemainder;
+	nOfParticles = (int)emission;
+	emissionRemainder = emission - nOfParticles;
 
 	for (int i = 0; i < nOfParticles; ++i)
 	{
@@ -64,12 +70,16 @@ void ParticleGenerator::GenerateBoltParticle(int frame, const Vector2D & velocit
 
     // low particles -> lifetime / 2
     if (game().getParameters().lowParticles) lifeTime *= 0.5f;
+    lifeTime *= game().getParticleBudget()->getLifetimeScale();
+
+    // the background particles are the first to go
+    bool backParticle = frame != 2 && unitDistribution(randomGenerator) < game().getParticleBudget()->getBackLayerScale();
 
     if (game().getParameters().particlesBatching)
     {
       // "background" particle
       // not for ice shots
-      if (frame != 2)
+      if (backParticle)
         game().getCurrentMapEntity()->generateBoltParticle(posX, posY, velocity, true, BOLT_PRO_LINE + frame, particleScale, lifeTime);
 
       // "blend" particle
@@ -81,7 +91,7 @@ void ParticleGenerator::GenerateBoltParticle(int frame, const Vector2D & velocit
     {
       // "background" particle
       // not for ice shots
-      if (frame != 2)
+      if (backParticle)
       {
         SpriteEntity* particle = new SpriteEntity(ImageManager::getInstance().getImage(IMAGE_BOLT), posX, posY, BOLT_WIDTH, BOLT_HEIGHT);
         particle->setFading(true);
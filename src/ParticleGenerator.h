@@ -30,6 +30,9 @@ private:
 	std::uniform_int_distribution<> sizeDistribution;
 	std::uniform_int_distribution<> colorDistribution;
 	std::uniform_int_distribution<> dice6Distribution;
+	std::uniform_real_distribution<float> unitDistribution;
+
+	float emissionRemainder;	// part of a particle not emitted yet (scaled emission)
 
 };
 
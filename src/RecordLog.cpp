@@ -0,0 +1,309 @@
+/**  This file is part of Witch Blast.
+  *
+  *  Witch Blast is free software: you can redistribute it and/or modify
+  *  it under the terms of the GNU General Public License as published by
+  *  the Free Software Foundation, either version 3 of the License, or
+  *  (at your option) any later version.
+  *
+  *  Witch Blast is distributed in the hope that it will be useful,
+  *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  *  GNU General Public License for more details.
+  *
+  *  You should have received a copy of the GNU General Public License
+  *  along with Witch Blast.  If not, see <http://www.gnu.org/licenses/>.
+  */
+
+#include "RecordLog.h"
+
+#include <iostream>
+#include <sstream>
+#include <algorithm>
+#include <set>
+#include <cstdio>
+#include <ctime>
+
+RecordLog::RecordLog()
+{
+  topSize = 10;
+  recordCount = 0;
+  currentDay = getDay();
+  readOnly = false;
+}
+
+RecordLog::~RecordLog()
+{
+  if (file.is_open()) file.close();
+}
+
+int RecordLog::getDay()
+{
+  time_t now = time(NULL);
+  struct tm* localNow = localtime(&now);
+  return (localNow->tm_year + 1900) * 1000 + localNow->tm_yday;
+}
+
+bool RecordLog::open(const std::string& fileName, int topSize)
+{
+  this->fileName = fileName;
+  this->topSize = topSize;
+  if (file.is_open()) file.close();
+
+  values.clear();
+  scoreEntries.clear();
+  allTimeHeap.clear();
+  todayHeap.clear();
+  groupHeaps.clear();
+  recordCount = 0;
+  currentDay = getDay();
+  readOnly = false;
+
+  std::string fileData;
+  std::ifstream inputFile(fileName.c_str(), std::ios::in | std::ios::binary);
+  bool exists = inputFile.is_open();
+  if (exists)
+  {
+    std::ostringstream oss;
+    oss << inputFile.rdbuf();
+    fileData = oss.str();
+    inputFile.close();
+  }
+
+  // new or empty log: the header is written by the compaction
+  bool mustCompact = !exists || fileData.empty();
+  std::size_t position = 0;
+  bool header = true;
+  while (position < fileData.size())
+  {
+    std::size_t end = fileData.find('\n', position);
+    if (end == std::string::npos)
+    {
+      // record torn by a crash
+      mustCompact = true;
+      break;
+    }
+    std::istringstream line(fileData.substr(position, end - position));
+    position = end + 1;
+
+    std::string type;
+    line >> type;
+    if (header)
+    {
+      int version = 0;
+      line >> version;
+      if (type != "WBLOG" || version > RECORD_LOG_VERSION)
+      {
+        // never rewritten: kept aside, and a new log is started
+        std::string backupFileName = fileName + ".bak";
+        std::cout << "[ERROR] Unknown record log format: " << fileName << " (renamed to " << backupFileName << ")" << std::endl;
+        remove(backupFileName.c_str());
+        if (rename(fileName.c_str(), backupFileName.c_str()) != 0)
+        {
+          std::cout << "[ERROR] Impossible to rename record log, nothing will be written: " << fileName << std::endl;
+          readOnly = true;
+          return exists;
+        }
+        mustCompact = true;
+        break;
+      }
+      header = false;
+    }
+    else if (type == "V")
+    {
+      std::string key;
+      int value;
+      if (line >> key >> value) values[key] = value;
+      recordCount++;
+    }
+    else if (type == "S")
+    {
+      scoreEntryStruct entry;
+      if (line >> entry.day >> entry.group >> entry.score)
+      {
+        line.get();
+        std::getline(line, entry.data);
+        scoreEntries.push_back(entry);
+        insertScore(scoreEntries.size() - 1);
+      }
+      recordCount++;
+    }
+  }
+
+  if (mustCompact)
+    compact();
+  else
+  {
+    file.open(fileName.c_str(), std::ios::out | std::ios::app | std::ios::binary);
+    checkCompaction();
+  }
+
+  if (!file.is_open()) std::cout << "[ERROR] Impossible to open record log: " << fileName << std::endl;
+  return exists;
+}
+
+void RecordLog::appendLine(const std::string& line)
+{
+  if (file.is_open())
+  {
+    file << line << '\n';
+    file.flush();
+  }
+  recordCount++;
+  checkCompaction();
+}
+
+void RecordLog::setValue(const std::string& key, int value)
+{
+  std::map<std::string, int>::iterator it = values.find(key);
+  if (it != values.end() && it->second == value) return;
+  values[key] = value;
+
+  std::ostringstream oss;
+  oss << "V " << key << " " << value;
+  appendLine(oss.str());
+}
+
+bool RecordLog::getValue(const std::string& key, int& value)
+{
+  std::map<std::string, int>::iterator it = values.find(key);
+  if (it == values.end()) return false;
+  value = it->second;
+  return true;
+}
+
+void RecordLog::addScore(int score, int group, const std::string& data, int day)
+{
+  checkDay();
+
+  scoreEntryStruct entry;
+  entry.day = (day == -1) ? currentDay : day;
+  entry.group = group;
+  entry.score = score;
+  entry.data = data;
+  scoreEntries.push_back(entry);
+  insertScore(scoreEntries.size() - 1);
+
+  std::ostringstream oss;
+  oss << "S " << entry.day << " " << entry.group << " " << entry.score << " " << entry.data;
+  appendLine(oss.str());
+}
+
+void RecordLog::insertScore(int index)
+{
+  const scoreEntryStruct& entry = scoreEntries[index];
+  pushHeap(allTimeHeap, index);
+  pushHeap(groupHeaps[entry.group], index);
+  if (entry.day == currentDay) pushHeap(todayHeap, index);
+}
+
+bool RecordLog::isBetterScore(int a, int b) const
+{
+  // better score first, the older one if equal
+  return scoreEntries[a].score > scoreEntries[b].score
+         || (scoreEntries[a].score == scoreEntries[b].score && a < b);
+}
+
+void RecordLog::pushHeap(scoreHeap& heap, int index)
+{
+  // the worst entry is on top of the heap
+  auto better = [this](int a, int b) { return isBetterScore(a, b); };
+
+  if ((int)heap.size() < topSize)
+  {
+    heap.push_back(index);
+    std::push_heap(heap.begin(), heap.end(), better);
+  }
+  else if (topSize > 0 && better(index, heap.front()))
+  {
+    std::pop_heap(heap.begin(), heap.end(), better);
+    heap.back() = index;
+    std::push_heap(heap.begin(), heap.end(), better);
+  }
+}
+
+void RecordLog::checkDay()
+{
+  int day = getDay();
+  if (day == currentDay) return;
+
+  currentDay = day;
+  todayHeap.clear();
+  for (unsigned int i = 0; i < scoreEntries.size(); i++)
+    if (scoreEntries[i].day == currentDay) pushHeap(todayHeap, i);
+}
+
+void RecordLog::getTopScores(scoreCategoryEnum category, int group, std::vector<std::string>& data)
+{
+  data.clear();
+  checkDay();
+
+  scoreHeap top;
+  if (category == ScoreCategoryAllTime) top = allTimeHeap;
+  else if (category == ScoreCategoryToday) top = todayHeap;
+  else
+  {
+    std::map<int, scoreHeap>::iterator it = groupHeaps.find(group);
+    if (it != groupHeaps.end()) top = it->second;
+  }
+
+  // at most topSize entries
+  std::sort(top.begin(), top.end(), [this](int a, int b) { return isBetterScore(a, b); });
+  for (int index : top) data.push_back(scoreEntries[index].data);
+}
+
+void RecordLog::checkCompaction()
+{
+  // live records: the values and the scores of the top lists
+  int liveScores = std::min((int)scoreEntries.size(), topSize * (2 + (int)groupHeaps.size()));
+  if (recordCount > 2 * ((int)values.size() + liveScores) + RECORD_LOG_COMPACTION_SLACK)
+    compact();
+}
+
+void RecordLog::compact()
+{
+  if (readOnly) return;
+  if (file.is_open()) file.close();
+  checkDay();
+
+  // the scores of the top lists (in their order in the log)
+  std::set<int> kept(allTimeHeap.begin(), allTimeHeap.end());
+  kept.insert(todayHeap.begin(), todayHeap.end());
+  for (auto& heap : groupHeaps) kept.insert(heap.second.begin(), heap.second.end());
+
+  std::vector<scoreEntryStruct> oldEntries;
+  oldEntries.swap(scoreEntries);
+  allTimeHeap.clear();
+  todayHeap.clear();
+  groupHeaps.clear();
+  for (int index : kept)
+  {
+    scoreEntries.push_back(oldEntries[index]);
+    insertScore(scoreEntries.size() - 1);
+  }
+
+  std::ostringstream oss;
+  oss << "WBLOG " << RECORD_LOG_VERSION << '\n';
+  for (auto& value : values)
+    oss << "V " << value.first << " " << value.second << '\n';
+  for (auto& entry : scoreEntries)
+    oss << "S " << entry.day << " " << entry.group << " " << entry.score << " " << entry.data << '\n';
+  recordCount = values.size() + scoreEntries.size();
+
+  // written to a temporary file and renamed: a crash never loses the log
+  std::string tmpFileName = fileName + ".tmp";
+  std::ofstream tmpFile(tmpFileName.c_str(), std::ios::out | std::ios::trunc | std::ios::binary);
+  tmpFile << oss.str();
+  tmpFile.close();
+  if (tmpFile)
+  {
+    // rename does not replace an existing file on every platform
+    if (rename(tmpFileName.c_str(), fileName.c_str()) != 0)
+    {
+      remove(fileName.c_str());
+      if (rename(tmpFileName.c_str(), fileName.c_str()) != 0)
+        std::cout << "[ERROR] Compacting record log: " << fileName << std::endl;
+    }
+  }
+
+  file.open(fileName.c_str(), std::ios::out | std::ios::app | std::ios::binary);
+}
@@ -0,0 +1,138 @@
+/**  This file is part of Witch Blast.
+  *
+  *  Witch Blast is free software: you can redistribute it and/or modify
+  *  it under the terms of the GNU General Public License as published by
+  *  the Free Software Foundation, either version 3 of the License, or
+  *  (at your option) any later version.
+  *
+  *  Witch Blast is distributed in the hope that it will be useful,
+  *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  *  GNU General Public License for more details.
+  *
+  *  You should have received a copy of the GNU General Public License
+  *  along with Witch Blast.  If not, see <http://www.gnu.org/licenses/>.
+  */
+
+#ifndef RECORDLOG_H
+#define RECORDLOG_H
+
+#include <string>
+#include <vector>
+#include <map>
+#include <fstream>
+
+/*
+ *  Record log layout (text, one record per line):
+ *
+ *  header:  "WBLOG" and the format version
+ *  values:  "V <key> <value>", the last record of a key wins
+ *  scores:  "S <day> <group> <score> <data>", data is the rest of the line
+ *
+ *  A line is only valid when it ends with a new line (a record torn by a crash is ignored).
+ *  A log of an unknown format (or of a newer version) is never rewritten: it is renamed to
+ *  "<file>.bak" and a new log is started, or it stays read-only if it can't be renamed.
+ *  When the log holds too many dead records (values written again, scores out of every
+ *  top list), it is rewritten with the live records only.
+ */
+
+const int RECORD_LOG_VERSION = 1;
+const int RECORD_LOG_COMPACTION_SLACK = 256;  // dead records allowed before a compaction
+
+/** Top lists of the scores */
+enum scoreCategoryEnum
+{
+  ScoreCategoryAllTime,   /**< every score */
+  ScoreCategoryToday,     /**< scores of the current day */
+  ScoreCategoryGroup      /**< scores of a group (shot type) */
+};
+
+/*! \class RecordLog
+* \brief Append-only store of the persistent values (statistics, achievements...) and of the scores
+*
+*  A change costs one line appended to the file. The best scores of every category are kept
+*  in bounded heaps, so adding a score is O(log n) and a top list is read without sorting
+*  the whole history.
+*/
+class RecordLog
+{
+  public:
+    RecordLog();
+    ~RecordLog();
+
+    /*!
+     *  \brief loads the log (compacted if needed) and opens it for appending
+     *  \param fileName : name of the log file
+     *  \param topSize : size of the top lists
+     *  \return false if the log did not exist (a new one is created)
+     */
+    bool open(const std::string& fileName, int topSize);
+
+    /*!
+     *  \brief sets a value (a record is appended only if the value changes)
+     */
+    void setValue(const std::string& key, int value);
+
+    /*!
+     *  \brief gets a value
+     *  \return false if the value has never been set
+     */
+    bool getValue(const std::string& key, int& value);
+
+    /*!
+     *  \brief adds a score
+     *  \param score : score (the top lists are sorted by score)
+     *  \param group : group of the score (ScoreCategoryGroup)
+     *  \param data : the details of the score (one line)
+     *  \param day : day of the score (-1: today)
+     */
+    void addScore(int score, int group, const std::string& data, int day = -1);
+
+    /*!
+     *  \brief gets a top list, best score first
+     *  \param category : category of the list
+     *  \param group : the group (only with ScoreCategoryGroup)
+     *  \param data : filled with the details of the scores
+     */
+    void getTopScores(scoreCategoryEnum category, int group, std::vector<std::string>& data);
+
+    /*!
+     *  \brief rewrites the log with the live records only
+     */
+    void compact();
+
+  private:
+    struct scoreEntryStruct
+    {
+      int day;
+      int group;
+      int score;
+      std::string data;
+    };
+
+    /** min-heap of entries (the worst score on top), bounded to topSize */
+    typedef std::vector<int> scoreHeap;
+
+    std::string fileName;
+    std::ofstream file;
+    int topSize;
+    int recordCount;
+    int currentDay;
+    bool readOnly;        // unknown log, not renamed: nothing is written
+
+    std::map<std::string, int> values;
+    std::vector<scoreEntryStruct> scoreEntries;
+    scoreHeap allTimeHeap;
+    scoreHeap todayHeap;
+    std::map<int, scoreHeap> groupHeaps;
+
+    static int getDay();
+    void appendLine(const std::string& line);
+    void insertScore(int index);
+    bool isBetterScore(int a, int b) const;
+    void pushHeap(scoreHeap& heap, int index);
+    void checkDay();
+    void checkCompaction();
+};
+
+#endif // RECORDLOG_H
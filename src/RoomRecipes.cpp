@@ -0,0 +1,936 @@
+/**  This file is part of Witch Blast.
+  *
+  *  Witch Blast is free software: you can redistribute it and/or modify
+  *  it under the terms of the GNU General Public License as published by
+  *  the Free Software Foundation, either version 3 of the License, or
+  *  (at your option) any later version.
+  *
+  *  Witch Blast is distributed in the hope that it will be useful,
+  *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  *  GNU General Public License for more details.
+  *
+  *  You should have received a copy of the GNU General Public License
+  *  along with Witch Blast.  If not, see <http://www.gnu.org/licenses/>.
+  */
+
+#include "RoomRecipes.h"
+#include "DungeonMap.h"
+
+#include <iostream>
+#include <string>
+#include <algorithm>
+#include <cstdlib>
+
+// A level table is a flat list of steps: each recipe step (weighted) is followed by
+// the spawn steps of the recipe.
+// A spawn step runs if "rand() % chanceOver < chance". An "else" step only runs when
+// no step of the current if/else chain did, and an "also" step runs with the step before it.
+
+enum roomStepEnum
+{
+  RoomStepRecipe,
+  RoomStepSpawn,
+  RoomStepSpawnElse,
+  RoomStepSpawnAlso
+};
+
+struct monsterPickStruct
+{
+  enemyTypeEnum type;
+  int weight;
+};
+
+struct roomStepStruct
+{
+  roomStepEnum step;
+
+  // recipe
+  int weight;
+  roomLayoutEnum layout;
+  int layoutType;
+  int layoutTypeRange;
+  int grids;
+
+  // spawn
+  int chance;
+  int chanceOver;
+  enemyTypeEnum type;
+  const monsterPickStruct* picks;   /**< NULL when the type is fixed */
+  int nbPicks;
+  bool pickEach;                    /**< true: pick a type for each monster, false: for the whole group */
+  int count;
+  int countRange;
+};
+
+constexpr roomStepStruct room(int weight, roomLayoutEnum layout, int layoutType, int layoutTypeRange = 0, int grids = 0)
+{
+  return roomStepStruct { RoomStepRecipe, weight, layout, layoutType, layoutTypeRange, grids,
+                          1, 1, EnemyTypeNone, NULL, 0, false, 0, 0 };
+}
+
+constexpr roomStepStruct chestRoom(int weight, bool centered)
+{
+  return room(weight, centered ? RoomLayoutChestCentered : RoomLayoutChest, 0);
+}
+
+constexpr roomStepStruct spawn(enemyTypeEnum type, int count, int countRange = 0)
+{
+  return roomStepStruct { RoomStepSpawn, 0, RoomLayoutRandom, 0, 0, 0,
+                          1, 1, type, NULL, 0, false, count, countRange };
+}
+
+template <std::size_t N>
+constexpr roomStepStruct spawnOneOf(const monsterPickStruct (&picks)[N], int count, int countRange = 0)
+{
+  return roomStepStruct { RoomStepSpawn, 0, RoomLayoutRandom, 0, 0, 0,
+                          1, 1, EnemyTypeNone, picks, N, false, count, countRange };
+}
+
+template <std::size_t N>
+constexpr roomStepStruct spawnEach(const monsterPickStruct (&picks)[N], int count, int countRange = 0)
+{
+  return roomStepStruct { RoomStepSpawn, 0, RoomLayoutRandom, 0, 0, 0,
+                          1, 1, EnemyTypeNone, picks, N, true, count, countRange };
+}
+
+constexpr roomStepStruct linkStep(roomStepEnum step, int chance, int chanceOver, roomStepStruct s)
+{
+  return roomStepStruct { step, s.weight, s.layout, s.layoutType, s.layoutTypeRange, s.grids,
+                          chance, chanceOver, s.type, s.picks, s.nbPicks, s.pickEach, s.count, s.countRange };
+}
+
+constexpr roomStepStruct chance(int chance, int chanceOver, roomStepStruct s)
+{
+  return linkStep(RoomStepSpawn, chance, chanceOver, s);
+}
+
+constexpr roomStepStruct orElse(int chance, int chanceOver, roomStepStruct s)
+{
+  return linkStep(RoomStepSpawnElse, chance, chanceOver, s);
+}
+
+constexpr roomStepStruct orElse(roomStepStruct s)
+{
+  return linkStep(RoomStepSpawnElse, 1, 1, s);
+}
+
+constexpr roomStepStruct also(roomStepStruct s)
+{
+  return linkStep(RoomStepSpawnAlso, 1, 1, s);
+}
+
+// monster picks
+
+constexpr monsterPickStruct slimePick[] =
+{
+  { EnemyTypeSlime, 2 }, { EnemyTypeSlimeBlue, 1 }, { EnemyTypeSlimeRed, 1 }, { EnemyTypeSlimeViolet, 1 }
+};
+
+constexpr monsterPickStruct slimeNoVioletPick[] =
+{
+  { EnemyTypeSlime, 3 }, { EnemyTypeSlimeBlue, 1 }, { EnemyTypeSlimeRed, 1 }
+};
+
+constexpr monsterPickStruct slimeEvenPick[] =
+{
+  { EnemyTypeSlime, 1 }, { EnemyTypeSlimeBlue, 1 }, { EnemyTypeSlimeRed, 1 }
+};
+
+constexpr monsterPickStruct slimeLargePick[] =
+{
+  { EnemyTypeSlimeLarge, 1 }, { EnemyTypeSlimeRedLarge, 1 }, { EnemyTypeSlimeBlueLarge, 1 }, { EnemyTypeSlimeVioletLarge, 1 }
+};
+
+constexpr monsterPickStruct slimeLargeNoVioletPick[] =
+{
+  { EnemyTypeSlimeLarge, 1 }, { EnemyTypeSlimeRedLarge, 1 }, { EnemyTypeSlimeBlueLarge, 1 }
+};
+
+constexpr monsterPickStruct slimeLargeRedBluePick[] =
+{
+  { EnemyTypeSlimeRedLarge, 1 }, { EnemyTypeSlimeBlueLarge, 1 }
+};
+
+constexpr monsterPickStruct snakePick[] = { { EnemyTypeSnake, 1 }, { EnemyTypeSnakeBlood, 2 } };
+constexpr monsterPickStruct snakeEvenPick[] = { { EnemyTypeSnake, 1 }, { EnemyTypeSnakeBlood, 1 } };
+constexpr monsterPickStruct witchPick[] = { { EnemyTypeWitchRed, 1 }, { EnemyTypeWitch, 1 } };
+constexpr monsterPickStruct impPick[] = { { EnemyTypeImpRed, 1 }, { EnemyTypeImpBlue, 1 } };
+constexpr monsterPickStruct flowerPick[] = { { EnemyTypeEvilFlowerIce, 1 }, { EnemyTypeEvilFlowerFire, 1 } };
+
+///////////////// STANDARD /////////////////
+
+constexpr roomStepStruct standardRooms01[] =
+{
+  room(16, RoomLayoutWithoutHoles, 0, ROOM_TYPE_CHECKER),
+    spawn(EnemyTypeRat, 2),
+  room(16, RoomLayoutWithoutHoles, 0, ROOM_TYPE_CHECKER),
+    spawn(EnemyTypeBat, 2),
+  room(16, RoomLayoutWithoutHoles, 0, ROOM_TYPE_CHECKER),
+    spawn(EnemyTypeEvilFlower, 2),
+  chestRoom(16, true),
+};
+
+constexpr roomStepStruct standardRooms02[] =
+{
+  room(16, RoomLayoutRandom, 0, ROOM_TYPE_CHECKER),
+    spawn(EnemyTypeRat, 3),
+    chance(1, 2, spawn(EnemyTypeSnake, 1)),
+    orElse(spawn(EnemyTypeBat, 2)),
+  room(16, RoomLayoutRandom, 0, ROOM_TYPE_ALL),
+    spawn(EnemyTypeBat, 3),
+    chance(1, 2, spawn(EnemyTypeSnake, 1)),
+  room(16, RoomLayoutRandom, 0, ROOM_TYPE_ALL),
+    spawn(EnemyTypeEvilFlower, 4),
+  chestRoom(16, false),
+  room(16, RoomLayoutRandom, 0, ROOM_TYPE_CHECKER),
+    spawn(EnemyTypeSnake, 4),
+  room(15, RoomLayoutRandom, ROOM_TYPE_CHECKER),
+    spawn(EnemyTypeRatBlack, 6),
+};
+
+constexpr roomStepStruct standardRooms03[] =
+{
+  room(16, RoomLayoutRandom, 0, ROOM_TYPE_CHECKER),
+    spawn(EnemyTypeRat, 4),
+    spawn(EnemyTypeRatHelmet, 2),
+  room(16, RoomLayoutRandom, 0, ROOM_TYPE_ALL),
+    spawn(EnemyTypeBat, 5),
+    chance(1, 3, spawn(EnemyTypeImpRed, 1)),
+  room(16, RoomLayoutRandom, 0, ROOM_TYPE_ALL),
+    spawn(EnemyTypeEvilFlower, 4, 2),
+    chance(1, 3, spawn(EnemyTypeImpBlue, 1)),
+    chance(1, 3, spawn(EnemyTypePumpkin, 1)),
+    chance(1, 3, spawn(EnemyTypeEvilFlowerIce, 1)),
+  chestRoom(16, false),
+  room(16, RoomLayoutRandom, 0, ROOM_TYPE_CHECKER),
+    spawnEach(snakeEvenPick, 5, 2),
+    spawn(EnemyTypeRatHelmet, 1),
+    // 1/2: imps (1/2 each), else 1/2: two snakes
+    chance(1, 8, spawn(EnemyTypeImpRed, 1)),
+    also(spawn(EnemyTypeImpBlue, 1)),
+    orElse(1, 7, spawn(EnemyTypeImpRed, 1)),
+    orElse(1, 6, spawn(EnemyTypeImpBlue, 1)),
+    orElse(2, 5, spawn(EnemyTypeSnake, 2)),
+  room(15, RoomLayoutRandom, ROOM_TYPE_CHECKER),
+    chance(1, 2, spawn(EnemyTypeRatBlack, 5)),
+    also(spawn(EnemyTypeRatBlackHelmet, 1)),
+    orElse(spawn(EnemyTypeRatBlack, 4)),
+    also(spawn(EnemyTypeRatBlackHelmet, 2)),
+  room(15, RoomLayoutWithoutHoles, 0, ROOM_TYPE_CHECKER, 4),
+    spawn(EnemyTypeSlime, 7, 5),
+    chance(1, 4, spawn(EnemyTypeSlimeBlue, 1)),
+    chance(1, 4, spawn(EnemyTypeSlimeRed, 1)),
+};
+
+constexpr roomStepStruct standardRooms04[] =
+{
+  room(16, RoomLayoutRandom, 0, ROOM_TYPE_CHECKER),
+    spawn(EnemyTypeRat, 4),
+    spawn(EnemyTypeRatHelmet, 3),
+    chance(1, 4, spawn(EnemyTypeWitch, 1)),
+    orElse(spawn(EnemyTypeSnakeBlood, 1)),
+  room(16, RoomLayoutRandom, 0, ROOM_TYPE_ALL),
+    spawn(EnemyTypeBat, 3),
+    spawnOneOf(impPick, 3),
+  room(16, RoomLayoutRandom, 0, ROOM_TYPE_ALL),
+    spawn(EnemyTypeEvilFlower, 4),
+    chance(1, 2, spawn(EnemyTypePumpkin, 2, 2)),
+    orElse(spawn(EnemyTypeImpBlue, 2)),
+    chance(1, 2, spawn(EnemyTypePumpkin, 2, 2)),
+    also(spawn(EnemyTypeEvilFlowerIce, 1, 2)),
+    orElse(spawn(EnemyTypeImpBlue, 3)),
+    also(spawn(EnemyTypeEvilFlowerFire, 1)),
+  chestRoom(16, false),
+  room(16, RoomLayoutRandom, 0, ROOM_TYPE_CHECKER),
+    spawn(EnemyTypeImpRed, 3),
+    spawn(EnemyTypeImpBlue, 3),
+    chance(1, 4, spawn(EnemyTypeWitchRed, 1)),
+  room(10, RoomLayoutRandom, 0, ROOM_TYPE_CHECKER),
+    spawnEach(snakeEvenPick, 6),
+    spawnOneOf(witchPick, 1),
+  room(10, RoomLayoutRandom, ROOM_TYPE_CHECKER),
+    spawn(EnemyTypeRatBlack, 4),
+    spawn(EnemyTypeRatBlackHelmet, 3),
+  room(5, RoomLayoutWithoutHoles, -1, 0, 4),
+    spawn(EnemyTypeSlimeLarge, 1),
+    spawnEach(slimeNoVioletPick, 3, 5),
+  room(5, RoomLayoutWithoutHoles, 0, ROOM_TYPE_CHECKER, 4),
+    spawnEach(slimeNoVioletPick, 8, 5),
+};
+
+constexpr roomStepStruct standardRooms05[] =
+{
+  room(10, RoomLayoutRandom, 0, ROOM_TYPE_CHECKER),
+    spawn(EnemyTypeRat, 3),
+    spawn(EnemyTypeRatHelmet, 4),
+    spawnOneOf(witchPick, 1),
+  room(10, RoomLayoutRandom, 0, ROOM_TYPE_ALL),
+    spawn(EnemyTypeBat, 4),
+    spawnOneOf(impPick, 4),
+  room(12, RoomLayoutWithoutHoles, 2, 2),
+    spawn(EnemyTypeWitch, 2, 2),
+    spawn(EnemyTypeWitchRed, 1, 2),
+    spawn(EnemyTypeCauldron, 1),
+  room(16, RoomLayoutRandom, 0, ROOM_TYPE_ALL),
+    spawn(EnemyTypeEvilFlower, 3),
+    chance(1, 2, spawn(EnemyTypePumpkin, 2, 4)),
+    also(spawn(EnemyTypeEvilFlowerIce, 1)),
+    orElse(spawn(EnemyTypeImpBlue, 3)),
+    also(spawn(EnemyTypeEvilFlowerFire, 1)),
+  chestRoom(16, false),
+  room(16, RoomLayoutRandom, 0, ROOM_TYPE_CHECKER),
+    chance(1, 3, spawn(EnemyTypeImpRed, 3, 2)),
+    also(spawn(EnemyTypeImpBlue, 3, 2)),
+    orElse(1, 2, spawn(EnemyTypeImpRed, 7)),
+    orElse(spawn(EnemyTypeImpBlue, 7)),
+    chance(1, 3, spawn(EnemyTypeWitchRed, 1)),
+  room(10, RoomLayoutRandom, ROOM_TYPE_CHECKER),
+    spawn(EnemyTypeRatBlack, 4),
+    spawn(EnemyTypeRatBlackHelmet, 4),
+  room(10, RoomLayoutRandom, 0, ROOM_TYPE_CHECKER),
+    spawnEach(snakePick, 5, 2),
+    spawnEach(witchPick, 2),
+  room(5, RoomLayoutWithoutHoles, -1, 0, 4),
+    spawnOneOf(slimeLargeNoVioletPick, 1),
+    spawnEach(slimePick, 2, 4),
+  room(5, RoomLayoutWithoutHoles, 0, ROOM_TYPE_CHECKER, 4),
+    chance(1, 3, spawn(EnemyTypeCauldronElemental, 1)),
+    also(spawnEach(slimePick, 4, 5)),
+    orElse(spawnEach(slimePick, 8, 5)),
+    chance(1, 4, spawn(EnemyTypeWitch, 1)),
+};
+
+constexpr roomStepStruct standardRooms06[] =
+{
+  room(10, RoomLayoutRandom, 0, ROOM_TYPE_CHECKER),
+    spawn(EnemyTypeZombie, 6, 2),
+    spawn(EnemyTypeRatHelmet, 2),
+    chance(1, 2, spawn(EnemyTypeWitch, 1)),
+    orElse(spawn(EnemyTypeZombie, 2)),
+  room(10, RoomLayoutRandom, 0, ROOM_TYPE_ALL),
+    spawn(EnemyTypeBat, 2),
+    spawn(EnemyTypeGhost, 5),
+    spawnOneOf(impPick, 1),
+  room(10, RoomLayoutWithoutHoles, 2, 2),
+    spawn(EnemyTypeWitch, 2, 2),
+    spawn(EnemyTypeWitchRed, 2, 2),
+    chance(1, 5, spawn(EnemyTypeCauldronElemental, 1)),
+    orElse(spawn(EnemyTypeCauldron, 1)),
+  room(10, RoomLayoutRandom, 0, ROOM_TYPE_ALL),
+    spawn(EnemyTypeEvilFlower, 2),
+    spawn(EnemyTypePumpkin, 3, 4),
+    spawn(EnemyTypeEvilFlowerIce, 2),
+  room(10, RoomLayoutRandom, 0, ROOM_TYPE_CHECKER),
+    chance(1, 3, spawn(EnemyTypeImpRed, 4)),
+    also(spawn(EnemyTypeImpBlue, 4)),
+    orElse(1, 2, spawn(EnemyTypeImpRed, 8)),
+    orElse(spawn(EnemyTypeImpBlue, 8)),
+    chance(1, 3, spawn(EnemyTypeWitchRed, 1)),
+  room(10, RoomLayoutRandom, ROOM_TYPE_CHECKER),
+    spawn(EnemyTypeZombieDark, 5),
+    spawn(EnemyTypeRatBlackHelmet, 4),
+  room(10, RoomLayoutRandom, 0, ROOM_TYPE_CHECKER),
+    spawnEach(snakePick, 5, 2),
+    spawnEach(witchPick, 2),
+  room(10, RoomLayoutRandom, 0, ROOM_TYPE_CHECKER),
+    spawn(EnemyTypeSpiderLittle, 8),
+    spawn(EnemyTypeSpiderEgg, 14),
+  room(5, RoomLayoutWithoutHoles, -1, 0, 4),
+    spawnOneOf(slimeLargePick, 1),
+    spawnEach(slimePick, 2, 4),
+    chance(1, 3, spawn(EnemyTypeWitch, 1)),
+  room(5, RoomLayoutWithoutHoles, 0, ROOM_TYPE_CHECKER, 4),
+    chance(1, 3, spawn(EnemyTypeCauldronElemental, 1)),
+    also(spawnEach(slimePick, 4, 5)),
+    orElse(spawnEach(slimePick, 8, 5)),
+    chance(1, 4, spawn(EnemyTypeWitch, 1)),
+    chance(1, 3, spawn(EnemyTypeWitch, 1)),
+  chestRoom(10, false),
+};
+
+constexpr roomStepStruct standardRooms07[] =
+{
+  room(10, RoomLayoutRandom, 0, ROOM_TYPE_CHECKER),
+    spawn(EnemyTypeZombie, 8, 3),
+    spawn(EnemyTypeRatHelmet, 2),
+    chance(1, 2, spawn(EnemyTypeWitch, 1)),
+    orElse(spawn(EnemyTypeZombie, 2)),
+    chance(1, 2, spawn(EnemyTypeBogeyman, 1)),
+  room(10, RoomLayoutRandom, 0, ROOM_TYPE_ALL),
+    spawn(EnemyTypeBat, 2),
+    spawn(EnemyTypeGhost, 6),
+    spawnOneOf(impPick, 2),
+    chance(1, 3, spawn(EnemyTypeBogeyman, 1)),
+  room(10, RoomLayoutWithoutHoles, 2, 2),
+    spawn(EnemyTypeWitch, 2, 2),
+    spawn(EnemyTypeWitchRed, 2, 2),
+    spawn(EnemyTypeCauldron, 1),
+    // 1/2: another cauldron (elemental 1/3)
+    chance(1, 6, spawn(EnemyTypeCauldronElemental, 1)),
+    orElse(2, 5, spawn(EnemyTypeCauldron, 1)),
+  room(10, RoomLayoutRandom, 0, ROOM_TYPE_ALL),
+    spawn(EnemyTypeEvilFlower, 2),
+    spawn(EnemyTypePumpkin, 3, 4),
+    spawnOneOf(flowerPick, 3),
+  room(10, RoomLayoutRandom, 0, ROOM_TYPE_CHECKER),
+    spawn(EnemyTypeBogeyman, 5, 2),
+    chance(1, 2, spawn(EnemyTypeWitchRed, 1)),
+  room(10, RoomLayoutRandom, ROOM_TYPE_CHECKER),
+    spawn(EnemyTypeZombieDark, 7),
+    spawn(EnemyTypeRatBlackHelmet, 4),
+  room(10, RoomLayoutRandom, 0, ROOM_TYPE_CHECKER),
+    spawnEach(snakePick, 7, 2),
+    spawnEach(witchPick, 2),
+  room(10, RoomLayoutRandom, 0, ROOM_TYPE_CHECKER),
+    spawn(EnemyTypeSpiderLittle, 8),
+    spawn(EnemyTypeSpiderTarantula, 2),
+    spawn(EnemyTypeSpiderEgg, 16),
+  room(10, RoomLayoutWithoutHoles, -1, 0, 4),
+    spawnOneOf(slimeLargePick, 1),
+    chance(1, 2, spawnOneOf(slimeLargePick, 1)),
+    also(spawnEach(slimePick, 2, 4)),
+    orElse(spawnEach(slimePick, 8, 5)),
+    chance(1, 4, spawn(EnemyTypeWitch, 1)),
+  chestRoom(10, false),
+};
+
+constexpr roomStepStruct standardRooms08[] =
+{
+  room(10, RoomLayoutRandom, 0, ROOM_TYPE_CHECKER),
+    spawn(EnemyTypeZombie, 9, 3),
+    spawn(EnemyTypeRatHelmet, 3),
+    chance(1, 2, spawn(EnemyTypeWitch, 1)),
+    orElse(spawn(EnemyTypeZombie, 2)),
+    chance(1, 2, spawn(EnemyTypeBogeyman, 1)),
+  room(10, RoomLayoutRandom, 0, ROOM_TYPE_ALL),
+    spawn(EnemyTypeBatSkeleton, 3),
+    spawn(EnemyTypeGhost, 6),
+    spawnOneOf(impPick, 2),
+    chance(1, 3, spawn(EnemyTypeBogeyman, 1)),
+  room(10, RoomLayoutWithoutHoles, 2, 2),
+    spawn(EnemyTypeWitch, 2, 3),
+    spawn(EnemyTypeWitchRed, 2, 3),
+    spawn(EnemyTypeCauldron, 1, 2),
+    // 1/2: another cauldron (elemental 1/3)
+    chance(1, 6, spawn(EnemyTypeCauldronElemental, 1)),
+    orElse(2, 5, spawn(EnemyTypeCauldron, 1)),
+  room(10, RoomLayoutRandom, 0, ROOM_TYPE_ALL),
+    spawn(EnemyTypeEvilFlower, 2),
+    spawn(EnemyTypePumpkin, 4, 4),
+    spawnOneOf(flowerPick, 4),
+  room(10, RoomLayoutRandom, 0, ROOM_TYPE_CHECKER),
+    spawn(EnemyTypeBogeyman, 5, 3),
+    chance(1, 2, spawn(EnemyTypeWitchRed, 1)),
+  room(10, RoomLayoutRandom, ROOM_TYPE_CHECKER),
+    spawn(EnemyTypeZombieDark, 9),
+    spawn(EnemyTypeRatBlackHelmet, 4),
+  room(10, RoomLayoutRandom, 0, ROOM_TYPE_CHECKER),
+    spawnEach(snakePick, 11, 2),
+    spawnEach(witchPick, 2),
+  room(10, RoomLayoutRandom, 0, ROOM_TYPE_CHECKER),
+    spawn(EnemyTypeSpiderLittle, 6),
+    spawn(EnemyTypeSpiderTarantula, 4),
+    spawn(EnemyTypeSpiderEgg, 20),
+  room(10, RoomLayoutWithoutHoles, -1, 0, 4),
+    spawnEach(slimeLargePick, 2),
+    chance(1, 2, spawnOneOf(slimeLargePick, 1)),
+    also(spawnEach(slimePick, 2, 4)),
+    orElse(spawnEach(slimePick, 8, 5)),
+    chance(1, 4, spawn(EnemyTypeWitch, 1)),
+  chestRoom(10, false),
+};
+
+///////////////// ADVANCED /////////////////
+
+constexpr roomStepStruct advancedRooms01[] =
+{
+  room(16, RoomLayoutWithoutHoles, 0, ROOM_TYPE_CHECKER),
+    spawn(EnemyTypeRat, 2),
+    spawn(EnemyTypeRatHelmet, 1, 2),
+  room(16, RoomLayoutWithoutHoles, 0, ROOM_TYPE_CHECKER),
+    spawn(EnemyTypeBat, 2),
+    chance(1, 3, spawn(EnemyTypeImpBlue, 1)),
+    chance(1, 3, spawn(EnemyTypeImpRed, 1)),
+  room(16, RoomLayoutWithoutHoles, 0, ROOM_TYPE_CHECKER),
+    spawn(EnemyTypeEvilFlower, 2),
+    chance(1, 3, spawn(EnemyTypeEvilFlowerIce, 1)),
+    chance(1, 3, spawn(EnemyTypeEvilFlowerFire, 1)),
+  chestRoom(16, true),
+};
+
+constexpr roomStepStruct advancedRooms02[] =
+{
+  room(16, RoomLayoutRandom, 0, ROOM_TYPE_CHECKER),
+    spawn(EnemyTypeRat, 2),
+    spawn(EnemyTypeRatHelmet, 2),
+    chance(1, 2, spawn(EnemyTypeSnake, 2)),
+    orElse(spawn(EnemyTypeBat, 3)),
+  room(16, RoomLayoutRandom, 0, ROOM_TYPE_ALL),
+    spawn(EnemyTypeBat, 3),
+    chance(1, 2, spawn(EnemyTypeSnake, 1)),
+    chance(1, 2, spawn(EnemyTypeImpBlue, 1)),
+    chance(1, 2, spawn(EnemyTypeImpRed, 1)),
+  room(16, RoomLayoutRandom, 0, ROOM_TYPE_ALL),
+    spawn(EnemyTypeEvilFlower, 3),
+    spawnOneOf(flowerPick, 2),
+  chestRoom(16, false),
+  room(16, RoomLayoutRandom, 0, ROOM_TYPE_CHECKER),
+    spawn(EnemyTypeSnake, 4),
+    chance(1, 3, spawn(EnemyTypeSnakeBlood, 1)),
+    chance(1, 3, spawn(EnemyTypeSnakeBlood, 1)),
+  room(15, RoomLayoutRandom, ROOM_TYPE_CHECKER),
+    spawn(EnemyTypeRatBlack, 6),
+  room(5, RoomLayoutRandom, ROOM_TYPE_CHECKER),
+    chance(1, 2, spawn(EnemyTypeWitchRed, 1)),
+    also(spawn(EnemyTypeBat, 3)),
+    orElse(spawn(EnemyTypeZombie, 2)),
+    also(spawn(EnemyTypeBat, 1)),
+};
+
+constexpr roomStepStruct advancedRooms03[] =
+{
+  room(16, RoomLayoutRandom, 0, ROOM_TYPE_CHECKER),
+    spawn(EnemyTypeRat, 2),
+    spawn(EnemyTypeRatHelmet, 2),
+    chance(1, 2, spawn(EnemyTypeRatHelmet, 2)),
+    orElse(spawn(EnemyTypeZombie, 1)),
+  room(16, RoomLayoutRandom, 0, ROOM_TYPE_ALL),
+    spawn(EnemyTypeBat, 4),
+    chance(1, 2, spawn(EnemyTypeImpRed, 2)),
+    orElse(spawn(EnemyTypeBatSkeleton, 3)),
+  room(16, RoomLayoutRandom, 0, ROOM_TYPE_ALL),
+    spawn(EnemyTypeEvilFlower, 4, 2),
+    chance(1, 3, spawn(EnemyTypeImpBlue, 2)),
+    chance(1, 3, spawn(EnemyTypePumpkin, 2)),
+    chance(1, 3, spawn(EnemyTypeEvilFlowerIce, 1)),
+    chance(1, 3, spawn(EnemyTypeEvilFlowerFire, 1)),
+  chestRoom(16, false),
+  room(16, RoomLayoutRandom, 0, ROOM_TYPE_CHECKER),
+    spawnEach(snakeEvenPick, 6, 2),
+    spawn(EnemyTypeRatHelmet, 2),
+    chance(1, 2, spawn(EnemyTypeImpRed, 1)),
+    chance(1, 2, spawn(EnemyTypeImpBlue, 1)),
+  room(15, RoomLayoutRandom, ROOM_TYPE_CHECKER),
+    chance(1, 2, spawn(EnemyTypeRatBlack, 5)),
+    also(spawn(EnemyTypeRatBlackHelmet, 1)),
+    orElse(spawn(EnemyTypeRatBlack, 4)),
+    also(spawn(EnemyTypeRatBlackHelmet, 2)),
+    spawn(EnemyTypeZombieDark, 1),
+  room(15, RoomLayoutWithoutHoles, 0, ROOM_TYPE_CHECKER, 4),
+    spawn(EnemyTypeSlime, 7, 5),
+    chance(1, 4, spawn(EnemyTypeSlimeBlue, 1)),
+    chance(1, 4, spawn(EnemyTypeSlimeRed, 1)),
+    chance(1, 2, spawn(EnemyTypeSlimeViolet, 1)),
+  room(5, RoomLayoutRandom, 0, ROOM_TYPE_ALL),
+    spawnOneOf(witchPick, 3),
+};
+
+constexpr roomStepStruct advancedRooms04[] =
+{
+  room(16, RoomLayoutRandom, 0, ROOM_TYPE_CHECKER),
+    spawn(EnemyTypeRat, 3),
+    spawn(EnemyTypeRatHelmet, 5),
+    chance(1, 4, spawn(EnemyTypeWitchRed, 1)),
+    orElse(spawn(EnemyTypeSnakeBlood, 2)),
+  room(16, RoomLayoutRandom, 0, ROOM_TYPE_ALL),
+    spawn(EnemyTypeBatSkeleton, 5),
+    spawnOneOf(impPick, 3),
+  room(16, RoomLayoutRandom, 0, ROOM_TYPE_ALL),
+    spawnOneOf(flowerPick, 4),
+    chance(1, 2, spawn(EnemyTypePumpkin, 2, 2)),
+    orElse(spawn(EnemyTypeImpBlue, 2)),
+    chance(1, 2, spawn(EnemyTypePumpkin, 2, 2)),
+    also(spawn(EnemyTypeEvilFlowerIce, 1, 2)),
+    orElse(spawn(EnemyTypeImpBlue, 3)),
+    also(spawn(EnemyTypeEvilFlowerFire, 1)),
+  chestRoom(16, false),
+  room(16, RoomLayoutRandom, 0, ROOM_TYPE_CHECKER),
+    spawn(EnemyTypeImpRed, 3),
+    spawn(EnemyTypeImpBlue, 3),
+    chance(1, 2, spawn(EnemyTypeWitchRed, 1)),
+    chance(1, 2, spawn(EnemyTypeWitch, 1)),
+  room(10, RoomLayoutRandom, 0, ROOM_TYPE_CHECKER),
+    spawnEach(snakeEvenPick, 9),
+    spawnOneOf(witchPick, 1),
+  room(10, RoomLayoutRandom, ROOM_TYPE_CHECKER),
+    spawn(EnemyTypeRatBlack, 3),
+    spawn(EnemyTypeRatBlackHelmet, 5),
+  room(5, RoomLayoutWithoutHoles, -1, 0, 4),
+    spawn(EnemyTypeSlimeLarge, 1),
+    spawnOneOf(slimeLargeRedBluePick, 1),
+    spawnEach(slimeNoVioletPick, 3, 5),
+  room(5, RoomLayoutWithoutHoles, 0, ROOM_TYPE_CHECKER, 4),
+    spawnEach(slimeNoVioletPick, 11, 5),
+  room(5, RoomLayoutWithoutHoles, 0, ROOM_TYPE_CHECKER, 4),
+    spawnEach(slimeEvenPick, 4, 2),
+    spawn(EnemyTypeCauldronElemental, 1),
+};
+
+constexpr roomStepStruct advancedRooms05[] =
+{
+  room(10, RoomLayoutRandom, 0, ROOM_TYPE_CHECKER),
+    spawn(EnemyTypeRat, 3),
+    spawn(EnemyTypeRatHelmet, 5),
+    spawnOneOf(witchPick, 2),
+  room(10, RoomLayoutRandom, 0, ROOM_TYPE_ALL),
+    spawn(EnemyTypeBatSkeleton, 4),
+    spawnOneOf(impPick, 5),
+  room(12, RoomLayoutWithoutHoles, 2, 2),
+    spawn(EnemyTypeBatSkeleton, 4),
+    spawn(EnemyTypeWitch, 2, 2),
+    spawn(EnemyTypeWitchRed, 1, 2),
+    spawn(EnemyTypeCauldron, 1),
+  room(16, RoomLayoutRandom, 0, ROOM_TYPE_ALL),
+    spawn(EnemyTypeEvilFlower, 3),
+    chance(1, 2, spawn(EnemyTypePumpkin, 2, 4)),
+    also(spawn(EnemyTypeEvilFlowerIce, 3)),
+    orElse(spawn(EnemyTypeImpBlue, 3)),
+    also(spawn(EnemyTypeEvilFlowerFire, 3)),
+  chestRoom(16, false),
+  room(16, RoomLayoutRandom, 0, ROOM_TYPE_CHECKER),
+    spawn(EnemyTypeBatSkeleton, 3),
+    chance(1, 3, spawn(EnemyTypeImpRed, 3, 2)),
+    also(spawn(EnemyTypeImpBlue, 3, 2)),
+    orElse(1, 2, spawn(EnemyTypeImpRed, 7)),
+    orElse(spawn(EnemyTypeImpBlue, 7)),
+    chance(1, 3, spawn(EnemyTypeWitchRed, 1)),
+  room(10, RoomLayoutRandom, ROOM_TYPE_CHECKER),
+    spawn(EnemyTypeRatBlack, 4),
+    spawn(EnemyTypeRatBlackHelmet, 4),
+    spawn(EnemyTypeZombie, 3),
+  room(10, RoomLayoutRandom, 0, ROOM_TYPE_CHECKER),
+    spawnEach(snakePick, 6, 2),
+    spawnEach(witchPick, 3),
+  room(5, RoomLayoutWithoutHoles, -1, 0, 4),
+    spawnOneOf(slimeLargeNoVioletPick, 2),
+    spawnEach(slimePick, 2, 4),
+  room(5, RoomLayoutWithoutHoles, 0, ROOM_TYPE_CHECKER, 4),
+    chance(1, 3, spawn(EnemyTypeCauldronElemental, 1)),
+    also(spawnEach(slimePick, 4, 5)),
+    orElse(spawnEach(slimePick, 8, 5)),
+    chance(1, 4, spawn(EnemyTypeWitch, 1)),
+  room(5, RoomLayoutWithoutHoles, 0, ROOM_TYPE_CHECKER, 4),
+    spawn(EnemyTypeCauldron, 3),
+};
+
+constexpr roomStepStruct advancedRooms06[] =
+{
+  room(10, RoomLayoutRandom, 0, ROOM_TYPE_CHECKER),
+    spawn(EnemyTypeZombie, 10, 2),
+    spawn(EnemyTypeRatHelmet, 2),
+    chance(1, 2, spawn(EnemyTypeWitch, 1)),
+    orElse(spawn(EnemyTypeZombie, 2)),
+  room(10, RoomLayoutRandom, 0, ROOM_TYPE_ALL),
+    spawn(EnemyTypeBatSkeleton, 4),
+    spawn(EnemyTypeGhost, 5),
+    spawnOneOf(impPick, 1),
+  room(10, RoomLayoutWithoutHoles, 2, 2),
+    spawn(EnemyTypeWitch, 2, 2),
+    spawn(EnemyTypeWitchRed, 2, 2),
+    chance(1, 5, spawn(EnemyTypeCauldronElemental, 1)),
+    orElse(spawn(EnemyTypeCauldron, 1)),
+    spawn(EnemyTypeSausage, 6),
+  room(10, RoomLayoutRandom, 0, ROOM_TYPE_ALL),
+    spawn(EnemyTypeEvilFlower, 5),
+    spawn(EnemyTypePumpkin, 3, 4),
+    spawn(EnemyTypeEvilFlowerIce, 2),
+  room(10, RoomLayoutRandom, 0, ROOM_TYPE_CHECKER),
+    chance(1, 3, spawn(EnemyTypeImpRed, 5)),
+    also(spawn(EnemyTypeImpBlue, 5)),
+    orElse(1, 2, spawn(EnemyTypeImpRed, 10)),
+    orElse(spawn(EnemyTypeImpBlue, 10)),
+    chance(1, 3, spawn(EnemyTypeWitchRed, 1)),
+  room(10, RoomLayoutRandom, ROOM_TYPE_CHECKER),
+    spawn(EnemyTypeZombieDark, 8),
+    spawn(EnemyTypeRatBlackHelmet, 4),
+  room(10, RoomLayoutRandom, 0, ROOM_TYPE_CHECKER),
+    spawnEach(snakePick, 5, 2),
+    spawnEach(witchPick, 4),
+  room(10, RoomLayoutRandom, 0, ROOM_TYPE_CHECKER),
+    spawn(EnemyTypeSpiderLittle, 5),
+    spawn(EnemyTypeSpiderTarantula, 3),
+    spawn(EnemyTypeSpiderEgg, 18),
+  room(5, RoomLayoutWithoutHoles, -1, 0, 4),
+    spawnOneOf(slimeLargePick, 2),
+    spawnEach(slimePick, 2, 4),
+    chance(1, 3, spawn(EnemyTypeWitch, 1)),
+  room(5, RoomLayoutWithoutHoles, 0, ROOM_TYPE_CHECKER, 4),
+    chance(1, 3, spawn(EnemyTypeCauldronElemental, 1)),
+    also(spawnEach(slimePick, 6, 5)),
+    orElse(spawnEach(slimePick, 10, 5)),
+    chance(1, 4, spawn(EnemyTypeWitch, 1)),
+    chance(1, 3, spawn(EnemyTypeWitch, 1)),
+  chestRoom(10, false),
+  room(5, RoomLayoutRandom, 0, ROOM_TYPE_ALL),
+    spawn(EnemyTypeZombie, 10),
+    spawn(EnemyTypeBatSkeleton, 5),
+    spawn(EnemyTypeGhost, 1),
+};
+
+///////////////// TABLES /////////////////
+
+struct roomTableStruct
+{
+  const char* name;
+  const roomStepStruct* steps;
+  int nbSteps;
+};
+
+template <std::size_t N>
+constexpr roomTableStruct table(const char* name, const roomStepStruct (&steps)[N])
+{
+  return roomTableStruct { name, steps, N };
+}
+
+const int NB_STANDARD_TABLES = 8;
+const int NB_ADVANCED_TABLES = 6;
+const int NB_ROOM_TABLES = NB_STANDARD_TABLES + NB_ADVANCED_TABLES;
+
+// the advanced levels after the last advanced table use the standard tables
+constexpr roomTableStruct roomTables[NB_ROOM_TABLES] =
+{
+  table("standard 1", standardRooms01),
+  table("standard 2", standardRooms02),
+  table("standard 3", standardRooms03),
+  table("standard 4", standardRooms04),
+  table("standard 5", standardRooms05),
+  table("standard 6", standardRooms06),
+  table("standard 7", standardRooms07),
+  table("standard 8", standardRooms08),
+  table("advanced 1", advancedRooms01),
+  table("advanced 2", advancedRooms02),
+  table("advanced 3", advancedRooms03),
+  table("advanced 4", advancedRooms04),
+  table("advanced 5", advancedRooms05),
+  table("advanced 6", advancedRooms06),
+};
+
+struct roomTableIndexStruct
+{
+  std::vector<int> recipeStep;        /**< first step of each recipe */
+  std::vector<int> cumulativeWeight;  /**< cumulative weight of the recipes */
+};
+
+static roomTableIndexStruct roomTableIndex[NB_ROOM_TABLES];
+static bool roomTableIndexBuilt = false;
+
+static void buildRoomTableIndex()
+{
+  checkRoomRecipes();
+
+  for (int t = 0; t < NB_ROOM_TABLES; t++)
+  {
+    roomTableIndex[t].recipeStep.clear();
+    roomTableIndex[t].cumulativeWeight.clear();
+    int totalWeight = 0;
+
+    for (int i = 0; i < roomTables[t].nbSteps; i++)
+    {
+      const roomStepStruct& step = roomTables[t].steps[i];
+      if (step.step == RoomStepRecipe && step.weight > 0)
+      {
+        totalWeight += step.weight;
+        roomTableIndex[t].recipeStep.push_back(i);
+        roomTableIndex[t].cumulativeWeight.push_back(totalWeight);
+      }
+    }
+  }
+  roomTableIndexBuilt = true;
+}
+
+static int getRoomTable(int level, bool advanced)
+{
+  if (level < 1) level = 1;
+  if (advanced && level <= NB_ADVANCED_TABLES) return NB_STANDARD_TABLES + level - 1;
+  if (level > NB_STANDARD_TABLES) level = NB_STANDARD_TABLES;
+  return level - 1;
+}
+
+static bool rollChance(const roomStepStruct& step)
+{
+  if (step.chanceOver <= 1) return step.chance >= 1;
+  return rand() % step.chanceOver < step.chance;
+}
+
+static enemyTypeEnum pickMonster(const roomStepStruct& step)
+{
+  int totalWeight = 0;
+  for (int i = 0; i < step.nbPicks; i++) totalWeight += step.picks[i].weight;
+
+  int r = rand() % totalWeight;
+  for (int i = 0; i < step.nbPicks; i++)
+  {
+    if (r < step.picks[i].weight) return step.picks[i].type;
+    r -= step.picks[i].weight;
+  }
+  return step.picks[step.nbPicks - 1].type;
+}
+
+static void addSpawn(roomPlanStruct& plan, enemyTypeEnum type, int count)
+{
+  if (count <= 0) return;
+  if (!plan.spawns.empty() && plan.spawns.back().type == type)
+    plan.spawns.back().count += count;
+  else
+  {
+    roomSpawnStruct roomSpawn;
+    roomSpawn.type = type;
+    roomSpawn.count = count;
+    plan.spawns.push_back(roomSpawn);
+  }
+}
+
+static void rollSpawnStep(const roomStepStruct& step, roomPlanStruct& plan)
+{
+  int count = step.count;
+  if (step.countRange > 0) count += rand() % step.countRange;
+
+  if (step.picks == NULL)
+    addSpawn(plan, step.type, count);
+  else if (!step.pickEach)
+    addSpawn(plan, pickMonster(step), count);
+  else
+    for (int i = 0; i < count; i++) addSpawn(plan, pickMonster(step), 1);
+}
+
+void rollRoomPlan(int level, bool advanced, roomPlanStruct& plan)
+{
+  if (!roomTableIndexBuilt) buildRoomTableIndex();
+
+  int t = getRoomTable(level, advanced);
+  const roomTableStruct& roomTable = roomTables[t];
+  const std::vector<int>& cumulativeWeight = roomTableIndex[t].cumulativeWeight;
+
+  plan.spawns.clear();
+  plan.recipe = -1;
+  plan.layout = RoomLayoutRandom;
+  plan.layoutType = 0;
+  plan.grids = 0;
+  if (cumulativeWeight.empty()) return;
+
+  int r = rand() % cumulativeWeight.back();
+  plan.recipe = std::upper_bound(cumulativeWeight.begin(), cumulativeWeight.end(), r) - cumulativeWeight.begin();
+
+  int firstStep = roomTableIndex[t].recipeStep[plan.recipe];
+  const roomStepStruct& recipe = roomTable.steps[firstStep];
+
+  plan.layout = recipe.layout;
+  plan.layoutType = recipe.layoutType;
+  if (recipe.layoutTypeRange > 0) plan.layoutType += rand() % recipe.layoutTypeRange;
+  plan.grids = recipe.grids;
+
+  bool stepDone = false;
+  bool chainDone = false;
+
+  for (int i = firstStep + 1; i < roomTable.nbSteps && roomTable.steps[i].step != RoomStepRecipe; i++)
+  {
+    const roomStepStruct& step = roomTable.steps[i];
+
+    switch (step.step)
+    {
+    case RoomStepSpawn:
+      stepDone = rollChance(step);
+      chainDone = stepDone;
+      break;
+
+    case RoomStepSpawnElse:
+      stepDone = !chainDone && rollChance(step);
+      chainDone = chainDone || stepDone;
+      break;
+
+    default:
+      // "also": same result as the step before
+      break;
+    }
+
+    if (stepDone) rollSpawnStep(step, plan);
+  }
+}
+
+int getRoomRecipeCount(int level, bool advanced)
+{
+  if (!roomTableIndexBuilt) buildRoomTableIndex();
+  return roomTableIndex[getRoomTable(level, advanced)].recipeStep.size();
+}
+
+void getRoomRecipeMonsters(int level, bool advanced, std::vector<enemyTypeEnum>& monsters)
+{
+  const roomTableStruct& roomTable = roomTables[getRoomTable(level, advanced)];
+  monsters.clear();
+
+  for (int i = 0; i < roomTable.nbSteps; i++)
+  {
+    const roomStepStruct& step = roomTable.steps[i];
+    if (step.step == RoomStepRecipe) continue;
+
+    if (step.picks == NULL)
+    {
+      if (std::find(monsters.begin(), monsters.end(), step.type) == monsters.end())
+        monsters.push_back(step.type);
+    }
+    else
+    {
+      for (int p = 0; p < step.nbPicks; p++)
+        if (std::find(monsters.begin(), monsters.end(), step.picks[p].type) == monsters.end())
+          monsters.push_back(step.picks[p].type);
+    }
+  }
+}
+
+bool checkRoomRecipes()
+{
+  bool valid = true;
+
+  for (int t = 0; t < NB_ROOM_TABLES; t++)
+  {
+    const roomTableStruct& roomTable = roomTables[t];
+    int nbRecipes = 0;
+
+    for (int i = 0; i < roomTable.nbSteps; i++)
+    {
+      const roomStepStruct& step = roomTable.steps[i];
+      std::string error = "";
+
+      if (step.step == RoomStepRecipe)
+      {
+        nbRecipes++;
+        if (step.weight <= 0) error = "recipe without weight";
+        else if (step.layoutTypeRange < 0) error = "negative layout range";
+        else if (step.grids < 0) error = "negative grids";
+      }
+      else
+      {
+        bool isChained = step.step == RoomStepSpawnElse || step.step == RoomStepSpawnAlso;
+        if (i == 0) error = "spawn before the first recipe";
+        else if (isChained && roomTable.steps[i - 1].step == RoomStepRecipe) error = "chained spawn without previous spawn";
+        else if (step.chanceOver <= 0 || step.chance < 0 || step.chance > step.chanceOver) error = "wrong chance";
+        else if (step.count <= 0 || step.countRange < 0) error = "wrong count";
+        else if (step.picks != NULL)
+        {
+          int totalWeight = 0;
+          for (int p = 0; p < step.nbPicks; p++)
+          {
+            if (step.picks[p].weight < 0) totalWeight = -1;
+            else if (totalWeight >= 0) totalWeight += step.picks[p].weight;
+          }
+          if (step.nbPicks <= 0 || totalWeight <= 0) error = "wrong monster picks";
+        }
+      }
+
+      if (error.size() > 0)
+      {
+        std::cout << "[ERROR] Room recipes (" << roomTable.name << "), step " << i << ": " << error << std::endl;
+        valid = false;
+      }
+    }
+
+    if (nbRecipes == 0)
+    {
+      std::cout << "[ERROR] Room recipes (" << roomTable.name << "): no recipe" << std::endl;
+      valid = false;
+    }
+  }
+
+  return valid;
+}
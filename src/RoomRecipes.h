@@ -0,0 +1,80 @@
+/**  This file is part of Witch Blast.
+  *
+  *  Witch Blast is free software: you can redistribute it and/or modify
+  *  it under the terms of the GNU General Public License as published by
+  *  the Free Software Foundation, either version 3 of the License, or
+  *  (at your option) any later version.
+  *
+  *  Witch Blast is distributed in the hope that it will be useful,
+  *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  *  GNU General Public License for more details.
+  *
+  *  You should have received a copy of the GNU General Public License
+  *  along with Witch Blast.  If not, see <http://www.gnu.org/licenses/>.
+  */
+
+#ifndef ROOMRECIPES_H
+#define ROOMRECIPES_H
+
+#include "BaseCreatureEntity.h"
+#include <vector>
+
+/** Room layouts of the standard rooms */
+enum roomLayoutEnum
+{
+  RoomLayoutRandom,         /**< DungeonMap::generateRoomRandom */
+  RoomLayoutWithoutHoles,   /**< DungeonMap::generateRoomWithoutHoles */
+  RoomLayoutChest,          /**< chest room, no monster */
+  RoomLayoutChestCentered   /**< chest room, chest centered horizontally */
+};
+
+/** A group of monsters of the same type to place in a room */
+struct roomSpawnStruct
+{
+  enemyTypeEnum type;
+  int count;
+};
+
+/** The result of a recipe roll: what the room will contain */
+struct roomPlanStruct
+{
+  int recipe;                           /**< index of the recipe in the level table */
+  roomLayoutEnum layout;
+  int layoutType;                       /**< parameter of the layout generation */
+  int grids;                            /**< number of random grids (0 = none) */
+  std::vector<roomSpawnStruct> spawns;  /**< monsters, in placement order */
+};
+
+/*!
+ *  \brief rolls a standard room of a level
+ *
+ *  The recipe is chosen in the weighted table of the level, then its layout and monsters
+ *  are rolled. Only rand() is used, and the map is not modified, so the rooms can be
+ *  reproduced from a seed (srand) and generated in batches.
+ *  \param level : level (levels above the last table use the last table)
+ *  \param advanced : true for the advanced rooms
+ *  \param plan : filled with the room plan
+ */
+void rollRoomPlan(int level, bool advanced, roomPlanStruct& plan);
+
+/*!
+ *  \brief returns the number of recipes of a level table
+ */
+int getRoomRecipeCount(int level, bool advanced);
+
+/*!
+ *  \brief lists the monsters which can be placed in the standard rooms of a level
+ *  \param level : level
+ *  \param advanced : true for the advanced rooms
+ *  \param monsters : filled with the monster types (each one once)
+ */
+void getRoomRecipeMonsters(int level, bool advanced, std::vector<enemyTypeEnum>& monsters);
+
+/*!
+ *  \brief checks the consistency of the recipe tables
+ *  \return true if every table is valid (errors are displayed on the console)
+ */
+bool checkRoomRecipes();
+
+#endif // ROOMRECIPES_H
@@ -0,0 +1,404 @@
+/**  This file is part of Witch Blast.
+  *
+  *  Witch Blast is free software: you can redistribute it and/or modify
+  *  it under the terms of the GNU General Public License as published by
+  *  the Free Software Foundation, either version 3 of the License, or
+  *  (at your option) any later version.
+  *
+  *  Witch Blast is distributed in the hope that it will be useful,
+  *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  *  GNU General Public License for more details.
+  *
+  *  You should have received a copy of the GNU General Public License
+  *  along with Witch Blast.  If not, see <http://www.gnu.org/licenses/>.
+  */
+
+#include "SaveFile.h"
+
+#include <iostream>
+#include <fstream>
+#include <cstdio>
+#include <cstring>
+
+const char SAVE_FILE_MAGIC[4] = { 'W', 'B', 'S', 'V' };
+const unsigned int SAVE_FILE_HEADER_SIZE = 20;
+const unsigned int SAVE_CHUNK_HEADER_SIZE = 10;
+
+static uint32_t crcTable[256];
+static bool crcTableBuilt = false;
+
+static uint32_t computeCrc32(const char* buffer, unsigned int size)
+{
+  if (!crcTableBuilt)
+  {
+    for (uint32_t i = 0; i < 256; i++)
+    {
+      uint32_t c = i;
+      for (int k = 0; k < 8; k++) c = (c & 1) ? 0xEDB88320 ^ (c >> 1) : c >> 1;
+      crcTable[i] = c;
+    }
+    crcTableBuilt = true;
+  }
+
+  uint32_t crc = 0xFFFFFFFF;
+  for (unsigned int i = 0; i < size; i++)
+    crc = crcTable[(crc ^ (unsigned char)buffer[i]) & 0xFF] ^ (crc >> 8);
+  return crc ^ 0xFFFFFFFF;
+}
+
+static void putUint(char* dest, uint32_t n, int size)
+{
+  for (int i = 0; i < size; i++) dest[i] = (char)((n >> (8 * i)) & 0xFF);
+}
+
+static uint32_t getUint(const char* source, int size)
+{
+  uint32_t n = 0;
+  for (int i = 0; i < size; i++) n |= (uint32_t)(unsigned char)source[i] << (8 * i);
+  return n;
+}
+
+///////////////// WRITER /////////////////
+
+SaveFileWriter::SaveFileWriter()
+{
+  chunkStart = -1;
+  nbChunks = 0;
+  writeFailed = false;
+}
+
+SaveFileWriter::~SaveFileWriter()
+{
+  wait();
+}
+
+void SaveFileWriter::begin()
+{
+  data.clear();
+  chunkStart = -1;
+  nbChunks = 0;
+}
+
+void SaveFileWriter::beginChunk(const char* tag, int version)
+{
+  if (chunkStart >= 0) endChunk();
+
+  chunkStart = data.size();
+  data.resize(data.size() + SAVE_CHUNK_HEADER_SIZE);
+  memcpy(&data[chunkStart], tag, 4);
+  putUint(&data[chunkStart + 4], version, 2);
+  nbChunks++;
+}
+
+void SaveFileWriter::endChunk()
+{
+  if (chunkStart < 0) return;
+  putUint(&data[chunkStart + 6], data.size() - chunkStart - SAVE_CHUNK_HEADER_SIZE, 4);
+  chunkStart = -1;
+}
+
+void SaveFileWriter::writeInt(int n)
+{
+  char buffer[4];
+  putUint(buffer, (uint32_t)n, 4);
+  data.insert(data.end(), buffer, buffer + 4);
+}
+
+void SaveFileWriter::writeFloat(float f)
+{
+  uint32_t n;
+  memcpy(&n, &f, 4);
+  char buffer[4];
+  putUint(buffer, n, 4);
+  data.insert(data.end(), buffer, buffer + 4);
+}
+
+void SaveFileWriter::writeBool(bool b)
+{
+  data.push_back(b ? 1 : 0);
+}
+
+void SaveFileWriter::writeString(const std::string& s)
+{
+  writeInt(s.size());
+  data.insert(data.end(), s.begin(), s.end());
+}
+
+void SaveFileWriter::writeToFile(const std::string& fileName)
+{
+  endChunk();
+  wait();
+
+  fileData.resize(SAVE_FILE_HEADER_SIZE);
+  memcpy(&fileData[0], SAVE_FILE_MAGIC, 4);
+  putUint(&fileData[4], SAVE_FILE_FORMAT_VERSION, 2);
+  putUint(&fileData[6], nbChunks, 2);
+  putUint(&fileData[8], data.size(), 4);
+  putUint(&fileData[12], computeCrc32(data.data(), data.size()), 4);
+  putUint(&fileData[16], computeCrc32(fileData.data(), 16), 4);
+  fileData.insert(fileData.end(), data.begin(), data.end());
+
+  this->fileName = fileName;
+  writeThread = std::thread(&SaveFileWriter::writeFileThread, this);
+}
+
+void SaveFileWriter::writeFileThread()
+{
+  std::string tmpFileName = fileName + ".tmp";
+  writeFailed = true;
+
+  std::ofstream file(tmpFileName.c_str(), std::ios::out | std::ios::trunc | std::ios::binary);
+  if (file)
+  {
+    file.write(fileData.data(), fileData.size());
+    file.close();
+
+    if (file)
+    {
+      // rename does not replace an existing file on every platform
+      if (rename(tmpFileName.c_str(), fileName.c_str()) != 0)
+      {
+        remove(fileName.c_str());
+        writeFailed = rename(tmpFileName.c_str(), fileName.c_str()) != 0;
+      }
+      else
+        writeFailed = false;
+    }
+  }
+
+  if (writeFailed) std::cerr << "[ERROR] Saving the game..." << std::endl;
+}
+
+bool SaveFileWriter::wait()
+{
+  if (writeThread.joinable()) writeThread.join();
+  return !writeFailed;
+}
+
+int SaveFileWriter::getFileSize()
+{
+  return fileData.size();
+}
+
+///////////////// READER /////////////////
+
+SaveFileReader::SaveFileReader()
+{
+  binary = false;
+  ok = false;
+  position = 0;
+  chunkEnd = 0;
+}
+
+bool SaveFileReader::open(const std::string& fileName)
+{
+  ok = false;
+  binary = false;
+
+  std::ifstream file(fileName.c_str(), std::ios::in | std::ios::binary);
+  if (!file) return false;
+
+  std::ostringstream oss;
+  oss << file.rdbuf();
+  fileData = oss.str();
+  file.close();
+
+  if (fileData.size() >= SAVE_FILE_HEADER_SIZE && memcmp(fileData.data(), SAVE_FILE_MAGIC, 4) == 0)
+  {
+    binary = true;
+    const char* header = fileData.data();
+
+    if (getUint(header + 16, 4) != computeCrc32(header, 16))
+    {
+      std::cerr << "[ERROR] Save file: wrong header checksum" << std::endl;
+      return false;
+    }
+    if ((int)getUint(header + 4, 2) > SAVE_FILE_FORMAT_VERSION)
+    {
+      std::cerr << "[ERROR] Save file: unknown format version" << std::endl;
+      return false;
+    }
+    unsigned int dataSize = getUint(header + 8, 4);
+    if (dataSize != fileData.size() - SAVE_FILE_HEADER_SIZE
+        || getUint(header + 12, 4) != computeCrc32(header + SAVE_FILE_HEADER_SIZE, dataSize))
+    {
+      std::cerr << "[ERROR] Save file: corrupted data" << std::endl;
+      return false;
+    }
+
+    position = SAVE_FILE_HEADER_SIZE;
+    chunkEnd = position;
+  }
+  else
+  {
+    // old text format
+    textStream.str(fileData);
+    textStream.clear();
+  }
+
+  ok = true;
+  return true;
+}
+
+bool SaveFileReader::isBinary()
+{
+  return binary;
+}
+
+bool SaveFileReader::checkChunks(const saveChunkStruct* chunks, int nbChunks)
+{
+  if (!binary) return true;
+
+  std::vector<bool> found(nbChunks, false);
+  unsigned int chunkPosition = SAVE_FILE_HEADER_SIZE;
+
+  while (chunkPosition < fileData.size())
+  {
+    if (chunkPosition + SAVE_CHUNK_HEADER_SIZE > fileData.size())
+    {
+      std::cerr << "[ERROR] Save file: truncated chunk" << std::endl;
+      return false;
+    }
+    const char* header = fileData.data() + chunkPosition;
+    int version = getUint(header + 4, 2);
+    unsigned int size = getUint(header + 6, 4);
+    std::string tag(header, 4);
+
+    int n = 0;
+    while (n < nbChunks && tag != chunks[n].tag) n++;
+    if (n == nbChunks)
+    {
+      std::cerr << "[ERROR] Save file: unknown chunk " << tag << std::endl;
+      return false;
+    }
+    if (version != chunks[n].version)
+    {
+      std::cerr << "[ERROR] Save file: chunk " << tag << " version " << version
+                << " (supported: " << chunks[n].version << ")" << std::endl;
+      return false;
+    }
+    if (size > fileData.size() - chunkPosition - SAVE_CHUNK_HEADER_SIZE)
+    {
+      std::cerr << "[ERROR] Save file: truncated chunk " << tag << std::endl;
+      return false;
+    }
+    found[n] = true;
+    chunkPosition += SAVE_CHUNK_HEADER_SIZE + size;
+  }
+
+  for (int n = 0; n < nbChunks; n++)
+  {
+    if (chunks[n].required && !found[n])
+    {
+      std::cerr << "[ERROR] Save file: missing chunk " << chunks[n].tag << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+bool SaveFileReader::isOk()
+{
+  return ok;
+}
+
+int SaveFileReader::beginChunk(const char* tag)
+{
+  if (!binary) return 0;
+
+  position = chunkEnd;
+  if (position + SAVE_CHUNK_HEADER_SIZE > fileData.size())
+  {
+    ok = false;
+    return -1;
+  }
+
+  const char* header = fileData.data() + position;
+  unsigned int size = getUint(header + 6, 4);
+  if (memcmp(header, tag, 4) != 0 || size > fileData.size() - position - SAVE_CHUNK_HEADER_SIZE)
+  {
+    ok = false;
+    return -1;
+  }
+
+  position += SAVE_CHUNK_HEADER_SIZE;
+  chunkEnd = position + size;
+  return getUint(header + 4, 2);
+}
+
+void SaveFileReader::endChunk()
+{
+  if (binary) position = chunkEnd;
+}
+
+bool SaveFileReader::readBytes(void* dest, unsigned int size)
+{
+  if (position + size > chunkEnd)
+  {
+    ok = false;
+    memset(dest, 0, size);
+    return false;
+  }
+  memcpy(dest, fileData.data() + position, size);
+  position += size;
+  return true;
+}
+
+int SaveFileReader::readInt()
+{
+  int n = 0;
+  if (binary)
+  {
+    char buffer[4];
+    if (readBytes(buffer, 4)) n = (int)getUint(buffer, 4);
+  }
+  else if (!(textStream >> n)) ok = false;
+  return n;
+}
+
+float SaveFileReader::readFloat()
+{
+  float f = 0.0f;
+  if (binary)
+  {
+    char buffer[4];
+    if (readBytes(buffer, 4))
+    {
+      uint32_t n = getUint(buffer, 4);
+      memcpy(&f, &n, 4);
+    }
+  }
+  else if (!(textStream >> f)) ok = false;
+  return f;
+}
+
+bool SaveFileReader::readBool()
+{
+  bool b = false;
+  if (binary)
+  {
+    char c;
+    if (readBytes(&c, 1)) b = c != 0;
+  }
+  else if (!(textStream >> b)) ok = false;
+  return b;
+}
+
+std::string SaveFileReader::readString()
+{
+  std::string s;
+  if (binary)
+  {
+    unsigned int size = readInt();
+    if (ok && size <= chunkEnd - position)
+    {
+      s.assign(fileData.data() + position, size);
+      position += size;
+    }
+    else
+      ok = false;
+  }
+  else if (!(textStream >> s)) ok = false;
+  return s;
+}
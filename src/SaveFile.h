@@ -0,0 +1,176 @@
+/**  This file is part of Witch Blast.
+  *
+  *  Witch Blast is free software: you can redistribute it and/or modify
+  *  it under the terms of the GNU General Public License as published by
+  *  the Free Software Foundation, either version 3 of the License, or
+  *  (at your option) any later version.
+  *
+  *  Witch Blast is distributed in the hope that it will be useful,
+  *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  *  GNU General Public License for more details.
+  *
+  *  You should have received a copy of the GNU General Public License
+  *  along with Witch Blast.  If not, see <http://www.gnu.org/licenses/>.
+  */
+
+#ifndef SAVEFILE_H
+#define SAVEFILE_H
+
+#include <string>
+#include <vector>
+#include <sstream>
+#include <thread>
+#include <cstdint>
+
+/*
+ *  Binary save file layout (little endian):
+ *
+ *  header (20 bytes): magic "WBSV", format version (16 bits), number of chunks (16 bits),
+ *                     data size (32 bits), CRC32 of the data, CRC32 of the 16 first bytes of the header
+ *  data:              chunks, each one with a tag (4 chars), a version (16 bits), the size
+ *                     of its content (32 bits) and its content
+ *
+ *  The chunks are checked before loading (SaveFileReader::checkChunks): a chunk with another
+ *  version than the one supported by the loader, an unknown chunk or a missing required chunk
+ *  makes the file unreadable. Changing the content of a chunk means increasing its version.
+ */
+
+const int SAVE_FILE_FORMAT_VERSION = 1;
+
+/** A chunk known by the loader */
+struct saveChunkStruct
+{
+  const char* tag;  /**< tag (4 chars) */
+  int version;      /**< supported version */
+  bool required;    /**< true if the file must contain it */
+};
+
+/*! \class SaveFileWriter
+* \brief Builds a binary save file and writes it in a background thread
+*
+*  The game state is serialized in memory (a snapshot of the state at the time of the save),
+*  then written to a temporary file and renamed, so a crash while writing never truncates
+*  the previous save file.
+*/
+class SaveFileWriter
+{
+  public:
+    SaveFileWriter();
+    ~SaveFileWriter();
+
+    /*!
+     *  \brief starts a new save (clears the data)
+     */
+    void begin();
+
+    /*!
+     *  \brief starts a chunk
+     *  \param tag : tag of the chunk (4 chars)
+     *  \param version : version of the chunk content
+     */
+    void beginChunk(const char* tag, int version);
+    void endChunk();
+
+    void writeInt(int n);
+    void writeFloat(float f);
+    void writeBool(bool b);
+    void writeString(const std::string& s);
+
+    /*!
+     *  \brief writes the save file in a background thread
+     *
+     *  Waits for the previous write to be done first.
+     *  \param fileName : name of the save file
+     */
+    void writeToFile(const std::string& fileName);
+
+    /*!
+     *  \brief waits for the pending write to be done
+     *  \return false if the last write failed
+     */
+    bool wait();
+
+    /*!
+     *  \brief size of the last save file (bytes)
+     */
+    int getFileSize();
+
+  private:
+    std::vector<char> data;
+    int chunkStart;
+    int nbChunks;
+
+    std::vector<char> fileData;
+    std::string fileName;
+    std::thread writeThread;
+    bool writeFailed;
+
+    void writeFileThread();
+};
+
+/*! \class SaveFileReader
+* \brief Reads a save file, in the binary format or in the old text format
+*
+*  With the text format (whitespace separated values), the chunks are ignored and
+*  their version is 0.
+*/
+class SaveFileReader
+{
+  public:
+    SaveFileReader();
+
+    /*!
+     *  \brief loads the file and checks it
+     *  \param fileName : name of the save file
+     *  \return false if the file is missing or corrupted
+     */
+    bool open(const std::string& fileName);
+
+    bool isBinary();
+
+    /*!
+     *  \brief checks the chunks of the file, before loading it
+     *
+     *  Always true with the text format (no chunk).
+     *  \param chunks : chunks known by the loader
+     *  \param nbChunks : number of known chunks
+     *  \return false if a chunk is unknown or has another version, or if a required chunk is missing
+     */
+    bool checkChunks(const saveChunkStruct* chunks, int nbChunks);
+
+    /*!
+     *  \brief returns false if a value was missing or a chunk was not found
+     */
+    bool isOk();
+
+    /*!
+     *  \brief enters the next chunk
+     *  \param tag : expected tag of the chunk
+     *  \return version of the chunk (0 with the text format, -1 if the chunk is missing)
+     */
+    int beginChunk(const char* tag);
+
+    /*!
+     *  \brief leaves the chunk (skips the values that have not been read)
+     */
+    void endChunk();
+
+    int readInt();
+    float readFloat();
+    bool readBool();
+    std::string readString();
+
+  private:
+    std::string fileData;
+    std::istringstream textStream;
+    bool binary;
+    bool ok;
+
+    unsigned int position;
+    unsigned int chunkEnd;
+
+    bool readBytes(void* dest, unsigned int size);
+};
+
+#endif // SAVEFILE_H
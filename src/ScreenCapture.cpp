@@ -0,0 +1,131 @@
+/**  This file is part of Witch Blast.
+  *
+  *  Witch Blast is free software: you can redistribute it and/or modify
+  *  it under the terms of the GNU General Public License as published by
+  *  the Free Software Foundation, either version 3 of the License, or
+  *  (at your option) any later version.
+  *
+  *  Witch Blast is distributed in the hope that it will be useful,
+  *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  *  GNU General Public License for more details.
+  *
+  *  You should have received a copy of the GNU General Public License
+  *  along with Witch Blast.  If not, see <http://www.gnu.org/licenses/>.
+  */
+
+#include "ScreenCapture.h"
+
+#include <iostream>
+
+ScreenCapture::ScreenCapture()
+{
+  pendingCount = 0;
+  stopping = false;
+}
+
+ScreenCapture::~ScreenCapture()
+{
+  if (captureThread.joinable())
+  {
+    {
+      std::lock_guard<std::mutex> lock(captureMutex);
+      stopping = true;
+    }
+    captureCondition.notify_one();
+    captureThread.join();
+  }
+
+  for (auto texture : texturePool) delete texture;
+  texturePool.clear();
+}
+
+bool ScreenCapture::capture(const sf::RenderWindow& window, const std::string& fileName, sf::IntRect area)
+{
+  sf::Texture* texture = NULL;
+  {
+    std::lock_guard<std::mutex> lock(captureMutex);
+    if (pendingCount >= SCREEN_CAPTURE_MAX_PENDING)
+    {
+      std::cout << "[WARNING] Screen capture dropped: " << fileName << std::endl;
+      return false;
+    }
+    pendingCount++;
+
+    if (!texturePool.empty())
+    {
+      texture = texturePool.back();
+      texturePool.pop_back();
+    }
+  }
+
+  // copy of the back buffer, done by the GPU
+  if (!texture) texture = new sf::Texture();
+  if (texture->getSize() != window.getSize())
+    texture->create(window.getSize().x, window.getSize().y);
+  texture->update(window);
+
+  if (!captureThread.joinable())
+    captureThread = std::thread(&ScreenCapture::captureThreadLoop, this);
+
+  captureStruct capture;
+  capture.texture = texture;
+  capture.fileName = fileName;
+  capture.area = area;
+  {
+    std::lock_guard<std::mutex> lock(captureMutex);
+    captureQueue.push_back(capture);
+  }
+  captureCondition.notify_one();
+
+  return true;
+}
+
+int ScreenCapture::getPendingCount()
+{
+  std::lock_guard<std::mutex> lock(captureMutex);
+  return pendingCount;
+}
+
+void ScreenCapture::captureThreadLoop()
+{
+  // the textures are shared with the context of the thread
+  sf::Context context;
+
+  while (true)
+  {
+    captureStruct capture;
+    {
+      std::unique_lock<std::mutex> lock(captureMutex);
+      captureCondition.wait(lock, [this] { return stopping || !captureQueue.empty(); });
+      if (captureQueue.empty()) return;
+      capture = captureQueue.front();
+      captureQueue.pop_front();
+    }
+
+    sf::Image screenShot = capture.texture->copyToImage();
+
+    {
+      std::lock_guard<std::mutex> lock(captureMutex);
+      texturePool.push_back(capture.texture);
+    }
+
+    bool saved;
+    if (capture.area.width > 0 && capture.area.height > 0)
+    {
+      sf::Image savedImage;
+      savedImage.create(capture.area.width, capture.area.height);
+      savedImage.copy(screenShot, 0, 0, capture.area);
+      saved = savedImage.saveToFile(capture.fileName);
+    }
+    else
+      saved = screenShot.saveToFile(capture.fileName);
+
+    if (!saved) std::cout << "[ERROR] Saving the screen capture: " << capture.fileName << std::endl;
+
+    {
+      std::lock_guard<std::mutex> lock(captureMutex);
+      pendingCount--;
+    }
+  }
+}
@@ -0,0 +1,81 @@
+/**  This file is part of Witch Blast.
+  *
+  *  Witch Blast is free software: you can redistribute it and/or modify
+  *  it under the terms of the GNU General Public License as published by
+  *  the Free Software Foundation, either version 3 of the License, or
+  *  (at your option) any later version.
+  *
+  *  Witch Blast is distributed in the hope that it will be useful,
+  *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  *  GNU General Public License for more details.
+  *
+  *  You should have received a copy of the GNU General Public License
+  *  along with Witch Blast.  If not, see <http://www.gnu.org/licenses/>.
+  */
+
+#ifndef SCREENCAPTURE_H
+#define SCREENCAPTURE_H
+
+#include <SFML/Graphics.hpp>
+#include <string>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+const int SCREEN_CAPTURE_MAX_PENDING = 3;  // captures waiting to be saved (the next ones are dropped)
+
+/*! \class ScreenCapture
+* \brief Saves screenshots without stalling the render thread
+*
+*  The back buffer is copied into a pooled texture (a GPU copy, no read back),
+*  then a worker thread, with its own OpenGL context, reads the texture back,
+*  crops it and encodes the PNG file.
+*/
+class ScreenCapture
+{
+  public:
+    ScreenCapture();
+
+    /*!
+     *  \brief waits for the pending captures to be saved
+     */
+    ~ScreenCapture();
+
+    /*!
+     *  \brief captures the window and saves it in the background
+     *  \param window : the window (its back buffer is captured)
+     *  \param fileName : name of the PNG file
+     *  \param area : area to save (the whole window if empty)
+     *  \return false if the queue is full (the capture is dropped)
+     */
+    bool capture(const sf::RenderWindow& window, const std::string& fileName, sf::IntRect area = sf::IntRect());
+
+    /*!
+     *  \brief returns the number of captures waiting to be saved
+     */
+    int getPendingCount();
+
+  private:
+    struct captureStruct
+    {
+      sf::Texture* texture;
+      std::string fileName;
+      sf::IntRect area;
+    };
+
+    std::vector<sf::Texture*> texturePool;
+    std::deque<captureStruct> captureQueue;
+    int pendingCount;
+
+    std::mutex captureMutex;
+    std::condition_variable captureCondition;
+    std::thread captureThread;
+    bool stopping;
+
+    void captureThreadLoop();
+};
+
+#endif // SCREENCAPTURE_H
@@ -70,6 +70,7 @@ SlimeEntity::SlimeEntity(float x, float y, slimeTypeEnum slimeType, bool invocat
   isPet = false;
   willExplode = false;
   noCollisionTimer = -1.0f;
+  hasThinkStep = true;
 }
 
 void SlimeEntity::setH(float h)
@@ -126,24 +127,9 @@ void SlimeEntity::animate(float delay)
   }
   else
   {
+    // the jump is decided by think()
     jumpingDelay -= slimeDelay;
-    if (jumpingDelay < 0.0f)
-    {
-      SoundManager::getInstance().playSound(SOUND_SLIME_JUMP);
-      hVelocity = 350.0f + rand() % 300;
-      isJumping = true;
-      isFirstJumping = true;
-
-      float randVel = 250.0f + rand() % 250;
-
-      if (!game().getPlayer()->isEquiped(EQUIP_MANUAL_SLIMES) && rand() % 2 == 0)
-      {
-        setVelocity(Vector2D(x, y).vectorTo(game().getPlayerPosition(), randVel ));
-      }
-      else
-        velocity = Vector2D(randVel);
-    }
-    else if (jumpingDelay < 0.1f)
+    if (jumpingDelay < 0.1f)
       frame = 1;
     else frame = 0;
   }
@@ -152,6 +138,25 @@ void SlimeEntity::animate(float delay)
   z = y + 14;
 }
 
+void SlimeEntity::think(float delay)
+{
+  if (isJumping || jumpingDelay >= 0.0f) return;
+
+  SoundManager::getInstance().playSound(SOUND_SLIME_JUMP);
+  hVelocity = 350.0f + rand() % 300;
+  isJumping = true;
+  isFirstJumping = true;
+
+  float randVel = 250.0f + rand() % 250;
+
+  if (!game().getPlayer()->isEquiped(EQUIP_MANUAL_SLIMES) && rand() % 2 == 0)
+  {
+    setVelocity(Vector2D(x, y).vectorTo(game().getPlayerPosition(), randVel ));
+  }
+  else
+    velocity = Vector2D(randVel);
+}
+
 void SlimeEntity::makeExplode()
 {
   if (isJumping)
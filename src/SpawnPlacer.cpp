@@ -0,0 +1,96 @@
+/**  This file is part of Witch Blast.
+  *
+  *  Witch Blast is free software: you can redistribute it and/or modify
+  *  it under the terms of the GNU General Public License as published by
+  *  the Free Software Foundation, either version 3 of the License, or
+  *  (at your option) any later version.
+  *
+  *  Witch Blast is distributed in the hope that it will be useful,
+  *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  *  GNU General Public License for more details.
+  *
+  *  You should have received a copy of the GNU General Public License
+  *  along with Witch Blast.  If not, see <http://www.gnu.org/licenses/>.
+  */
+
+#include "SpawnPlacer.h"
+
+#include <stdlib.h>
+
+bool SpawnPlacer::isInBounds(spawnTypeEnum spawnType, int xm, int ym)
+{
+  if (spawnType == SpawnLarge)
+    return xm >= 2 && xm <= MAP_WIDTH - 4 && ym >= 2 && ym <= MAP_HEIGHT - 4;
+  else
+    return xm >= 1 && xm <= MAP_WIDTH - 3 && ym >= 1 && ym <= MAP_HEIGHT - 3;
+}
+
+SpawnPlacer::spawnTypeEnum SpawnPlacer::getSpawnType(enemyTypeEnum monsterType)
+{
+  switch (monsterType)
+  {
+  case EnemyTypeBat:
+  case EnemyTypeImpBlue:
+  case EnemyTypeImpRed:
+    return SpawnFlying;
+
+  case EnemyTypeSlimeLarge:
+  case EnemyTypeSlimeBlueLarge:
+  case EnemyTypeSlimeRedLarge:
+  case EnemyTypeSlimeVioletLarge:
+    return SpawnLarge;
+
+  default:
+    return SpawnWalking;
+  }
+}
+
+void SpawnPlacer::build(const bool walkable[MAP_WIDTH][MAP_HEIGHT], const bool flyable[MAP_WIDTH][MAP_HEIGHT],
+                        const bool occupied[MAP_WIDTH][MAP_HEIGHT], float xPlayer, float yPlayer)
+{
+  for (int n = 0; n < NB_SPAWN_TYPES; n++) candidates[n].clear();
+
+  for (int xm = 1; xm <= MAP_WIDTH - 3; xm++)
+    for (int ym = 1; ym <= MAP_HEIGHT - 3; ym++)
+    {
+      if (occupied[xm][ym]) continue;
+
+      float xMonster = xm * TILE_WIDTH + TILE_WIDTH * 0.5f;
+      float yMonster = ym * TILE_HEIGHT+ TILE_HEIGHT * 0.5f;
+      float dist2 = (xMonster - xPlayer)*(xMonster - xPlayer) + (yMonster - yPlayer)*(yMonster - yPlayer);
+      if ( dist2 < SPAWN_MIN_DISTANCE2) continue;
+
+      if (walkable[xm][ym])
+      {
+        candidates[SpawnWalking].push_back(IntCoord(xm, ym));
+        if (isInBounds(SpawnLarge, xm, ym))
+          candidates[SpawnLarge].push_back(IntCoord(xm, ym));
+      }
+      if (flyable[xm][ym])
+        candidates[SpawnFlying].push_back(IntCoord(xm, ym));
+    }
+}
+
+bool SpawnPlacer::take(spawnTypeEnum spawnType, bool occupied[MAP_WIDTH][MAP_HEIGHT], IntCoord* tile)
+{
+  std::vector<IntCoord>& list = candidates[spawnType];
+
+  // random draw without replacement
+  // (the tiles taken from another list are skipped when drawn)
+  while (!list.empty())
+  {
+    int n = rand() % list.size();
+    IntCoord candidate = list[n];
+    list[n] = list.back();
+    list.pop_back();
+
+    if (!occupied[candidate.x][candidate.y])
+    {
+      occupied[candidate.x][candidate.y] = true;
+      *tile = candidate;
+      return true;
+    }
+  }
+  return false;
+}
@@ -0,0 +1,88 @@
+/**  This file is part of Witch Blast.
+  *
+  *  Witch Blast is free software: you can redistribute it and/or modify
+  *  it under the terms of the GNU General Public License as published by
+  *  the Free Software Foundation, either version 3 of the License, or
+  *  (at your option) any later version.
+  *
+  *  Witch Blast is distributed in the hope that it will be useful,
+  *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  *  GNU General Public License for more details.
+  *
+  *  You should have received a copy of the GNU General Public License
+  *  along with Witch Blast.  If not, see <http://www.gnu.org/licenses/>.
+  */
+
+#ifndef SPAWNPLACER_H
+#define SPAWNPLACER_H
+
+#include "sfml_game/MyTools.h"
+#include "Constants.h"
+#include "BaseCreatureEntity.h"
+#include <vector>
+
+const float SPAWN_MIN_DISTANCE2 = 75000.0f;   // min squared distance between a spawned monster and the player
+
+/*! \class SpawnPlacer
+* \brief Free tiles of a room, for the random monster placement
+*
+*  The candidate tiles (walkable, flyable, far enough from the walls for the large monsters)
+*  are listed once after the room generation, then drawn without replacement: a placement
+*  costs O(1) and only fails when no suitable tile is left.
+*  It only knows the tile flags, so the placement can be checked without the game
+*  (see tools/SpawnPlacementCheck.cpp).
+*/
+class SpawnPlacer
+{
+  public:
+    /** Spawn type enum
+     *  Tiles lists for the monster placement.
+     */
+    enum spawnTypeEnum
+    {
+      SpawnWalking,   /**< Walkable tiles */
+      SpawnFlying,    /**< Flyable tiles */
+      SpawnLarge,     /**< Walkable tiles, far enough from the walls for large monsters */
+      NB_SPAWN_TYPES
+    };
+
+    /*!
+     *  \brief lists the free tiles of a room, far enough from the player
+     *  \param walkable : walkable tiles of the room
+     *  \param flyable : flyable tiles of the room
+     *  \param occupied : tiles already taken by a monster
+     *  \param xPlayer : x position of the player (pixels)
+     *  \param yPlayer : y position of the player (pixels)
+     */
+    void build(const bool walkable[MAP_WIDTH][MAP_HEIGHT], const bool flyable[MAP_WIDTH][MAP_HEIGHT],
+               const bool occupied[MAP_WIDTH][MAP_HEIGHT], float xPlayer, float yPlayer);
+
+    /*!
+     *  \brief draws a free tile and marks it as occupied
+     *
+     *  The tiles occupied since build() (taken from another list, or by a monster placed at a fixed position) are skipped.
+     *  \param spawnType : type of tile
+     *  \param occupied : tiles already taken by a monster (updated)
+     *  \param tile : the tile found
+     *  \return false if no suitable tile is left
+     */
+    bool take(spawnTypeEnum spawnType, bool occupied[MAP_WIDTH][MAP_HEIGHT], IntCoord* tile);
+
+    /*!
+     *  \brief checks if a tile can be a candidate of a list
+     *
+     *  Bounds of the random placement: the large monsters stay one more tile away from the walls.
+     */
+    static bool isInBounds(spawnTypeEnum spawnType, int xm, int ym);
+
+    /*!
+     *  \brief returns the list a monster is placed from (flying and large monsters)
+     */
+    static spawnTypeEnum getSpawnType(enemyTypeEnum monsterType);
+
+  private:
+    std::vector<IntCoord> candidates[NB_SPAWN_TYPES];
+};
+
+#endif // SPAWNPLACER_H
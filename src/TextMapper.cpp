@@ -1,23 +1,57 @@
 #include "TextMapper.h"
 
+#include "sfml_game/AssetArchive.h"
+
 #include <fstream>
+#include <sstream>
 #include <iostream>
+#include <cstring>
 
 namespace tools
 {
+	static void putUint(std::string & dest, uint32_t n)
+	{
+		for (int i = 0; i < 4; i++) dest.push_back((char)((n >> (8 * i)) & 0xFF));
+	}
+
+	static uint32_t getUint(const char * source)
+	{
+		const unsigned char * s = (const unsigned char *)source;
+		return (uint32_t)s[0] | ((uint32_t)s[1] << 8) | ((uint32_t)s[2] << 16) | ((uint32_t)s[3] << 24);
+	}
+
 	void setLanguage(const std::string & language)
 	{
 		TextMapper::instance().setLanguage(language);
 	}
 
-	const std::string getLabel(const std::string & key)
+	const std::string & getLabel(const std::string & key)
 	{
 		return TextMapper::instance().getText(key);
 	}
 
+	const std::string & getLabel(const char * key)
+	{
+		return TextMapper::instance().getText(key, strlen(key));
+	}
+
+	int getLabelId(const std::string & key)
+	{
+		return TextMapper::instance().getId(key.c_str(), key.size());
+	}
+
+	const std::string & getLabel(int id)
+	{
+		return TextMapper::instance().getText(id);
+	}
+
 	TextMapper::TextMapper()
-		: separator('#')
-		, textFileName("labels.txt")
+		: textFileName("labels.txt")
+		, table(NULL)
+		, tableSize(0)
+		, labelCount(0)
+		, slotCount(0)
+		, texts(NULL)
 	{
 		LoadTextFile("english");
 	}
@@ -30,40 +64,231 @@ namespace tools
 
 	void TextMapper::setLanguage(const std::string & language)
 	{
-		textMap.clear(); // clear old map
-		LoadTextFile(language); // load new text map
+		LoadTextFile(language); // load new label table
+	}
+
+	const std::string & TextMapper::getText(const char * key, size_t keySize)
+	{
+		int id = getId(key, keySize);
+		if (id >= 0) return (*texts)[id];
+
+		// unknown key: "[key]"
+		std::string missingKey(key, keySize);
+		TextMap::iterator it = missingTexts.find(missingKey);
+		if (it == missingTexts.end())
+			it = missingTexts.insert(std::make_pair(missingKey, "[" + missingKey + "]")).first;
+		return it->second;
+	}
+
+	const std::string & TextMapper::getText(int id)
+	{
+		if (!texts || id < 0 || id >= (int)texts->size()) return getText("", 0);
+		return (*texts)[id];
+	}
+
+	int TextMapper::getId(const char * key, size_t keySize) const
+	{
+		if (!table || slotCount == 0) return -1;
+
+		const char * labels = table + LABEL_TABLE_HEADER_SIZE;
+		const char * slots = labels + labelCount * LABEL_TABLE_ENTRY_SIZE;
+		const char * strings = slots + slotCount * 4;
+
+		uint32_t slot = hashKey(key, keySize) & (slotCount - 1);
+		for (uint32_t i = 0; i < slotCount; i++)
+		{
+			uint32_t n = getUint(slots + slot * 4);
+			if (n == 0) return -1;
+
+			const char * label = labels + (n - 1) * LABEL_TABLE_ENTRY_SIZE;
+			if (getUint(label + 4) == keySize && memcmp(strings + getUint(label), key, keySize) == 0)
+				return n - 1;
+			slot = (slot + 1) & (slotCount - 1);
+		}
+		return -1;
+	}
+
+	uint32_t TextMapper::hashKey(const char * key, size_t keySize)
+	{
+		uint32_t hash = 2166136261u;
+		for (size_t i = 0; i < keySize; i++)
+		{
+			hash ^= (unsigned char)key[i];
+			hash *= 16777619u;
+		}
+		return hash;
+	}
+
+	void TextMapper::compileTextFile(std::istream & textFile, std::map<std::string, std::string> & tables)
+	{
+		// 1. load every language section
+		std::map<std::string, TextMap> languages;
+		std::map<std::string, uint32_t> keys;
+		TextMap * textMap = NULL;
+		std::string line;
+		while (std::getline(textFile, line))
+		{
+			std::string trimmed = trim(line);
+			if (trimmed.empty())
+				continue;
+			if (trimmed[0] == '[')
+			{
+				// [language]
+				if (trimmed.size() > 2 && trimmed[trimmed.size() - 1] == ']')
+					textMap = &languages[trimmed.substr(1, trimmed.size() - 2)];
+				else
+					textMap = NULL;
+			}
+			else if (textMap)
+			{
+				std::pair<std::string, std::string> text = split(trimmed);
+				textMap->insert(text);
+				keys[text.first] = 0;
+			}
+		}
+
+		// 2. ids: the keys of every language, sorted
+		uint32_t labelCount = 0;
+		for (auto & key : keys) key.second = labelCount++;
+
+		uint32_t slotCount = 16;
+		while (slotCount < labelCount * 2) slotCount *= 2;
+
+		std::vector<uint32_t> slots(slotCount, 0);
+		for (auto & key : keys)
+		{
+			uint32_t slot = hashKey(key.first.c_str(), key.first.size()) & (slotCount - 1);
+			while (slots[slot] != 0) slot = (slot + 1) & (slotCount - 1);
+			slots[slot] = key.second + 1;
+		}
+
+		// 3. one table per language
+		tables.clear();
+		for (auto & language : languages)
+		{
+			std::string labels;
+			std::string strings;
+			for (auto & key : keys)
+			{
+				putUint(labels, strings.size());
+				putUint(labels, key.first.size());
+				strings.append(key.first);
+				strings.push_back('\0');
+
+				TextMap::const_iterator text = language.second.find(key.first);
+				if (text == language.second.end())
+				{
+					putUint(labels, 0);
+					putUint(labels, LABEL_TABLE_NO_TEXT);
+				}
+				else
+				{
+					putUint(labels, strings.size());
+					putUint(labels, text->second.size());
+					strings.append(text->second);
+					strings.push_back('\0');
+				}
+			}
+
+			std::string & table = tables[language.first];
+			table.append(LABEL_TABLE_MAGIC, 4);
+			putUint(table, LABEL_TABLE_VERSION);
+			putUint(table, labelCount);
+			putUint(table, slotCount);
+			putUint(table, strings.size());
+			putUint(table, 0);
+			table.append(labels);
+			for (uint32_t slot : slots) putUint(table, slot);
+			table.append(strings);
+		}
+	}
+
+	bool TextMapper::useTable(const std::string & language, const char * data, size_t size)
+	{
+		if (size < LABEL_TABLE_HEADER_SIZE || memcmp(data, LABEL_TABLE_MAGIC, 4) != 0
+			|| getUint(data + 4) != LABEL_TABLE_VERSION)
+			return false;
+
+		uint32_t count = getUint(data + 8);
+		uint32_t slots = getUint(data + 12);
+		uint32_t stringsSize = getUint(data + 16);
+		if (slots == 0 || (slots & (slots - 1)) != 0 || slots <= count) return false;
+		uint64_t stringsOffset = LABEL_TABLE_HEADER_SIZE + (uint64_t)count * LABEL_TABLE_ENTRY_SIZE + (uint64_t)slots * 4;
+		if (stringsOffset + stringsSize != size) return false;
+
+		const char * strings = data + stringsOffset;
+		for (uint32_t i = 0; i < count; i++)
+		{
+			const char * label = data + LABEL_TABLE_HEADER_SIZE + i * LABEL_TABLE_ENTRY_SIZE;
+			if ((uint64_t)getUint(label) + getUint(label + 4) > stringsSize) return false;
+			if (getUint(label + 12) != LABEL_TABLE_NO_TEXT && (uint64_t)getUint(label + 8) + getUint(label + 12) > stringsSize)
+				return false;
+		}
+		for (uint32_t i = 0; i < slots; i++)
+			if (getUint(data + stringsOffset - (slots - i) * 4) > count) return false;
+
+		table = data;
+		tableSize = size;
+		labelCount = count;
+		slotCount = slots;
+
+		// the texts are built once per language and kept: a lookup needs no allocation,
+		// and the labels returned before a language change stay valid
+		texts = &languageTexts[language];
+		if (texts->size() == count) return true;
+		texts->resize(count);
+		for (uint32_t i = 0; i < count; i++)
+		{
+			const char * label = data + LABEL_TABLE_HEADER_SIZE + i * LABEL_TABLE_ENTRY_SIZE;
+			if (getUint(label + 12) == LABEL_TABLE_NO_TEXT)
+				(*texts)[i] = "[" + std::string(strings + getUint(label), getUint(label + 4)) + "]";
+			else
+				(*texts)[i].assign(strings + getUint(label + 8), getUint(label + 12));
+		}
+		return true;
 	}
 
 	void TextMapper::LoadTextFile(const std::string & language)
 	{
-		// 1. open file
-		std::ifstream textFile("data/" + textFileName);
+		// 1. label table compiled for the language, in the asset archive
+		const void* data;
+		std::size_t size;
+		std::string tableName = "data/labels_" + language + ".bin";
+		if (AssetArchive::getInstance().find(tableName, data, size))
+		{
+			if (useTable(language, (const char*)data, size))
+				return;
+			std::cout << "[ERROR] Invalid label table: " << tableName << std::endl;
+		}
+
+		// 2. no table (development): the text file is compiled (in the asset archive, or on the disk)
+		std::string fileName = "data/" + textFileName;
+		std::ifstream diskFile;
+		std::istringstream archiveFile;
+		bool inArchive = AssetArchive::getInstance().find(fileName, data, size);
+		if (inArchive)
+			archiveFile.str(std::string((const char*)data, size));
+		else
+			diskFile.open(fileName.c_str());
+		std::istream& textFile = inArchive ? (std::istream&)archiveFile : (std::istream&)diskFile;
 		if (!textFile)
 			std::cout << "[ERROR] No text file !";
 
-		// 2. find language section
-		std::string line;
-		bool found = false;
-		std::string token = "[" + language + "]";
-		while (!found && std::getline(textFile, line))
-			found = (trim(line) == token);
+		std::map<std::string, std::string> tables;
+		compileTextFile(textFile, tables);
 
-		if (!found)
+		// 3. find language section
+		std::map<std::string, std::string>::iterator it = tables.find(language);
+		if (it == tables.end())
 		{
 			std::string errMsg = "[ERROR] Language '" + language + "' NOT FOUND !";
 			std::cout << errMsg.c_str();
+			return;
 		}
 
-		// 3. load map
-		bool mustStop = false;
-		while (std::getline(textFile, line) && !mustStop)
-		{
-			std::string trimmed = trim(line);
-			if (trimmed[0] == '[')
-				mustStop = true;
-			else if (!trimmed.empty())
-				textMap.insert(split(trimmed));
-		}
+		// 4. load table
+		compiledTable.swap(it->second);
+		useTable(language, compiledTable.data(), compiledTable.size());
 	}
 
 } // end namespace tools
@@ -23,19 +23,50 @@ calling the member or free function setLanguage()
 
 -> 'text description file': it's basically a map of pairs "key"/"value", separated by a given separator, where "value" is the text that will be displayed in the game.
 this file is separated in x parts: each part correspond to a language. Each part is defined by the markup [language], where "language" is one of the supported language.
+
+-> 'label table': the text file compiled for one language (tools/LabelCompiler.cpp, data/labels_<language>.bin in the asset archive).
+Every key of the text file gets an id (its index in the sorted keys, the same in every language), and the table contains
+a hash table of the keys, so a key is found without any allocation. The table is used in place in the mapped archive.
+Without the archive (development), the tables are compiled from the text file when the language is set.
 */
 
 #ifndef __TEXTMAPPER
 #define __TEXTMAPPER
 
 #include <map>
+#include <vector>
 #include <string>
+#include <istream>
+#include <cstdint>
 
 namespace tools
 {
 
 	void setLanguage(const std::string & language);
-	const std::string getLabel(const std::string & key);
+
+	// the texts of a language are kept after setLanguage: the references stay valid
+	const std::string & getLabel(const std::string & key);
+	const std::string & getLabel(const char * key);
+
+	// ids: for the labels displayed every frame (the id does not change with the language)
+	int getLabelId(const std::string & key);
+	const std::string & getLabel(int id);
+
+	/*
+	 *  Label table layout (little endian):
+	 *
+	 *  header (24 bytes): magic "WBLT", format version, number of labels, number of hash slots,
+	 *                     size of the strings block, unused
+	 *  labels:            one entry (16 bytes) per id: offset and size of the key, offset and size of the text
+	 *                     in the strings block (size 0xFFFFFFFF: no text in this language)
+	 *  hash slots:        id + 1 of the key in the slot (0: empty slot), FNV-1a hash, linear probing
+	 *  strings:           keys and texts, zero terminated
+	 */
+	const char LABEL_TABLE_MAGIC[4] = { 'W', 'B', 'L', 'T' };
+	const uint32_t LABEL_TABLE_VERSION = 1;
+	const uint32_t LABEL_TABLE_HEADER_SIZE = 24;
+	const uint32_t LABEL_TABLE_ENTRY_SIZE = 16;
+	const uint32_t LABEL_TABLE_NO_TEXT = 0xFFFFFFFF;
 
 	class TextMapper
 	{
@@ -46,8 +77,14 @@ namespace tools
 		static TextMapper& instance();
 
 		void setLanguage(const std::string & language);
-		inline const std::string getText(const std::string & key) const
-		{ return textMap.find(key) != textMap.end() ? textMap.find(key)->second : "[" + key + "]" ; }
+
+		const std::string & getText(const char * key, size_t keySize);
+		inline const std::string & getText(const std::string & key) { return getText(key.c_str(), key.size()); }
+		const std::string & getText(int id);
+		int getId(const char * key, size_t keySize) const;
+
+		/* compiles the text file: one label table per language (language -> table) */
+		static void compileTextFile(std::istream & textFile, std::map<std::string, std::string> & tables);
 
 	private:
 		TextMapper();								// hidden ctor
@@ -55,6 +92,7 @@ namespace tools
 		void operator=(TextMapper const&) = delete;	// don't implement
 
 		void LoadTextFile(const std::string & language);
+		bool useTable(const std::string & language, const char * data, size_t size);
 
 		/* tools funcs */
 		// std::isspace function fail with some chars (à,é,è, etc.)
@@ -78,15 +116,25 @@ namespace tools
 		inline static std::string trim(const std::string &s){ return (ltrim(rtrim(s))); }
 
 		// split using separator
-		inline std::pair<std::string, std::string> split(const std::string & s) const {
+		inline static std::pair<std::string, std::string> split(const std::string & s) {
 			auto pos = s.find_first_of(separator);
 			return std::make_pair(s.substr(0, pos), s.substr(pos + 1, s.size() - pos));
 		}
 
+		static uint32_t hashKey(const char * key, size_t keySize);
+
 	private:
-		const char separator;
+		static const char separator = '#';
 		const std::string textFileName;
-		TextMap textMap;
+
+		const char * table;				// label table of the language (mapped archive or compiledTable)
+		size_t tableSize;
+		std::string compiledTable;		// table compiled from the text file (without archive)
+		uint32_t labelCount;
+		uint32_t slotCount;
+		std::vector<std::string> * texts;	// by id, of the current language
+		std::map<std::string, std::vector<std::string> > languageTexts;	// every language used (never freed)
+		TextMap missingTexts;			// "[key]", for the keys without text
 	};
 
 
@@ -94,10 +94,8 @@ int VampireEntity::getHealthLevel()
   return healthLevel;
 }
 
-void VampireEntity::computeStates(float delay)
+void VampireEntity::think(float delay)
 {
-  timer -= delay;
-
   if (timer <= 0.0f)
   {
     if (state == 0) // waiting bef hypnose
@@ -282,7 +280,9 @@ void VampireEntity::animate(float delay)
   EnemyEntity::animate(delay);
   if (isAgonising) return;
 
-  computeStates(delay);
+  timer -= delay;
+  if (timer <= 0.0f) promoteThink();
+  updateThink(delay);
   if (state == 0)
   {
     if (timer < 0.2f) frame = 1;
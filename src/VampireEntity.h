@@ -17,7 +17,7 @@ class VampireEntity : public EnemyEntity
 	  virtual void drop();
 	  virtual int hurt(StructHurt hurtParam) override;
 
-	  void computeStates(float delay);
+    virtual void think(float delay) override;
 	  int getHealthLevel();
 	  virtual void prepareDying() override;
 
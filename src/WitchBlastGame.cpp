@@ -19,8 +19,11 @@
 #include "sfml_game/TileMapEntity.h"
 #include "DungeonMap.h"
 #include "sfml_game/ImageManager.h"
+#include "sfml_game/JobSystem.h"
 #include "sfml_game/SoundManager.h"
 #include "sfml_game/EntityManager.h"
+#include "sfml_game/AssetArchive.h"
+#include "sfml_game/InputManager.h"
 #include "Constants.h"
 #include "RatEntity.h"
 #include "BlackRatEntity.h"
@@ -61,6 +64,7 @@
 #include "SlimePetEntity.h"
 #include "SausageEntity.h"
 #include "FairyEntity.h"
+#include "RoomRecipes.h"
 
 #include <iostream>
 #include <sstream>
@@ -82,6 +86,83 @@ const unsigned int ACHIEV_LINES = 3;
 
 const int VolumeModifier = 55;
 
+/** Sounds only played by a monster (they are loaded with the floors where it can be met) */
+struct enemySoundStruct
+{
+  enemyTypeEnum enemy;
+  sound_resources sound;
+};
+
+const enemySoundStruct enemySounds[] =
+{
+  { EnemyTypeBat, SOUND_BAT_DYING },
+  { EnemyTypeSnake, SOUND_SNAKE_DIE },
+  { EnemyTypeSnakeBlood, SOUND_SNAKE_DIE },
+  { EnemyTypeImpBlue, SOUND_IMP_HURT },         { EnemyTypeImpBlue, SOUND_IMP_DYING },
+  { EnemyTypeImpRed, SOUND_IMP_HURT },          { EnemyTypeImpRed, SOUND_IMP_DYING },
+  { EnemyTypePumpkin, SOUND_PUMPKIN_00 },       { EnemyTypePumpkin, SOUND_PUMPKIN_01 },
+  { EnemyTypePumpkin, SOUND_PUMPKIN_DIE },
+  { EnemyTypeWitch, SOUND_WITCH_00 },           { EnemyTypeWitch, SOUND_WITCH_DIE_00 },
+  { EnemyTypeWitchRed, SOUND_WITCH_00 },        { EnemyTypeWitchRed, SOUND_WITCH_DIE_00 },
+  { EnemyTypeCauldron, SOUND_CAULDRON },        { EnemyTypeCauldron, SOUND_CAULDRON_DIE },
+  { EnemyTypeCauldronElemental, SOUND_CAULDRON }, { EnemyTypeCauldronElemental, SOUND_CAULDRON_DIE },
+  { EnemyTypeGhost, SOUND_GHOST },              { EnemyTypeGhost, SOUND_GHOST_DYING },
+  { EnemyTypeZombie, SOUND_ZOMBIE_00 },         { EnemyTypeZombie, SOUND_ZOMBIE_ATTACKING },
+  { EnemyTypeZombie, SOUND_ZOMBIE_DYING },
+  { EnemyTypeZombieDark, SOUND_ZOMBIE_00 },     { EnemyTypeZombieDark, SOUND_ZOMBIE_ATTACKING },
+  { EnemyTypeZombieDark, SOUND_ZOMBIE_DYING },
+  { EnemyTypeBogeyman, SOUND_BOGEYMAN_ATTACK }, { EnemyTypeBogeyman, SOUND_BOGEYMAN_DIE },
+  { EnemyTypeBogeyman, SOUND_BOGEYMAN_VORTEX_00 }, { EnemyTypeBogeyman, SOUND_BOGEYMAN_VORTEX_01 },
+
+  // bosses
+  { EnemyTypeButcher, SOUND_BUTCHER_00 },       { EnemyTypeButcher, SOUND_BUTCHER_01 },
+  { EnemyTypeButcher, SOUND_BUTCHER_HURT },     { EnemyTypeButcher, SOUND_BUTCHER_DIE },
+  { EnemyTypeCyclops, SOUND_CYCLOP_00 },        { EnemyTypeCyclops, SOUND_CYCLOP_DIE },
+  { EnemyTypeCyclops, SOUND_HEAVY_STEP_00 },    { EnemyTypeCyclops, SOUND_HEAVY_STEP_01 },
+  { EnemyTypeCyclops, SOUND_THROW },
+  { EnemyTypeRatKing, SOUND_KING_RAT_1 },       { EnemyTypeRatKing, SOUND_KING_RAT_2 },
+  { EnemyTypeRatKing, SOUND_KING_RAT_DIE },     { EnemyTypeRatKing, SOUND_BIG_WALL_IMPACT },
+  { EnemyTypeSpiderGiant, SOUND_SPIDER_DIE },   { EnemyTypeSpiderGiant, SOUND_SPIDER_HURT },
+  { EnemyTypeSpiderGiant, SOUND_SPIDER_WALKING }, { EnemyTypeSpiderGiant, SOUND_EGG_SMASH_00 },
+  { EnemyTypeSpiderGiant, SOUND_EGG_SMASH_01 }, { EnemyTypeSpiderGiant, SOUND_SPIDER_LITTLE_DIE },
+  { EnemyTypeFrancky, SOUND_FRANCKY_00 },       { EnemyTypeFrancky, SOUND_FRANCKY_01 },
+  { EnemyTypeFrancky, SOUND_FRANCKY_02 },       { EnemyTypeFrancky, SOUND_FRANCKY_DYING },
+  { EnemyTypeFrancky, SOUND_ELECTRICITY },      { EnemyTypeFrancky, SOUND_ELECTRIC_BLAST },
+  { EnemyTypeVampire, SOUND_VAMPIRE_FLYING },   { EnemyTypeVampire, SOUND_VAMPIRE_FLAP },
+  { EnemyTypeVampire, SOUND_VAMPIRE_SONIC_RAY }, { EnemyTypeVampire, SOUND_VAMPIRE_LAUGHING },
+  { EnemyTypeVampire, SOUND_VAMPIRE_TRANSFORM_BOLT }, { EnemyTypeVampire, SOUND_VAMPIRE_TRANSFORM_BAT },
+  { EnemyTypeVampire, SOUND_VAMPIRE_HYPNOSIS }, { EnemyTypeVampire, SOUND_VAMPIRE_CRY },
+  { EnemyTypeVampire, SOUND_VAMPIRE_DYING },
+};
+
+/** Sprite sheets only used by a boss: streamed, they are in the video memory on its floors only */
+struct enemyImageStruct
+{
+  enemyTypeEnum enemy;
+  enum_images image;
+};
+
+const enemyImageStruct enemyImages[] =
+{
+  { EnemyTypeButcher, IMAGE_BUTCHER },
+  { EnemyTypeRatKing, IMAGE_KING_RAT },
+  { EnemyTypeSpiderGiant, IMAGE_GIANT_SPIDER },
+  { EnemyTypeFrancky, IMAGE_FRANCKY },
+  { EnemyTypeVampire, IMAGE_VAMPIRE },          { EnemyTypeVampire, IMAGE_VAMPIRE_BAT },
+  { EnemyTypeVampire, IMAGE_VAMPIRE_PART },
+};
+
+// the font reads its file while it is used: the archive stays mapped
+static bool loadFont(sf::Font& font, const std::string& fileName)
+{
+  const void* data;
+  std::size_t size;
+  if (AssetArchive::getInstance().find(fileName, data, size))
+    return font.loadFromMemory(data, size);
+  else
+    return font.loadFromFile(fileName);
+}
+
 static std::string intToString(int n)
 {
   std::ostringstream oss;
@@ -89,6 +170,31 @@ static std::string intToString(int n)
   return oss.str();
 }
 
+// a score in the record log: the fields of the old hi-scores file
+static std::string scoreToString(const WitchBlastGame::StructScore& score)
+{
+  std::ostringstream oss;
+  oss << score.name << " " << score.level << " " << score.score << " " << score.shotType << " "
+      << score.divinity << " " << score.killedBy << " " << score.time;
+  for (int i = 0; i < NUMBER_EQUIP_ITEMS; i++)
+    oss << " " << score.equip[i];
+  return oss.str();
+}
+
+static WitchBlastGame::StructScore scoreFromString(const std::string& data)
+{
+  WitchBlastGame::StructScore score;
+  std::istringstream iss(data);
+  iss >> score.name >> score.level >> score.score >> score.shotType
+      >> score.divinity >> score.killedBy >> score.time;
+  for (int i = 0; i < NUMBER_EQUIP_ITEMS; i++)
+  {
+    score.equip[i] = false;
+    iss >> score.equip[i];
+  }
+  return score;
+}
+
 static std::string keyToString(sf::Keyboard::Key key)
 {
   std::string s = "Unknown";
@@ -317,8 +423,22 @@ WitchBlastGame* gameptr;
 WitchBlastGame::WitchBlastGame()
 {
   gameptr = this;
+  sf::Clock startupClock;
+
+  // without the archive (development), the assets are loaded from media/ and data/
+  if (AssetArchive::getInstance().open(ASSET_ARCHIVE_FILE))
+    std::cout << "Asset archive: " << AssetArchive::getInstance().getEntryCount() << " files" << std::endl;
 
   gameFromSaveFile = false;
+  pipelinedFrame = false;
+  frameTiming.update = frameTiming.simulation = frameTiming.render = frameTiming.display = frameTiming.wait = 0.0f;
+  roomChanges = 0;
+  simulationRequested = false;
+  simulationRunning = false;
+  simulationStopping = false;
+  frameTimingSum = frameTiming;
+  frameTimingCount = 0;
+  frameTimingPipelined = false;
   configureFromFile();
 
   if (parameters.vsync == false)
@@ -406,8 +526,10 @@ WitchBlastGame::WitchBlastGame()
     "media/arrow_pad.png",
   };
 
-  for (const char *const filename : images)
-    ImageManager::getInstance().addImage(filename);
+  ImageManager::getInstance().setCacheDirectory(ImageCache::getUserDirectory(IMAGE_CACHE_NAME));
+  std::vector<bool> streamedImages(std::end(images) - std::begin(images), false);
+  for (const enemyImageStruct& enemyImage : enemyImages) streamedImages[enemyImage.image] = true;
+  ImageManager::getInstance().addImages(std::vector<std::string>(std::begin(images), std::end(images)), streamedImages);
 
   const char *const sounds[] =
   {
@@ -484,21 +606,57 @@ WitchBlastGame::WitchBlastGame()
   // AA in fullscreen
   if (parameters.fullscreen) enableAA(true);
 
-  SoundManager::getInstance().setVolume(parameters.soundVolume);
   for (const char *const filename : sounds)
   {
     SoundManager::getInstance().addSound(filename);
   }
 
-  if (font.loadFromFile("media/DejaVuSans-Bold.ttf"))
+  // the sounds of the monsters are loaded with the floors,
+  // the other ones stay in memory
+  for (int i = 0; i < (int)(sizeof(sounds) / sizeof(sounds[0])); i++)
+  {
+    bool isEnemySound = false;
+    for (const enemySoundStruct& enemySound : enemySounds)
+      if (enemySound.sound == i) isEnemySound = true;
+    if (!isEnemySound) SoundManager::getInstance().prefetchSound(i, true);
+  }
+
+  // priorities, when too many sounds are playing
+  const sound_resources lowPrioritySounds[] =
+  {
+    SOUND_BLAST_STANDARD, SOUND_BLAST_FLOWER, SOUND_BLAST_LIGHTNING, SOUND_BLAST_FIRE,
+    SOUND_BLAST_ICE, SOUND_BLAST_ILLUSION, SOUND_BLAST_POISON, SOUND_BLAST_STONE,
+    SOUND_IMPACT, SOUND_WALL_IMPACT, SOUND_ELECTRICITY, SOUND_SPIDER_WALKING,
+    SOUND_HEAVY_STEP_00, SOUND_HEAVY_STEP_01,
+  };
+  for (sound_resources sound : lowPrioritySounds)
+    SoundManager::getInstance().setPriority(sound, SOUND_PRIORITY_LOW);
+
+  const sound_resources highPrioritySounds[] =
+  {
+    SOUND_PLAYER_HIT, SOUND_PLAYER_DIE, SOUND_MESSAGE, SOUND_ACHIEVEMENT,
+    SOUND_DOOR_OPENING_BOSS, SOUND_INTRO_WITCH, SOUND_NIGHT,
+    SOUND_KING_RAT_DIE, SOUND_CYCLOP_DIE, SOUND_BUTCHER_DIE, SOUND_SPIDER_DIE,
+    SOUND_WITCH_DIE_00, SOUND_WITCH_DIE_01, SOUND_FRANCKY_DYING,
+  };
+  for (sound_resources sound : highPrioritySounds)
+    SoundManager::getInstance().setPriority(sound, SOUND_PRIORITY_HIGH);
+
+  if (loadFont(font, "media/DejaVuSans-Bold.ttf"))
   {
     myText.setFont(font);
   }
-  graphicsFont.loadFromFile("media/Caudex-Bold.ttf");
+  loadFont(graphicsFont, "media/Caudex-Bold.ttf");
+
+  // the glyphs are rendered in the first frames (intro and menu), before they are displayed
+  cyrillicGlyphsBaked = false;
+  bakeGlyphs(false);
+  if (parameters.language == 4) bakeGlyphs(true);
 
   miniMap = NULL;
   currentMap = NULL;
   currentFloor = NULL;
+  spawnCandidatesMap = NULL;
 
   lastScore.score = 0;
   lastScore.name = "";
@@ -562,6 +720,8 @@ WitchBlastGame::WitchBlastGame()
 
   for (int i = 0; i < 5; i++)
     buttons.push_back(ButtonStruct { sf::IntRect(124 + 55 * i, 655, 48, 48), ButtonShotType, i });
+
+  std::cout << "Startup: " << startupClock.getElapsedTime().asMilliseconds() << " ms" << std::endl;
 }
 
 void WitchBlastGame::enableAA(bool enable)
@@ -581,6 +741,16 @@ void WitchBlastGame::enableAA(bool enable)
 
 WitchBlastGame::~WitchBlastGame()
 {
+  if (simulationThread.joinable())
+  {
+    {
+      std::lock_guard<std::mutex> lock(simulationMutex);
+      simulationStopping = true;
+    }
+    simulationCondition.notify_all();
+    simulationThread.join();
+  }
+
   // cleaning all entities
   EntityManager::getInstance().clean();
 
@@ -618,6 +788,16 @@ DungeonMapEntity* WitchBlastGame::getCurrentMapEntity()
   return dungeonEntity;
 }
 
+AiScheduler* WitchBlastGame::getAiScheduler()
+{
+  return &aiScheduler;
+}
+
+ParticleBudget* WitchBlastGame::getParticleBudget()
+{
+  return &particleBudget;
+}
+
 PlayerEntity* WitchBlastGame::getPlayer()
 {
   return player;
@@ -686,6 +866,36 @@ float WitchBlastGame::getGameTime()
   return gameTime;
 }
 
+void WitchBlastGame::animateEntities()
+{
+  sf::Clock clock;
+
+  // time stop
+  enemyTargetIndex.invalidate();
+  aiScheduler.beginFrame();
+  if (player->isSpecialStateActive(SpecialStateTime))
+  {
+    if (loopCounter == 0)
+      EntityManager::getInstance().animate(deltaTime);
+    else
+      player->animate(deltaTime);
+
+    SoundManager::getInstance().playSound(SOUND_CLOCK, false);
+  }
+  else
+  {
+    EntityManager::getInstance().animate(deltaTime);
+    if (isPressing(0, KeyTimeControl, false))
+    {
+      enemyTargetIndex.invalidate();
+      EntityManager::getInstance().animate(deltaTime);
+      SoundManager::getInstance().playSound(SOUND_VIB, false);
+    }
+  }
+
+  frameTiming.simulation = clock.getElapsedTime().asMicroseconds() / 1000.0f;
+}
+
 void WitchBlastGame::onUpdate()
 {
   if (gameState == gameStatePlaying)
@@ -694,25 +904,8 @@ void WitchBlastGame::onUpdate()
     loopCounter++;
     if (loopCounter > 3) loopCounter = 0;
 
-    // time stop
-    if (player->isSpecialStateActive(SpecialStateTime))
-    {
-      if (loopCounter == 0)
-        EntityManager::getInstance().animate(deltaTime);
-      else
-        player->animate(deltaTime);
-
-      SoundManager::getInstance().playSound(SOUND_CLOCK, false);
-    }
-    else
-    {
-      EntityManager::getInstance().animate(deltaTime);
-      if (isPressing(0, KeyTimeControl, false))
-      {
-        EntityManager::getInstance().animate(deltaTime);
-        SoundManager::getInstance().playSound(SOUND_VIB, false);
-      }
-    }
+    // pipelined: animated during the rendering
+    if (!pipelinedFrame) animateEntities();
 
     if (isPlayerAlive) gameTime += deltaTime;
 
@@ -823,7 +1016,9 @@ void WitchBlastGame::startNewGame(bool fromSaveFile, int startingLevel)
   {
     if (!loadGame())
     {
-      fromSaveFile = false;
+      // invalid save file (removed): a new game, from a clean state
+      startNewGame(false, startingLevel);
+      return;
     }
     else
     {
@@ -910,6 +1105,9 @@ void WitchBlastGame::startNewLevel()
   // reset present items
   resetPresentItems();
 
+  // AI costs are reported per level
+  aiScheduler.resetThinkCosts();
+
   bool needShop = false;
   // create the new level
   if (currentFloor != NULL)
@@ -949,9 +1147,70 @@ void WitchBlastGame::startNewLevel()
   playLevel(false);
 }
 
+// bosses of the level (see generateMap)
+static void getFloorBosses(int level, std::vector<enemyTypeEnum>& monsters)
+{
+  switch (level)
+  {
+    case 1: monsters.push_back(EnemyTypeButcher); break;
+    case 2: monsters.push_back(EnemyTypeSlimeBoss); break;
+    case 3: monsters.push_back(EnemyTypeCyclops); break;
+    case 4: monsters.push_back(EnemyTypeRatKing); break;
+    case 5: monsters.push_back(EnemyTypeSpiderGiant); break;
+    case 6: monsters.push_back(EnemyTypeFrancky); break;
+    case 7: monsters.push_back(EnemyTypeVampire); break;
+    case 8:
+      monsters.push_back(EnemyTypeFrancky);
+      monsters.push_back(EnemyTypeRatKing);
+      monsters.push_back(EnemyTypeCyclops);
+      break;
+    default:
+      monsters.push_back(EnemyTypeSpiderGiant);
+      monsters.push_back(EnemyTypeSlimeBoss);
+      monsters.push_back(EnemyTypeRatKing);
+      monsters.push_back(EnemyTypeCyclops);
+      monsters.push_back(EnemyTypeCauldron);
+      break;
+  }
+}
+
+void WitchBlastGame::prefetchFloorSounds()
+{
+  std::vector<enemyTypeEnum> monsters;
+  getRoomRecipeMonsters(level, isAdvancedLevel(), monsters);
+  getFloorBosses(level, monsters);
+
+  for (const enemySoundStruct& enemySound : enemySounds)
+  {
+    if (std::find(monsters.begin(), monsters.end(), enemySound.enemy) != monsters.end())
+      SoundManager::getInstance().prefetchSound(enemySound.sound);
+  }
+}
+
+void WitchBlastGame::prefetchFloorImages()
+{
+  // released at the end: a sheet used on both floors stays loaded
+  std::vector<ImageHandle> previousImages;
+  previousImages.swap(floorImages);
+
+  std::vector<enemyTypeEnum> bosses;
+  getFloorBosses(level, bosses);
+  for (unsigned int i = 0; i < bosses.size(); i++) acquireEnemyImages(bosses[i]);
+}
+
+void WitchBlastGame::acquireEnemyImages(enemyTypeEnum enemy)
+{
+  for (const enemyImageStruct& enemyImage : enemyImages)
+  {
+    if (enemyImage.enemy == enemy) floorImages.push_back(ImageHandle(enemyImage.image));
+  }
+}
+
 void WitchBlastGame::playLevel(bool isFight)
 {
   isPlayerAlive = true;
+  prefetchFloorSounds();
+  prefetchFloorImages();
 
   if (!isFight)
   {
@@ -1338,6 +1597,7 @@ void WitchBlastGame::updateRunningGame()
       {
         if (sf::Keyboard::isKeyPressed(sf::Keyboard::LAlt))
         {
+          acquireEnemyImages(EnemyTypeButcher);
           new ButcherEntity(OFFSET_X + (MAP_WIDTH / 2) * TILE_WIDTH + TILE_WIDTH / 2,
                             OFFSET_Y + (MAP_HEIGHT / 2) * TILE_HEIGHT + TILE_HEIGHT / 2);
         }
@@ -1386,6 +1646,7 @@ void WitchBlastGame::updateRunningGame()
       {
         if (sf::Keyboard::isKeyPressed(sf::Keyboard::LAlt))
         {
+          acquireEnemyImages(EnemyTypeRatKing);
           new KingRatEntity(OFFSET_X + (MAP_WIDTH / 2) * TILE_WIDTH + TILE_WIDTH / 2,
                             OFFSET_Y + (MAP_HEIGHT / 2) * TILE_HEIGHT + TILE_HEIGHT / 2);
         }
@@ -1400,6 +1661,7 @@ void WitchBlastGame::updateRunningGame()
       {
         if (sf::Keyboard::isKeyPressed(sf::Keyboard::LAlt))
         {
+          acquireEnemyImages(EnemyTypeSpiderGiant);
           new GiantSpiderEntity(OFFSET_X + (MAP_WIDTH / 2) * TILE_WIDTH + TILE_WIDTH / 2,
                                 OFFSET_Y + (MAP_HEIGHT / 2) * TILE_HEIGHT + TILE_HEIGHT / 2);
         }
@@ -1416,6 +1678,7 @@ void WitchBlastGame::updateRunningGame()
       {
         if (sf::Keyboard::isKeyPressed(sf::Keyboard::LAlt))
         {
+          acquireEnemyImages(EnemyTypeFrancky);
           new FranckyEntity(OFFSET_X + (MAP_WIDTH / 2) * TILE_WIDTH + TILE_WIDTH / 2,
                             OFFSET_Y + (MAP_HEIGHT / 2) * TILE_HEIGHT + TILE_HEIGHT / 2);
         }
@@ -1431,6 +1694,7 @@ void WitchBlastGame::updateRunningGame()
       {
         if (sf::Keyboard::isKeyPressed(sf::Keyboard::LAlt))
         {
+          acquireEnemyImages(EnemyTypeVampire);
           new VampireEntity(OFFSET_X + (MAP_WIDTH / 2) * TILE_WIDTH + TILE_WIDTH / 2,
                             OFFSET_Y + (MAP_HEIGHT / 2) * TILE_HEIGHT + TILE_HEIGHT / 2);
         }
@@ -1509,7 +1773,7 @@ void WitchBlastGame::updateRunningGame()
 
       case MenuExit:
         backToMenu = true;
-        remove(SAVE_FILE.c_str());
+        removeSaveFile();
         break;
 
       case MenuContinue:
@@ -1745,7 +2009,7 @@ void WitchBlastGame::updateRunningGame()
                         MAP_HEIGHT / 2 * TILE_HEIGHT + TILE_HEIGHT / 2);
       player->onClearRoom();
       openDoors();
-      if (!autosave) remove(SAVE_FILE.c_str());
+      if (!autosave) removeSaveFile();
       if (currentMap->getRoomType() == roomTypeBoss)
       {
         playMusic(MusicDungeon);
@@ -2337,8 +2601,10 @@ void WitchBlastGame::renderRunningGame()
   myText.setColor(sf::Color(0, 0, 0, 255));
   myText.setCharacterSize(16);
 
+  // drawn every frame: by id
+  static const int levelLabel = tools::getLabelId("level");
   oss.str("");
-  oss << tools::getLabel("level") << " " << level;
+  oss << tools::getLabel(levelLabel) << " " << level;
 
   writeGraphic(oss.str(), 16, levelStrPosition.x, levelStrPosition.y, ALIGN_CENTER, sf::Color::Black, app, 0, 0, 0);
 
@@ -2568,25 +2834,32 @@ void WitchBlastGame::renderRunningGame()
       oss << time;
       writeGraphic(oss.str(), 18, 734, 143, ALIGN_CENTER, sf::Color::Black, app);
 
+      static const int damageLabel = tools::getLabelId("ui_base_damage");
+      static const int fireRateLabel = tools::getLabelId("ui_fire_rate");
+      static const int secondLabel = tools::getLabelId("ui_second");
+      static const int killedLabel = tools::getLabelId("dc_killed_monsters");
+      static const int challengesLabel = tools::getLabelId("dc_challenges");
+      static const int donationLabel = tools::getLabelId("ui_temple_donation");
+
       oss.str("");
-      oss << tools::getLabel("ui_base_damage") << ": " << player->getDamage();
+      oss << tools::getLabel(damageLabel) << ": " << player->getDamage();
       writeGraphic(oss.str(), 17, 588, 190, ALIGN_LEFT, sf::Color::Black, app);
 
       oss.str("");
-      oss << tools::getLabel("ui_fire_rate") << ": " << std::fixed << std::setprecision(1) << player->getFireRate()
-        << " / " << tools::getLabel("ui_second");
+      oss << tools::getLabel(fireRateLabel) << ": " << std::fixed << std::setprecision(1) << player->getFireRate()
+        << " / " << tools::getLabel(secondLabel);
       writeGraphic(oss.str(), 17, 588, 222, ALIGN_LEFT, sf::Color::Black, app);
 
       oss.str("");
-      oss << tools::getLabel("dc_killed_monsters") << ": " << bodyCount;
+      oss << tools::getLabel(killedLabel) << ": " << bodyCount;
       writeGraphic(oss.str(), 17, 588, 254, ALIGN_LEFT, sf::Color::Black, app);
 
       oss.str("");
-      oss << tools::getLabel("dc_challenges") << ": " << challengeLevel - 1;
+      oss << tools::getLabel(challengesLabel) << ": " << challengeLevel - 1;
       writeGraphic(oss.str(), 17, 588, 286, ALIGN_LEFT, sf::Color::Black, app);
 
       oss.str("");
-      oss << tools::getLabel("ui_temple_donation") << ": " << player->getDonation();
+      oss << tools::getLabel(donationLabel) << ": " << player->getDonation();
       writeGraphic(oss.str(), 17, 588, 318, ALIGN_LEFT, sf::Color::Black, app);
 
       // potions
@@ -2726,6 +2999,13 @@ void WitchBlastGame::renderRunningGame()
     write(ss.str(), 14, 4, 4, ALIGN_LEFT, sf::Color::Green, app, 0, 0, 0);
   }
 
+  // show AI think costs and sound voices
+  if (showLogical)
+  {
+    write(aiScheduler.getReport(5) + "\n" + SoundManager::getInstance().getReport() + "\n" + music.getReport()
+          + "\n" + getRenderReport() + "\n" + particleBudget.getReport(), 12, 4, 24, ALIGN_LEFT, sf::Color::Green, app, 0, 0, 0);
+  }
+
 // achievements ?
   if (!achievementsQueue.empty()) // && (currentMap->isCleared() || achievementsQueue.front().hasStarted) )
   {
@@ -2938,11 +3218,7 @@ void WitchBlastGame::saveDeathScreen()
 
   int width = 810, height = 300, border = 4;
   int x = 80, y = 110;
-  sf::Image screenShot(app->capture());
-  sf::Image savedImage;
-  savedImage.create(width + border * 2, height + border * 2);
-  savedImage.copy(screenShot,0 , 0, sf::IntRect( x - border, y - border, width + border * 2, height + border * 2));
-  savedImage.saveToFile(ss.str());
+  screenCapture.capture(*app, ss.str(), sf::IntRect( x - border, y - border, width + border * 2, height + border * 2));
 }
 
 void WitchBlastGame::saveScreen()
@@ -2965,8 +3241,7 @@ void WitchBlastGame::saveScreen()
   ss << (now->tm_sec);
   ss << ".png";
 
-  sf::Image screenShot(app->capture());
-  screenShot.saveToFile(ss.str());
+  screenCapture.capture(*app, ss.str());
 }
 
 void WitchBlastGame::renderDeathScreen(float x, float y)
@@ -3041,11 +3316,6 @@ void WitchBlastGame::renderDeathScreen(float x, float y)
 
 }
 
-bool compareScores(WitchBlastGame::StructScore s1, WitchBlastGame::StructScore s2)
-{
-  return s1.score > s2.score;
-}
-
 void WitchBlastGame::calculateScore()
 {
   saveStats();
@@ -3084,11 +3354,9 @@ void WitchBlastGame::calculateScore()
 
   if (nbPlayers > 1) return;
 
-  scores.push_back(lastScore);
-
-  std::sort (scores.begin(), scores.end(), compareScores);
-
-  saveHiScores();
+  // one record appended, the top lists are updated in O(log n)
+  recordLog.addScore(lastScore.score, lastScore.shotType, scoreToString(lastScore));
+  loadHiScores();
 
   // Online
 #ifdef ONLINE_MODE
@@ -3341,7 +3609,7 @@ void WitchBlastGame::updateMenu()
     if (escape || isPressing(0, KeyFireDown, true))
     {
       menuScoreIndex++;
-      if (menuScoreIndex > 2)
+      if (menuScoreIndex > 3)
       {
         menuState = MenuStateMain;
         if (lastScore.level > 0)
@@ -3381,26 +3649,20 @@ void WitchBlastGame::updateMenu()
       if (menu->items[menu->index].id == MenuLanguage)
       {
         SoundManager::getInstance().playSound(SOUND_SHOT_SELECT);
-        parameters.language++;
-        if (parameters.language >= NB_LANGUAGES) parameters.language = 0;
+        config.setInt(ConfigLanguage, (parameters.language + 1) % NB_LANGUAGES);
         if (menuState == MenuStateConfig) saveConfigurationToFile();
-        tools::setLanguage(languageString[parameters.language]);
         buildMenu(true);
       }
       else if (menu->items[menu->index].id == MenuVolumeSound)
       {
-        parameters.soundVolume = (parameters.soundVolume / 10) * 10 + 10;
-        if (parameters.soundVolume > 100) parameters.soundVolume = 100;
+        config.setInt(ConfigVolumeSound, (parameters.soundVolume / 10) * 10 + 10);
         saveConfigurationToFile();
-        SoundManager::getInstance().setVolume(parameters.soundVolume);
         SoundManager::getInstance().playSound(SOUND_SHOT_SELECT);
       }
       else if (menu->items[menu->index].id == MenuVolumeMusic)
       {
-        parameters.musicVolume = (parameters.musicVolume / 10) * 10 + 10;
-        if (parameters.musicVolume > 100) parameters.musicVolume = 100;
+        config.setInt(ConfigVolumeMusic, (parameters.musicVolume / 10) * 10 + 10);
         saveConfigurationToFile();
-        updateMusicVolume();
         SoundManager::getInstance().playSound(SOUND_SHOT_SELECT);
       }
       else if (menu->items[menu->index].id == MenuStartNew)
@@ -3417,26 +3679,20 @@ void WitchBlastGame::updateMenu()
       if (menu->items[menu->index].id == MenuLanguage)
       {
         SoundManager::getInstance().playSound(SOUND_SHOT_SELECT);
-        parameters.language--;
-        if (parameters.language < 0) parameters.language = NB_LANGUAGES - 1;
+        config.setInt(ConfigLanguage, (parameters.language + NB_LANGUAGES - 1) % NB_LANGUAGES);
         if (menuState == MenuStateConfig) saveConfigurationToFile();
-        tools::setLanguage(languageString[parameters.language]);
         buildMenu(true);
       }
       else if (menu->items[menu->index].id == MenuVolumeSound)
       {
-        parameters.soundVolume = (parameters.soundVolume / 10) * 10 - 10;
-        if (parameters.soundVolume < 0) parameters.soundVolume = 0;
+        config.setInt(ConfigVolumeSound, (parameters.soundVolume / 10) * 10 - 10);
         saveConfigurationToFile();
-        SoundManager::getInstance().setVolume(parameters.soundVolume);
         SoundManager::getInstance().playSound(SOUND_SHOT_SELECT);
       }
       else if (menu->items[menu->index].id == MenuVolumeMusic)
       {
-        parameters.musicVolume = (parameters.musicVolume / 10) * 10 - 10;
-        if (parameters.musicVolume < 0) parameters.musicVolume = 0;
+        config.setInt(ConfigVolumeMusic, (parameters.musicVolume / 10) * 10 - 10);
         saveConfigurationToFile();
-        updateMusicVolume();
         SoundManager::getInstance().playSound(SOUND_SHOT_SELECT);
       }
       else if (menu->items[menu->index].id == MenuStartNew)
@@ -3453,7 +3709,7 @@ void WitchBlastGame::updateMenu()
       switch (menu->items[menu->index].id)
       {
       case MenuStartNew:
-        remove(SAVE_FILE.c_str());
+        removeSaveFile();
         startNewGame(false, 1);
         break;
       case MenuStartOld:
@@ -3483,6 +3739,7 @@ void WitchBlastGame::updateMenu()
 #else
         menuScoreIndex = 2;
 #endif
+        loadHiScores();
         receiveScoreFromServer();
         break;
       case MenuAchievements:
@@ -3545,8 +3802,10 @@ void WitchBlastGame::renderMenu()
       renderScores(scoresOnline, "Best Players (ON-LINE)", true);
     else if (menuScoreIndex == 1)
       renderScores(scoresOnlineDay, "Best TODAY Scores (ON-LINE)", true);
-    else
+    else if (menuScoreIndex == 2)
       renderScores(scores, "Best Scores (local)", false);
+    else
+      renderScores(scoresToday, "Best TODAY Scores (local)", false);
     return;
   }
   else if (menuState == MenuStateAchievements)
@@ -3861,7 +4120,7 @@ void WitchBlastGame::renderCredits()
   yCursor += yStep;
 }
 
-void WitchBlastGame::renderScores(std::vector <StructScore> scoresToRender, std::string title, bool blinkingName)
+void WitchBlastGame::renderScores(const std::vector <StructScore>& scoresToRender, std::string title, bool blinkingName)
 {
   sf::Sprite bgSprite;
   bgSprite.setTexture(*ImageManager::getInstance().getImage(IMAGE_HALL_OF_FAME));
@@ -4024,6 +4283,8 @@ startNewGame(true, 1); quitGame();
   // Start game loop
   while (app->isOpen())
   {
+    SoundManager::getInstance().beginFrame();
+
     deltaTime = getAbsolutTime() - lastTime;
     if (deltaTime < 0.008f)
     {
@@ -4035,8 +4296,26 @@ startNewGame(true, 1); quitGame();
     lastTime = getAbsolutTime();
     if (deltaTime > 0.05f) deltaTime = 0.05f;
 
+    music.update(deltaTime);
+    glyphBaker.update(GLYPH_BAKE_BUDGET);
+    ImageManager::getInstance().update();
+
+    // particles emission scaled to the busy time of the last frame (not the wait for the display)
+    if (gameState == gameStatePlaying)
+    {
+      int liveParticles = parameters.particlesBatching ? dungeonEntity->getBoltParticleCount()
+                                                       : EntityManager::getInstance().getList()->size();
+      particleBudget.update(frameTiming.update + frameTiming.render + frameTiming.wait, deltaTime, liveParticles);
+    }
+
+    sf::Clock updateClock;
+    pipelinedFrame = false;
+    frameTiming.simulation = 0.0f;
+    frameTiming.wait = 0.0f;
+
     if (app->hasFocus())
     {
+      pipelinedFrame = parameters.pipelinedUpdate && gameState == gameStatePlaying;
       updateActionKeys();
 
       switch (gameState)
@@ -4077,6 +4356,7 @@ startNewGame(true, 1); quitGame();
         }
       }
     }
+    frameTiming.update = updateClock.getElapsedTime().asMicroseconds() / 1000.0f;
 
     onRender();
   }
@@ -4305,36 +4585,17 @@ int WitchBlastGame::getItemsCount()
 
 Vector2D WitchBlastGame::getNearestEnemy(float x, float y)
 {
-  Vector2D target(-100.0f, -100.0f);
-  float distanceMin = -1.0f;
-
-  EntityManager::EntityList* entityList =EntityManager::getInstance().getList();
-  EntityManager::EntityList::iterator it;
-
-  for (it = entityList->begin (); it != entityList->end ();)
-  {
-    GameEntity *e = *it;
-    it++;
-
-    if (e->getType() >= ENTITY_ENEMY && e->getType() <= ENTITY_ENEMY_MAX_COUNT)
-    {
-      // enemy
-      EnemyEntity* enemy = dynamic_cast<EnemyEntity*>(e);
-      if (enemy->canCollide())
-      {
-        float d2 = (x - enemy->getX()) * (x - enemy->getX()) + (y - enemy->getY()) * (y - enemy->getY());
+  return enemyTargetIndex.getNearest(x, y);
+}
 
-        if (target.x < -1.0f || d2 < distanceMin)
-        {
-          distanceMin = d2;
-          target.x = enemy->getX();
-          target.y = enemy->getY();
-        }
-      }
-    }
-  }
+int WitchBlastGame::getNearestEnemies(float x, float y, int k, std::vector<Vector2D>& result)
+{
+  return enemyTargetIndex.getKNearest(x, y, k, result);
+}
 
-  return target;
+Vector2D WitchBlastGame::getNearestEnemyInCone(float x, float y, Vector2D direction, float halfAngle, float maxDistance)
+{
+  return enemyTargetIndex.getNearestInCone(x, y, direction.x, direction.y, halfAngle, maxDistance);
 }
 
 void WitchBlastGame::setDoorVisible(int n)
@@ -4382,6 +4643,7 @@ void WitchBlastGame::refreshMap()
 {
   // clean the sprites from old map
   EntityManager::getInstance().partialClean(10);
+  enemyTargetIndex.invalidate();
 
   // if new map, it has to be randomized
   bool generateMap =  !(currentFloor->getMap(floorX, floorY)->isVisited());
@@ -4530,6 +4792,7 @@ void WitchBlastGame::checkEntering()
   if (!currentMap->isCleared())
   {
     player->setEntering();
+    aiScheduler.promoteAll();
     SoundManager::getInstance().playSound(SOUND_DOOR_CLOSING);
     for (int i=0; i<4; i++)
       doorEntity[i]->closeDoor();
@@ -4574,6 +4837,10 @@ void WitchBlastGame::saveMapItems()
 
 void WitchBlastGame::moveToOtherMap(int direction)
 {
+  // pipelined: called by the simulation thread, the new room loads textures
+  std::lock_guard<std::mutex> lock(renderMutex);
+  roomChanges++;
+
   // stairs to next level
   if (direction == 8 && currentMap->getRoomType() == roomTypeExit)
   {
@@ -4634,9 +4901,22 @@ void WitchBlastGame::moveToOtherMap(int direction)
 
 void WitchBlastGame::onRender()
 {
+  // statistics of the last frame (displayed in this one)
+  renderStatistics = app->getStatistics();
+  app->resetStatistics();
+
   // clear the view
   app->clear(sf::Color::Black);
 
+  // not if the game has been paused or left during the update
+  if (pipelinedFrame && gameState == gameStatePlaying)
+  {
+    renderPipelined();
+    return;
+  }
+
+  sf::Clock clock;
+
   switch (gameState)
   {
   case gameStateInit:
@@ -4654,8 +4934,127 @@ void WitchBlastGame::onRender()
     renderIntro();
     break;
   }
+  frameTiming.render = clock.restart().asMicroseconds() / 1000.0f;
 
   app->display();
+  frameTiming.display = clock.getElapsedTime().asMicroseconds() / 1000.0f;
+  logFrameTiming();
+}
+
+void WitchBlastGame::renderPipelined()
+{
+  sf::Clock clock;
+
+  // the frame is recorded (no OpenGL call)...
+  app->startRecording(renderSnapshot);
+  renderRunningGame();
+  app->stopRecording();
+  int snapshotRoomChanges = roomChanges;
+
+  // ... then drawn while the entities are animated for the next one
+  startSimulation();
+  {
+    std::lock_guard<std::mutex> lock(renderMutex);
+    frameTiming.render = clock.restart().asMicroseconds() / 1000.0f;
+    frameTiming.display = 0.0f;
+
+    // the simulation changed the room first: the snapshot shows the old one (the previous frame stays displayed)
+    if (roomChanges == snapshotRoomChanges)
+    {
+      app->draw(renderSnapshot);
+      frameTiming.render += clock.restart().asMicroseconds() / 1000.0f;
+      app->display();
+      frameTiming.display = clock.getElapsedTime().asMicroseconds() / 1000.0f;
+    }
+  }
+  clock.restart();
+
+  waitSimulation();
+  frameTiming.wait = clock.getElapsedTime().asMicroseconds() / 1000.0f;
+  logFrameTiming();
+}
+
+void WitchBlastGame::startSimulation()
+{
+  {
+    std::lock_guard<std::mutex> lock(simulationMutex);
+    simulationRequested = true;
+    simulationRunning = true;
+  }
+  if (!simulationThread.joinable())
+    simulationThread = std::thread(&WitchBlastGame::simulationThreadLoop, this);
+  simulationCondition.notify_all();
+}
+
+void WitchBlastGame::waitSimulation()
+{
+  std::unique_lock<std::mutex> lock(simulationMutex);
+  simulationCondition.wait(lock, [this] { return !simulationRunning; });
+}
+
+void WitchBlastGame::simulationThreadLoop()
+{
+  while (true)
+  {
+    {
+      std::unique_lock<std::mutex> lock(simulationMutex);
+      simulationCondition.wait(lock, [this] { return simulationStopping || simulationRequested; });
+      if (simulationStopping) return;
+      simulationRequested = false;
+    }
+
+    animateEntities();
+
+    {
+      std::lock_guard<std::mutex> lock(simulationMutex);
+      simulationRunning = false;
+    }
+    simulationCondition.notify_all();
+  }
+}
+
+void WitchBlastGame::logFrameTiming()
+{
+  // the running game only, one mode per average
+  if (!parameters.frameTimingLog || gameState != gameStatePlaying || pipelinedFrame != frameTimingPipelined)
+  {
+    frameTimingCount = 0;
+    frameTimingPipelined = pipelinedFrame;
+    if (!parameters.frameTimingLog || gameState != gameStatePlaying) return;
+  }
+
+  if (frameTimingCount == 0)
+  {
+    frameTimingSum.update = frameTimingSum.simulation = frameTimingSum.render = frameTimingSum.display = frameTimingSum.wait = 0.0f;
+    frameTimingClock.restart();
+  }
+  frameTimingSum.update += frameTiming.update;
+  frameTimingSum.simulation += frameTiming.simulation;
+  frameTimingSum.render += frameTiming.render;
+  frameTimingSum.display += frameTiming.display;
+  frameTimingSum.wait += frameTiming.wait;
+  frameTimingCount++;
+
+  if (frameTimingCount == FRAME_TIMING_PERIOD)
+  {
+    // busy: the frame time without the wait for the vertical sync (sequential: the update includes the simulation)
+    float busy = frameTimingSum.update + frameTimingSum.render + frameTimingSum.wait;
+    // throughput: frames per second; latency: from the input (update) to the display of the frame,
+    // a frame later when the snapshot of the previous frame is drawn during the simulation
+    float period = frameTimingClock.getElapsedTime().asMicroseconds() / 1000.0f / frameTimingCount;
+    float latency = frameTimingPipelined ? period + frameTimingSum.render / frameTimingCount + frameTimingSum.display / frameTimingCount
+                                         : busy / frameTimingCount + frameTimingSum.display / frameTimingCount;
+    std::ostringstream oss;
+    oss.setf(std::ios::fixed);
+    oss.precision(2);
+    oss << "Frame (" << (frameTimingPipelined ? "pipelined" : "sequential") << "): busy " << busy / frameTimingCount
+        << " ms on average over " << frameTimingCount << " frames (update " << frameTimingSum.update / frameTimingCount
+        << ", simulation " << frameTimingSum.simulation / frameTimingCount << ", render " << frameTimingSum.render / frameTimingCount
+        << ", wait " << frameTimingSum.wait / frameTimingCount << "), " << 1000.0f / period
+        << " frames/s, latency " << latency << " ms";
+    std::cout << oss.str() << std::endl;
+    frameTimingCount = 0;
+  }
 }
 
 void WitchBlastGame::renderHudShots(sf::RenderTarget* app)
@@ -4712,6 +5111,7 @@ void WitchBlastGame::showArtefactDescription(enumItemType itemType)
 void WitchBlastGame::generateMap()
 {
   saveInFight.monsters.clear();
+  spawnCandidatesMap = NULL;
 
   if (currentMap->getRoomType() == roomTypeStandard)
     generateStandardMap();
@@ -5052,7 +5452,7 @@ void WitchBlastGame::write(std::string str, int size, float x, float y, int alig
       yOff = yOffset;
   }
   
-  myText.setString(str);
+  // the geometry is rebuilt only if the string changes (the position and the color do not rebuild it)
   myText.setString(sf::String::fromUtf8(str.begin(), str.end()));
   myText.setCharacterSize(size);
 
@@ -5102,6 +5502,7 @@ void WitchBlastGame::initMonsterArray()
   for (int i = 0; i < MAP_WIDTH; i++)
     for (int j = 0; j < MAP_HEIGHT; j++)
       monsterArray[i][j] = false;
+  spawnCandidatesMap = NULL;
 }
 
 void WitchBlastGame::addMonster(enemyTypeEnum monsterType, float xm, float ym)
@@ -5273,73 +5674,37 @@ void WitchBlastGame::addMonster(enemyTypeEnum monsterType, float xm, float ym)
   }
 }
 
+void WitchBlastGame::buildSpawnCandidates()
+{
+  bool walkable[MAP_WIDTH][MAP_HEIGHT];
+  bool flyable[MAP_WIDTH][MAP_HEIGHT];
+  for (int xm = 0; xm < MAP_WIDTH; xm++)
+    for (int ym = 0; ym < MAP_HEIGHT; ym++)
+    {
+      walkable[xm][ym] = currentMap->isWalkable(xm, ym);
+      flyable[xm][ym] = currentMap->isFlyable(xm, ym);
+    }
+
+  spawnPlacer.build(walkable, flyable, monsterArray, player->getX(), player->getY());
+  spawnCandidatesMap = currentMap;
+}
+
 void WitchBlastGame::findPlaceMonsters(enemyTypeEnum monsterType, int amount)
 {
   // find a suitable place
-  bool isMonsterFlying = monsterType == EnemyTypeBat
-                         || monsterType == EnemyTypeImpBlue
-                         || monsterType == EnemyTypeImpRed;
+  if (spawnCandidatesMap != currentMap) buildSpawnCandidates();
 
-  bool isMonsterLarge = monsterType == EnemyTypeSlimeLarge
-                        || monsterType == EnemyTypeSlimeBlueLarge
-                        || monsterType == EnemyTypeSlimeRedLarge
-                        || monsterType == EnemyTypeSlimeVioletLarge;
-
-  bool bOk;
-  int xm, ym;
-  float xMonster, yMonster;
+  SpawnPlacer::spawnTypeEnum spawnType = SpawnPlacer::getSpawnType(monsterType);
 
   for (int index = 0; index < amount; index++)
   {
-    bOk = false;
-
-    int watchdog = 200;
-
-    while (!bOk && watchdog > 0)
+    IntCoord tile(0, 0);
+    if (!spawnPlacer.take(spawnType, monsterArray, &tile))
     {
-      bOk = true;
-      watchdog--;
-
-      if (isMonsterLarge)
-      {
-        xm = 2 +rand() % (MAP_WIDTH - 5);
-        ym = 2 +rand() % (MAP_HEIGHT - 5);
-      }
-      else
-      {
-        xm = 1 +rand() % (MAP_WIDTH - 3);
-        ym = 1 +rand() % (MAP_HEIGHT - 3);
-      }
-
-      if (monsterArray[xm][ym])
-      {
-        bOk = false;
-      }
-      if (bOk && !isMonsterFlying && !currentMap->isWalkable(xm, ym))
-      {
-        bOk = false;
-      }
-      if (bOk && isMonsterFlying && !currentMap->isFlyable(xm, ym))
-      {
-        bOk = false;
-      }
-      if (bOk)
-      {
-        xMonster = xm * TILE_WIDTH + TILE_WIDTH * 0.5f;
-        yMonster = ym * TILE_HEIGHT+ TILE_HEIGHT * 0.5f;
-
-        float dist2 = (xMonster - player->getX())*(xMonster - player->getX()) + (yMonster - player->getY())*(yMonster - player->getY());
-        if ( dist2 < 75000.0f)
-        {
-          bOk = false;
-        }
-        else
-        {
-          addMonster(monsterType, xMonster, yMonster);
-          monsterArray[xm][ym] = true;
-        }
-      }
+      std::cout << "[WARNING] No place left for enemy (" << monsterType << ").\n";
+      return;
     }
+    addMonster(monsterType, tile.x * TILE_WIDTH + TILE_WIDTH * 0.5f, tile.y * TILE_HEIGHT+ TILE_HEIGHT * 0.5f);
   }
 }
 
@@ -5656,13 +6021,13 @@ void WitchBlastGame::verifyDoorUnlocking()
 
 void WitchBlastGame::playMusic(musicEnum musicChoice)
 {
-  music.stop();
-
-  if (parameters.musicVolume <= 0) return;
+  if (parameters.musicVolume <= 0)
+  {
+    music.stop();
+    return;
+  }
 
-  music.setLoop(true);
   music.setVolume(parameters.musicVolume * VolumeModifier / 100);
-  bool ok = false;
 
   switch (musicChoice)
   {
@@ -5673,9 +6038,9 @@ void WitchBlastGame::playMusic(musicEnum musicChoice)
 
       switch (r)
       {
-        case 0: ok = music.openFromFile("media/sound/WitchBlastTheme.ogg"); break;
-        case 1: ok = music.openFromFile("media/sound/SavageLife.ogg"); break;
-        case 2: ok = music.openFromFile("media/sound/HauntedLighthouse.ogg"); break;
+        case 0: music.play("media/sound/WitchBlastTheme.ogg", MUSIC_CROSSFADE_DELAY); break;
+        case 1: music.play("media/sound/SavageLife.ogg", MUSIC_CROSSFADE_DELAY); break;
+        case 2: music.play("media/sound/HauntedLighthouse.ogg", MUSIC_CROSSFADE_DELAY); break;
       }
 
       currentStandardMusic = r;
@@ -5683,24 +6048,21 @@ void WitchBlastGame::playMusic(musicEnum musicChoice)
     break;
 
   case MusicEnding:
-    ok = music.openFromFile("media/sound/AmbiantMedieval.ogg");
+    music.play("media/sound/AmbiantMedieval.ogg", MUSIC_CROSSFADE_DELAY);
     break;
 
   case MusicBoss:
-    ok = music.openFromFile("media/sound/ShowMeThePower.ogg");
+    music.play("media/sound/ShowMeThePower.ogg", MUSIC_CROSSFADE_DELAY);
     break;
 
   case MusicChallenge:
-    ok = music.openFromFile("media/sound/HellsFire.ogg");
+    music.play("media/sound/HellsFire.ogg", MUSIC_CROSSFADE_DELAY);
     break;
 
   case MusicIntro:
-    ok = music.openFromFile("media/sound/WitchBlastTheme.ogg");
+    music.play("media/sound/WitchBlastTheme.ogg", MUSIC_CROSSFADE_DELAY);
     break;
   }
-
-  if (ok)
-    music.play();
 }
 
 void WitchBlastGame::pauseMusic()
@@ -5710,12 +6072,12 @@ void WitchBlastGame::pauseMusic()
 
 void WitchBlastGame::resumeMusic()
 {
-  music.play();
+  music.resume();
 }
 
 void WitchBlastGame::updateMusicVolume()
 {
-  if (music.getStatus() == sf::Music::Playing)
+  if (music.isPlaying())
   {
     if (parameters.musicVolume == 0)
       music.stop();
@@ -5726,9 +6088,8 @@ void WitchBlastGame::updateMusicVolume()
   {
     if (parameters.musicVolume > 0)
     {
-      bool ok = music.openFromFile("media/sound/wb.ogg");
       music.setVolume(parameters.musicVolume * VolumeModifier / 100);
-      if (ok) music.play();
+      music.play("media/sound/wb.ogg", 0.0f);
     }
   }
 }
@@ -5754,219 +6115,245 @@ void WitchBlastGame::saveGame(bool autosave)
 
   if (player->getPlayerStatus() == PlayerEntity::playerStatusAcquire)
     player->acquireItemAfterStance();
-  std::ofstream file(SAVE_FILE.c_str(), std::ios::out | std::ios::trunc);
 
+  SaveFileWriter& file = saveFileWriter;
   int i, j, k, l;
 
-  if (file)
-  {
-    // version (for compatibility check)
-    file << SAVE_VERSION << std::endl;
-
-    time_t t = time(0);   // get time now
-    struct tm * now = localtime( & t );
-    file << (now->tm_year + 1900) << '-';
+  file.begin();
 
-    if (now->tm_mon < 9) file << "0";
+  // header (displayed in the menu)
+  file.beginChunk("HEAD", SAVE_CHUNK_HEAD_VERSION);
 
-    file << (now->tm_mon + 1) << '-';
+  // version (for compatibility check)
+  file.writeString(SAVE_VERSION);
 
-    if (now->tm_mday < 9) file << "0";
-
-    file <<  now->tm_mday
-         << std::endl;
-
-    if (now->tm_hour <= 9) file << "0";
+  time_t t = time(0);   // get time now
+  struct tm * now = localtime( & t );
+  std::ostringstream oss;
+  oss << (now->tm_year + 1900) << '-';
+  if (now->tm_mon < 9) oss << "0";
+  oss << (now->tm_mon + 1) << '-';
+  if (now->tm_mday < 9) oss << "0";
+  oss <<  now->tm_mday;
+  file.writeString(oss.str());
 
-    file << (now->tm_hour) << ':';
+  oss.str("");
+  if (now->tm_hour <= 9) oss << "0";
+  oss << (now->tm_hour) << ':';
+  if (now->tm_min <= 9) oss << "0";
+  oss << (now->tm_min);
+  file.writeString(oss.str());
 
-    if (now->tm_min <= 9) file << "0";
-    file << (now->tm_min) << std::endl;
+  // floor
+  file.writeInt(level);
+  file.writeInt(challengeLevel);
+  file.writeInt(secretsFound);
 
-    // floor
-    file << level << " " << challengeLevel << " " << secretsFound << std::endl;
+  // game age
+  file.writeInt((int)gameTime);
 
-    // game age
-    file << (int)gameTime << std::endl;
+  // player equip
+  for (i = 0; i < NUMBER_EQUIP_ITEMS; i++) file.writeBool(player->isEquiped(i));
+  file.writeInt(player->getShotType());
 
-    // player equip
-    for (i = 0; i < NUMBER_EQUIP_ITEMS; i++) file << player->isEquiped(i) << " ";
-    file << std::endl;
-    file << player->getShotType() << std::endl;
+  // floor
+  file.beginChunk("FLOR", SAVE_CHUNK_FLOOR_VERSION);
 
-    int nbRooms = 0;
-    for (j = 0; j < FLOOR_HEIGHT; j++)
+  int nbRooms = 0;
+  for (j = 0; j < FLOOR_HEIGHT; j++)
+  {
+    for (i = 0; i < FLOOR_WIDTH; i++)
     {
-      for (i = 0; i < FLOOR_WIDTH; i++)
-      {
-        file << currentFloor->getRoom(i,j) << " ";
-        if (currentFloor->getRoom(i,j) > 0) nbRooms++;
-      }
-      file << std::endl;
+      file.writeInt(currentFloor->getRoom(i,j));
+      if (currentFloor->getRoom(i,j) > 0) nbRooms++;
     }
-    // kill stats
-    for (i = 0; i < NB_ENEMY; i++) file << killedEnemies[i] << " ";
-    file << std::endl;
+  }
+  // kill stats
+  for (i = 0; i < NB_ENEMY; i++) file.writeInt(killedEnemies[i]);
 
-    // potions
-    for(auto it = potionMap.begin(); it != potionMap.end(); ++it)
-    {
-      file << it->first << " " << it->second.effect << " " << it->second.known << std::endl;
-    }
+  // potions
+  for(auto it = potionMap.begin(); it != potionMap.end(); ++it)
+  {
+    file.writeInt(it->first);
+    file.writeInt(it->second.effect);
+    file.writeBool(it->second.known);
+  }
 
-    // maps
-    if (currentMap->isCleared())
-      saveMapItems();
+  // maps
+  if (currentMap->isCleared())
+    saveMapItems();
 
-    file << nbRooms << std::endl;
-    for (j = 0; j < FLOOR_HEIGHT; j++)
+  file.writeInt(nbRooms);
+  for (j = 0; j < FLOOR_HEIGHT; j++)
+  {
+    for (i = 0; i < FLOOR_WIDTH; i++)
     {
-      for (i = 0; i < FLOOR_WIDTH; i++)
+      if (currentFloor->getRoom(i,j) > 0)
       {
-        if (currentFloor->getRoom(i,j) > 0)
+        DungeonMap* iMap = currentFloor->getMap(i, j);
+
+        file.beginChunk("ROOM", SAVE_CHUNK_ROOM_VERSION);
+        file.writeInt(i);
+        file.writeInt(j);
+        file.writeInt(iMap->getRoomType());
+        file.writeBool(iMap->isKnown());
+        file.writeBool(iMap->isVisited());
+        file.writeBool(iMap->isRevealed());
+        file.writeBool(iMap->isCleared());
+
+        if (iMap->isVisited())
         {
-          file << i << " " << j << " "
-               << currentFloor->getMap(i, j)->getRoomType() << " "
-               << currentFloor->getMap(i, j)->isKnown() << " "
-               << currentFloor->getMap(i, j)->isVisited() << " "
-               << currentFloor->getMap(i, j)->isRevealed() << " "
-               << currentFloor->getMap(i, j)->isCleared() << std::endl;
-          if (currentFloor->getMap(i, j)->isVisited())
+          for (l = 0; l < MAP_HEIGHT; l++)
           {
-            for (l = 0; l < MAP_HEIGHT; l++)
-            {
-              for (k = 0; k < MAP_WIDTH; k++)
-              {
-                int tile = currentFloor->getMap(i, j)->getTile(k, l);
-                file << tile << " ";
-                tile = currentFloor->getMap(i, j)->getObjectTile(k, l);
-                if (tile == MAPOBJ_DOOR_CLOSED) tile = MAPOBJ_DOOR_OPEN;
-                file << tile << " ";
-                file << currentFloor->getMap(i, j)->getLogicalTile(k, l) << " ";
-              }
-              file << std::endl;
-            }
-            // style
-            file << currentFloor->getMap(i, j)->getFloorOffset() << " "
-                 << currentFloor->getMap(i, j)->getWallType() << std::endl;
-            // items, etc...
-            std::list<DungeonMap::itemListElement> itemList = currentFloor->getMap(i, j)->getItemList();
-            file << itemList.size() << std::endl;
-            std::list<DungeonMap::itemListElement>::iterator it;
-            for (it = itemList.begin (); it != itemList.end ();)
+            for (k = 0; k < MAP_WIDTH; k++)
             {
-              DungeonMap::itemListElement ilm = *it;
-              it++;
-
-              file << ilm.type << " " << ilm.x << " " << ilm.y << " " << ilm.merch << std::endl;
+              file.writeInt(iMap->getTile(k, l));
+              int tile = iMap->getObjectTile(k, l);
+              if (tile == MAPOBJ_DOOR_CLOSED) tile = MAPOBJ_DOOR_OPEN;
+              file.writeInt(tile);
+              file.writeInt(iMap->getLogicalTile(k, l));
             }
+          }
+          // style
+          file.writeInt(iMap->getFloorOffset());
+          file.writeInt(iMap->getWallType());
+
+          // items, etc...
+          const DungeonMap::ItemList& itemList = iMap->getItemList();
+          file.writeInt(itemList.size());
+          for (DungeonMap::ItemList::const_iterator it = itemList.begin (); it != itemList.end (); it++)
+          {
+            file.writeInt(it->type);
+            file.writeFloat(it->x);
+            file.writeFloat(it->y);
+            file.writeBool(it->merch);
+          }
 
-            // chests
-            std::list<DungeonMap::chestListElement> chestList = currentFloor->getMap(i, j)->getChestList();
-            file << chestList.size() << std::endl;
-            std::list<DungeonMap::chestListElement>::iterator itc;
-            for (itc = chestList.begin (); itc != chestList.end ();)
-            {
-              DungeonMap::chestListElement ilm = *itc;
-              itc++;
-
-              file << ilm.type << " " << ilm.x << " " << ilm.y << " " << ilm.state << std::endl;
-            }
-
-            // sprites
-            std::list<DungeonMap::spriteListElement> spriteList = currentFloor->getMap(i, j)->getSpriteList();
-            file << spriteList.size() << std::endl;
-            std::list<DungeonMap::spriteListElement>::iterator its;
-            for (its = spriteList.begin (); its != spriteList.end ();)
-            {
-              DungeonMap::spriteListElement ilm = *its;
-              its++;
+          // chests
+          const DungeonMap::ChestList& chestList = iMap->getChestList();
+          file.writeInt(chestList.size());
+          for (DungeonMap::ChestList::const_iterator it = chestList.begin (); it != chestList.end (); it++)
+          {
+            file.writeInt(it->type);
+            file.writeFloat(it->x);
+            file.writeFloat(it->y);
+            file.writeBool(it->state);
+          }
 
-              file << ilm.type << " " << ilm.frame << " " << ilm.x << " " << ilm.y << " " << ilm.scale << std::endl;
-            }
+          // sprites
+          const DungeonMap::SpriteList& spriteList = iMap->getSpriteList();
+          file.writeInt(spriteList.size());
+          for (DungeonMap::SpriteList::const_iterator it = spriteList.begin (); it != spriteList.end (); it++)
+          {
+            file.writeInt(it->type);
+            file.writeInt(it->frame);
+            file.writeFloat(it->x);
+            file.writeFloat(it->y);
+            file.writeFloat(it->scale);
+          }
 
-            // doors
-            for (int k = 0; k < 4; k++)
-              file << currentFloor->getMap(i, j)->getDoorType(k) << " ";
-            file << std::endl;
+          // doors
+          for (int k = 0; k < 4; k++)
+            file.writeInt(iMap->getDoorType(k));
 
-            // random sprite
-            for (int k = 0; k < NB_RANDOM_TILES_IN_ROOM; k++)
-            {
-              file << currentFloor->getMap(i, j)->getRandomTileElement(k).type
-                   << " " <<currentFloor->getMap(i, j)->getRandomTileElement(k).x
-                   << " " << currentFloor->getMap(i, j)->getRandomTileElement(k).y
-                   << " " << currentFloor->getMap(i, j)->getRandomTileElement(k).rotation << std::endl;
-            }
+          // random sprite
+          for (int k = 0; k < NB_RANDOM_TILES_IN_ROOM; k++)
+          {
+            DungeonMap::RandomTileElement rd = iMap->getRandomTileElement(k);
+            file.writeInt(rd.type);
+            file.writeFloat(rd.x);
+            file.writeFloat(rd.y);
+            file.writeFloat(rd.rotation);
           }
         }
       }
-      file << std::endl;
     }
+  }
 
-    // game
-    file << floorX << " " << floorY << std::endl;
-    file << bossRoomOpened << std::endl;
-    // boss door !
+  // game
+  file.beginChunk("GAME", SAVE_CHUNK_GAME_VERSION);
+  file.writeInt(floorX);
+  file.writeInt(floorY);
+  file.writeBool(bossRoomOpened);
 
-    // fight ?
-    if (currentMap->isCleared())
-    {
-      file << false << std::endl;
-    }
-    else
-    {
-      file << true << std::endl;
-      file << saveInFight.x << " " << saveInFight.y << " " << saveInFight.direction << std::endl;
-
-      file << saveInFight.monsters.size();
-      for (auto monster : saveInFight.monsters)
-        file << " " << monster.id << " " << monster.x  << " " << monster.y;
-      file << std::endl;
-    }
-
-    // player
-    file << player->getHp() << " " << player->getHpMax() << " " << player->getGold() << " " << player->getDonation() << std::endl;
-    // score
-    file << score << " " << bodyCount << std::endl;
-    // lost hp
-    for (i = 1; i <= LAST_LEVEL; i++) file << player->getLostHp(i) << " ";
-    file << std::endl;
-    // equip
-    for (i = 0; i < NUMBER_EQUIP_ITEMS; i++) file << player->isEquiped(i) << " ";
-    file << std::endl;
-    file << player->getX() << " " << player->getY() << std::endl;
-    file << player->getShotIndex();
-    for (i = 0; i < SPECIAL_SHOT_SLOTS; i++) file << " " << player->getShotType(i) << std::endl;
-    file << player->getActiveSpell().spell << std::endl;
-    for (i = 0; i < MAX_SLOT_CONSUMABLES; i++)
-    {
-      file << player->getConsumable(i) << " ";
-    }
-    file << std::endl;
-    // divinity
-    file << player->getDivinity().divinity << " " << player->getDivinity().piety << " "
-         << player->getDivinity().level << " " << player->getDivinity().interventions << std::endl;
-    // events
-    for (i = 0; i < NB_EVENTS; i++) file << worldEvent[i] << " ";
-    file << std::endl;
-    // special states
-    for (int i = 0; i < NB_SPECIAL_STATES; i++)
-    {
-      file << player->getSpecialState((enumSpecialState)i).active << " "
-      << player->getSpecialState((enumSpecialState)i).waitUnclear << " "
-      << player->getSpecialState((enumSpecialState)i).timer << " "
-      << player->getSpecialState((enumSpecialState)i).param1 << " "
-      << player->getSpecialState((enumSpecialState)i).param2 << " "
-      << player->getSpecialState((enumSpecialState)i).param3 << std::endl;
-
-    }
-    file.close();
+  // fight ?
+  if (currentMap->isCleared())
+  {
+    file.writeBool(false);
   }
   else
   {
-    std::cerr << "[ERROR] Saving the game..." << std::endl;
+    file.writeBool(true);
+    file.writeFloat(saveInFight.x);
+    file.writeFloat(saveInFight.y);
+    file.writeInt(saveInFight.direction);
+
+    file.writeInt(saveInFight.monsters.size());
+    for (auto monster : saveInFight.monsters)
+    {
+      file.writeInt(monster.id);
+      file.writeFloat(monster.x);
+      file.writeFloat(monster.y);
+    }
   }
+
+  // player
+  file.beginChunk("PLYR", SAVE_CHUNK_PLAYER_VERSION);
+  file.writeInt(player->getHp());
+  file.writeInt(player->getHpMax());
+  file.writeInt(player->getGold());
+  file.writeInt(player->getDonation());
+  // score
+  file.writeInt(score);
+  file.writeInt(bodyCount);
+  // lost hp
+  for (i = 1; i <= LAST_LEVEL; i++) file.writeInt(player->getLostHp(i));
+  // equip
+  for (i = 0; i < NUMBER_EQUIP_ITEMS; i++) file.writeBool(player->isEquiped(i));
+  file.writeFloat(player->getX());
+  file.writeFloat(player->getY());
+  file.writeInt(player->getShotIndex());
+  for (i = 0; i < SPECIAL_SHOT_SLOTS; i++) file.writeInt(player->getShotType(i));
+  file.writeInt(player->getActiveSpell().spell);
+  for (i = 0; i < MAX_SLOT_CONSUMABLES; i++) file.writeInt(player->getConsumable(i));
+  // divinity
+  file.writeInt(player->getDivinity().divinity);
+  file.writeInt(player->getDivinity().piety);
+  file.writeInt(player->getDivinity().level);
+  file.writeInt(player->getDivinity().interventions);
+  // events
+  for (i = 0; i < NB_EVENTS; i++) file.writeBool(worldEvent[i]);
+  // special states
+  for (int i = 0; i < NB_SPECIAL_STATES; i++)
+  {
+    specialStateStuct specialState = player->getSpecialState((enumSpecialState)i);
+    file.writeBool(specialState.active);
+    file.writeBool(specialState.waitUnclear);
+    file.writeFloat(specialState.timer);
+    file.writeFloat(specialState.param1);
+    file.writeFloat(specialState.param2);
+    file.writeFloat(specialState.param3);
+  }
+
+  // the file is written in a background thread
+  file.writeToFile(SAVE_FILE);
+}
+
+// chunks of the save file, in the versions written by saveGame()
+const saveChunkStruct saveChunks[] =
+{
+  { "HEAD", SAVE_CHUNK_HEAD_VERSION,   true },
+  { "FLOR", SAVE_CHUNK_FLOOR_VERSION,  true },
+  { "ROOM", SAVE_CHUNK_ROOM_VERSION,   false },
+  { "GAME", SAVE_CHUNK_GAME_VERSION,   true },
+  { "PLYR", SAVE_CHUNK_PLAYER_VERSION, true },
+};
+const int NB_SAVE_CHUNKS = sizeof(saveChunks) / sizeof(saveChunks[0]);
+
+void WitchBlastGame::removeSaveFile()
+{
+  saveFileWriter.wait();
+  remove(SAVE_FILE.c_str());
 }
 
 bool WitchBlastGame::loadGame()
@@ -5975,276 +6362,274 @@ bool WitchBlastGame::loadGame()
 
   resetPresentItems();
   saveInFight.monsters.clear();
-  std::ifstream file(SAVE_FILE.c_str(), std::ios::in);
 
-  if (file)
+  saveFileWriter.wait();
+  SaveFileReader file;
+
+  if (!file.open(SAVE_FILE) || !file.checkChunks(saveChunks, NB_SAVE_CHUNKS))
   {
-    int i, j, k, n;
+    // missing, corrupted or another version
+    removeSaveFile();
+    return false;
+  }
 
-    // version
-    std::string v;
-    file >> v;
+  int i, j, k, n;
 
-    if (v != SAVE_VERSION)
-    {
-      file.close();
-      remove(SAVE_FILE.c_str());
-      return false;
-    }
+  // version
+  if (file.beginChunk("HEAD") < 0 || file.readString() != SAVE_VERSION)
+  {
+    removeSaveFile();
+    return false;
+  }
 
-    // date an time
-    file >> v;
-    file >> v;
+  // date an time
+  file.readString();
+  file.readString();
 
-    // floor
-    file >> level;
-    file >> challengeLevel;
-    file >> secretsFound;
-    file >> gameTime;
+  // floor
+  level = file.readInt();
+  challengeLevel = file.readInt();
+  secretsFound = file.readInt();
+  gameTime = file.readInt();
 
-    for (i = 0; i < NUMBER_EQUIP_ITEMS; i++)
-    {
-      bool eq;
-      file >> eq;
-    }
-    file >> n;
+  for (i = 0; i < NUMBER_EQUIP_ITEMS; i++) file.readBool();
+  file.readInt();
+  file.endChunk();
+  if (level < 1)
+  {
+    std::cout << "[ERROR] Save file: invalid level (" << level << ")" << std::endl;
+    removeSaveFile();
+    return false;
+  }
 
-    currentFloor = new GameFloor(level);
-    for (j = 0; j < FLOOR_HEIGHT; j++)
+  file.beginChunk("FLOR");
+  currentFloor = new GameFloor(level);
+  for (j = 0; j < FLOOR_HEIGHT; j++)
+  {
+    for (i = 0; i < FLOOR_WIDTH; i++)
     {
-      for (i = 0; i < FLOOR_WIDTH; i++)
-      {
-        int n;
-        file >> n;
-        currentFloor->setRoom(i, j, (roomTypeEnum)n);
-      }
+      currentFloor->setRoom(i, j, (roomTypeEnum)file.readInt());
     }
+  }
 
+  // kill stats
+  for (int i = 0; i < NB_ENEMY; i++) killedEnemies[i] = file.readInt();
 
-    // kill stats
-    for (int i = 0; i < NB_ENEMY; i++) file >> killedEnemies[i];
+  // potions
+  for (i = 0; i < NUMBER_UNIDENTIFIED * 2; i++)
+  {
+    int source = file.readInt();
+    int effect = file.readInt();
+    bool known = file.readBool();
+    addPotionToMap((enumItemType)source, (enumItemType)effect, known);
+  }
 
-    // potions
-    for (i = 0; i < NUMBER_UNIDENTIFIED * 2; i++)
-    {
-      int source, effect;
-      bool known;
+  // maps
+  int nbRooms = file.readInt();
+  file.endChunk();
+  if (nbRooms < 0 || nbRooms > FLOOR_WIDTH * FLOOR_HEIGHT)
+  {
+    std::cout << "[ERROR] Save file: invalid number of rooms (" << nbRooms << ")" << std::endl;
+    removeSaveFile();
+    return false;
+  }
 
-      file >> source >> effect >> known;
-      addPotionToMap((enumItemType)source, (enumItemType)effect, known);
+  for (k = 0; k < nbRooms; k++)
+  {
+    file.beginChunk("ROOM");
+    i = file.readInt();
+    j = file.readInt();
+    n = file.readInt();
+    if (i < 0 || i >= FLOOR_WIDTH || j < 0 || j >= FLOOR_HEIGHT || currentFloor->getMap(i, j) != NULL)
+    {
+      std::cout << "[ERROR] Save file: invalid room (" << i << ", " << j << ")" << std::endl;
+      removeSaveFile();
+      return false;
     }
+    DungeonMap* iMap = new DungeonMap(currentFloor, i, j);
+    currentFloor->setMap(i, j, iMap);
+    iMap->setRoomType((roomTypeEnum)n);
+    iMap->setKnown(file.readBool());
+    iMap->setVisited(file.readBool());
+    bool flag = file.readBool();
+    if (iMap->getRoomType() == roomTypeSecret) iMap->setRevealed(flag);
+    iMap->setCleared(file.readBool());
 
-    // maps
-    int nbRooms;
-    file >> nbRooms;
-
-    for (k = 0; k < nbRooms; k++)
+    if (iMap->isVisited())
     {
-      file >> i;
-      file >> j;
-      file >> n;
-      DungeonMap* iMap = new DungeonMap(currentFloor, i, j);
-      currentFloor->setMap(i, j, iMap);
-      iMap->setRoomType((roomTypeEnum)n);
-      bool flag;
-      file >> flag;
-      iMap->setKnown(flag);
-      file >> flag;
-      iMap->setVisited(flag);
-      file >> flag;
-      if (iMap->getRoomType() == roomTypeSecret) iMap->setRevealed(flag);
-      file >> flag;
-      iMap->setCleared(flag);
-
-      if (iMap->isVisited())
+      for (j = 0; j < MAP_HEIGHT; j++)
       {
-        for (j = 0; j < MAP_HEIGHT; j++)
-        {
-          for (i = 0; i < MAP_WIDTH; i++)
-          {
-            file >> n;
-            iMap->setTile(i, j, n);
-            file >> n;
-            iMap->setObjectTile(i, j, n);
-            file >> n;
-            iMap->setLogicalTile(i, j, (logicalMapStateEnum)n);
-          }
-        }
-        // style
-        file >> n;
-        iMap->setFloorOffset(n);
-        file >> n;
-        iMap->setWallType(n);
-
-        // items int the map
-        file >> n;
-        for (i = 0; i < n; i++)
-        {
-          int t;
-          float x, y;
-          bool merc;
-          file >> t >> x >> y >> merc;
-          iMap->addItem(t, x, y, merc);
-        }
-        // chests in the map
-        file >> n;
-        for (i = 0; i < n; i++)
-        {
-          int t;
-          float x, y;
-          bool state;
-          file >> t >> x >> y >> state;
-          iMap->addChest(t, state, x, y);
-        }
-        // sprites in the map
-        file >> n;
-        for (i = 0; i < n; i++)
-        {
-          int t, f;
-          float x, y, scale;
-          file >> t >> f >> x >> y >> scale;
-          iMap->addSprite(t, f, x, y, scale);
-        }
-
-        // doors
-        for (int index = 0; index < 4; index++)
-        {
-          file >> n;
-          iMap->setDoorType(index, (doorEnum)n);
-        }
-
-        // random sprite
-        for (int index = 0; index < NB_RANDOM_TILES_IN_ROOM; index++)
+        for (i = 0; i < MAP_WIDTH; i++)
         {
-          DungeonMap::RandomTileElement rd;
-          file >> rd.type;
-          file >> rd.x;
-          file >> rd.y;
-          file >> rd.rotation;
-          iMap->setRandomTileElement(index, rd);
+          iMap->setTile(i, j, file.readInt());
+          iMap->setObjectTile(i, j, file.readInt());
+          iMap->setLogicalTile(i, j, (logicalMapStateEnum)file.readInt());
         }
-        // random sprite
       }
-    }
+      // style
+      iMap->setFloorOffset(file.readInt());
+      iMap->setWallType(file.readInt());
 
-    // game
-    file >> floorX >> floorY;
-    currentMap = currentFloor->getMap(floorX, floorY);
-    file >> bossRoomOpened;
+      // items int the map
+      n = file.readInt();
+      for (i = 0; i < n; i++)
+      {
+        int t = file.readInt();
+        float x = file.readFloat();
+        float y = file.readFloat();
+        bool merc = file.readBool();
+        iMap->addItem(t, x, y, merc);
+      }
+      // chests in the map
+      n = file.readInt();
+      for (i = 0; i < n; i++)
+      {
+        int t = file.readInt();
+        float x = file.readFloat();
+        float y = file.readFloat();
+        bool state = file.readBool();
+        iMap->addChest(t, state, x, y);
+      }
+      // sprites in the map
+      n = file.readInt();
+      for (i = 0; i < n; i++)
+      {
+        int t = file.readInt();
+        int f = file.readInt();
+        float x = file.readFloat();
+        float y = file.readFloat();
+        float scale = file.readFloat();
+        iMap->addSprite(t, f, x, y, scale);
+      }
 
-    // fight ?
-    file >> saveInFight.isFight;
-    if (saveInFight.isFight)
-    {
-      currentMap->setCleared(false);
-      file >> saveInFight.x;
-      file >> saveInFight.y;
-      file >> saveInFight.direction;
+      // doors
+      for (int index = 0; index < 4; index++)
+        iMap->setDoorType(index, (doorEnum)file.readInt());
 
-      file >> n;
-      for (i = 0; i < n; i++)
+      // random sprite
+      for (int index = 0; index < NB_RANDOM_TILES_IN_ROOM; index++)
       {
-        StructMonster monster;
-        file >> j;
-        monster.id = (enemyTypeEnum)j;
-        file >> monster.x;
-        file >> monster.y;
-        saveInFight.monsters.push_back(monster);
+        DungeonMap::RandomTileElement rd;
+        rd.type = file.readInt();
+        rd.x = file.readFloat();
+        rd.y = file.readFloat();
+        rd.rotation = file.readFloat();
+        iMap->setRandomTileElement(index, rd);
       }
     }
+    file.endChunk();
+  }
 
-    // player
-    int hp, hpMax, gold, donation;
-    file >> hp >> hpMax >> gold >> donation;
-    player = new PlayerEntity((TILE_WIDTH * MAP_WIDTH * 0.5f),
-                              (TILE_HEIGHT * MAP_HEIGHT * 0.5f));
-    player->setHp(hp);
-    player->setHpMax(hpMax);
-    player->setGold(gold);
-    player->setDonation(donation);
-    // score
-    file >> score;
-    scoreDisplayed = score;
-    file >> bodyCount;
-    // lost hp
-    for (i = 1; i <= LAST_LEVEL; i++)
-    {
-      file >> n;
-      player->setLostHp(i, n);
-    }
+  // game
+  file.beginChunk("GAME");
+  floorX = file.readInt();
+  floorY = file.readInt();
+  currentMap = currentFloor->getMap(floorX, floorY);
+  if (currentMap == NULL)
+  {
+    std::cout << "[ERROR] Save file: invalid current room (" << floorX << ", " << floorY << ")" << std::endl;
+    removeSaveFile();
+    return false;
+  }
+  bossRoomOpened = file.readBool();
 
-    // equip
-    for (i = 0; i < NUMBER_EQUIP_ITEMS; i++)
-    {
-      bool eq;
-      file >> eq;
-      player->setEquipped(i, eq);
-    }
-    float x, y;
-    file >> x >> y;
+  // fight ?
+  saveInFight.isFight = file.readBool();
+  if (saveInFight.isFight)
+  {
+    currentMap->setCleared(false);
+    saveInFight.x = file.readFloat();
+    saveInFight.y = file.readFloat();
+    saveInFight.direction = file.readInt();
 
-    if (saveInFight.isFight)
+    n = file.readInt();
+    for (i = 0; i < n; i++)
     {
-      x = saveInFight.x;
-      y = saveInFight.y;
-      player->move(saveInFight.direction);
-      player->setEntering();
+      StructMonster monster;
+      monster.id = (enemyTypeEnum)file.readInt();
+      monster.x = file.readFloat();
+      monster.y = file.readFloat();
+      saveInFight.monsters.push_back(monster);
     }
-    player->moveTo(x, y);
+  }
+  file.endChunk();
 
-    file >> n;
-    player->setShotIndex(n);
+  // player
+  file.beginChunk("PLYR");
+  int hp = file.readInt();
+  int hpMax = file.readInt();
+  int gold = file.readInt();
+  int donation = file.readInt();
+  player = new PlayerEntity((TILE_WIDTH * MAP_WIDTH * 0.5f),
+                            (TILE_HEIGHT * MAP_HEIGHT * 0.5f));
+  player->setHp(hp);
+  player->setHpMax(hpMax);
+  player->setGold(gold);
+  player->setDonation(donation);
+  // score
+  score = file.readInt();
+  scoreDisplayed = score;
+  bodyCount = file.readInt();
+  // lost hp
+  for (i = 1; i <= LAST_LEVEL; i++) player->setLostHp(i, file.readInt());
+
+  // equip
+  for (i = 0; i < NUMBER_EQUIP_ITEMS; i++) player->setEquipped(i, file.readBool());
+  float x = file.readFloat();
+  float y = file.readFloat();
+
+  if (saveInFight.isFight)
+  {
+    x = saveInFight.x;
+    y = saveInFight.y;
+    player->move(saveInFight.direction);
+    player->setEntering();
+  }
+  player->moveTo(x, y);
 
-    for (i = 0; i < SPECIAL_SHOT_SLOTS; i++)
-    {
-      file >> n;
-      player->setShotType(i, (enumShotType)n);
-    }
+  player->setShotIndex(file.readInt());
 
-    file >> n;
-    player->setActiveSpell((enumCastSpell)n, saveInFight.isFight);
+  for (i = 0; i < SPECIAL_SHOT_SLOTS; i++) player->setShotType(i, (enumShotType)file.readInt());
 
-    for (i = 0; i < MAX_SLOT_CONSUMABLES; i++)
-    {
-      file >> n;
-      player->setConsumable(i, n);
-    }
+  player->setActiveSpell((enumCastSpell)file.readInt(), saveInFight.isFight);
 
-    // divinity
-    {
-      int divinityId, piety, divLevel, interventions;
-      file >> divinityId;
-      file >> piety;
-      file >> divLevel;
-      file >> interventions;
-      player->loadDivinity(divinityId, piety, divLevel, interventions);
-    }
+  for (i = 0; i < MAX_SLOT_CONSUMABLES; i++) player->setConsumable(i, file.readInt());
 
-    // events
-    for (i = 0; i < NB_EVENTS; i++)
-    {
-      bool event;
-      file >> event;
-      worldEvent[i] = event;
-    }
-    // special states
-    for (int i = 0; i < NB_SPECIAL_STATES; i++)
-    {
-      bool active, waitUnclear;
-      float timer, param1, param2, param3;
-      file >> active >> waitUnclear >> timer >> param1 >> param2 >> param3;
-      player->setSpecialState(enumSpecialState(i), active, timer, param1, param2, waitUnclear);
-    }
+  // divinity
+  {
+    int divinityId = file.readInt();
+    int piety = file.readInt();
+    int divLevel = file.readInt();
+    int interventions = file.readInt();
+    player->loadDivinity(divinityId, piety, divLevel, interventions);
+  }
+
+  // events
+  for (i = 0; i < NB_EVENTS; i++) worldEvent[i] = file.readBool();
 
-    player->computePlayer();
-    file.close();
-    if (!saveInFight.isFight && !autosave) remove(SAVE_FILE.c_str());
+  // special states
+  for (int i = 0; i < NB_SPECIAL_STATES; i++)
+  {
+    bool active = file.readBool();
+    bool waitUnclear = file.readBool();
+    float timer = file.readFloat();
+    float param1 = file.readFloat();
+    float param2 = file.readFloat();
+    file.readFloat(); // param3
+    player->setSpecialState(enumSpecialState(i), active, timer, param1, param2, waitUnclear);
   }
-  else
+  file.endChunk();
+
+  if (!file.isOk())
   {
+    std::cout << "[ERROR] Save file: missing data" << std::endl;
+    removeSaveFile();
     return false;
   }
 
+  player->computePlayer();
+  if (!saveInFight.isFight && !autosave) removeSaveFile();
+
   return true;
 }
 
@@ -6253,36 +6638,33 @@ WitchBlastGame::saveHeaderStruct WitchBlastGame::loadGameHeader()
   saveHeaderStruct saveHeader;
   saveHeader.ok = true;
 
-  std::ifstream file(SAVE_FILE.c_str(), std::ios::in);
+  saveFileWriter.wait();
+  SaveFileReader file;
 
-  if (file)
+  if (file.open(SAVE_FILE))
   {
     // version
-    std::string v;
-    file >> v;
-
-    if (v != SAVE_VERSION)
+    if (!file.checkChunks(saveChunks, NB_SAVE_CHUNKS)
+        || file.beginChunk("HEAD") < 0 || file.readString() != SAVE_VERSION)
     {
-      file.close();
-      remove(SAVE_FILE.c_str());
+      removeSaveFile();
       saveHeader.ok = false;
     }
     else
     {
       // date an time
-      file >> saveHeader.date;
-      file >> saveHeader.time;
+      saveHeader.date = file.readString();
+      saveHeader.time = file.readString();
 
       // floor
-      file >> saveHeader.level;
-
-      int challengeLevel;
-      file >> challengeLevel;
-      file >> saveHeader.gameTime;
+      saveHeader.level = file.readInt();
+      file.readInt(); // challenge level
+      file.readInt(); // secrets found
+      saveHeader.gameTime = file.readInt();
 
       for (int i = 0; i < NUMBER_EQUIP_ITEMS; i++)
-        file >> equipToDisplay[i];
-      file >> saveHeader.shotType;
+        equipToDisplay[i] = file.readBool();
+      saveHeader.shotType = file.readInt();
     }
   }
   else
@@ -6294,55 +6676,55 @@ WitchBlastGame::saveHeaderStruct WitchBlastGame::loadGameHeader()
 
 void WitchBlastGame::saveGameData()
 {
-  std::ofstream file(SAVE_DATA_FILE.c_str(), std::ios::out | std::ios::trunc);
+  int i;
 
-  if (file)
+  // tuto
+  for (i = 0; i < NB_MESSAGES; i++)
   {
-    // version (for compatibility check)
-    file << SAVE_VERSION << std::endl;
-    int i;
-
-    // tuto
-    file << NB_MESSAGES << std::endl;
-    for (i = 0; i < NB_MESSAGES; i++)
-    {
-      messageStruct msg = getMessage((EnumMessages)i);
-      file << messageEnumToString((EnumMessages)i) << " ";
-      if (msg.messageType == MessageTypeTutorial)
-      {
-        file << gameMessagesToSkip[i] << " ";
-      }
-      else file << "0 ";
-    }
-    file << std::endl;
+    messageStruct msg = getMessage((EnumMessages)i);
+    if (msg.messageType == MessageTypeTutorial)
+      recordLog.setValue("tuto." + messageEnumToString((EnumMessages)i), gameMessagesToSkip[i]);
+  }
 
-    // achievements
-    file << NB_ACHIEVEMENTS << std::endl;
-    for (i = 0; i < NB_ACHIEVEMENTS; i++)
-    {
-      file << achievementEnumToString((enumAchievementType)i) << " ";
-      if (achievementState[i] == AchievementDone) file << "1 ";
-      else file << "0 ";
-    }
-    file << std::endl;
+  // achievements
+  for (i = 0; i < NB_ACHIEVEMENTS; i++)
+    recordLog.setValue("achiev." + achievementEnumToString((enumAchievementType)i), achievementState[i] == AchievementDone ? 1 : 0);
 
-    // monsters
-    file << NB_ENEMY << std::endl;
-    for (i = 0; i < NB_ENEMY; i++)
-    {
-      file << enemyString[i] << " " << globalData.killedMonster[i] << " ";
-    }
-    file << std::endl;
+  // monsters
+  for (i = 0; i < NB_ENEMY; i++)
+    recordLog.setValue("killed." + enemyString[i], globalData.killedMonster[i]);
+}
 
-    file.close();
-  }
-  else
+void WitchBlastGame::loadGameData()
+{
+  if (!recordLog.open(RECORDS_FILE, SCORES_MAX))
   {
-    std::cout << "[ERROR] Impossible to open save data file.\n";
+    // first launch with the record log
+    importGameData();
+    saveGameData();
+    importHiScores();
+    return;
   }
+
+  int i, value;
+
+  // tuto
+  for (i = 0; i < NB_MESSAGES; i++)
+    if (recordLog.getValue("tuto." + messageEnumToString((EnumMessages)i), value))
+      gameMessagesToSkip[i] = value;
+
+  // Achievements
+  for (i = 0; i < NB_ACHIEVEMENTS; i++)
+    if (recordLog.getValue("achiev." + achievementEnumToString((enumAchievementType)i), value))
+      achievementState[i] = (value == 1) ? AchievementDone : AchievementUndone;
+
+  // Monsters
+  for (i = 0; i < NB_ENEMY; i++)
+    if (recordLog.getValue("killed." + enemyString[i], value))
+      globalData.killedMonster[i] = value;
 }
 
-void WitchBlastGame::loadGameData()
+void WitchBlastGame::importGameData()
 {
   std::ifstream file(SAVE_DATA_FILE.c_str(), std::ios::in);
   int i;
@@ -6422,203 +6804,174 @@ void WitchBlastGame::loadGameData()
   }
 }
 
-void WitchBlastGame::addKey(int logicInput, std::string key)
+void WitchBlastGame::saveConfigurationToFile()
 {
-  int iKey = config.findInt(key);
-  if (iKey >= 0)
+  // the player name and the input bindings are edited in place by the menus
+  if (parameters.playerName.length() == 0)
+    parameters.playerName = "Player";
+  config.setString(ConfigPlayerName, parameters.playerName);
+
+  for (unsigned int i = 0; i < NumberKeys; i++)
   {
-    sf::Keyboard::Key k = (sf::Keyboard::Key)iKey;
-    input[logicInput] = k;
+    config.setInt(getKeyboardConfigKey(i), input[i]);
+    config.setBool(getJoystickConfigKey(i, ConfigJoystickButton), joystickInput[i].isButton);
+    config.setInt(getJoystickConfigKey(i, ConfigJoystickValue), joystickInput[i].value);
+    config.setInt(getJoystickConfigKey(i, ConfigJoystickAxis), joystickInput[i].axis);
   }
+
+  config.saveToFile(CONFIG_FILE);
 }
 
-void WitchBlastGame::saveConfigurationToFile()
+void WitchBlastGame::applyConfiguration(configKeyEnum key, bool loading)
 {
-  std::map<std::string, std::string> newMap;
-
-  // parameters
-  if (parameters.playerName.length() == 0)
-    parameters.playerName = "Player";
-  newMap["language"] = intToString(parameters.language);
-  newMap["player_name"] = parameters.playerName;
-
-  // audio volume
-  newMap["volume_sound"] = intToString(parameters.soundVolume);
-  newMap["volume_music"] = intToString(parameters.musicVolume);
-
-  newMap["zoom_enabled"] = parameters.zoom ? "1" : "0";
-  newMap["vsync_enabled"] = parameters.vsync ? "1" : "0";
-  newMap["blood_spreading"] = parameters.bloodSpread ? "1" : "0";
-  newMap["fullscreen"] = parameters.fullscreen ? "1" : "0";
-  newMap["pause_on_focus_lost"] = parameters.pauseOnFocusLost ? "1" : "0";
-  newMap["particles_batching"] = parameters.particlesBatching ? "1" : "0";
-  newMap["low_particles"] = parameters.lowParticles ? "1" : "0";
-  newMap["display_boss_portrait"] = parameters.displayBossPortrait ? "1" : "0";
-
-  // Keys
-  newMap["keyboard_move_up"] = intToString(input[KeyUp]);
-  newMap["keyboard_move_down"] = intToString(input[KeyDown]);
-  newMap["keyboard_move_left"] = intToString(input[KeyLeft]);
-  newMap["keyboard_move_right"] = intToString(input[KeyRight]);
-  newMap["keyboard_fire_up"] = intToString(input[KeyFireUp]);
-  newMap["keyboard_fire_down"] = intToString(input[KeyFireDown]);
-  newMap["keyboard_fire_left"] = intToString(input[KeyFireLeft]);
-  newMap["keyboard_fire_right"] = intToString(input[KeyFireRight]);
-  newMap["keyboard_spell"] = intToString(input[KeySpell]);
-  newMap["keyboard_interact"] = intToString(input[KeyInteract]);
-  newMap["keyboard_fire"] = intToString(input[KeyFire]);
-  newMap["keyboard_time_control"] = intToString(input[KeyTimeControl]);
-  newMap["keyboard_fire_select"] = intToString(input[KeyFireSelect]);
-
-  // Joystick
-  for (unsigned int i = 0; i < NumberKeys; i++)
+  switch (key)
   {
-    std::stringstream oss_button;
-    oss_button << "joy_" << inputKeyStr[i] << "_button";
-    std::stringstream oss_value;
-    oss_value << "joy_" << inputKeyStr[i] << "_value";
-    std::stringstream oss_axis;
-    oss_axis << "joy_" << inputKeyStr[i] << "_axis";
+  case ConfigLanguage:
+    parameters.language = config.getInt(key);
+    tools::setLanguage(languageString[parameters.language]);
+    // russian (fonts loaded)
+    if (!loading && parameters.language == 4) bakeGlyphs(true);
+    break;
+  case ConfigPlayerName: parameters.playerName = config.getString(key); break;
+  case ConfigVolumeSound:
+    parameters.soundVolume = config.getInt(key);
+    SoundManager::getInstance().setVolume(parameters.soundVolume);
+    break;
+  case ConfigVolumeMusic:
+    parameters.musicVolume = config.getInt(key);
+    // no music before the game is started
+    if (!loading) updateMusicVolume();
+    break;
+  case ConfigZoom: parameters.zoom = config.getBool(key); break;
+  case ConfigVsync: parameters.vsync = config.getBool(key); break;
+  case ConfigBloodSpread: parameters.bloodSpread = config.getBool(key); break;
+  case ConfigFullscreen: parameters.fullscreen = config.getBool(key); break;
+  case ConfigPauseOnFocusLost: parameters.pauseOnFocusLost = config.getBool(key); break;
+  case ConfigParticlesBatching: parameters.particlesBatching = config.getBool(key); break;
+  case ConfigLowParticles: parameters.lowParticles = config.getBool(key); break;
+  case ConfigDisplayBossPortrait: parameters.displayBossPortrait = config.getBool(key); break;
+  case ConfigAiThinkRate:
+    parameters.aiThinkRate = config.getInt(key);
+    aiScheduler.setThinkRate(parameters.aiThinkRate);
+    break;
+  case ConfigAiThinkBudget:
+    parameters.aiThinkBudget = config.getInt(key);
+    aiScheduler.setBudget(parameters.aiThinkBudget);
+    break;
+  case ConfigSoundMemory:
+    parameters.soundMemory = config.getInt(key);
+    SoundManager::getInstance().setMemoryBudget(parameters.soundMemory * 1024 * 1024);
+    break;
+  case ConfigMusicBuffer:
+    parameters.musicBuffer = config.getInt(key);
+    music.setBufferDuration(parameters.musicBuffer);
+    break;
+  case ConfigJoystickDeadZone: InputManager::getInstance().setDeadZone(config.getInt(key)); break;
+  case ConfigPipelinedUpdate: parameters.pipelinedUpdate = config.getBool(key); break;
+  case ConfigFrameTimingLog: parameters.frameTimingLog = config.getBool(key); break;
+  // 0: one thread per core
+  case ConfigJobThreads: JobSystem::getInstance().start(config.getInt(key)); break;
+  case ConfigParticleBudget: particleBudget.setEnabled(config.getBool(key)); break;
+  case ConfigParticleFrameTarget: particleBudget.setFrameTarget(config.getInt(key)); break;
+  case ConfigParticleScaleMin:
+  case ConfigParticleScaleMax:
+    particleBudget.setScaleRange(config.getInt(ConfigParticleScaleMin), config.getInt(ConfigParticleScaleMax));
+    break;
+  case ConfigParticleLiveMax: particleBudget.setMaxLiveParticles(config.getInt(key)); break;
+  case ConfigParticleBudgetLog: particleBudget.setLogEnabled(config.getBool(key)); break;
 
-    newMap[oss_button.str()] = joystickInput[i].isButton ? "1" : "0";
-    newMap[oss_value.str()] = intToString(joystickInput[i].value);
-    newMap[oss_axis.str()] = intToString(joystickInput[i].axis);
+  default:
+    if (key >= ConfigKeyboard && key < ConfigJoystick)
+    {
+      input[key - ConfigKeyboard] = (sf::Keyboard::Key)config.getInt(key);
+      InputManager::getInstance().watchKey(input[key - ConfigKeyboard]);
+    }
+    else if (key >= ConfigJoystick && key < NB_CONFIG_KEYS)
+    {
+      int i = (key - ConfigJoystick) / NB_CONFIG_JOYSTICK;
+      switch ((key - ConfigJoystick) % NB_CONFIG_JOYSTICK)
+      {
+      case ConfigJoystickButton: joystickInput[i].isButton = config.getBool(key); break;
+      case ConfigJoystickValue: joystickInput[i].value = config.getInt(key); break;
+      case ConfigJoystickAxis: joystickInput[i].axis = (sf::Joystick::Axis)config.getInt(key); break;
+      }
+    }
+    break;
   }
-
-  config.saveToFile(CONFIG_FILE, newMap);
 }
 
 void WitchBlastGame::configureFromFile()
 {
-  // default
-  parameters.language = 0;  // english
-  parameters.zoom = true;
-  parameters.vsync = true;
-  parameters.bloodSpread = true;
-  parameters.fullscreen = false;
-  parameters.pauseOnFocusLost = true;
-  parameters.particlesBatching = true;
-  parameters.lowParticles = false;
-  parameters.musicVolume = 80;
-  parameters.soundVolume = 80;
-  parameters.playerName = "";
-  parameters.displayBossPortrait = false;
-
-  input[KeyUp]    = sf::Keyboard::W;
-  input[KeyDown]  = sf::Keyboard::S;
-  input[KeyLeft]  = sf::Keyboard::A;
-  input[KeyRight] = sf::Keyboard::D;
-  input[KeyFireUp]    = sf::Keyboard::Up;
-  input[KeyFireDown]  = sf::Keyboard::Down;
-  input[KeyFireLeft]  = sf::Keyboard::Left;
-  input[KeyFireRight] = sf::Keyboard::Right;
-  input[KeyFire] = sf::Keyboard::RControl;
-  input[KeySpell] = sf::Keyboard::Space;
-  input[KeyInteract] = sf::Keyboard::E;
-  input[KeyFireSelect] = sf::Keyboard::Tab;
-  input[KeyTimeControl] = sf::Keyboard::RShift;
+  // the config file has been parsed by Config (defaults for the missing settings)
+  for (int i = 0; i < NB_CONFIG_KEYS; i++)
+    applyConfiguration((configKeyEnum)i, true);
 
-  // Joystick
-  joystickInput[KeyUp].isButton = false;
-  joystickInput[KeyUp].axis = sf::Joystick::Y;
-  joystickInput[KeyUp].value = -1;
-
-  joystickInput[KeyDown].isButton = false;
-  joystickInput[KeyDown].axis = sf::Joystick::Y;
-  joystickInput[KeyDown].value = 1;
-
-  joystickInput[KeyLeft].isButton = false;
-  joystickInput[KeyLeft].axis = sf::Joystick::X;
-  joystickInput[KeyLeft].value = -1;
-
-  joystickInput[KeyRight].isButton = false;
-  joystickInput[KeyRight].axis = sf::Joystick::X;
-  joystickInput[KeyRight].value = 1;
-
-  for (unsigned int i = KeyFireUp; i < NumberKeys; i++)
-  {
-    joystickInput[i].isButton = true;
-    joystickInput[i].axis = sf::Joystick::X;
-
-    if (i > KeyFireRight) joystickInput[i].value = i - 4;
-  }
-  joystickInput[KeyFireUp].value = 3;
-  joystickInput[KeyFireDown].value = 0;
-  joystickInput[KeyFireLeft].value = 2;
-  joystickInput[KeyFireRight].value = 1;
-
-  // from file
-  addKey(KeyUp, "keyboard_move_up");
-  addKey(KeyDown, "keyboard_move_down");
-  addKey(KeyLeft, "keyboard_move_left");
-  addKey(KeyRight, "keyboard_move_right");
-  addKey(KeyFireUp, "keyboard_fire_up");
-  addKey(KeyFireDown, "keyboard_fire_down");
-  addKey(KeyFireLeft, "keyboard_fire_left");
-  addKey(KeyFireRight, "keyboard_fire_right");
-  addKey(KeyFire, "keyboard_fire");
-  addKey(KeySpell, "keyboard_spell");
-  addKey(KeyInteract, "keyboard_interact");
-  addKey(KeyTimeControl, "keyboard_time_control");
-  addKey(KeyFireSelect, "keyboard_fire_select");
-
-  // Joystick
-  for (unsigned int i = 0; i < NumberKeys; i++)
-  {
-    std::stringstream oss_button;
-    oss_button << "joy_" << inputKeyStr[i] << "_button";
-    std::stringstream oss_value;
-    oss_value << "joy_" << inputKeyStr[i] << "_value";
-    std::stringstream oss_axis;
-    oss_axis << "joy_" << inputKeyStr[i] << "_axis";
-
-    int isButton = config.findInt(oss_button.str());
-    if (isButton > -1000)
-      joystickInput[i].isButton = isButton;
-    int n = config.findInt(oss_value.str());
-    if (n > -1000)
-      joystickInput[i].value = n;
-    n = config.findInt(oss_axis.str());
-    if (n >= sf::Joystick::Axis::X && n <= sf::Joystick::Axis::PovY)
-      joystickInput[i].axis = (sf::Joystick::Axis)n;
-  }
-
-  int i = config.findInt("language");
-  if (i >= 0 && i < NB_LANGUAGES) parameters.language = i;
-
-  i = config.findInt("volume_sound");
-  if (i >= 0) parameters.soundVolume = i;
-  i = config.findInt("volume_music");
-  if (i >= 0) parameters.musicVolume = i;
-
-  i = config.findInt("vsync_enabled");
-  if (i >= 0) parameters.vsync = i;
-  i = config.findInt("zoom_enabled");
-  if (i >= 0) parameters.zoom = i;
-  i = config.findInt("blood_spreading");
-  if (i >= 0) parameters.bloodSpread = i;
-  i = config.findInt("fullscreen");
-  if (i >= 0) parameters.fullscreen = i;
-  i = config.findInt("pause_on_focus_lost");
-  if (i >= 0) parameters.pauseOnFocusLost = i;
-  i = config.findInt("particles_batching");
-  if (i >= 0) parameters.particlesBatching = i;
-  i = config.findInt("low_particles");
-  if (i >= 0) parameters.lowParticles = i;
-  i = config.findInt("display_boss_portrait");
-  if (i >= 0) parameters.displayBossPortrait = i;
-
-  std::string playerName = config.findString("player_name");
-  if (playerName.size() > 0) parameters.playerName = playerName;
-
-  tools::setLanguage(languageString[parameters.language]);
-}
-
-parameterStruct WitchBlastGame::getParameters()
+  // keys of the menus (the bound keys are watched when they are applied)
+  InputManager::getInstance().watchKey(sf::Keyboard::Left);
+  InputManager::getInstance().watchKey(sf::Keyboard::Right);
+  InputManager::getInstance().watchKey(sf::Keyboard::Up);
+  InputManager::getInstance().watchKey(sf::Keyboard::Down);
+  InputManager::getInstance().watchKey(sf::Keyboard::Return);
+
+  // then each change is applied as soon as it is made
+  config.addListener([this](configKeyEnum key) { applyConfiguration(key, false); });
+}
+
+const parameterStruct& WitchBlastGame::getParameters()
 {
   return parameters;
 }
 
+const sf::RenderTarget::Statistics& WitchBlastGame::getRenderStatistics()
+{
+  return renderStatistics;
+}
+
+void WitchBlastGame::bakeGlyphs(bool cyrillic)
+{
+  // the most used sizes first, then the ones of the shrink loop of write()
+  const int mainSizes[] = { 16, 17, 18, 19, 22, 12, 13, 20, 23, 30, 32 };
+  std::vector<int> sizes(mainSizes, mainSizes + sizeof(mainSizes) / sizeof(mainSizes[0]));
+  for (int size = GLYPH_BAKE_MAX_SIZE; size >= GLYPH_BAKE_MIN_SIZE; size--)
+    if (std::find(sizes.begin(), sizes.end(), size) == sizes.end()) sizes.push_back(size);
+
+  if (cyrillic)
+  {
+    if (cyrillicGlyphsBaked) return;
+    cyrillicGlyphsBaked = true;
+
+    // no cyrillic in the "medieval" font (writeGraphic uses the main font in russian)
+    for (int size : sizes) glyphBaker.add(font, size, 0x0400, 0x045F);
+  }
+  else
+  {
+    for (int size : sizes)
+    {
+      glyphBaker.add(font, size, 32, 126);
+      glyphBaker.add(font, size, 160, 255);
+      glyphBaker.add(graphicsFont, size, 32, 126);
+      glyphBaker.add(graphicsFont, size, 160, 255);
+    }
+  }
+}
+
+std::string WitchBlastGame::getRenderReport()
+{
+  std::ostringstream oss;
+  oss << "Render: " << renderStatistics.drawCalls << " draws, " << renderStatistics.vertices << " vertices, "
+      << renderStatistics.quadsExpanded << " quads\n"
+      << "  textures " << renderStatistics.textureChanges << ", blend " << renderStatistics.blendChanges
+      << ", transforms " << renderStatistics.transformChanges << ", views " << renderStatistics.viewChanges
+      << ", shaders " << renderStatistics.shaderChanges << ", resets " << renderStatistics.stateResets << "\n";
+  oss.setf(std::ios::fixed);
+  oss.precision(2);
+  oss << "Frame (" << (pipelinedFrame ? "pipelined" : "sequential") << "): update " << frameTiming.update
+      << " ms, simulation " << frameTiming.simulation << " ms, render " << frameTiming.render
+      << " ms, display " << frameTiming.display << " ms, wait " << frameTiming.wait << " ms\n";
+  oss << "Video memory: " << ImageManager::getInstance().getVideoMemory() / (1024 * 1024) << " MB";
+  return oss.str();
+}
+
 void WitchBlastGame::buildMenu(bool rebuild)
 {
   menuMain.items.clear();
@@ -6970,7 +7323,7 @@ void WitchBlastGame::proceedEvent(EnumWorldEvents event)
 }
 
 void WitchBlastGame::renderPlayer(float x, float y,
-                                  bool equip[NUMBER_EQUIP_ITEMS], int shotType,
+                                  const bool equip[NUMBER_EQUIP_ITEMS], int shotType,
                                   int frame, int spriteDy)
 {
    x+=xOffset;
@@ -7486,45 +7839,21 @@ std::string WitchBlastGame::equipToString(bool equip[NUMBER_EQUIP_ITEMS])
   return oss.str();
 }
 
-void WitchBlastGame::saveHiScores()
+void WitchBlastGame::loadHiScores()
 {
-  std::ofstream file(HISCORES_FILE.c_str(), std::ios::out | std::ios::trunc);
-
-  if (file)
-  {
-    // version (for compatibility check)
-    file << SAVE_VERSION << std::endl;
-
-    file << scores.size() << std::endl;
+  std::vector<std::string> data;
 
-    // tuto
-    for (unsigned int i = 0; i < scores.size() && i < SCORES_MAX; i++)
-    {
-      file << scores[i].name << " ";
-      file << scores[i].level << " ";
-      file << scores[i].score << " ";
-      file << scores[i].shotType << " ";
-      file << scores[i].divinity << " ";
-      file << scores[i].killedBy << " ";
-      file << scores[i].time << " ";
-      // player equip
-      for (int j = 0; j < NUMBER_EQUIP_ITEMS; j++)
-        file << scores[i].equip[j] << " ";
-      file << std::endl;
-    }
-    file << std::endl;
+  recordLog.getTopScores(ScoreCategoryAllTime, 0, data);
+  scores.clear();
+  for (auto& line : data) scores.push_back(scoreFromString(line));
 
-    file.close();
-  }
-  else
-  {
-    std::cout << "[ERROR] Impossible to open hi-scores file.\n";
-  }
+  recordLog.getTopScores(ScoreCategoryToday, 0, data);
+  scoresToday.clear();
+  for (auto& line : data) scoresToday.push_back(scoreFromString(line));
 }
 
-void WitchBlastGame::loadHiScores()
+void WitchBlastGame::importHiScores()
 {
-  scores.clear();
   std::ifstream file(HISCORES_FILE.c_str(), std::ios::in);
 
   if (file)
@@ -7557,7 +7886,8 @@ void WitchBlastGame::loadHiScores()
       for (int j = 0; j < NUMBER_EQUIP_ITEMS; j++)
         file >> score.equip[j];
 
-      scores.push_back(score);
+      // day 0: not in the scores of the day
+      recordLog.addScore(score.score, score.shotType, scoreToString(score), 0);
     }
   }
 }
@@ -7665,6 +7995,8 @@ bool WitchBlastGame::isPressing(int p, inputKeyEnum k, bool oneShot)
 
 bool WitchBlastGame::getPressingState(int p, inputKeyEnum k)
 {
+  InputManager& inputs = InputManager::getInstance();
+
   if (p == 0 || gameState != gameStatePlaying)
   {
     // arrows in menu
@@ -7672,92 +8004,60 @@ bool WitchBlastGame::getPressingState(int p, inputKeyEnum k)
         || player->isDead()
         || player->getPlayerStatus() == PlayerEntity::playerStatusVictorious)
     {
-      if (k == KeyLeft && sf::Keyboard::isKeyPressed(sf::Keyboard::Left)) return true;
-      if (k == KeyRight && sf::Keyboard::isKeyPressed(sf::Keyboard::Right)) return true;
-      if (k == KeyUp && sf::Keyboard::isKeyPressed(sf::Keyboard::Up)) return true;
-      if (k == KeyDown && sf::Keyboard::isKeyPressed(sf::Keyboard::Down)) return true;
+      if (k == KeyLeft && inputs.isKeyDown(sf::Keyboard::Left)) return true;
+      if (k == KeyRight && inputs.isKeyDown(sf::Keyboard::Right)) return true;
+      if (k == KeyUp && inputs.isKeyDown(sf::Keyboard::Up)) return true;
+      if (k == KeyDown && inputs.isKeyDown(sf::Keyboard::Down)) return true;
 
-      if (k == KeyFireDown && sf::Keyboard::isKeyPressed(sf::Keyboard::Return)) return true;
+      if (k == KeyFireDown && inputs.isKeyDown(sf::Keyboard::Return)) return true;
     }
 
     // keyboard
-    if (sf::Keyboard::isKeyPressed(input[k])) return true;
+    if (inputs.isKeyDown(input[k])) return true;
   }
 
+  // touch
+  for (int i = 0; i < INPUT_FINGERS; i++)
+  {
+    if (inputs.isTouchDown(i))
+    {
+      float ratio = float(app->getDefaultView().getSize().x) / float(sf::VideoMode::getDesktopMode().width);
+      sf::Vector2i position = inputs.getTouchPosition(i);
 
-  
-//	  float ratio = float(app->getDefaultView().getSize().x) / float(SCREEN_WIDTH);
-  //float ratio = float(SCREEN_WIDTH) / float(sf::VideoMode::getDesktopMode().width);
-  float ratio = float(app->getDefaultView().getSize().x) / float(sf::VideoMode::getDesktopMode().width);
+      float xTouch = position.x * ratio;
+      float yTouch = position.y * ratio;
 
- 
-	//here
-    for(int i =0; i< 6; i++){ //6 fingers?! ;)
-        if(sf::Touch::isDown(i)){
-			app->mapPixelToCoords(sf::Touch::getPosition(0)).x;
-		  	//window.mapPixelToCoords(sf::Touch::getPosition(0, window));
-
-		//	float xTouch = app->mapPixelToCoords(sf::Touch::getPosition(i)).x * ratio;
-		//	float yTouch = app->mapPixelToCoords(sf::Touch::getPosition(i)).y * ratio;
-		
-
-			float xTouch = sf::Touch::getPosition(i).x * ratio;
-			float yTouch = sf::Touch::getPosition(i).y * ratio;
-
-			float xDiff = xTouch - xCtrl_Pad;
-			float yDiff = yTouch - yCtrl_Pad;
-			float dist_Ctrl_Pad = sqrt(xDiff*xDiff + yDiff*yDiff);
-			float dead_zone = 20;
-
-			
-			if (i == 0) {
-				//sf::err() << " xTouch " << xTouch << std::endl;
-				//sf::err() << " yTouch " << yTouch << std::endl;
-				//sf::err() << " ratio " << ratio << std::endl;
-				/*
-				sf::err() << " sf::Touch::getPosition(i).x " << xTouch << std::endl;
-				sf::err() << " sf::Touch::getPosition(i).y " << sf::Touch::getPosition(i).y << std::endl;
-
-				sf::err() << " xDiff " << xDiff << std::endl;
-				sf::err() << " yDiff " << yDiff << std::endl;
-				sf::err() << " xCtrl_Pad " << xCtrl_Pad << std::endl;
-				sf::err() << " yCtrl_Pad " << yCtrl_Pad << std::endl;
-				sf::err() << " dist_Ctrl_Pad " << dist_Ctrl_Pad << std::endl;**/
-			}
-
-			if(dist_Ctrl_Pad > 20 && dist_Ctrl_Pad < 150){
-				if (k == KeyLeft  && xTouch  <  xCtrl_Pad - dead_zone) return true;
-				if (k == KeyRight && xTouch >  xCtrl_Pad + dead_zone) return true;
-				if (k == KeyUp    && yTouch  <  yCtrl_Pad - dead_zone) return true;
-				if (k == KeyDown  && yTouch  >  yCtrl_Pad + dead_zone) return true;
-			}
-
-            if (k == KeyFireDown && sf::Touch::getPosition(i).y > 200  &&  sf::Touch::getPosition(i).x > 400) return true;
-
-            // if (k == KeyRight && sf::Keyboard::isKeyPressed(sf::Keyboard::Right)) return true;
-            // if (k == KeyUp && sf::Keyboard::isKeyPressed(sf::Keyboard::Up)) return true;
-            // if (k == KeyDown && sf::Keyboard::isKeyPressed(sf::Keyboard::Down)) return true;
-        }
-    }
+      float xDiff = xTouch - xCtrl_Pad;
+      float yDiff = yTouch - yCtrl_Pad;
+      float dist_Ctrl_Pad = sqrt(xDiff*xDiff + yDiff*yDiff);
+      float dead_zone = 20;
 
+      if (dist_Ctrl_Pad > 20 && dist_Ctrl_Pad < 150)
+      {
+        if (k == KeyLeft  && xTouch < xCtrl_Pad - dead_zone) return true;
+        if (k == KeyRight && xTouch > xCtrl_Pad + dead_zone) return true;
+        if (k == KeyUp    && yTouch < yCtrl_Pad - dead_zone) return true;
+        if (k == KeyDown  && yTouch > yCtrl_Pad + dead_zone) return true;
+      }
 
+      if (k == KeyFireDown && position.y > 200 && position.x > 400) return true;
+    }
+  }
 
   if (p == 1 || gameState != gameStatePlaying || nbPlayers == 1)
   {
-    if (!sf::Joystick::isConnected(0)) return false;
+    if (!inputs.isJoystickConnected(0)) return false;
 
     // joystick
     if (joystickInput[k].isButton)
     {
       // button
-      if (joystickInput[k].value >= 0)
-        if (sf::Joystick::isButtonPressed(0, joystickInput[k].value)) return true;
+      if (inputs.isButtonDown(0, joystickInput[k].value)) return true;
     }
     else
     {
-      // axis
-      if (joystickInput[k].value < 0 && sf::Joystick::getAxisPosition(0, joystickInput[k].axis) < -40) return true;
-      else if (joystickInput[k].value > 0 && sf::Joystick::getAxisPosition(0, joystickInput[k].axis) > 40) return true;
+      // axis (beyond the dead zone)
+      if (inputs.isAxisDown(0, joystickInput[k].axis, joystickInput[k].value)) return true;
     }
   }
 
@@ -7766,6 +8066,9 @@ bool WitchBlastGame::getPressingState(int p, inputKeyEnum k)
 
 void WitchBlastGame::updateActionKeys()
 {
+  // the devices are sampled once, then each key of each player reads the snapshot
+  InputManager::getInstance().update();
+
   for (int p = 0; p < NB_PLAYERS_MAX; p++)
   {
     for (unsigned int i = 0; i < NumberKeys; i++)
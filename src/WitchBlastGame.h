@@ -19,6 +19,9 @@
 
 #include "sfml_game/Game.h"
 #include "sfml_game/TileMapEntity.h"
+#include "sfml_game/MusicPlayer.h"
+#include "sfml_game/GlyphBaker.h"
+#include "sfml_game/ImageManager.h"
 #include "PlayerEntity.h"
 #include "DungeonMapEntity.h"
 #include "MiniMapEntity.h"
@@ -27,9 +30,18 @@
 #include "GameFloor.h"
 #include "Config.h"
 #include "Achievements.h"
+#include "EnemyTargetIndex.h"
+#include "SpawnPlacer.h"
+#include "AiScheduler.h"
+#include "ParticleBudget.h"
+#include "SaveFile.h"
+#include "RecordLog.h"
+#include "ScreenCapture.h"
 
 #include <queue>
 #include <thread>
+#include <mutex>
+#include <condition_variable>
 
 // for tests
 //#define TEST_MODE
@@ -51,8 +63,6 @@ const int X_GAME_COLOR_VIOLET = 3;  /*!< Violet light color effect  ID */
 const int X_GAME_COLOR_BROWN  = 4;  /*!< Brown light color effect  ID */
 const int X_GAME_COLOR_WHITE  = 5;  /*!< White light color effect  ID */
 
-unsigned const int NumberKeys = 13; /*!< Number of input keys on the game */
-
 /** Input key string
  *  Keys in the config file.
  */
@@ -127,9 +137,25 @@ struct parameterStruct
   bool particlesBatching;
   bool lowParticles;
   bool displayBossPortrait;
+  int aiThinkRate;            /*!< enemies think steps per second */
+  int aiThinkBudget;          /*!< enemies think budget per frame (microseconds) */
+  int soundMemory;            /*!< decoded sounds memory budget (MB) */
+  int musicBuffer;            /*!< music stream buffer duration (ms) */
+  bool pipelinedUpdate;       /*!< entities animated while the previous frame is drawn (false = disabled) */
+  bool frameTimingLog;        /*!< averaged frame timings written to the standard output (false = disabled) */
   std::string playerName;     /*!< player name */
 };
 
+/** Durations of the steps of the last frame (ms) */
+struct frameTimingStruct
+{
+  float update;               /*!< events and game logic (main thread) */
+  float simulation;           /*!< entities animation (worker thread when pipelined) */
+  float render;               /*!< rendering (recording and drawing of the snapshot when pipelined) */
+  float display;              /*!< display (waiting for the vertical sync) */
+  float wait;                 /*!< main thread waiting for the simulation (pipelined) */
+};
+
 struct structPotionMap
 {
   enumItemType effect;
@@ -218,6 +244,18 @@ public:
   */
   DungeonMapEntity* getCurrentMapEntity();
 
+  /*!
+   *  \brief Accessor on the AI scheduler (enemies "think" steps)
+   *  \return a pointer to the AI scheduler
+   */
+  AiScheduler* getAiScheduler();
+
+  /*!
+   *  \brief Accessor on the particle budget (emission scale)
+   *  \return a pointer to the particle budget
+   */
+  ParticleBudget* getParticleBudget();
+
   /*!
    *  \brief Accessor on the player
    *  \return a pointer to the player
@@ -256,11 +294,17 @@ public:
 
   float getDeltaTime();
 
+  /*!
+   *  \brief accessor on the rendering statistics of the last frame
+   *  \return : draw calls, vertices and state changes of the window
+   */
+  const sf::RenderTarget::Statistics& getRenderStatistics();
+
   /*!
    *  \brief accessor on the parameters
    *  \return : the parameters
    */
-  parameterStruct getParameters();
+  const parameterStruct& getParameters();
 
   /*!
    *  \brief Start the game and the game loop
@@ -328,6 +372,27 @@ public:
   */
   Vector2D getNearestEnemy(float x, float y);
 
+ /*!
+  *  \brief Return the positions of the nearest enemies
+  *  \param x : x position of the source
+  *  \param y : y position of the source
+  *  \param k : max number of enemies
+  *  \param result : positions of the enemies, the nearest first
+  *  \return number of enemies found
+  */
+  int getNearestEnemies(float x, float y, int k, std::vector<Vector2D>& result);
+
+ /*!
+  *  \brief Return the position of the nearest enemy in a cone (aiming)
+  *  \param x : x position of the source
+  *  \param y : y position of the source
+  *  \param direction : direction of the cone
+  *  \param halfAngle : half angle of the cone (radians)
+  *  \param maxDistance : max distance of the enemy (0 = no limit)
+  *  \return position of the nearest enemy (negative position when no enemy found)
+  */
+  Vector2D getNearestEnemyInCone(float x, float y, Vector2D direction, float halfAngle, float maxDistance = 0.0f);
+
  /*!
   *  \brief Generates blood
   *  \param x : x position of the blood
@@ -386,9 +451,15 @@ public:
   /*!
    *  \brief Save the game
    *  Save the game to file : complete floor and maps, items and blood position, player current equipment and stats....
+   *  The state is serialized immediately, the file is written in a background thread.
    */
   void saveGame(bool autosave);
 
+  /*!
+   *  \brief Delete the save file (after the pending write)
+   */
+  void removeSaveFile();
+
   /*!
    *  \brief Load the game
    *  Load the game from file. After restoring the game, the file is destroy.
@@ -398,14 +469,23 @@ public:
 
   /*!
    *  \brief Save the game data (general)
+   *
+   *  Only the values which changed are appended to the record log.
    */
   void saveGameData();
 
   /*!
    *  \brief Load the game data (general)
+   *
+   *  Opens the record log. The first time, the old data and hi-scores files are imported.
    */
   void loadGameData();
 
+  /*!
+   *  \brief Load the game data from the old text file (before the record log)
+   */
+  void importGameData();
+
   /*!
    *  \brief Load the savegame data
    *  \return the savegame data
@@ -557,6 +637,38 @@ protected:
    */
   virtual void onUpdate();
 
+  /*!
+   *  \brief Animates the entities (one step)
+   *
+   *  Called by onUpdate, or in a worker thread while the previous frame is drawn (pipelined mode).
+   */
+  void animateEntities();
+
+  /*!
+   *  \brief Renders the running game in pipelined mode
+   *
+   *  The frame is recorded (snapshot), then drawn while the entities are animated by the simulation thread.
+   *  The snapshot is not drawn if the simulation changed the room first.
+   */
+  void renderPipelined();
+
+  /*!
+   *  \brief Starts an animation step in the simulation thread (created at the first call)
+   */
+  void startSimulation();
+
+  /*!
+   *  \brief Waits for the end of the animation step
+   */
+  void waitSimulation();
+
+  void simulationThreadLoop();
+
+  /*!
+   *  \brief Adds the timing of the frame to the average, logged every FRAME_TIMING_PERIOD frames
+   */
+  void logFrameTiming();
+
   /*!
    *  \brief render the HUD for shot types
    *
@@ -576,7 +688,29 @@ private:
   GameMap* miniMap;           /*!< Pointer to the logical minimap */
   DungeonMap* currentMap;     /*!< Pointer to the logical current map */
   GameFloor* currentFloor;    /*!< Pointer to the logical floor (level) */
+  EnemyTargetIndex enemyTargetIndex; /*!< Enemies positions for targeting (rebuilt each update step) */
+  AiScheduler aiScheduler;    /*!< Schedules the enemies "think" steps */
+  ParticleBudget particleBudget;  /*!< Scales the particles emission to the frame time */
+  std::vector<ImageHandle> floorImages;  /*!< Streamed sprite sheets used on the floor */
   bool showLogical;           /*!< True if showing bounding boxes, z and center */
+  sf::RenderTarget::Statistics renderStatistics;  /*!< Rendering statistics of the last frame */
+  frameTimingStruct frameTiming;                  /*!< Durations of the steps of the last frame */
+
+  // pipelined update / render
+  sf::RenderTarget::Recording renderSnapshot;     /*!< The frame drawn while the next one is simulated */
+  bool pipelinedFrame;        /*!< True if the entities of this frame are animated during its rendering */
+  std::mutex renderMutex;     /*!< Held while the snapshot is drawn (a room change loads textures) */
+  int roomChanges;            /*!< Number of room changes (guarded by renderMutex) */
+  std::thread simulationThread;                   /*!< Animates the entities while the snapshot is drawn */
+  std::mutex simulationMutex;
+  std::condition_variable simulationCondition;
+  bool simulationRequested;   /*!< True if an animation step waits for the simulation thread */
+  bool simulationRunning;     /*!< True until the requested animation step is done */
+  bool simulationStopping;
+  frameTimingStruct frameTimingSum;               /*!< Sum of the frame timings since the last log */
+  int frameTimingCount;
+  sf::Clock frameTimingClock; /*!< Since the first frame of the sum */
+  bool frameTimingPipelined;  /*!< Mode of the frames of the sum */
   bool showGameTime;          /*!< True if showing the game time */
 
   // game play
@@ -610,6 +744,8 @@ private:
   DoorEntity* doorEntity[4];  /*!< Pointers to the door graphical entity */
   sf::Font font;              /*!< The font used for displaying text */
   sf::Font graphicsFont;      /*!< The font used for displaying "medieval" text */
+  GlyphBaker glyphBaker;      /*!< Renders the glyphs of the fonts before they are displayed */
+  bool cyrillicGlyphsBaked;   /*!< True if the cyrillic glyphs are queued in the glyph baker */
   sf::Text myText;            /*!< The text to be displayed */
   sf::Sprite introScreenSprite;
   sf::Sprite titleSprite;
@@ -638,7 +774,7 @@ private:
   float xOffset, yOffset;     /*!< Main game client position in the GUI */
   float xCtrl_Pad, yCtrl_Pad;
 
-  sf::Music music;            /*!< Current game music */
+  MusicPlayer music;          /*!< Game musics (opened in background, crossfaded) */
 
   /** Music enum
    *  Identify the various music tracks of the game.
@@ -709,23 +845,6 @@ private:
     KeyFire
   };
 
-  const std::string inputKeyStr[NumberKeys] =
-  {
-    "_move_up",
-    "_move_down",
-    "_move_left",
-    "_move_right",
-    "_fire_up",
-    "_fire_down",
-    "_fire_left",
-    "_fire_right",
-    "_spell",
-    "_interact",
-    "_fire",
-    "_time_control",
-    "_fire_select"
-  };
-
   sf::Keyboard::Key input[NumberKeys];     /*!< Input key array */
 
   struct JoystickInputStruct
@@ -768,6 +887,27 @@ private:
    */
   void playLevel(bool isFight);
 
+  /*!
+   *  \brief Prefetch the sounds of the floor
+   *
+   *  Decodes in the background the sounds of the monsters and bosses which can be met on the floor.
+   */
+  void prefetchFloorSounds();
+
+  /*!
+   *  \brief Loads the sprite sheets of the floor bosses
+   *
+   *  The streamed sheets of the bosses of the floor are loaded in the background,
+   *  the ones of the previous floor are released (their video memory is freed).
+   */
+  void prefetchFloorImages();
+
+  /*!
+   *  \brief Keeps the streamed sprite sheets of an enemy loaded until the next floor
+   *  \param enemy : the enemy type
+   */
+  void acquireEnemyImages(enemyTypeEnum enemy);
+
   /*!
    *  \brief Creates a level
    *
@@ -830,9 +970,21 @@ private:
    *  \brief Initializes the monster array
    *
    * Initializes the monster array (to empty).
+   * The spawn candidates will be built again at the next monster placement.
    */
   void initMonsterArray();
 
+  SpawnPlacer spawnPlacer;          /*!< Free tiles for the monster placement */
+  DungeonMap* spawnCandidatesMap;   /*!< Map the spawn candidates have been built for (NULL = to build) */
+
+  /*!
+   *  \brief Builds the spawn candidates of the current room
+   *
+   * Lists the free tiles of the room (walkable, flyable, large monsters) far enough from the player.
+   * Called once after the room generation, at the first monster placement.
+   */
+  void buildSpawnCandidates();
+
   /*!
    *  \brief Adds a monster
    *
@@ -862,13 +1014,6 @@ private:
    */
   void updateMusicVolume();
 
-  /*!
-   *  \brief Add a key to the player input map from a string key (from file)
-   *  \param logicInput : input function (move left, fire up, etc...)
-   *  \param key : Key as string
-   */
-  void addKey(int logicInput, std::string key);
-
   /*!
    *  \brief Save configuration to "config.dat"
    */
@@ -879,6 +1024,13 @@ private:
    */
   void configureFromFile();
 
+  /*!
+   *  \brief Applies a setting of the configuration (called on each change)
+   *  \param key : the setting
+   *  \param loading : true when the configuration is loaded (nothing is playing yet)
+   */
+  void applyConfiguration(configKeyEnum key, bool loading);
+
   /*!
    *  \brief Update the game
    */
@@ -939,7 +1091,18 @@ private:
   /*!
    *  \brief Render the scores screen
    */
-  void renderScores(std::vector <StructScore> scoresToRender, std::string title, bool blinkingName);
+  void renderScores(const std::vector <StructScore>& scoresToRender, std::string title, bool blinkingName);
+
+  /*!
+   *  \brief Report of the rendering statistics of the last frame (F2)
+   */
+  std::string getRenderReport();
+
+  /*!
+   *  \brief Queues the glyphs of the texts in the glyph baker
+   *  \param cyrillic : queues the cyrillic glyphs (russian) instead of the latin ones
+   */
+  void bakeGlyphs(bool cyrillic);
 
   /** Menu keys enum
    *  Identify the various keys of the menu.
@@ -1052,7 +1215,7 @@ private:
   };
   std::queue <achievementStruct> achievementsQueue;
 
-  void renderPlayer(float x, float y, bool equip[NUMBER_EQUIP_ITEMS], int shotType,
+  void renderPlayer(float x, float y, const bool equip[NUMBER_EQUIP_ITEMS], int shotType,
                   int frame, int spriteDy);
   void renderDeathScreen(float x, float y);
 
@@ -1088,12 +1251,13 @@ private:
   int currentStandardMusic;
 
   std::vector <StructScore> scores;
+  std::vector <StructScore> scoresToday;
   std::vector <StructScore> scoresOnline;
   std::vector <StructScore> scoresOnlineDay;
   StructScore lastScore;
   void loadHiScores();
   void loadHiScoresOnline(bool fromDayOnly);
-  void saveHiScores();
+  void importHiScores();
   enum enumNetworkScoreState
   {
     ScoreOK,
@@ -1144,6 +1308,10 @@ private:
 
   bool gameFromSaveFile;
 
+  SaveFileWriter saveFileWriter; /*!< Save file, written in a background thread */
+  RecordLog recordLog;           /*!< Game data and hi-scores */
+  ScreenCapture screenCapture;   /*!< Screenshots, saved in a background thread */
+
   // scoring server
   std::thread sendScoreThread;
   void sendScoreToServer();
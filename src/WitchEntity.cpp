@@ -48,6 +48,7 @@ WitchEntity::WitchEntity(float x, float y, witchTypeEnum witchType)
   timer = 3.0f;
   escapeTimer = -1.0f;
   state = 0;
+  hasThinkStep = true;
   agonizingSound = (sound_resources)(SOUND_WITCH_DIE_00 + rand() % 2);
 }
 
@@ -106,12 +107,6 @@ void WitchEntity::animate(float delay)
 
     if (state == 0)
     {
-      if (escapeTimer < 0.0f && Vector2D(x, y).distance2(game().getPlayerPosition()) <= 36000)
-      {
-        velocity = game().getPlayerPosition().vectorTo(Vector2D(x, y), creatureSpeed);
-        escapeTimer = 2.5f;
-      }
-
       frame = ((int)(age * 5.0f)) % 4;
       if (frame == 2) frame = 0;
       else if (frame == 3) frame = 2;
@@ -130,6 +125,16 @@ void WitchEntity::animate(float delay)
   z = y + 20;
 }
 
+void WitchEntity::think(float delay)
+{
+  // escape when the player is too close
+  if (state == 0 && escapeTimer < 0.0f && Vector2D(x, y).distance2(game().getPlayerPosition()) <= 36000)
+  {
+    velocity = game().getPlayerPosition().vectorTo(Vector2D(x, y), creatureSpeed);
+    escapeTimer = 2.5f;
+  }
+}
+
 void WitchEntity::calculateBB()
 {
   boundingBox.left = (int)x - 16;
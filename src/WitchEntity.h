@@ -20,6 +20,7 @@ class WitchEntity : public EnemyEntity
     virtual void collideWithEnemy(EnemyEntity* entity) override;
     virtual void collideWithBolt(BoltEntity* boltEntity);
     virtual void drop();
+    virtual void think(float delay) override;
   private:
     witchTypeEnum witchType;
     float timer;
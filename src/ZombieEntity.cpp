@@ -30,6 +30,7 @@ ZombieEntity::ZombieEntity(float x, float y, bool invocated)
   compute(false);
   timer = 5 + rand() % 6;
   attackTimer = 0.9f;
+  hasThinkStep = true;
 
   meleeDamages = ZOMBIE_DAMAGE;
 
@@ -66,22 +67,14 @@ void ZombieEntity::animate(float delay)
   }
   else if (age > 0.0f)
   {
-    if (attackTimer <= 0.0f && attack())
+    timer -= delay;
+    attackTimer -= delay;
+    if (timer < 0.0f)
     {
-      attackTimer = 2.0f;
-      giveRepulsion(false, Vector2D(velocity.x * 3.0f, velocity.y * 3.0f), 2.5f);
-    }
-    else
-    {
-      timer -= delay;
-      attackTimer -= delay;
-      if (timer < 0.0f)
-      {
-        SoundManager::getInstance().playSound(SOUND_ZOMBIE_00 + rand() % 2);
-        timer = 5 + rand() % 6;
-        if (rand() % 3 == 0) clockTurn = !clockTurn;
-        compute(true);
-      }
+      SoundManager::getInstance().playSound(SOUND_ZOMBIE_00 + rand() % 2);
+      timer = 5 + rand() % 6;
+      if (rand() % 3 == 0) clockTurn = !clockTurn;
+      compute(true);
     }
 
     checkNextFacing(delay);
@@ -97,6 +90,15 @@ void ZombieEntity::animate(float delay)
   z = y + 17;
 }
 
+void ZombieEntity::think(float delay)
+{
+  if (attackTimer <= 0.0f && attack())
+  {
+    attackTimer = 2.0f;
+    giveRepulsion(false, Vector2D(velocity.x * 3.0f, velocity.y * 3.0f), 2.5f);
+  }
+}
+
 bool ZombieEntity::attack()
 {
   Vector2D playerPos = game().getPlayerPosition();
@@ -18,6 +18,7 @@ class ZombieEntity : public EnemyEntity
     virtual void collideMapBottom();
     virtual void collideWithEnemy(EnemyEntity* entity) override;
     virtual void drop();
+    virtual void think(float delay) override;
 
   private:
     bool invocated;
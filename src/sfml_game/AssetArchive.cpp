@@ -0,0 +1,169 @@
+/**  This file is part of sfmlGame.
+  *
+  *  FreeTumble is free software: you can redistribute it and/or modify
+  *  it under the terms of the GNU General Public License as published by
+  *  the Free Software Foundation, either version 3 of the License, or
+  *  (at your option) any later version.
+  *
+  *  FreeTumble is distributed in the hope that it will be useful,
+  *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  *  GNU General Public License for more details.
+  *
+  *  You should have received a copy of the GNU General Public License
+  *  along with FreeTumble.  If not, see <http://www.gnu.org/licenses/>.
+  */
+
+#include "AssetArchive.h"
+#include <iostream>
+#include <cstring>
+
+static uint32_t getUint(const char* source)
+{
+    const unsigned char* s = (const unsigned char*)source;
+    return (uint32_t)s[0] | ((uint32_t)s[1] << 8) | ((uint32_t)s[2] << 16) | ((uint32_t)s[3] << 24);
+}
+
+assetTypeEnum getAssetType(const std::string& fileName)
+{
+    std::size_t dot = fileName.find_last_of('.');
+    if (dot == std::string::npos) return AssetTypeOther;
+    std::string extension = fileName.substr(dot + 1);
+
+    if (extension == "png" || extension == "jpg") return AssetTypeImage;
+    if (extension == "ogg" || extension == "wav" || extension == "flac") return AssetTypeSound;
+    if (extension == "ttf" || extension == "otf") return AssetTypeFont;
+    if (extension == "txt") return AssetTypeText;
+    return AssetTypeOther;
+}
+
+AssetArchive::AssetArchive()
+{
+    mapData = NULL;
+    mapSize = 0;
+    entryCount = 0;
+    names = NULL;
+    namesSize = 0;
+}
+
+AssetArchive::~AssetArchive()
+{
+    close();
+}
+
+AssetArchive& AssetArchive::getInstance()
+{
+    static AssetArchive singleton;
+    return singleton;
+}
+
+bool AssetArchive::open(const std::string& fileName)
+{
+    close();
+
+    // no archive: the loose files are used
+    if (!file.open(fileName)) return false;
+    mapData = file.getData();
+    mapSize = file.getSize();
+
+    if (!checkIndex())
+    {
+        std::cout << "[ERROR] Invalid asset archive: " << fileName << std::endl;
+        close();
+        return false;
+    }
+
+    this->fileName = fileName;
+    return true;
+}
+
+void AssetArchive::close()
+{
+    file.close();
+    fileName.clear();
+    mapData = NULL;
+    mapSize = 0;
+    entryCount = 0;
+    names = NULL;
+    namesSize = 0;
+}
+
+bool AssetArchive::checkIndex()
+{
+    if (mapSize < ASSET_ARCHIVE_HEADER_SIZE || memcmp(mapData, ASSET_ARCHIVE_MAGIC, 4) != 0) return false;
+    if (getUint(mapData + 4) != ASSET_ARCHIVE_VERSION) return false;
+
+    uint32_t count = getUint(mapData + 8);
+    uint32_t size = getUint(mapData + 12);
+    uint64_t namesOffset = ASSET_ARCHIVE_HEADER_SIZE + (uint64_t)count * ASSET_ARCHIVE_ENTRY_SIZE;
+    if (namesOffset + size > mapSize) return false;
+
+    entryCount = count;
+    names = mapData + namesOffset;
+    namesSize = size;
+
+    // every name and every file in the archive, names sorted (for the binary search)
+    const char* previousName = NULL;
+    for (uint32_t i = 0; i < entryCount; i++)
+    {
+        const char* entry = getEntry(i);
+        uint32_t nameOffset = getUint(entry);
+        if (nameOffset >= namesSize || memchr(names + nameOffset, 0, namesSize - nameOffset) == NULL)
+            return false;
+        if ((uint64_t)getUint(entry + 4) + getUint(entry + 8) > mapSize) return false;
+
+        const char* name = getEntryName(entry);
+        if (previousName && strcmp(previousName, name) >= 0) return false;
+        previousName = name;
+    }
+    return true;
+}
+
+const char* AssetArchive::getEntry(uint32_t n)
+{
+    return mapData + ASSET_ARCHIVE_HEADER_SIZE + n * ASSET_ARCHIVE_ENTRY_SIZE;
+}
+
+const char* AssetArchive::getEntryName(const char* entry)
+{
+    return names + getUint(entry);
+}
+
+bool AssetArchive::isOpen()
+{
+    return mapData != NULL;
+}
+
+const std::string& AssetArchive::getFileName()
+{
+    return fileName;
+}
+
+int AssetArchive::getEntryCount()
+{
+    return entryCount;
+}
+
+bool AssetArchive::find(const std::string& fileName, const void*& data, std::size_t& size)
+{
+    uint32_t first = 0;
+    uint32_t last = entryCount;
+    while (first < last)
+    {
+        uint32_t middle = first + (last - first) / 2;
+        const char* entry = getEntry(middle);
+        int comparison = strcmp(getEntryName(entry), fileName.c_str());
+
+        if (comparison == 0)
+        {
+            data = mapData + getUint(entry + 4);
+            size = getUint(entry + 8);
+            return true;
+        }
+        else if (comparison < 0)
+            first = middle + 1;
+        else
+            last = middle;
+    }
+    return false;
+}
@@ -0,0 +1,93 @@
+/**  This file is part of sfmlGame.
+  *
+  *  FreeTumble is free software: you can redistribute it and/or modify
+  *  it under the terms of the GNU General Public License as published by
+  *  the Free Software Foundation, either version 3 of the License, or
+  *  (at your option) any later version.
+  *
+  *  FreeTumble is distributed in the hope that it will be useful,
+  *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  *  GNU General Public License for more details.
+  *
+  *  You should have received a copy of the GNU General Public License
+  *  along with FreeTumble.  If not, see <http://www.gnu.org/licenses/>.
+  */
+
+#ifndef ASSETARCHIVE_H_INCLUDED
+#define ASSETARCHIVE_H_INCLUDED
+
+#include <string>
+#include <cstddef>
+#include <cstdint>
+#include "MappedFile.h"
+
+/** Archive layout (little endian, built by tools/AssetPacker.cpp):
+  *
+  *  header (16 bytes): magic "WBPK", format version, number of entries, size of the names block
+  *  index:             one entry (16 bytes) per file, sorted by name: offset of the name in
+  *                     the names block, offset of the data in the archive, size, type
+  *  names:             file names ("media/bat.png"), zero terminated
+  *  data:              the files, each one aligned on ASSET_ARCHIVE_ALIGN bytes
+  */
+const char ASSET_ARCHIVE_MAGIC[4] = { 'W', 'B', 'P', 'K' };
+const uint32_t ASSET_ARCHIVE_VERSION = 1;
+const uint32_t ASSET_ARCHIVE_HEADER_SIZE = 16;
+const uint32_t ASSET_ARCHIVE_ENTRY_SIZE = 16;
+const uint32_t ASSET_ARCHIVE_ALIGN = 16;
+
+enum assetTypeEnum
+{
+    AssetTypeOther,
+    AssetTypeImage,
+    AssetTypeSound,
+    AssetTypeFont,
+    AssetTypeText
+};
+
+/** Returns the type of an asset from the extension of its name. */
+assetTypeEnum getAssetType(const std::string& fileName);
+
+/** The assets packed in a single file, mapped in memory.
+  * The files are served from the mapped memory (loadFromMemory / openFromMemory), without
+  * any copy, so it stays mapped until the end of the program.
+  * The files missing in the archive (or all of them, without archive) are loaded from
+  * the disk by the callers. */
+class AssetArchive
+{
+public:
+    static AssetArchive& getInstance();
+
+    /** Maps the archive. Returns false if it is missing or invalid (the loose files are used). */
+    bool open(const std::string& fileName);
+    bool isOpen();
+
+    /** Name of the archive file (empty if no archive is open). */
+    const std::string& getFileName();
+
+    /** Finds a file in the archive (binary search in the index).
+      * Thread safe once the archive is opened. */
+    bool find(const std::string& fileName, const void*& data, std::size_t& size);
+
+    int getEntryCount();
+
+private:
+    AssetArchive();
+    ~AssetArchive();
+
+    void close();
+    bool checkIndex();
+    const char* getEntry(uint32_t n);
+    const char* getEntryName(const char* entry);
+
+    std::string fileName;
+    MappedFile file;
+    const char* mapData;
+    std::size_t mapSize;
+
+    uint32_t entryCount;
+    const char* names;
+    uint32_t namesSize;
+};
+
+#endif // ASSETARCHIVE_H_INCLUDED
@@ -26,32 +26,17 @@ GameMap::GameMap(int width, int height)
   this->width = width;
   this->height = height;
 
-  map = new int* [width];
-  int i = 0;
-  for ( i = 0 ; i < width ; i++)
-      map[i] = new int [height];
-
-  for ( i = 0 ; i < width ; i++)
-    for ( int j = 0 ; j < height ; j++)
-      map[i][j] = 0;
+  mapTileStruct emptyTile = { 0, 0, 0 };
+  tiles.assign(width * height, emptyTile);
 }
 
 GameMap::~GameMap()
 {
-    for ( int i = 0 ; i < width ; i++)
-        delete[] map [i];
-    delete[] map;
 }
 
 int GameMap::getWidth() { return width; }
 int GameMap::getHeight() { return height; }
 
-int GameMap::getTile(int x, int y)
-{
-    if (!inMap(x, y)) return -1;
-    return map[x][y];
-}
-
 bool GameMap::getChanged()
 {
   bool result = hasChanged;
@@ -59,44 +44,35 @@ bool GameMap::getChanged()
   return result;
 }
 
-bool GameMap::inMap(int x, int y)
-{
-  if (x < 0) return false;
-  if (y < 0) return false;
-  if (x >= width) return false;
-  if (y >= height) return false;
-  return true;
-}
-
 bool GameMap::isDownBlocking(int x, int y)
 {
   if (!inMap(x, y)) return false;
-  return (map[x][y] > 0);
+  return (tileAt(x, y).tile > 0);
 }
 
 bool GameMap::isUpBlocking(int x, int y)
 {
   if (y < 0) return true;
   if (!inMap(x, y)) return false;
-  return (map[x][y] > 0);
+  return (tileAt(x, y).tile > 0);
 }
 
 bool GameMap::isLeftBlocking(int x, int y)
 {
   if (!inMap(x, y)) return false;
-  return (map[x][y] > 0);
+  return (tileAt(x, y).tile > 0);
 }
 
 bool GameMap::isRightBlocking(int x, int y)
 {
   if (!inMap(x, y)) return false;
-  return (map[x][y] > 0);
+  return (tileAt(x, y).tile > 0);
 }
 
 void GameMap::setTile(int x, int y, int n)
 {
   if (!inMap(x, y)) return;
-  map[x][y] = n;
+  tileAt(x, y).tile = n;
   hasChanged = true;
 }
 
@@ -105,7 +81,7 @@ void GameMap::randomize(int n)
   hasChanged = true;
     for ( int i = 0 ; i < width ; i++)
         for ( int j = 0 ; j < height ; j++)
-            map[i][j] = (int) (((float) rand() / (float)RAND_MAX * ((float)n)));
+            tileAt(i, j).tile = (int) (((float) rand() / (float)RAND_MAX * ((float)n)));
 
 }
 
@@ -129,9 +105,14 @@ void GameMap::loadFromFile(const char* fileName)
     for (i = 0; i < width; i++)
     {
       f >> n;
-      map[i][j] = n;
+      tileAt(i, j).tile = n;
     }
   }
 
   f.close();
 }
+
+int GameMap::getMemorySize()
+{
+  return sizeof(GameMap) + tiles.capacity() * sizeof(mapTileStruct);
+}
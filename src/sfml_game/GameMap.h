@@ -17,10 +17,20 @@
 #define GAMEMAP_H_INCLUDED
 
 #include <string>
+#include <vector>
+#include <cstdint>
 
 class GameMap
 {
 public:
+    /** Data of a tile, interleaved in a single row-major buffer */
+    struct mapTileStruct
+    {
+      uint16_t tile;      /**< tile index in the tileset */
+      uint16_t object;    /**< object tile, used by derived maps */
+      uint16_t logical;   /**< logical state, used by derived maps */
+    };
+
     GameMap(int width, int height);
     virtual ~GameMap();
     int getWidth();
@@ -39,11 +49,27 @@ public:
     virtual void randomize(int n);
     virtual void loadFromFile(const char* fileName);
 
+    /** Memory used by the map (bytes) */
+    virtual int getMemorySize();
+
 protected:
     int width;
     int height;
-    int** map;
+    std::vector<mapTileStruct> tiles;
     bool hasChanged;
+
+    mapTileStruct& tileAt(int x, int y) { return tiles[x + y * width]; }
 };
 
+inline bool GameMap::inMap(int x, int y)
+{
+  return x >= 0 && y >= 0 && x < width && y < height;
+}
+
+inline int GameMap::getTile(int x, int y)
+{
+  if (!inMap(x, y)) return -1;
+  return tiles[x + y * width].tile;
+}
+
 #endif // GAMEMAP_H_INCLUDED
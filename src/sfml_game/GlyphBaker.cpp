@@ -0,0 +1,64 @@
+/**  This file is part of Witch Blast.
+  *
+  *  Witch Blast is free software: you can redistribute it and/or modify
+  *  it under the terms of the GNU General Public License as published by
+  *  the Free Software Foundation, either version 3 of the License, or
+  *  (at your option) any later version.
+  *
+  *  Witch Blast is distributed in the hope that it will be useful,
+  *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  *  GNU General Public License for more details.
+  *
+  *  You should have received a copy of the GNU General Public License
+  *  along with Witch Blast.  If not, see <http://www.gnu.org/licenses/>.
+  */
+
+#include "GlyphBaker.h"
+
+GlyphBaker::GlyphBaker()
+{
+    bakedCount = 0;
+}
+
+void GlyphBaker::add(const sf::Font& font, unsigned int size, sf::Uint32 first, sf::Uint32 last)
+{
+    if (first > last) return;
+
+    bakeJobStruct job;
+    job.font = &font;
+    job.size = size;
+    job.next = first;
+    job.last = last;
+    jobs.push_back(job);
+}
+
+void GlyphBaker::update(int budget)
+{
+    if (jobs.empty()) return;
+
+    clock.restart();
+    while (!jobs.empty() && clock.getElapsedTime().asMicroseconds() < budget)
+    {
+        bakeJobStruct& job = jobs.front();
+
+        // the same glyph as sf::Text (regular, without outline)
+        job.font->getGlyph(job.next, job.size, false);
+        bakedCount++;
+
+        if (job.next == job.last)
+            jobs.pop_front();
+        else
+            job.next++;
+    }
+}
+
+bool GlyphBaker::isDone()
+{
+    return jobs.empty();
+}
+
+int GlyphBaker::getBakedCount()
+{
+    return bakedCount;
+}
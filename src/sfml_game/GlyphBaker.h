@@ -0,0 +1,56 @@
+/**  This file is part of Witch Blast.
+  *
+  *  Witch Blast is free software: you can redistribute it and/or modify
+  *  it under the terms of the GNU General Public License as published by
+  *  the Free Software Foundation, either version 3 of the License, or
+  *  (at your option) any later version.
+  *
+  *  Witch Blast is distributed in the hope that it will be useful,
+  *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  *  GNU General Public License for more details.
+  *
+  *  You should have received a copy of the GNU General Public License
+  *  along with Witch Blast.  If not, see <http://www.gnu.org/licenses/>.
+  */
+
+#ifndef GLYPHBAKER_H_INCLUDED
+#define GLYPHBAKER_H_INCLUDED
+
+#include <SFML/Graphics.hpp>
+#include <deque>
+
+/** Rasterizes the glyphs of fonts before they are displayed.
+  * sf::Font renders a glyph (FreeType) and packs it in the page of its size the first time
+  * it is used, so a text in a new size costs a stutter. The baker renders the queued glyphs
+  * a few at a time, under a time budget per frame, in the main thread (the fonts and their
+  * textures are not thread safe). A baked glyph is then found in the cache of the font. */
+class GlyphBaker
+{
+public:
+    GlyphBaker();
+
+    /** Queues the glyphs from first to last (codepoints) of a font, at a size.
+      * The glyphs are baked in the order of the calls. */
+    void add(const sf::Font& font, unsigned int size, sf::Uint32 first, sf::Uint32 last);
+
+    /** Bakes glyphs for about budget microseconds. */
+    void update(int budget);
+
+    bool isDone();
+    int getBakedCount();
+
+private:
+    struct bakeJobStruct
+    {
+        const sf::Font* font;
+        unsigned int size;
+        sf::Uint32 next;
+        sf::Uint32 last;
+    };
+    std::deque<bakeJobStruct> jobs;
+    sf::Clock clock;
+    int bakedCount;
+};
+
+#endif // GLYPHBAKER_H_INCLUDED
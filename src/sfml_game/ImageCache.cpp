@@ -0,0 +1,287 @@
+/**  This file is part of Witch Blast.
+  *
+  *  Witch Blast is free software: you can redistribute it and/or modify
+  *  it under the terms of the GNU General Public License as published by
+  *  the Free Software Foundation, either version 3 of the License, or
+  *  (at your option) any later version.
+  *
+  *  Witch Blast is distributed in the hope that it will be useful,
+  *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  *  GNU General Public License for more details.
+  *
+  *  You should have received a copy of the GNU General Public License
+  *  along with Witch Blast.  If not, see <http://www.gnu.org/licenses/>.
+  */
+
+#include "ImageCache.h"
+#include "AssetArchive.h"
+#include "MappedFile.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <vector>
+#include <cstring>
+#include <cstdlib>
+#include <cstdio>
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <direct.h>
+#else
+#include <dirent.h>
+#endif
+
+static uint32_t getUint(const char* source)
+{
+    const unsigned char* s = (const unsigned char*)source;
+    return (uint32_t)s[0] | ((uint32_t)s[1] << 8) | ((uint32_t)s[2] << 16) | ((uint32_t)s[3] << 24);
+}
+
+static uint64_t getUint64(const char* source)
+{
+    return (uint64_t)getUint(source) | ((uint64_t)getUint(source + 4) << 32);
+}
+
+static void putUint(char* dest, uint32_t n)
+{
+    for (int i = 0; i < 4; i++) dest[i] = (char)((n >> (8 * i)) & 0xFF);
+}
+
+static void putUint64(char* dest, uint64_t n)
+{
+    putUint(dest, (uint32_t)n);
+    putUint(dest + 4, (uint32_t)(n >> 32));
+}
+
+// FNV-1a
+static uint64_t getHash(const std::string& s)
+{
+    uint64_t hash = 14695981039346656037ULL;
+    for (std::size_t i = 0; i < s.size(); i++)
+    {
+        hash ^= (unsigned char)s[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+static bool endsWith(const std::string& s, const std::string& end)
+{
+    return s.size() >= end.size() && s.compare(s.size() - end.size(), end.size(), end) == 0;
+}
+
+ImageCache::ImageCache()
+{
+    prunedCount = 0;
+}
+
+std::string ImageCache::getUserDirectory(const std::string& name)
+{
+#if defined(_WIN32)
+    const char* localAppData = getenv("LOCALAPPDATA");
+    if (localAppData && localAppData[0]) return std::string(localAppData) + "/" + name + "/cache";
+#elif defined(__APPLE__)
+    const char* home = getenv("HOME");
+    if (home && home[0]) return std::string(home) + "/Library/Caches/" + name;
+#else
+    // a relative XDG_CACHE_HOME is invalid (XDG base directory specification)
+    const char* cacheHome = getenv("XDG_CACHE_HOME");
+    if (cacheHome && cacheHome[0] == '/') return std::string(cacheHome) + "/" + name;
+    const char* home = getenv("HOME");
+    if (home && home[0]) return std::string(home) + "/.cache/" + name;
+#endif
+    return "";
+}
+
+bool ImageCache::makeDirectory(const std::string& directory)
+{
+    // the parents first (~/.cache may not exist yet)
+    for (std::size_t i = 1; i <= directory.size(); i++)
+    {
+        if (i < directory.size() && directory[i] != '/' && directory[i] != '\\') continue;
+        std::string path = directory.substr(0, i);
+#ifdef _WIN32
+        _mkdir(path.c_str());
+#else
+        mkdir(path.c_str(), 0755);
+#endif
+    }
+
+    struct stat info;
+    return stat(directory.c_str(), &info) == 0 && (info.st_mode & S_IFDIR);
+}
+
+void ImageCache::open(const std::string& directory)
+{
+    this->directory.clear();
+    prunedCount = 0;
+    if (directory.empty()) return;
+
+    if (!makeDirectory(directory))
+    {
+        std::cout << "[WARNING] Impossible to create the image cache: " << directory << std::endl;
+        return;
+    }
+    this->directory = directory;
+    prune();
+}
+
+bool ImageCache::isOpen() const
+{
+    return !directory.empty();
+}
+
+int ImageCache::getPrunedCount() const
+{
+    return prunedCount;
+}
+
+bool ImageCache::getSource(const std::string& fileName, sourceStruct& source)
+{
+    // a packed image changes with the archive
+    const void* data;
+    std::size_t size;
+    bool packed = AssetArchive::getInstance().find(fileName, data, size);
+    const std::string& sourceFile = packed ? AssetArchive::getInstance().getFileName() : fileName;
+
+    struct stat info;
+    if (stat(sourceFile.c_str(), &info) != 0) return false;
+    source.size = packed ? size : (uint64_t)info.st_size;
+    source.time = (uint64_t)info.st_mtime;
+    return true;
+}
+
+std::string ImageCache::getEntryFile(const std::string& fileName) const
+{
+    std::ostringstream oss;
+    oss << directory << "/" << std::hex << std::setfill('0') << std::setw(16) << getHash(fileName) << ".rgba";
+    return oss.str();
+}
+
+bool ImageCache::readEntry(sf::Image& image, const std::string& entryFile, const std::string& fileName, const sourceStruct& source)
+{
+    MappedFile file;
+    if (!file.open(entryFile)) return false;
+
+    const char* data = file.getData();
+    if (file.getSize() < IMAGE_CACHE_HEADER_SIZE || memcmp(data, IMAGE_CACHE_MAGIC, 4) != 0
+        || getUint(data + 4) != IMAGE_CACHE_VERSION
+        || getUint64(data + 16) != source.size || getUint64(data + 24) != source.time)
+        return false;
+
+    uint32_t width = getUint(data + 8);
+    uint32_t height = getUint(data + 12);
+    uint32_t nameSize = getUint(data + 32);
+    if (nameSize != fileName.size()
+        || file.getSize() != IMAGE_CACHE_HEADER_SIZE + nameSize + (uint64_t)width * height * 4
+        || memcmp(data + IMAGE_CACHE_HEADER_SIZE, fileName.c_str(), nameSize) != 0)
+        return false;
+
+    image.create(width, height, (const sf::Uint8*)(data + IMAGE_CACHE_HEADER_SIZE + nameSize));
+    return true;
+}
+
+void ImageCache::writeEntry(const sf::Image& image, const std::string& entryFile, const std::string& fileName, const sourceStruct& source)
+{
+    char header[IMAGE_CACHE_HEADER_SIZE];
+    memcpy(header, IMAGE_CACHE_MAGIC, 4);
+    putUint(header + 4, IMAGE_CACHE_VERSION);
+    putUint(header + 8, image.getSize().x);
+    putUint(header + 12, image.getSize().y);
+    putUint64(header + 16, source.size);
+    putUint64(header + 24, source.time);
+    putUint(header + 32, fileName.size());
+
+    // written to a temporary file and renamed: a cached image is always complete
+    std::string tmpFileName = entryFile + ".tmp";
+    std::ofstream file(tmpFileName.c_str(), std::ios::out | std::ios::trunc | std::ios::binary);
+    file.write(header, IMAGE_CACHE_HEADER_SIZE);
+    file.write(fileName.c_str(), fileName.size());
+    file.write((const char*)image.getPixelsPtr(), (std::streamsize)image.getSize().x * image.getSize().y * 4);
+    file.close();
+
+    // rename does not replace an existing file on every platform
+    bool ok = file && (rename(tmpFileName.c_str(), entryFile.c_str()) == 0
+                       || (remove(entryFile.c_str()) == 0 && rename(tmpFileName.c_str(), entryFile.c_str()) == 0));
+    if (!ok)
+    {
+        std::cout << "[WARNING] Writing cached image: " << entryFile << std::endl;
+        remove(tmpFileName.c_str());
+    }
+}
+
+bool ImageCache::load(sf::Image& image, const std::string& fileName, const void* data, std::size_t size, bool& fromCache)
+{
+    fromCache = false;
+    sourceStruct source;
+    if (directory.empty() || !getSource(fileName, source)) return image.loadFromMemory(data, size);
+
+    std::string entryFile = getEntryFile(fileName);
+    if (readEntry(image, entryFile, fileName, source))
+    {
+        fromCache = true;
+        return true;
+    }
+
+    if (!image.loadFromMemory(data, size)) return false;
+    writeEntry(image, entryFile, fileName, source);
+    return true;
+}
+
+bool ImageCache::isStale(const std::string& entryFile)
+{
+    char header[IMAGE_CACHE_HEADER_SIZE];
+    std::ifstream file(entryFile.c_str(), std::ios::in | std::ios::binary);
+    if (!file.read(header, IMAGE_CACHE_HEADER_SIZE)
+        || memcmp(header, IMAGE_CACHE_MAGIC, 4) != 0 || getUint(header + 4) != IMAGE_CACHE_VERSION)
+        return true;
+
+    std::string fileName(getUint(header + 32), '\0');
+    if (fileName.empty() || !file.read(&fileName[0], fileName.size())) return true;
+
+    // removed or modified source
+    sourceStruct source;
+    return !getSource(fileName, source) || getUint64(header + 16) != source.size || getUint64(header + 24) != source.time;
+}
+
+void ImageCache::prune()
+{
+    std::vector<std::string> entries;
+#ifdef _WIN32
+    WIN32_FIND_DATAA findData;
+    HANDLE find = FindFirstFileA((directory + "/*").c_str(), &findData);
+    if (find != INVALID_HANDLE_VALUE)
+    {
+        do entries.push_back(findData.cFileName);
+        while (FindNextFileA(find, &findData));
+        FindClose(find);
+    }
+#else
+    DIR* dir = opendir(directory.c_str());
+    if (dir)
+    {
+        while (struct dirent* entry = readdir(dir)) entries.push_back(entry->d_name);
+        closedir(dir);
+    }
+#endif
+
+    for (unsigned int i = 0; i < entries.size(); i++)
+    {
+        std::string entryFile = directory + "/" + entries[i];
+        // ".tmp": written by a crashed run
+        if (endsWith(entries[i], ".tmp") || (endsWith(entries[i], ".rgba") && isStale(entryFile)))
+        {
+            if (remove(entryFile.c_str()) == 0) prunedCount++;
+        }
+    }
+}
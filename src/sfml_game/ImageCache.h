@@ -0,0 +1,77 @@
+/**  This file is part of Witch Blast.
+  *
+  *  Witch Blast is free software: you can redistribute it and/or modify
+  *  it under the terms of the GNU General Public License as published by
+  *  the Free Software Foundation, either version 3 of the License, or
+  *  (at your option) any later version.
+  *
+  *  Witch Blast is distributed in the hope that it will be useful,
+  *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  *  GNU General Public License for more details.
+  *
+  *  You should have received a copy of the GNU General Public License
+  *  along with Witch Blast.  If not, see <http://www.gnu.org/licenses/>.
+  */
+
+#ifndef IMAGECACHE_H_INCLUDED
+#define IMAGECACHE_H_INCLUDED
+
+#include <SFML/Graphics/Image.hpp>
+#include <string>
+#include <cstddef>
+#include <cstdint>
+
+/** Cached image layout (little endian): magic "WBIC", format version, width, height,
+  * size and modification time of the source (8 bytes each), size of the source name,
+  * the source name, then the RGBA pixels. */
+const char IMAGE_CACHE_MAGIC[4] = { 'W', 'B', 'I', 'C' };
+const uint32_t IMAGE_CACHE_VERSION = 2;
+const uint32_t IMAGE_CACHE_HEADER_SIZE = 36;
+
+/** Cache of the decoded images, as raw RGBA pixels.
+  * An entry is named after a hash of the image file name, and keeps the size and the
+  * modification time of its source (the asset archive for the packed images): an entry
+  * which does not match is decoded and written again. The entries of the removed or
+  * modified files are pruned when the cache is opened. */
+class ImageCache
+{
+public:
+    ImageCache();
+
+    /** Sets the directory of the cache, created if needed (empty: no cache), and prunes
+      * the stale entries. */
+    void open(const std::string& directory);
+    bool isOpen() const;
+
+    /** Decodes an image (data of the file, from the archive or the disk), or reads it from
+      * the cache. Thread safe once the cache is opened. */
+    bool load(sf::Image& image, const std::string& fileName, const void* data, std::size_t size, bool& fromCache);
+
+    /** Number of stale entries removed by open(). */
+    int getPrunedCount() const;
+
+    /** Per-user cache directory of an application: $XDG_CACHE_HOME/<name> or ~/.cache/<name>
+      * (Linux), ~/Library/Caches/<name> (macOS), %LOCALAPPDATA%/<name>/cache (Windows).
+      * Empty if the user directory is unknown. */
+    static std::string getUserDirectory(const std::string& name);
+
+private:
+    struct sourceStruct
+    {
+        uint64_t size;
+        uint64_t time;
+    };
+    static bool getSource(const std::string& fileName, sourceStruct& source);
+    static bool makeDirectory(const std::string& directory);
+    std::string getEntryFile(const std::string& fileName) const;
+    bool readEntry(sf::Image& image, const std::string& entryFile, const std::string& fileName, const sourceStruct& source);
+    void writeEntry(const sf::Image& image, const std::string& entryFile, const std::string& fileName, const sourceStruct& source);
+    bool isStale(const std::string& entryFile);
+    void prune();
+
+    std::string directory;
+    int prunedCount;
+};
+
+#endif // IMAGECACHE_H_INCLUDED
@@ -15,14 +15,29 @@
   */
 
 #include "ImageManager.h"
+#include "AssetArchive.h"
+#include "MappedFile.h"
 #include <iostream>
+#include <atomic>
+#include <algorithm>
 
 ImageManager::ImageManager()
 {
+    stopping = false;
 }
 
 ImageManager::~ImageManager()
 {
+    if (loaderThread.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> lock(loadMutex);
+            stopping = true;
+        }
+        loadCondition.notify_one();
+        loaderThread.join();
+    }
+
     std::cout << "Releasing video memory... ";
     for (unsigned int i = 0; i < imageArray.size(); i++)
     {
@@ -38,22 +53,283 @@ ImageManager& ImageManager::getInstance()
     return singleton;
 }
 
+void ImageManager::setCacheDirectory(const std::string& directory)
+{
+    cache.open(directory);
+    if (cache.getPrunedCount() > 0)
+        std::cout << "Images: " << cache.getPrunedCount() << " stale entries removed from the cache" << std::endl;
+}
+
+bool ImageManager::decodeImage(sf::Image& image, const std::string& fileName, bool& fromCache)
+{
+    fromCache = false;
+
+    const void* data;
+    std::size_t size;
+    MappedFile file;
+    if (!AssetArchive::getInstance().find(fileName, data, size))
+    {
+        if (!file.open(fileName))
+        {
+            std::cout << "[ERROR] Loading image: " << fileName << std::endl;
+            return false;
+        }
+        data = file.getData();
+        size = file.getSize();
+    }
+
+    return cache.load(image, fileName, data, size, fromCache);
+}
+
+bool ImageManager::loadTexture(sf::Texture* texture, const std::string& fileName)
+{
+    sf::Image image;
+    bool fromCache;
+    return decodeImage(image, fileName, fromCache) && texture->loadFromImage(image);
+}
+
+void ImageManager::registerImage(sf::Texture* texture, const std::string& fileName, bool streamed)
+{
+    imageArray.push_back(texture);
+    imageFile.push_back(fileName);
+    imageStreamed.push_back(streamed);
+    imageRefCount.push_back(0);
+    imageGeneration.push_back(0);
+    imageLoading.push_back(false);
+}
+
 void ImageManager::addImage(const char* fileName)
 {
     sf::Texture* newImage = new sf::Texture;
-    newImage->loadFromFile(fileName);
-    imageArray.push_back(newImage);
+    loadTexture(newImage, fileName);
+    registerImage(newImage, fileName, false);
 }
 
-bool ImageManager::reloadImage(int n, const char* fileName)
+void ImageManager::addImages(const std::vector<std::string>& fileNames, const std::vector<bool>& streamed)
 {
-    sf::Texture* newImage = new sf::Texture;
-    bool result = newImage->loadFromFile(fileName);
-    imageArray[n] = newImage;
-    return result;
+    sf::Clock clock;
+    std::vector<sf::Image> images(fileNames.size());
+    std::vector<char> decoded(fileNames.size(), false);
+    std::atomic<unsigned int> nextImage(0);
+    std::atomic<int> cacheHits(0);
+
+    // each thread takes the next image to decode (the sizes are very different)
+    auto decodeImages = [&]()
+    {
+        for (unsigned int i = nextImage++; i < fileNames.size(); i = nextImage++)
+        {
+            if (i < streamed.size() && streamed[i]) continue;
+            bool fromCache;
+            decoded[i] = decodeImage(images[i], fileNames[i], fromCache);
+            if (fromCache) cacheHits++;
+        }
+    };
+
+    unsigned int nbThreads = std::max(1u, std::min(std::thread::hardware_concurrency(), (unsigned int)fileNames.size()));
+    std::vector<std::thread> threads;
+    for (unsigned int i = 1; i < nbThreads; i++) threads.push_back(std::thread(decodeImages));
+    decodeImages();
+    for (unsigned int i = 0; i < threads.size(); i++) threads[i].join();
+    sf::Int32 decodeTime = clock.getElapsedTime().asMilliseconds();
+
+    // OpenGL: main thread
+    for (unsigned int i = 0; i < fileNames.size(); i++)
+    {
+        sf::Texture* newImage = new sf::Texture;
+        if (decoded[i]) newImage->loadFromImage(images[i]);
+        registerImage(newImage, fileNames[i], i < streamed.size() && streamed[i]);
+        images[i] = sf::Image();
+    }
+
+    std::cout << "Images: " << fileNames.size() << " loaded in " << clock.getElapsedTime().asMilliseconds()
+              << " ms (decoding: " << decodeTime << " ms on " << nbThreads << " threads, "
+              << cacheHits << " from the cache)" << std::endl;
+}
+
+void ImageManager::addStreamedImage(const char* fileName)
+{
+    registerImage(new sf::Texture, fileName, true);
+}
+
+bool ImageManager::loadImage(int n, const std::string& fileName)
+{
+    // a pending background load would overwrite it
+    imageGeneration[n]++;
+    imageLoading[n] = false;
+    return loadTexture(imageArray[n], fileName);
+}
+
+void ImageManager::loadImageAsync(int n, const std::string& fileName, std::function<void(int)> callback)
+{
+    loadJobStruct job;
+    job.n = n;
+    job.generation = ++imageGeneration[n];
+    job.fileName = fileName;
+    job.callback = callback;
+    imageLoading[n] = true;
+
+    {
+        std::lock_guard<std::mutex> lock(loadMutex);
+        loadQueue.push_back(job);
+    }
+    if (!loaderThread.joinable())
+        loaderThread = std::thread(&ImageManager::loaderThreadLoop, this);
+    loadCondition.notify_one();
+}
+
+void ImageManager::loaderThreadLoop()
+{
+    while (true)
+    {
+        decodedImageStruct decoded;
+        {
+            std::unique_lock<std::mutex> lock(loadMutex);
+            loadCondition.wait(lock, [this] { return stopping || !loadQueue.empty(); });
+            if (stopping) return;
+            decoded.job = loadQueue.front();
+            loadQueue.pop_front();
+        }
+
+        // decoding only (no OpenGL in this thread)
+        bool fromCache;
+        decoded.ok = decodeImage(decoded.image, decoded.job.fileName, fromCache);
+
+        std::lock_guard<std::mutex> lock(loadMutex);
+        decodedImages.push_back(std::move(decoded));
+    }
+}
+
+void ImageManager::update()
+{
+    std::vector<decodedImageStruct> decoded;
+    {
+        std::lock_guard<std::mutex> lock(loadMutex);
+        decoded.swap(decodedImages);
+    }
+
+    for (unsigned int i = 0; i < decoded.size(); i++)
+    {
+        // not if the image has been loaded or unloaded since
+        loadJobStruct& job = decoded[i].job;
+        if (job.generation != imageGeneration[job.n]) continue;
+
+        if (decoded[i].ok)
+        {
+            imageArray[job.n]->loadFromImageAsync(decoded[i].image);
+            uploads.push_back(job);
+        }
+        else
+            imageLoading[job.n] = false;
+    }
+
+    for (unsigned int i = 0; i < unloads.size(); i++)
+    {
+        // not if it has been acquired again since
+        int n = unloads[i];
+        if (imageRefCount[n] > 0) continue;
+        // the texture object is kept (the sprites point to it), its OpenGL texture is deleted
+        sf::Texture empty;
+        imageArray[n]->swap(empty);
+    }
+    unloads.clear();
+
+    // the pixel buffers are released by isUploadComplete()
+    for (unsigned int i = 0; i < uploads.size(); )
+    {
+        loadJobStruct& job = uploads[i];
+        if (imageArray[job.n]->isUploadComplete())
+        {
+            if (job.generation == imageGeneration[job.n])
+            {
+                imageLoading[job.n] = false;
+                if (job.callback) job.callback(job.n);
+            }
+            uploads.erase(uploads.begin() + i);
+        }
+        else
+            i++;
+    }
+}
+
+bool ImageManager::isImageLoading(int n)
+{
+    return imageLoading[n];
+}
+
+void ImageManager::acquireImage(int n)
+{
+    imageRefCount[n]++;
+    if (imageRefCount[n] == 1 && imageStreamed[n])
+        loadImageAsync(n, imageFile[n]);
+}
+
+void ImageManager::releaseImage(int n)
+{
+    if (imageRefCount[n] <= 0)
+    {
+        std::cout << "[WARNING] Image released too many times: " << imageFile[n] << std::endl;
+        return;
+    }
+
+    imageRefCount[n]--;
+    if (imageRefCount[n] == 0 && imageStreamed[n])
+    {
+        imageGeneration[n]++;
+        imageLoading[n] = false;
+        // OpenGL: unloaded by update(), in the main thread
+        unloads.push_back(n);
+    }
 }
 
 sf::Texture* ImageManager::getImage(int n)
 {
     return imageArray[n];
 }
+
+int ImageManager::getVideoMemory()
+{
+    int size = 0;
+    for (unsigned int i = 0; i < imageArray.size(); i++)
+        size += 4 * imageArray[i]->getSize().x * imageArray[i]->getSize().y;
+    return size;
+}
+
+ImageHandle::ImageHandle()
+{
+    n = -1;
+}
+
+ImageHandle::ImageHandle(int n)
+{
+    this->n = n;
+    if (n >= 0) ImageManager::getInstance().acquireImage(n);
+}
+
+ImageHandle::ImageHandle(const ImageHandle& handle)
+{
+    n = handle.n;
+    if (n >= 0) ImageManager::getInstance().acquireImage(n);
+}
+
+ImageHandle& ImageHandle::operator=(const ImageHandle& handle)
+{
+    if (handle.n >= 0) ImageManager::getInstance().acquireImage(handle.n);
+    if (n >= 0) ImageManager::getInstance().releaseImage(n);
+    n = handle.n;
+    return *this;
+}
+
+ImageHandle::~ImageHandle()
+{
+    if (n >= 0) ImageManager::getInstance().releaseImage(n);
+}
+
+sf::Texture* ImageHandle::getImage() const
+{
+    return n >= 0 ? ImageManager::getInstance().getImage(n) : NULL;
+}
+
+int ImageHandle::getId() const
+{
+    return n;
+}
@@ -18,20 +18,116 @@
 #define IMAGEMANAGER_H_INCLUDED
 
 #include <SFML/Graphics.hpp>
+#include "ImageCache.h"
+#include <string>
+#include <vector>
+#include <deque>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 
 class ImageManager
 {
 public:
     static ImageManager& getInstance();
     void addImage(const char *fileName);
-    bool reloadImage(int n, const char* fileName);
+
+    /** Adds several images: the files are decoded in parallel (or read from the cache of
+      * decoded images), then sent to the video memory in their order. The images flagged
+      * in streamed are registered only (see addStreamedImage). */
+    void addImages(const std::vector<std::string>& fileNames, const std::vector<bool>& streamed = std::vector<bool>());
+
+    /** Sets the directory of the decoded images cache, created if needed (empty: no cache),
+      * and removes its stale entries (see ImageCache). */
+    void setCacheDirectory(const std::string& directory);
+
+    /** Loads a file in an existing texture (from the asset archive, or from the disk). */
+    bool loadImage(int n, const std::string& fileName);
+
+    /** Loads a file in an existing texture without blocking: the file is decoded by the loader
+      * thread, then sent to the texture through a pixel buffer by update(). The texture keeps
+      * its old content until then. The callback is called when the upload is finished. */
+    void loadImageAsync(int n, const std::string& fileName, std::function<void(int)> callback = nullptr);
+
+    /** True from loadImageAsync() until the end of the upload: the texture still has its old content. */
+    bool isImageLoading(int n);
+
+    /** Registers an image loaded on demand: its texture stays empty until it is acquired. */
+    void addStreamedImage(const char *fileName);
+
+    /** Takes a reference on an image. The first one loads a streamed image (in the background). */
+    void acquireImage(int n);
+
+    /** Releases a reference. The last one unloads a streamed image (its video memory is freed,
+      * the texture pointer stays valid) by the next update(). */
+    void releaseImage(int n);
+
+    /** Uploads the decoded images and calls the callbacks of the finished uploads (once per frame). */
+    void update();
+
     sf::Texture* getImage(int n);
 
+    /** Size of the loaded textures (bytes). */
+    int getVideoMemory();
+
 private:
     ImageManager();
     ~ImageManager();
 
+    struct loadJobStruct
+    {
+        int n;
+        int generation;
+        std::string fileName;
+        std::function<void(int)> callback;
+    };
+    struct decodedImageStruct
+    {
+        loadJobStruct job;
+        sf::Image image;
+        bool ok;
+    };
+    void loaderThreadLoop();
+    void registerImage(sf::Texture* texture, const std::string& fileName, bool streamed);
+    bool loadTexture(sf::Texture* texture, const std::string& fileName);
+    bool decodeImage(sf::Image& image, const std::string& fileName, bool& fromCache);
+
     std::vector<sf::Texture*> imageArray;
+    std::vector<std::string> imageFile;
+    std::vector<bool> imageStreamed;
+    std::vector<int> imageRefCount;
+    std::vector<int> imageGeneration;     // incremented by each load or unload: older jobs are dropped
+    std::vector<bool> imageLoading;
+    ImageCache cache;
+
+    // loader thread
+    std::deque<loadJobStruct> loadQueue;
+    std::vector<decodedImageStruct> decodedImages;
+    std::vector<loadJobStruct> uploads;   // uploading (main thread): pixel buffers released when done
+    std::vector<int> unloads;             // released streamed images, unloaded by update()
+    std::mutex loadMutex;
+    std::condition_variable loadCondition;
+    std::thread loaderThread;
+    bool stopping;
+};
+
+/** A reference on an image of the ImageManager: acquired by the constructor, released by
+  * the destructor, so a streamed image is loaded while something uses it. */
+class ImageHandle
+{
+public:
+    ImageHandle();
+    explicit ImageHandle(int n);
+    ImageHandle(const ImageHandle& handle);
+    ImageHandle& operator=(const ImageHandle& handle);
+    ~ImageHandle();
+
+    sf::Texture* getImage() const;
+    int getId() const;
+
+private:
+    int n;
 };
 
 #endif // IMAGEMANAGER_H_INCLUDED
@@ -0,0 +1,263 @@
+/**  This file is part of Witch Blast.
+  *
+  *  Witch Blast is free software: you can redistribute it and/or modify
+  *  it under the terms of the GNU General Public License as published by
+  *  the Free Software Foundation, either version 3 of the License, or
+  *  (at your option) any later version.
+  *
+  *  Witch Blast is distributed in the hope that it will be useful,
+  *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  *  GNU General Public License for more details.
+  *
+  *  You should have received a copy of the GNU General Public License
+  *  along with Witch Blast.  If not, see <http://www.gnu.org/licenses/>.
+  */
+
+#include "InputManager.h"
+#include <iostream>
+
+InputSnapshot::InputSnapshot()
+{
+    clear();
+}
+
+void InputSnapshot::clear()
+{
+    keys.reset();
+    joystickConnected.reset();
+    for (int j = 0; j < INPUT_JOYSTICKS; j++)
+    {
+        buttons[j].reset();
+        for (int i = 0; i < sf::Joystick::AxisCount; i++) axes[j][i] = 0;
+    }
+    touchDown.reset();
+    for (int i = 0; i < INPUT_FINGERS; i++) touchPosition[i] = sf::Vector2i(0, 0);
+}
+
+bool InputSnapshot::write(std::ostream& stream) const
+{
+    char data[INPUT_SNAPSHOT_SIZE] = { 0 };
+    int n = 0;
+
+    for (int i = 0; i < sf::Keyboard::KeyCount; i++)
+        if (keys[i]) data[i / 8] |= 1 << (i % 8);
+    n += (sf::Keyboard::KeyCount + 7) / 8;
+
+    for (int j = 0; j < INPUT_JOYSTICKS; j++)
+    {
+        data[n++] = joystickConnected[j];
+        for (int i = 0; i < sf::Joystick::ButtonCount; i++)
+            if (buttons[j][i]) data[n + i / 8] |= 1 << (i % 8);
+        n += sf::Joystick::ButtonCount / 8;
+        for (int i = 0; i < sf::Joystick::AxisCount; i++) data[n++] = axes[j][i];
+    }
+
+    data[n++] = (char)touchDown.to_ulong();
+    for (int i = 0; i < INPUT_FINGERS; i++)
+    {
+        data[n++] = touchPosition[i].x & 0xFF;
+        data[n++] = (touchPosition[i].x >> 8) & 0xFF;
+        data[n++] = touchPosition[i].y & 0xFF;
+        data[n++] = (touchPosition[i].y >> 8) & 0xFF;
+    }
+
+    stream.write(data, INPUT_SNAPSHOT_SIZE);
+    return (bool)stream;
+}
+
+bool InputSnapshot::read(std::istream& stream)
+{
+    unsigned char data[INPUT_SNAPSHOT_SIZE];
+    if (!stream.read((char*)data, INPUT_SNAPSHOT_SIZE)) return false;
+    int n = 0;
+
+    for (int i = 0; i < sf::Keyboard::KeyCount; i++)
+        keys[i] = (data[i / 8] >> (i % 8)) & 1;
+    n += (sf::Keyboard::KeyCount + 7) / 8;
+
+    for (int j = 0; j < INPUT_JOYSTICKS; j++)
+    {
+        joystickConnected[j] = data[n++] != 0;
+        for (int i = 0; i < sf::Joystick::ButtonCount; i++)
+            buttons[j][i] = (data[n + i / 8] >> (i % 8)) & 1;
+        n += sf::Joystick::ButtonCount / 8;
+        for (int i = 0; i < sf::Joystick::AxisCount; i++) axes[j][i] = (signed char)data[n++];
+    }
+
+    touchDown = std::bitset<INPUT_FINGERS>(data[n++]);
+    for (int i = 0; i < INPUT_FINGERS; i++)
+    {
+        touchPosition[i].x = (short)(data[n] | (data[n + 1] << 8));
+        touchPosition[i].y = (short)(data[n + 2] | (data[n + 3] << 8));
+        n += 4;
+    }
+    return true;
+}
+
+InputManager::InputManager()
+{
+    deadZone = INPUT_DEAD_ZONE;
+}
+
+InputManager::~InputManager()
+{
+    stop();
+}
+
+InputManager& InputManager::getInstance()
+{
+    static InputManager singleton;
+    return singleton;
+}
+
+void InputManager::watchKey(sf::Keyboard::Key key)
+{
+    if (key >= 0 && key < sf::Keyboard::KeyCount) watchedKeys[key] = true;
+}
+
+void InputManager::update()
+{
+    previous = current;
+
+    if (replayFile.is_open())
+    {
+        if (current.read(replayFile)) return;
+        // end of the replay: back to the devices
+        replayFile.close();
+    }
+
+    sample();
+    if (recordFile.is_open() && !current.write(recordFile))
+    {
+        std::cout << "[ERROR] Recording the inputs" << std::endl;
+        recordFile.close();
+    }
+}
+
+void InputManager::sample()
+{
+    current.clear();
+
+    // each keyboard poll can be a request to the system: only the keys used by the game
+    for (int i = 0; i < sf::Keyboard::KeyCount; i++)
+        if (watchedKeys[i] && sf::Keyboard::isKeyPressed((sf::Keyboard::Key)i))
+            current.keys[i] = true;
+
+    for (int j = 0; j < INPUT_JOYSTICKS; j++)
+    {
+        if (!sf::Joystick::isConnected(j)) continue;
+        current.joystickConnected[j] = true;
+
+        int nbButtons = sf::Joystick::getButtonCount(j);
+        for (int i = 0; i < nbButtons; i++)
+            current.buttons[j][i] = sf::Joystick::isButtonPressed(j, i);
+
+        for (int i = 0; i < sf::Joystick::AxisCount; i++)
+            if (sf::Joystick::hasAxis(j, (sf::Joystick::Axis)i))
+                current.axes[j][i] = (signed char)sf::Joystick::getAxisPosition(j, (sf::Joystick::Axis)i);
+    }
+
+    for (int i = 0; i < INPUT_FINGERS; i++)
+    {
+        if (sf::Touch::isDown(i))
+        {
+            current.touchDown[i] = true;
+            current.touchPosition[i] = sf::Touch::getPosition(i);
+        }
+    }
+}
+
+const InputSnapshot& InputManager::getSnapshot()
+{
+    return current;
+}
+
+bool InputManager::isKeyDown(sf::Keyboard::Key key)
+{
+    return key >= 0 && key < sf::Keyboard::KeyCount && current.keys[key];
+}
+
+bool InputManager::isKeyPressed(sf::Keyboard::Key key)
+{
+    return isKeyDown(key) && !previous.keys[key];
+}
+
+bool InputManager::isKeyReleased(sf::Keyboard::Key key)
+{
+    return key >= 0 && key < sf::Keyboard::KeyCount && !current.keys[key] && previous.keys[key];
+}
+
+bool InputManager::isJoystickConnected(int joystick)
+{
+    return joystick >= 0 && joystick < INPUT_JOYSTICKS && current.joystickConnected[joystick];
+}
+
+bool InputManager::isButtonDown(int joystick, int button)
+{
+    return isJoystickConnected(joystick) && button >= 0 && button < sf::Joystick::ButtonCount
+           && current.buttons[joystick][button];
+}
+
+bool InputManager::isButtonPressed(int joystick, int button)
+{
+    return isButtonDown(joystick, button) && !previous.buttons[joystick][button];
+}
+
+bool InputManager::isButtonReleased(int joystick, int button)
+{
+    return joystick >= 0 && joystick < INPUT_JOYSTICKS && button >= 0 && button < sf::Joystick::ButtonCount
+           && !current.buttons[joystick][button] && previous.buttons[joystick][button];
+}
+
+bool InputManager::isAxisDown(int joystick, sf::Joystick::Axis axis, int direction)
+{
+    if (!isJoystickConnected(joystick) || axis < 0 || (int)axis >= (int)sf::Joystick::AxisCount) return false;
+    int position = current.axes[joystick][axis];
+    if (direction < 0) return position < -deadZone;
+    else if (direction > 0) return position > deadZone;
+    return false;
+}
+
+void InputManager::setDeadZone(int deadZone)
+{
+    this->deadZone = deadZone;
+}
+
+bool InputManager::isTouchDown(int finger)
+{
+    return finger >= 0 && finger < INPUT_FINGERS && current.touchDown[finger];
+}
+
+sf::Vector2i InputManager::getTouchPosition(int finger)
+{
+    if (finger < 0 || finger >= INPUT_FINGERS) return sf::Vector2i(0, 0);
+    return current.touchPosition[finger];
+}
+
+bool InputManager::startRecording(const std::string& fileName)
+{
+    stop();
+    recordFile.open(fileName.c_str(), std::ios::out | std::ios::trunc | std::ios::binary);
+    if (!recordFile.is_open()) std::cout << "[ERROR] Opening input record: " << fileName << std::endl;
+    return recordFile.is_open();
+}
+
+bool InputManager::startReplay(const std::string& fileName)
+{
+    stop();
+    replayFile.open(fileName.c_str(), std::ios::in | std::ios::binary);
+    if (!replayFile.is_open()) std::cout << "[ERROR] Opening input record: " << fileName << std::endl;
+    return replayFile.is_open();
+}
+
+void InputManager::stop()
+{
+    if (recordFile.is_open()) recordFile.close();
+    if (replayFile.is_open()) replayFile.close();
+}
+
+bool InputManager::isReplaying()
+{
+    return replayFile.is_open();
+}
@@ -0,0 +1,111 @@
+/**  This file is part of Witch Blast.
+  *
+  *  Witch Blast is free software: you can redistribute it and/or modify
+  *  it under the terms of the GNU General Public License as published by
+  *  the Free Software Foundation, either version 3 of the License, or
+  *  (at your option) any later version.
+  *
+  *  Witch Blast is distributed in the hope that it will be useful,
+  *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  *  GNU General Public License for more details.
+  *
+  *  You should have received a copy of the GNU General Public License
+  *  along with Witch Blast.  If not, see <http://www.gnu.org/licenses/>.
+  */
+
+#ifndef INPUTMANAGER_H_INCLUDED
+#define INPUTMANAGER_H_INCLUDED
+
+#include <SFML/Window.hpp>
+#include <bitset>
+#include <fstream>
+#include <string>
+
+const int INPUT_JOYSTICKS = 2;        // joysticks sampled (the first ones)
+const int INPUT_FINGERS = 6;          // touch fingers sampled
+const int INPUT_DEAD_ZONE = 40;       // axis position (0 to 100) under which an axis is released (default)
+
+/** The state of the input devices at a given frame.
+  * Serialized in INPUT_SNAPSHOT_SIZE bytes (little endian):
+  *  keyboard:  one bit per key
+  *  joysticks: connected, buttons (one bit each), axes (-100 to 100, one byte each)
+  *  touch:     one bit per finger, positions (two 16 bits integers each) */
+class InputSnapshot
+{
+public:
+    InputSnapshot();
+    void clear();
+
+    bool write(std::ostream& stream) const;
+    bool read(std::istream& stream);
+
+    std::bitset<sf::Keyboard::KeyCount> keys;
+    std::bitset<INPUT_JOYSTICKS> joystickConnected;
+    std::bitset<sf::Joystick::ButtonCount> buttons[INPUT_JOYSTICKS];
+    signed char axes[INPUT_JOYSTICKS][sf::Joystick::AxisCount];
+    std::bitset<INPUT_FINGERS> touchDown;
+    sf::Vector2i touchPosition[INPUT_FINGERS];
+};
+
+const int INPUT_SNAPSHOT_SIZE = (sf::Keyboard::KeyCount + 7) / 8
+                                + INPUT_JOYSTICKS * (1 + sf::Joystick::ButtonCount / 8 + sf::Joystick::AxisCount)
+                                + 1 + INPUT_FINGERS * 4;
+
+/** Samples the input devices once per frame.
+  * The game reads the snapshot instead of polling the devices for each key and each player.
+  * The previous snapshot is kept: "pressed" and "released" are true only at the frame
+  * the key (or button) changes, "down" while it is held.
+  * The snapshots can be recorded to a file, and replayed in place of the devices. */
+class InputManager
+{
+public:
+    static InputManager& getInstance();
+
+    /** Adds a key to the sampled ones (the other keys are never down). */
+    void watchKey(sf::Keyboard::Key key);
+
+    /** Starts a new frame: samples the devices (or reads the replayed snapshot). */
+    void update();
+
+    const InputSnapshot& getSnapshot();
+
+    bool isKeyDown(sf::Keyboard::Key key);
+    bool isKeyPressed(sf::Keyboard::Key key);
+    bool isKeyReleased(sf::Keyboard::Key key);
+
+    bool isJoystickConnected(int joystick);
+    bool isButtonDown(int joystick, int button);
+    bool isButtonPressed(int joystick, int button);
+    bool isButtonReleased(int joystick, int button);
+
+    /** Axis pushed beyond the dead zone, in the direction (-1 or 1). */
+    bool isAxisDown(int joystick, sf::Joystick::Axis axis, int direction);
+    void setDeadZone(int deadZone);
+
+    bool isTouchDown(int finger);
+    sf::Vector2i getTouchPosition(int finger);
+
+    /** Writes each following snapshot to a file. */
+    bool startRecording(const std::string& fileName);
+    /** Reads the snapshots from a file instead of the devices, until its end. */
+    bool startReplay(const std::string& fileName);
+    void stop();
+    bool isReplaying();
+
+private:
+    InputManager();
+    ~InputManager();
+
+    void sample();
+
+    InputSnapshot current;
+    InputSnapshot previous;
+    std::bitset<sf::Keyboard::KeyCount> watchedKeys;
+    int deadZone;
+
+    std::ofstream recordFile;
+    std::ifstream replayFile;
+};
+
+#endif // INPUTMANAGER_H_INCLUDED
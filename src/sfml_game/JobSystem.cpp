@@ -0,0 +1,159 @@
+/**  This file is part of Witch Blast.
+  *
+  *  Witch Blast is free software: you can redistribute it and/or modify
+  *  it under the terms of the GNU General Public License as published by
+  *  the Free Software Foundation, either version 3 of the License, or
+  *  (at your option) any later version.
+  *
+  *  Witch Blast is distributed in the hope that it will be useful,
+  *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  *  GNU General Public License for more details.
+  *
+  *  You should have received a copy of the GNU General Public License
+  *  along with Witch Blast.  If not, see <http://www.gnu.org/licenses/>.
+  */
+
+#include "JobSystem.h"
+
+JobSystem::JobSystem()
+{
+    queuedChunks = 0;
+    pendingChunks = 0;
+    stopping = false;
+    queues.push_back(std::unique_ptr<workerQueueStruct>(new workerQueueStruct));
+}
+
+JobSystem::~JobSystem()
+{
+    stop();
+}
+
+JobSystem& JobSystem::getInstance()
+{
+    static JobSystem singleton;
+    return singleton;
+}
+
+void JobSystem::start(int threadCount)
+{
+    stop();
+    if (threadCount <= 0) threadCount = std::thread::hardware_concurrency();
+    if (threadCount <= 0) threadCount = 1;
+
+    stopping = false;
+    queues.clear();
+    for (int i = 0; i < threadCount; i++)
+        queues.push_back(std::unique_ptr<workerQueueStruct>(new workerQueueStruct));
+    for (int i = 1; i < threadCount; i++)
+        threads.push_back(std::thread(&JobSystem::workerThreadLoop, this, i));
+}
+
+void JobSystem::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopping = true;
+    }
+    wakeCondition.notify_all();
+    for (unsigned int i = 0; i < threads.size(); i++) threads[i].join();
+    threads.clear();
+
+    queues.resize(1);
+}
+
+int JobSystem::getThreadCount()
+{
+    return queues.size();
+}
+
+void JobSystem::parallelFor(int count, int grain, const RangeJob& job)
+{
+    if (count <= 0) return;
+    if (grain < 1) grain = 1;
+    if (threads.empty() || count <= grain)
+    {
+        job(0, count, 0);
+        return;
+    }
+
+    // a few chunks per thread, so the stealing can even out the load
+    int nbChunks = (count + grain - 1) / grain;
+    int maxChunks = 4 * queues.size();
+    if (nbChunks > maxChunks) nbChunks = maxChunks;
+
+    pendingChunks += nbChunks;
+    for (int i = 0; i < nbChunks; i++)
+    {
+        chunkStruct chunk;
+        chunk.job = &job;
+        chunk.begin = (long long)count * i / nbChunks;
+        chunk.end = (long long)count * (i + 1) / nbChunks;
+
+        workerQueueStruct& queue = *queues[i % queues.size()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.chunks.push_back(chunk);
+    }
+    queuedChunks += nbChunks;
+    {
+        // the sleeping workers check queuedChunks with this lock held: none misses the wake up
+        std::lock_guard<std::mutex> lock(sleepMutex);
+    }
+    wakeCondition.notify_all();
+
+    chunkStruct chunk;
+    while (takeChunk(0, chunk))
+    {
+        (*chunk.job)(chunk.begin, chunk.end, 0);
+        pendingChunks--;
+    }
+
+    // the last chunks are running in the workers
+    while (pendingChunks > 0) std::this_thread::yield();
+}
+
+bool JobSystem::takeChunk(int worker, chunkStruct& chunk)
+{
+    if (queuedChunks <= 0) return false;
+
+    // own queue first (the last chunk pushed), then the oldest chunk of the others
+    int nbQueues = queues.size();
+    for (int i = 0; i < nbQueues; i++)
+    {
+        workerQueueStruct& queue = *queues[(worker + i) % nbQueues];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.chunks.empty()) continue;
+
+        if (i == 0)
+        {
+            chunk = queue.chunks.back();
+            queue.chunks.pop_back();
+        }
+        else
+        {
+            chunk = queue.chunks.front();
+            queue.chunks.pop_front();
+        }
+        queuedChunks--;
+        return true;
+    }
+    return false;
+}
+
+void JobSystem::workerThreadLoop(int worker)
+{
+    while (true)
+    {
+        chunkStruct chunk;
+        if (takeChunk(worker, chunk))
+        {
+            (*chunk.job)(chunk.begin, chunk.end, worker);
+            pendingChunks--;
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        wakeCondition.wait(lock, [this] { return stopping || queuedChunks > 0; });
+        if (stopping) return;
+    }
+}
@@ -0,0 +1,83 @@
+/**  This file is part of Witch Blast.
+  *
+  *  Witch Blast is free software: you can redistribute it and/or modify
+  *  it under the terms of the GNU General Public License as published by
+  *  the Free Software Foundation, either version 3 of the License, or
+  *  (at your option) any later version.
+  *
+  *  Witch Blast is distributed in the hope that it will be useful,
+  *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  *  GNU General Public License for more details.
+  *
+  *  You should have received a copy of the GNU General Public License
+  *  along with Witch Blast.  If not, see <http://www.gnu.org/licenses/>.
+  */
+
+#ifndef JOBSYSTEM_H_INCLUDED
+#define JOBSYSTEM_H_INCLUDED
+
+#include <vector>
+#include <deque>
+#include <memory>
+#include <functional>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+/** Splits loops over independent elements between worker threads.
+  * parallelFor cuts the range in chunks, spread over one queue per thread. Each thread takes
+  * the chunks of its own queue, then steals the chunks of the other queues: a thread slowed
+  * down by its chunks does not keep the others waiting.
+  * The calling thread works too (it is the worker 0), and returns when every chunk is done.
+  * The jobs must not call parallelFor, nor use the OpenGL context. */
+class JobSystem
+{
+public:
+    /** A chunk of the range: elements begin to end - 1, run by the worker (0 to getThreadCount() - 1). */
+    typedef std::function<void(int begin, int end, int worker)> RangeJob;
+
+    static JobSystem& getInstance();
+
+    /** Starts the worker threads (0: one thread per core). threadCount includes the calling
+      * thread, so 1 runs every job in place. */
+    void start(int threadCount = 0);
+    void stop();
+
+    /** Number of workers, the calling thread included (the per-worker buffers of the jobs). */
+    int getThreadCount();
+
+    /** Runs the job on the range 0 to count - 1, in chunks of about grain elements.
+      * A range smaller than a chunk is run in place, without any synchronisation. */
+    void parallelFor(int count, int grain, const RangeJob& job);
+
+private:
+    JobSystem();
+    ~JobSystem();
+
+    struct chunkStruct
+    {
+        const RangeJob* job;
+        int begin;
+        int end;
+    };
+    struct workerQueueStruct
+    {
+        std::mutex mutex;
+        std::deque<chunkStruct> chunks;
+    };
+
+    void workerThreadLoop(int worker);
+    bool takeChunk(int worker, chunkStruct& chunk);
+
+    std::vector<std::thread> threads;
+    std::vector<std::unique_ptr<workerQueueStruct> > queues;   // queue 0: calling thread
+    std::atomic<int> queuedChunks;    // waiting in the queues
+    std::atomic<int> pendingChunks;   // not finished yet
+    std::mutex sleepMutex;
+    std::condition_variable wakeCondition;
+    bool stopping;
+};
+
+#endif // JOBSYSTEM_H_INCLUDED
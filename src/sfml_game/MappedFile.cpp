@@ -0,0 +1,118 @@
+/**  This file is part of sfmlGame.
+  *
+  *  FreeTumble is free software: you can redistribute it and/or modify
+  *  it under the terms of the GNU General Public License as published by
+  *  the Free Software Foundation, either version 3 of the License, or
+  *  (at your option) any later version.
+  *
+  *  FreeTumble is distributed in the hope that it will be useful,
+  *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  *  GNU General Public License for more details.
+  *
+  *  You should have received a copy of the GNU General Public License
+  *  along with FreeTumble.  If not, see <http://www.gnu.org/licenses/>.
+  */
+
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile()
+{
+    data = NULL;
+    size = 0;
+    fileHandle = NULL;
+    mappingHandle = NULL;
+}
+
+MappedFile::~MappedFile()
+{
+    close();
+}
+
+bool MappedFile::open(const std::string& fileName)
+{
+    close();
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) return false;
+    fileHandle = file;
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0)
+    {
+        close();
+        return false;
+    }
+    size = (std::size_t)fileSize.QuadPart;
+
+    mappingHandle = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (mappingHandle) data = (const char*)MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0);
+#else
+    int file = ::open(fileName.c_str(), O_RDONLY);
+    if (file < 0) return false;
+
+    struct stat fileStat;
+    if (fstat(file, &fileStat) == 0 && fileStat.st_size > 0)
+    {
+        size = (std::size_t)fileStat.st_size;
+        void* mapping = mmap(NULL, size, PROT_READ, MAP_PRIVATE, file, 0);
+        if (mapping != MAP_FAILED) data = (const char*)mapping;
+    }
+    // the mapping stays valid when the file is closed
+    ::close(file);
+#endif
+
+    if (!data)
+    {
+        close();
+        return false;
+    }
+    return true;
+}
+
+void MappedFile::close()
+{
+#ifdef _WIN32
+    if (data) UnmapViewOfFile(data);
+    if (mappingHandle) CloseHandle(mappingHandle);
+    if (fileHandle) CloseHandle(fileHandle);
+#else
+    if (data) munmap((void*)data, size);
+#endif
+    data = NULL;
+    size = 0;
+    fileHandle = NULL;
+    mappingHandle = NULL;
+}
+
+bool MappedFile::isOpen() const
+{
+    return data != NULL;
+}
+
+const char* MappedFile::getData() const
+{
+    return data;
+}
+
+std::size_t MappedFile::getSize() const
+{
+    return size;
+}
@@ -0,0 +1,49 @@
+/**  This file is part of sfmlGame.
+  *
+  *  FreeTumble is free software: you can redistribute it and/or modify
+  *  it under the terms of the GNU General Public License as published by
+  *  the Free Software Foundation, either version 3 of the License, or
+  *  (at your option) any later version.
+  *
+  *  FreeTumble is distributed in the hope that it will be useful,
+  *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  *  GNU General Public License for more details.
+  *
+  *  You should have received a copy of the GNU General Public License
+  *  along with FreeTumble.  If not, see <http://www.gnu.org/licenses/>.
+  */
+
+#ifndef MAPPEDFILE_H_INCLUDED
+#define MAPPEDFILE_H_INCLUDED
+
+#include <string>
+#include <cstddef>
+
+/** A file mapped in memory (read only).
+  * The data stays valid until the file is closed (or the object destroyed). */
+class MappedFile
+{
+public:
+    MappedFile();
+    ~MappedFile();
+
+    /** Maps a file. Returns false if it is missing or empty. */
+    bool open(const std::string& fileName);
+    void close();
+
+    bool isOpen() const;
+    const char* getData() const;
+    std::size_t getSize() const;
+
+private:
+    MappedFile(const MappedFile&);
+    MappedFile& operator=(const MappedFile&);
+
+    const char* data;
+    std::size_t size;
+    void* fileHandle;
+    void* mappingHandle;
+};
+
+#endif // MAPPEDFILE_H_INCLUDED
@@ -0,0 +1,333 @@
+/**  This file is part of Witch Blast.
+  *
+  *  Witch Blast is free software: you can redistribute it and/or modify
+  *  it under the terms of the GNU General Public License as published by
+  *  the Free Software Foundation, either version 3 of the License, or
+  *  (at your option) any later version.
+  *
+  *  Witch Blast is distributed in the hope that it will be useful,
+  *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  *  GNU General Public License for more details.
+  *
+  *  You should have received a copy of the GNU General Public License
+  *  along with Witch Blast.  If not, see <http://www.gnu.org/licenses/>.
+  */
+
+#include "MusicPlayer.h"
+#include "AssetArchive.h"
+#include <iostream>
+#include <sstream>
+
+///////////////// STREAM /////////////////
+
+MusicStream::MusicStream()
+{
+  bufferDuration = MUSIC_BUFFER_DURATION;
+  queuedEnd = 0.0f;
+  pauseStart = 0.0f;
+  resetClock = true;
+  underruns = 0;
+}
+
+MusicStream::~MusicStream()
+{
+  // the streaming thread uses the file
+  stop();
+}
+
+bool MusicStream::openFromFile(const std::string& fileName)
+{
+  stop();
+
+  std::lock_guard<std::mutex> lock(fileMutex);
+  const void* data;
+  std::size_t size;
+  if (AssetArchive::getInstance().find(fileName, data, size))
+  {
+    // streamed from the mapped archive
+    if (!file.openFromMemory(data, size)) return false;
+  }
+  else if (!file.openFromFile(fileName)) return false;
+
+  samples.resize(file.getSampleRate() * file.getChannelCount() * bufferDuration / 1000);
+  initialize(file.getChannelCount(), file.getSampleRate());
+  resetClock = true;
+  underruns = 0;
+  return true;
+}
+
+void MusicStream::setBufferDuration(int milliseconds)
+{
+  if (milliseconds < 50) milliseconds = 50;
+  bufferDuration = milliseconds;
+}
+
+void MusicStream::pauseStream()
+{
+  pause();
+  std::lock_guard<std::mutex> lock(fileMutex);
+  pauseStart = clock.getElapsedTime().asSeconds();
+}
+
+void MusicStream::resumeStream()
+{
+  {
+    std::lock_guard<std::mutex> lock(fileMutex);
+    queuedEnd += clock.getElapsedTime().asSeconds() - pauseStart;
+  }
+  play();
+}
+
+int MusicStream::getUnderruns()
+{
+  return underruns;
+}
+
+bool MusicStream::onGetData(Chunk& data)
+{
+  std::lock_guard<std::mutex> lock(fileMutex);
+
+  // the queued audio is played from the first buffer: a buffer requested after
+  // the end of the queued audio means the stream has been starved
+  float now = clock.getElapsedTime().asSeconds();
+  if (resetClock)
+  {
+    queuedEnd = now;
+    resetClock = false;
+  }
+  else if (now > queuedEnd)
+  {
+    underruns++;
+    queuedEnd = now;
+  }
+
+  data.samples = samples.data();
+  data.sampleCount = static_cast<std::size_t>(file.read(samples.data(), samples.size()));
+  if (getSampleRate() > 0 && getChannelCount() > 0)
+    queuedEnd += (float)data.sampleCount / (getSampleRate() * getChannelCount());
+
+  // a partial buffer is the end of the file
+  return data.sampleCount == samples.size();
+}
+
+void MusicStream::onSeek(sf::Time timeOffset)
+{
+  std::lock_guard<std::mutex> lock(fileMutex);
+  file.seek(timeOffset);
+}
+
+///////////////// PLAYER /////////////////
+
+MusicPlayer::MusicPlayer()
+{
+  current = -1;
+  fadingOut = -1;
+  opening = -1;
+  openDiscarded = false;
+  hasQueuedMusic = false;
+  queuedFadeDuration = 0.0f;
+  bufferDuration = MUSIC_BUFFER_DURATION;
+  openRequest = -1;
+  openBufferDuration = MUSIC_BUFFER_DURATION;
+  stopping = false;
+  openDone = false;
+  openOk = false;
+  fadeDuration = 0.0f;
+  fadeTimer = 0.0f;
+  volume = 100.0f;
+  underruns = 0;
+  streams[0].setLoop(true);
+  streams[1].setLoop(true);
+}
+
+MusicPlayer::~MusicPlayer()
+{
+  if (openThread.joinable())
+  {
+    {
+      std::lock_guard<std::mutex> lock(openMutex);
+      stopping = true;
+    }
+    openCondition.notify_one();
+    openThread.join();
+  }
+}
+
+void MusicPlayer::openThreadLoop()
+{
+  while (true)
+  {
+    int stream;
+    std::string fileName;
+    int duration;
+    {
+      std::unique_lock<std::mutex> lock(openMutex);
+      openCondition.wait(lock, [this] { return stopping || openRequest >= 0; });
+      if (stopping) return;
+      stream = openRequest;
+      fileName = openFileName;
+      duration = openBufferDuration;
+      openRequest = -1;
+    }
+
+    streams[stream].setBufferDuration(duration);
+    bool ok = streams[stream].openFromFile(fileName);
+    if (!ok) std::cout << "[ERROR] Opening music: " << fileName << std::endl;
+    openOk = ok;
+    openDone = true;
+  }
+}
+
+void MusicPlayer::startOpen(const std::string& fileName, float fadeDuration)
+{
+  // the stream used for the new music: not the current one
+  opening = (current == 0) ? 1 : 0;
+  if (opening == fadingOut)
+  {
+    streams[fadingOut].stop();
+    fadingOut = -1;
+  }
+  streams[opening].stop();
+  underruns += streams[opening].getUnderruns();
+
+  this->fadeDuration = fadeDuration;
+  openDiscarded = false;
+  openDone = false;
+  {
+    std::lock_guard<std::mutex> lock(openMutex);
+    openRequest = opening;
+    openFileName = fileName;
+    openBufferDuration = bufferDuration;
+  }
+  if (!openThread.joinable())
+    openThread = std::thread(&MusicPlayer::openThreadLoop, this);
+  openCondition.notify_one();
+}
+
+void MusicPlayer::play(const std::string& fileName, float fadeDuration)
+{
+  if (opening >= 0)
+  {
+    // the last request wins: opened when the pending open is done
+    openDiscarded = true;
+    hasQueuedMusic = true;
+    queuedFileName = fileName;
+    queuedFadeDuration = fadeDuration;
+  }
+  else
+    startOpen(fileName, fadeDuration);
+}
+
+void MusicPlayer::stop()
+{
+  if (opening >= 0) openDiscarded = true;
+  hasQueuedMusic = false;
+  fadingOut = -1;
+
+  // the stream being opened is stopped (and owned by the open thread)
+  for (int i = 0; i < 2; i++)
+    if (i != opening) streams[i].stop();
+}
+
+void MusicPlayer::pause()
+{
+  if (current >= 0 && streams[current].getStatus() == sf::SoundStream::Playing)
+    streams[current].pauseStream();
+  if (fadingOut >= 0)
+  {
+    streams[fadingOut].stop();
+    fadingOut = -1;
+  }
+}
+
+void MusicPlayer::resume()
+{
+  if (current >= 0 && streams[current].getStatus() == sf::SoundStream::Paused)
+    streams[current].resumeStream();
+}
+
+void MusicPlayer::update(float delay)
+{
+  if (opening >= 0 && openDone)
+  {
+    if (openOk && !openDiscarded)
+    {
+      if (current >= 0 && fadeDuration > 0.0f && streams[current].getStatus() == sf::SoundStream::Playing)
+      {
+        fadingOut = current;
+        fadeTimer = 0.0f;
+      }
+      else
+      {
+        if (current >= 0) streams[current].stop();
+        fadingOut = -1;
+      }
+      current = opening;
+      updateVolumes();
+      streams[current].play();
+    }
+    opening = -1;
+
+    if (hasQueuedMusic)
+    {
+      hasQueuedMusic = false;
+      startOpen(queuedFileName, queuedFadeDuration);
+    }
+  }
+
+  if (fadingOut >= 0)
+  {
+    fadeTimer += delay;
+    if (fadeTimer >= fadeDuration)
+    {
+      streams[fadingOut].stop();
+      fadingOut = -1;
+    }
+    updateVolumes();
+  }
+}
+
+void MusicPlayer::updateVolumes()
+{
+  if (fadingOut >= 0)
+  {
+    float fade = fadeTimer / fadeDuration;
+    if (fade > 1.0f) fade = 1.0f;
+    streams[fadingOut].setVolume(volume * (1.0f - fade));
+    if (current >= 0) streams[current].setVolume(volume * fade);
+  }
+  else if (current >= 0)
+    streams[current].setVolume(volume);
+}
+
+void MusicPlayer::setVolume(float volume)
+{
+  this->volume = volume;
+  updateVolumes();
+}
+
+void MusicPlayer::setBufferDuration(int milliseconds)
+{
+  // the streams already opened keep their buffers
+  bufferDuration = milliseconds;
+}
+
+bool MusicPlayer::isPlaying()
+{
+  return (opening >= 0 && !openDiscarded) || hasQueuedMusic
+         || (current >= 0 && streams[current].getStatus() == sf::SoundStream::Playing);
+}
+
+int MusicPlayer::getUnderruns()
+{
+  return underruns + streams[0].getUnderruns() + streams[1].getUnderruns();
+}
+
+std::string MusicPlayer::getReport()
+{
+  std::ostringstream oss;
+  oss << "Music: " << (fadingOut >= 0 ? "crossfading" : (opening >= 0 ? "opening" : "playing"))
+      << ", " << getUnderruns() << " underruns";
+  return oss.str();
+}
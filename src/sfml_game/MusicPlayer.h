@@ -0,0 +1,131 @@
+/**  This file is part of Witch Blast.
+  *
+  *  Witch Blast is free software: you can redistribute it and/or modify
+  *  it under the terms of the GNU General Public License as published by
+  *  the Free Software Foundation, either version 3 of the License, or
+  *  (at your option) any later version.
+  *
+  *  Witch Blast is distributed in the hope that it will be useful,
+  *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  *  GNU General Public License for more details.
+  *
+  *  You should have received a copy of the GNU General Public License
+  *  along with Witch Blast.  If not, see <http://www.gnu.org/licenses/>.
+  */
+
+#ifndef MUSICPLAYER_H_INCLUDED
+#define MUSICPLAYER_H_INCLUDED
+
+#include <SFML/Audio.hpp>
+#include <string>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+
+const int MUSIC_BUFFER_DURATION = 1000;   // audio decoded in each stream buffer (ms, default)
+
+/** A music stream (like sf::Music), with a configurable buffer size and an underrun counter.
+  * The stream decodes in the SFML streaming thread, three buffers ahead. */
+class MusicStream : public sf::SoundStream
+{
+public:
+    MusicStream();
+    ~MusicStream();
+
+    /** Opens the file (can be called from another thread when the stream is stopped). */
+    bool openFromFile(const std::string& fileName);
+
+    /** Duration of each buffer, used by the next openFromFile. */
+    void setBufferDuration(int milliseconds);
+
+    /** Pauses and resumes the stream (the pause is not counted as an underrun). */
+    void pauseStream();
+    void resumeStream();
+
+    /** Number of times the buffers have not been refilled in time (since the last open). */
+    int getUnderruns();
+
+protected:
+    virtual bool onGetData(Chunk& data);
+    virtual void onSeek(sf::Time timeOffset);
+
+private:
+    sf::InputSoundFile file;
+    std::vector<sf::Int16> samples;
+    std::mutex fileMutex;
+    int bufferDuration;
+
+    // underrun detection (streaming thread)
+    sf::Clock clock;
+    float queuedEnd;          // clock time when the queued audio will be played
+    float pauseStart;
+    bool resetClock;
+    std::atomic<int> underruns;
+};
+
+/** Plays the musics: the next one is opened in a background thread, then
+  * crossfaded with the current one (two streams are alive during the fade).
+  * The main thread never waits for an open: a request made during an open is
+  * queued (the last one wins), and the result of an open that is no longer wanted
+  * is discarded when it is done. */
+class MusicPlayer
+{
+public:
+    MusicPlayer();
+    ~MusicPlayer();
+
+    /** Opens the music in the background; it starts in update() when ready.
+      * \param fadeDuration : crossfade duration (seconds, 0 = no fade) */
+    void play(const std::string& fileName, float fadeDuration);
+    void stop();
+    void pause();
+    void resume();
+
+    /** Call every frame: starts the opened music and updates the crossfade. */
+    void update(float delay);
+
+    void setVolume(float volume);
+
+    /** Duration of the stream buffers, used by the next musics. */
+    void setBufferDuration(int milliseconds);
+
+    bool isPlaying();
+    int getUnderruns();
+    std::string getReport();
+
+private:
+    MusicStream streams[2];
+    int current;                // playing stream (-1 = none)
+    int fadingOut;              // stream fading out (-1 = none)
+    int opening;                // stream being opened (-1 = none)
+    bool openDiscarded;         // the stream being opened will not be played
+    bool hasQueuedMusic;        // music to open when the current open is done
+    std::string queuedFileName;
+    float queuedFadeDuration;
+    int bufferDuration;
+
+    // open thread
+    std::thread openThread;
+    std::mutex openMutex;
+    std::condition_variable openCondition;
+    int openRequest;            // stream to open (-1 = none)
+    std::string openFileName;
+    int openBufferDuration;
+    bool stopping;
+    std::atomic<bool> openDone;
+    std::atomic<bool> openOk;
+
+    float fadeDuration;
+    float fadeTimer;
+    float volume;
+    int underruns;              // underruns of the previous musics
+
+    void startOpen(const std::string& fileName, float fadeDuration);
+    void openThreadLoop();
+    void updateVolumes();
+};
+
+#endif // MUSICPLAYER_H_INCLUDED
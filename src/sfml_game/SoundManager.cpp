@@ -15,19 +15,43 @@
   */
 
 #include "SoundManager.h"
+#include "AssetArchive.h"
 #include <iostream>
+#include <sstream>
 
 
 SoundManager::SoundManager()
 {
   mute = false;
   volume = 100;
+  frame = 0;
+  playCounter = 0;
+  memoryBudget = SOUND_MEMORY_BUDGET;
+  residentMemory = 0;
+  residentPending = 0;
+  stopping = false;
+  decodingSound = -1;
+  for (int i = 0; i < SOUND_VOICES; i++)
+  {
+    voiceSound[i] = -1;
+    voiceAge[i] = 0;
+  }
+  resetStats();
 }
 
 SoundManager::~SoundManager()
 {
   std::cout << "Releasing audio memory... ";
-  soundArray.clear();
+  if (loaderThread.joinable())
+  {
+    {
+      std::lock_guard<std::mutex> lock(loadMutex);
+      stopping = true;
+    }
+    loadCondition.notify_one();
+    loaderThread.join();
+  }
+  for (int i = 0; i < SOUND_VOICES; i++) voices[i].stop();
   soundBufferArray.clear();
   std::cout << "OK" << std::endl;
 }
@@ -40,62 +64,293 @@ SoundManager& SoundManager::getInstance()
 
 void SoundManager::addSound(const char* fileName)
 {
-  sf::SoundBuffer* newSoundBuffer = new sf::SoundBuffer;
-  newSoundBuffer->loadFromFile(fileName);
-  soundBufferArray.push_back(newSoundBuffer);
+  soundFileArray.push_back(fileName);
+  soundBufferArray.push_back(NULL);
+  soundSize.push_back(0);
+  soundPriority.push_back(SOUND_PRIORITY_NORMAL);
+  soundVoice.push_back(-1);
+  soundFrame.push_back(-1);
+  soundLastUse.push_back(-1);
+  soundLoading.push_back(false);
+  soundResident.push_back(false);
 }
 
-void SoundManager::playSound(int n, bool force)
+void SoundManager::prefetchSound(int n, bool resident)
 {
-  checkSoundStatus();
+  if (n < 0 || n >= (int)soundFileArray.size()) return;
 
-  if (mute) return;
+  soundLastUse[n] = frame;
+  if (resident && !soundResident[n])
+  {
+    soundResident[n] = true;
+    if (!soundBufferArray[n])
+    {
+      if (residentPending == 0) residentClock.restart();
+      residentPending++;
+    }
+  }
+  if (soundBufferArray[n] || soundLoading[n]) return;
 
-  if (!force)
+  soundLoading[n] = true;
   {
-    for (sf::Sound* s: soundArray)
-      if (s->getBuffer() == soundBufferArray[n]) return;
+    std::lock_guard<std::mutex> lock(loadMutex);
+    loadQueue.push_back(std::pair<int, std::string>(n, soundFileArray[n]));
   }
+  if (!loaderThread.joinable())
+    loaderThread = std::thread(&SoundManager::loaderThreadLoop, this);
+  loadCondition.notify_one();
+}
 
-  stopSound(n);
+void SoundManager::loaderThreadLoop()
+{
+  while (true)
+  {
+    std::pair<int, std::string> sound;
+    {
+      std::unique_lock<std::mutex> lock(loadMutex);
+      loadCondition.wait(lock, [this] { return stopping || !loadQueue.empty(); });
+      if (stopping) return;
+      sound = loadQueue.front();
+      loadQueue.pop_front();
+      decodingSound = sound.first;
+    }
 
-  sf::Sound* newSound = new sf::Sound;
-  newSound->setBuffer(*soundBufferArray[n]);
-  newSound->setVolume(volume);
-  soundArray.push_back(newSound);
-  newSound->play();
+    decodedSoundStruct decoded;
+    decoded.n = sound.first;
+    decodeSound(sound.second, decoded);
+
+    {
+      std::lock_guard<std::mutex> lock(loadMutex);
+      decodedSounds.push_back(std::move(decoded));
+      decodingSound = -1;
+    }
+    decodedCondition.notify_all();
+  }
+}
+
+void SoundManager::decodeSound(const std::string& fileName, decodedSoundStruct& decoded)
+{
+  decoded.ok = false;
+  decoded.channelCount = 0;
+  decoded.sampleRate = 0;
+
+  sf::InputSoundFile file;
+  const void* data;
+  std::size_t size;
+  bool opened;
+  if (AssetArchive::getInstance().find(fileName, data, size))
+    opened = file.openFromMemory(data, size);
+  else
+    opened = file.openFromFile(fileName);
+
+  if (!opened)
+  {
+    std::cout << "[ERROR] Loading sound: " << fileName << std::endl;
+    return;
+  }
+
+  decoded.samples.resize(file.getSampleCount());
+  decoded.samples.resize(file.read(decoded.samples.data(), decoded.samples.size()));
+  decoded.channelCount = file.getChannelCount();
+  decoded.sampleRate = file.getSampleRate();
+  decoded.ok = true;
+}
+
+void SoundManager::loadSound(int n)
+{
+  decodedSoundStruct decoded;
+  decoded.n = -1;
+  {
+    // waits for the loader thread only if it is decoding this sound
+    std::unique_lock<std::mutex> lock(loadMutex);
+    decodedCondition.wait(lock, [this, n] { return decodingSound != n; });
+    for (auto it = decodedSounds.begin(); it != decodedSounds.end(); it++)
+    {
+      if (it->n == n)
+      {
+        decoded = std::move(*it);
+        decodedSounds.erase(it);
+        break;
+      }
+    }
+    for (auto it = loadQueue.begin(); it != loadQueue.end(); it++)
+    {
+      if (it->first == n)
+      {
+        loadQueue.erase(it);
+        break;
+      }
+    }
+  }
+
+  // not decoded yet (removed from the queue): decoded here, beside the loader thread
+  if (decoded.n < 0)
+  {
+    decoded.n = n;
+    decodeSound(soundFileArray[n], decoded);
+  }
+  uploadSound(decoded);
+}
+
+void SoundManager::uploadSound(decodedSoundStruct& decoded)
+{
+  int n = decoded.n;
+  soundLoading[n] = false;
+  if (soundBufferArray[n]) return;
+
+  // an empty buffer if the file can not be decoded (not decoded again)
+  sf::SoundBuffer* newSoundBuffer = new sf::SoundBuffer;
+  if (decoded.ok && !decoded.samples.empty())
+    newSoundBuffer->loadFromSamples(decoded.samples.data(), decoded.samples.size(), decoded.channelCount, decoded.sampleRate);
+  soundBufferArray[n] = newSoundBuffer;
+  soundSize[n] = decoded.samples.size() * sizeof(sf::Int16);
+  residentMemory += soundSize[n];
+
+  if (soundResident[n] && --residentPending == 0)
+  {
+    int count = 0, size = 0;
+    for (unsigned int i = 0; i < soundResident.size(); i++)
+      if (soundResident[i])
+      {
+        count++;
+        size += soundSize[i];
+      }
+    std::cout << "Sounds: " << count << " common sounds decoded in " << residentClock.getElapsedTime().asMilliseconds()
+              << " ms in the background (" << size / 1024 << " KB)" << std::endl;
+  }
+}
+
+void SoundManager::applyMemoryBudget()
+{
+  while (residentMemory > memoryBudget)
+  {
+    // least recently used, not playing, not resident
+    int oldest = -1;
+    for (unsigned int i = 0; i < soundBufferArray.size(); i++)
+    {
+      if (!soundBufferArray[i] || soundResident[i] || soundLastUse[i] >= frame - 1) continue;
+      if (soundVoice[i] >= 0 && voices[soundVoice[i]].getStatus() != sf::Sound::Stopped) continue;
+      if (oldest < 0 || soundLastUse[i] < soundLastUse[oldest]) oldest = i;
+    }
+    if (oldest < 0) return;
+
+    // the voice still holds the buffer
+    if (soundVoice[oldest] >= 0) releaseVoice(soundVoice[oldest]);
+    delete soundBufferArray[oldest];
+    soundBufferArray[oldest] = NULL;
+    residentMemory -= soundSize[oldest];
+    soundSize[oldest] = 0;
+    stats.evictions++;
+  }
+}
+
+void SoundManager::setMemoryBudget(int bytes)
+{
+  memoryBudget = bytes;
+}
+
+int SoundManager::getResidentMemory()
+{
+  return residentMemory;
+}
+
+void SoundManager::playSound(int n, bool force)
+{
+  play(n, force, 1.0f);
 }
 
 void SoundManager::playPitchModSound(int n, bool force)
 {
-  checkSoundStatus();
+  play(n, force, (float)(75 +(rand() % 50)) / 100.0f);
+}
 
+void SoundManager::play(int n, bool force, float pitch)
+{
   if (mute) return;
+  if (n < 0 || n >= (int)soundBufferArray.size()) return;
 
-  if (!force)
+  soundLastUse[n] = frame;
+  if (!soundBufferArray[n])
   {
-    for (sf::Sound* s: soundArray)
-      if (s->getBuffer() == soundBufferArray[n]) return;
+    loadSound(n);
+    stats.misses++;
+    if (!soundBufferArray[n]) return;
   }
 
-  stopSound(n);
+  if (soundFrame[n] == frame)
+  {
+    stats.merged++;
+    return;
+  }
 
-  sf::Sound* newSound = new sf::Sound;
-  newSound->setBuffer(*soundBufferArray[n]);
-  newSound->setVolume(volume);
+  int voice = soundVoice[n];
+  if (voice >= 0 && voices[voice].getStatus() == sf::Sound::Stopped)
+  {
+    releaseVoice(voice);
+    voice = -1;
+  }
 
-  newSound->setPitch( (float)(75 +(rand() % 50)) / 100.0f );
+  if (!force && voice >= 0) return;
+  soundFrame[n] = frame;
 
-  soundArray.push_back(newSound);
-  newSound->play();
+  // a sound only plays once: restarts its voice
+  if (voice >= 0)
+    voices[voice].stop();
+  else
+  {
+    voice = findVoice(soundPriority[n]);
+    if (voice < 0)
+    {
+      stats.drops++;
+      return;
+    }
+    voices[voice].setBuffer(*soundBufferArray[n]);
+    voiceSound[voice] = n;
+    soundVoice[n] = voice;
+  }
+
+  voices[voice].setPitch(pitch);
+  voices[voice].play();
+  voiceAge[voice] = ++playCounter;
+  stats.plays++;
 }
 
-void SoundManager::stopSound(int n)
+int SoundManager::findVoice(int priority)
 {
+  int victim = -1;
+  for (int i = 0; i < SOUND_VOICES; i++)
   {
-    for (sf::Sound* s: soundArray)
-      if (s->getBuffer() == soundBufferArray[n]) s->stop();
+    if (voiceSound[i] < 0) return i;
+    if (voices[i].getStatus() == sf::Sound::Stopped)
+    {
+      releaseVoice(i);
+      return i;
+    }
+
+    if (victim < 0
+        || soundPriority[voiceSound[i]] < soundPriority[voiceSound[victim]]
+        || (soundPriority[voiceSound[i]] == soundPriority[voiceSound[victim]] && voiceAge[i] < voiceAge[victim]))
+      victim = i;
   }
+
+  if (soundPriority[voiceSound[victim]] > priority) return -1;
+
+  voices[victim].stop();
+  releaseVoice(victim);
+  stats.steals++;
+  return victim;
+}
+
+void SoundManager::releaseVoice(int voice)
+{
+  soundVoice[voiceSound[voice]] = -1;
+  voiceSound[voice] = -1;
+}
+
+void SoundManager::stopSound(int n)
+{
+  if (n < 0 || n >= (int)soundVoice.size()) return;
+  if (soundVoice[n] >= 0) voices[soundVoice[n]].stop();
 }
 
 void SoundManager::setMute(bool mute)
@@ -106,20 +361,54 @@ void SoundManager::setMute(bool mute)
 void SoundManager::setVolume(int volume)
 {
   this->volume = volume;
-  for (sf::Sound* s: soundArray)
-    s->setVolume(volume);
+  for (int i = 0; i < SOUND_VOICES; i++)
+    voices[i].setVolume(volume);
 }
 
-void SoundManager::checkSoundStatus()
+void SoundManager::setPriority(int n, int priority)
 {
-  for (unsigned int i = 0; i < soundArray.size(); i++)
+  if (n >= 0 && n < (int)soundPriority.size()) soundPriority[n] = priority;
+}
+
+void SoundManager::beginFrame()
+{
+  frame++;
+
+  std::vector<decodedSoundStruct> decoded;
   {
-    sf::Sound* sound = soundArray[i];
-    if (sound->getStatus() == sf::Sound::Stopped)
-    {
-      delete sound;
-      soundArray.erase(soundArray.begin() + i);
-      i--;
-    }
+    std::lock_guard<std::mutex> lock(loadMutex);
+    decoded.swap(decodedSounds);
   }
+  for (decodedSoundStruct& sound : decoded) uploadSound(sound);
+
+  applyMemoryBudget();
+}
+
+SoundManager::soundStatsStruct SoundManager::getStats()
+{
+  return stats;
+}
+
+void SoundManager::resetStats()
+{
+  stats.plays = 0;
+  stats.steals = 0;
+  stats.drops = 0;
+  stats.merged = 0;
+  stats.misses = 0;
+  stats.evictions = 0;
+}
+
+std::string SoundManager::getReport()
+{
+  int busy = 0;
+  for (int i = 0; i < SOUND_VOICES; i++)
+    if (voiceSound[i] >= 0 && voices[i].getStatus() != sf::Sound::Stopped) busy++;
+
+  std::ostringstream oss;
+  oss << "Sound: " << busy << " / " << SOUND_VOICES << " voices, " << stats.plays << " plays, "
+      << stats.steals << " steals, " << stats.drops << " drops, " << stats.merged << " merged\n"
+      << "Sound memory: " << residentMemory / 1024 << " / " << memoryBudget / 1024 << " KB, "
+      << stats.misses << " misses, " << stats.evictions << " evictions";
+  return oss.str();
 }
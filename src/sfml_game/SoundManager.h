@@ -18,11 +18,26 @@
 #define SOUNDMANAGER_H_INCLUDED
 
 #include <SFML/Audio.hpp>
+#include <string>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+const int SOUND_VOICES = 32;          // number of sounds playing at the same time
+const int SOUND_MEMORY_BUDGET = 32 * 1024 * 1024;  // decoded sounds in memory (bytes, default): common sounds (19.6 MB),
+                                                   // largest floor (5.7 MB) and headroom
+
+const int SOUND_PRIORITY_LOW = 0;     // stolen first (repeated shots, impacts...)
+const int SOUND_PRIORITY_NORMAL = 1;
+const int SOUND_PRIORITY_HIGH = 2;    // never stolen by a lower priority sound
 
 class SoundManager
 {
 public:
     static SoundManager& getInstance();
+
+    /** Registers a sound: it is decoded when it is prefetched or played for the first time. */
     void addSound(const char *fileName);
     void playSound(int n, bool force = true);
     void playPitchModSound(int n, bool force = true);
@@ -30,14 +45,91 @@ public:
     void setMute(bool mute);
     void setVolume(int volume);
 
+    /** When the voices are all busy, a sound steals the voice of the oldest sound
+      * with the lowest priority, if this priority is not higher than its own. */
+    void setPriority(int n, int priority);
+
+    /** Decodes a sound in the background, so it is ready when played.
+      * A resident sound (common sounds) is never released by the memory budget. */
+    void prefetchSound(int n, bool resident = false);
+
+    /** When the decoded sounds use more memory than the budget, the least recently
+      * used ones (not playing, not resident) are released. They are decoded again when needed. */
+    void setMemoryBudget(int bytes);
+    int getResidentMemory();
+
+    /** Starts a new frame: a sound triggered several times in a frame is played once.
+      * The sounds decoded in the background are uploaded, and the memory budget is applied. */
+    void beginFrame();
+
+    struct soundStatsStruct
+    {
+      int plays;      // sounds started
+      int steals;     // voices stolen from a playing sound
+      int drops;      // sounds not played (all the voices busy with higher priority sounds)
+      int merged;     // triggers ignored (same sound in the same frame)
+      int misses;     // sounds decoded when played (not prefetched)
+      int evictions;  // sounds released (memory budget)
+    };
+    soundStatsStruct getStats();
+    void resetStats();
+    std::string getReport();
+
 private:
     SoundManager();
     ~SoundManager();
 
-    void checkSoundStatus();
+    void play(int n, bool force, float pitch);
+    int findVoice(int priority);
+    void releaseVoice(int voice);
+
+    struct decodedSoundStruct
+    {
+      int n;
+      std::vector<sf::Int16> samples;
+      unsigned int channelCount;
+      unsigned int sampleRate;
+      bool ok;
+    };
+    static void decodeSound(const std::string& fileName, decodedSoundStruct& decoded);
+    void loadSound(int n);
+    void uploadSound(decodedSoundStruct& decoded);
+    void applyMemoryBudget();
+    void loaderThreadLoop();
+
+    std::vector<std::string> soundFileArray;
+    std::vector<sf::SoundBuffer*> soundBufferArray;  // NULL if not decoded
+    std::vector<int> soundSize;         // decoded size (bytes)
+    std::vector<int> soundPriority;
+    std::vector<int> soundVoice;        // voice playing the sound (-1 = none)
+    std::vector<int> soundFrame;        // last frame the sound has been triggered
+    std::vector<int> soundLastUse;      // last frame the sound has been played or prefetched
+    std::vector<bool> soundLoading;     // in the loader thread
+    std::vector<bool> soundResident;    // never released
+
+    int residentPending;                // resident sounds not decoded yet
+    sf::Clock residentClock;            // since the first resident sound has been prefetched
+
+    int memoryBudget;
+    int residentMemory;
+
+    // loader thread
+    std::deque<std::pair<int, std::string> > loadQueue;
+    std::vector<decodedSoundStruct> decodedSounds;
+    std::mutex loadMutex;
+    std::condition_variable loadCondition;
+    std::condition_variable decodedCondition;
+    int decodingSound;                  // sound being decoded by the loader thread (-1 = none)
+    std::thread loaderThread;
+    bool stopping;
+
+    sf::Sound voices[SOUND_VOICES];
+    int voiceSound[SOUND_VOICES];       // sound played by the voice (-1 = free)
+    int voiceAge[SOUND_VOICES];         // play counter when the voice started
 
-    std::vector<sf::SoundBuffer*> soundBufferArray;
-    std::vector<sf::Sound*> soundArray;
+    int frame;
+    int playCounter;
+    soundStatsStruct stats;
 
     bool mute;
     int volume;
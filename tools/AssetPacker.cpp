@@ -0,0 +1,155 @@
+/**  This file is part of Witch Blast.
+  *
+  *  Witch Blast is free software: you can redistribute it and/or modify
+  *  it under the terms of the GNU General Public License as published by
+  *  the Free Software Foundation, either version 3 of the License, or
+  *  (at your option) any later version.
+  *
+  *  Witch Blast is distributed in the hope that it will be useful,
+  *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  *  GNU General Public License for more details.
+  *
+  *  You should have received a copy of the GNU General Public License
+  *  along with Witch Blast.  If not, see <http://www.gnu.org/licenses/>.
+  */
+
+/*
+ *  Builds the asset archive read by AssetArchive (see src/sfml_game/AssetArchive.h).
+ *
+ *  Usage: AssetPacker <archive> <file> [<file>...]
+ *  The files are stored with the name given on the command line ("media/bat.png"), so the
+ *  packer must be run from the game directory. The "assets" target of the CMake file does it
+ *  with every file of media/ and data/.
+ *  A file built elsewhere is given as <name>=<file> ("data/labels_english.bin=build/labels_english.bin").
+ */
+
+#include "src/sfml_game/AssetArchive.h"
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <algorithm>
+#include <cstring>
+
+struct packedFileStruct
+{
+  std::string name;
+  std::string data;
+  uint32_t nameOffset;
+  uint32_t offset;
+};
+
+static void putUint(std::string& dest, uint32_t n)
+{
+  for (int i = 0; i < 4; i++) dest.push_back((char)((n >> (8 * i)) & 0xFF));
+}
+
+static bool compareNames(const packedFileStruct& a, const packedFileStruct& b)
+{
+  return strcmp(a.name.c_str(), b.name.c_str()) < 0;
+}
+
+int main(int argc, char** argv)
+{
+  if (argc < 3)
+  {
+    std::cout << "Usage: " << argv[0] << " <archive> <file> [<file>...]" << std::endl;
+    return 1;
+  }
+
+  std::vector<packedFileStruct> files;
+  for (int i = 2; i < argc; i++)
+  {
+    packedFileStruct file;
+    std::string path = argv[i];
+    std::size_t separator = path.find('=');
+    if (separator != std::string::npos)
+    {
+      file.name = path.substr(0, separator);
+      path.erase(0, separator + 1);
+    }
+    else
+      file.name = path;
+    std::replace(file.name.begin(), file.name.end(), '\\', '/');
+    if (file.name.compare(0, 2, "./") == 0) file.name.erase(0, 2);
+
+    std::ifstream input(path.c_str(), std::ios::in | std::ios::binary);
+    if (!input)
+    {
+      std::cout << "[ERROR] Reading " << path << std::endl;
+      return 1;
+    }
+    std::ostringstream oss;
+    oss << input.rdbuf();
+    file.data = oss.str();
+    files.push_back(file);
+  }
+
+  // sorted by name, for the binary search at runtime
+  std::sort(files.begin(), files.end(), compareNames);
+  for (unsigned int i = 1; i < files.size(); i++)
+  {
+    if (files[i].name == files[i - 1].name)
+    {
+      std::cout << "[ERROR] File given twice: " << files[i].name << std::endl;
+      return 1;
+    }
+  }
+
+  std::string names;
+  for (unsigned int i = 0; i < files.size(); i++)
+  {
+    files[i].nameOffset = names.size();
+    names.append(files[i].name);
+    names.push_back('\0');
+  }
+
+  uint64_t offset = ASSET_ARCHIVE_HEADER_SIZE + files.size() * ASSET_ARCHIVE_ENTRY_SIZE + names.size();
+  for (unsigned int i = 0; i < files.size(); i++)
+  {
+    offset = (offset + ASSET_ARCHIVE_ALIGN - 1) / ASSET_ARCHIVE_ALIGN * ASSET_ARCHIVE_ALIGN;
+    files[i].offset = (uint32_t)offset;
+    offset += files[i].data.size();
+  }
+  if (offset > 0xFFFFFFFF)
+  {
+    std::cout << "[ERROR] Archive larger than 4 GB" << std::endl;
+    return 1;
+  }
+
+  std::string archive;
+  archive.reserve(offset);
+  archive.append(ASSET_ARCHIVE_MAGIC, 4);
+  putUint(archive, ASSET_ARCHIVE_VERSION);
+  putUint(archive, files.size());
+  putUint(archive, names.size());
+
+  for (unsigned int i = 0; i < files.size(); i++)
+  {
+    putUint(archive, files[i].nameOffset);
+    putUint(archive, files[i].offset);
+    putUint(archive, files[i].data.size());
+    putUint(archive, getAssetType(files[i].name));
+  }
+  archive.append(names);
+
+  for (unsigned int i = 0; i < files.size(); i++)
+  {
+    archive.resize(files[i].offset, '\0');
+    archive.append(files[i].data);
+  }
+
+  std::ofstream output(argv[1], std::ios::out | std::ios::trunc | std::ios::binary);
+  output.write(archive.data(), archive.size());
+  output.close();
+  if (!output)
+  {
+    std::cout << "[ERROR] Writing " << argv[1] << std::endl;
+    return 1;
+  }
+
+  std::cout << argv[1] << ": " << files.size() << " files, " << archive.size() << " bytes" << std::endl;
+  return 0;
+}
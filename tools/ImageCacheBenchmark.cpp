@@ -0,0 +1,120 @@
+/**  This file is part of Witch Blast.
+  *
+  *  Witch Blast is free software: you can redistribute it and/or modify
+  *  it under the terms of the GNU General Public License as published by
+  *  the Free Software Foundation, either version 3 of the License, or
+  *  (at your option) any later version.
+  *
+  *  Witch Blast is distributed in the hope that it will be useful,
+  *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  *  GNU General Public License for more details.
+  *
+  *  You should have received a copy of the GNU General Public License
+  *  along with Witch Blast.  If not, see <http://www.gnu.org/licenses/>.
+  */
+
+/*
+ *  Benchmark of the decoded images cache (see src/sfml_game/ImageCache.h).
+ *
+ *  Usage: ImageCacheBenchmark <cache directory> <image files...>
+ *  Decodes the images (PNG), then loads them twice through the cache: the first pass
+ *  decodes and writes the entries (if the directory is empty), the second one reads them.
+ *  Prints the time of each pass, and checks the cached pixels are the decoded ones.
+ *  Fails (exit code 1) if an image can't be loaded or differs.
+ */
+
+#include "src/sfml_game/ImageCache.h"
+#include "src/sfml_game/MappedFile.h"
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <cstring>
+
+static double getMilliseconds(std::chrono::steady_clock::time_point begin)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 3)
+    {
+        std::cout << "Usage: " << argv[0] << " <cache directory> <image files...>" << std::endl;
+        return 1;
+    }
+
+    std::vector<std::string> fileNames(argv + 2, argv + argc);
+    std::vector<MappedFile> files(fileNames.size());
+    std::size_t fileSize = 0;
+    for (unsigned int i = 0; i < fileNames.size(); i++)
+    {
+        if (!files[i].open(fileNames[i]))
+        {
+            std::cout << "[ERROR] Loading image: " << fileNames[i] << std::endl;
+            return 1;
+        }
+        fileSize += files[i].getSize();
+    }
+
+    // decoding only
+    std::vector<sf::Image> decoded(fileNames.size());
+    std::size_t pixelSize = 0;
+    auto begin = std::chrono::steady_clock::now();
+    for (unsigned int i = 0; i < fileNames.size(); i++)
+    {
+        if (!decoded[i].loadFromMemory(files[i].getData(), files[i].getSize()))
+        {
+            std::cout << "[ERROR] Decoding image: " << fileNames[i] << std::endl;
+            return 1;
+        }
+        pixelSize += decoded[i].getSize().x * decoded[i].getSize().y * 4;
+    }
+    double decodeTime = getMilliseconds(begin);
+
+    std::cout << fileNames.size() << " images, " << fileSize / 1024 << " KB of files, "
+              << pixelSize / 1024 << " KB of pixels" << std::endl;
+    std::cout << "decoding:     " << std::fixed << std::setprecision(1) << std::setw(8) << decodeTime << " ms" << std::endl;
+
+    ImageCache cache;
+    begin = std::chrono::steady_clock::now();
+    cache.open(argv[1]);
+    double openTime = getMilliseconds(begin);
+    if (!cache.isOpen()) return 1;
+    std::cout << "opening:      " << std::setw(8) << openTime << " ms (" << cache.getPrunedCount() << " stale entries removed)" << std::endl;
+
+    int errors = 0;
+    const char* passNames[] = { "first pass:   ", "second pass:  " };
+    for (int pass = 0; pass < 2; pass++)
+    {
+        int cacheHits = 0;
+        std::vector<sf::Image> images(fileNames.size());
+        begin = std::chrono::steady_clock::now();
+        for (unsigned int i = 0; i < fileNames.size(); i++)
+        {
+            bool fromCache;
+            if (!cache.load(images[i], fileNames[i], files[i].getData(), files[i].getSize(), fromCache))
+            {
+                std::cout << "[ERROR] Loading image: " << fileNames[i] << std::endl;
+                errors++;
+            }
+            if (fromCache) cacheHits++;
+        }
+        double loadTime = getMilliseconds(begin);
+
+        for (unsigned int i = 0; i < fileNames.size(); i++)
+            if (images[i].getSize() != decoded[i].getSize()
+                || memcmp(images[i].getPixelsPtr(), decoded[i].getPixelsPtr(), decoded[i].getSize().x * decoded[i].getSize().y * 4) != 0)
+            {
+                std::cout << "[ERROR] Cached image differs: " << fileNames[i] << std::endl;
+                errors++;
+            }
+
+        std::cout << passNames[pass] << std::setw(8) << loadTime << " ms (" << cacheHits << " from the cache)" << std::endl;
+    }
+
+    return errors == 0 ? 0 : 1;
+}
@@ -0,0 +1,179 @@
+/**  This file is part of Witch Blast.
+  *
+  *  Witch Blast is free software: you can redistribute it and/or modify
+  *  it under the terms of the GNU General Public License as published by
+  *  the Free Software Foundation, either version 3 of the License, or
+  *  (at your option) any later version.
+  *
+  *  Witch Blast is distributed in the hope that it will be useful,
+  *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  *  GNU General Public License for more details.
+  *
+  *  You should have received a copy of the GNU General Public License
+  *  along with Witch Blast.  If not, see <http://www.gnu.org/licenses/>.
+  */
+
+/*
+ *  Scaling benchmark of the job system (see src/sfml_game/JobSystem.h).
+ *
+ *  Usage: JobBenchmark [<particles> [<frames>]]
+ *  Animates bolt-like particles as DungeonMapEntity does (integration, deaths and respawns
+ *  through per-worker buffers, then the quads written in a vertex array) with 1, 2, 4 and 8
+ *  threads, and prints the time per frame and the speedup against one thread.
+ */
+
+#include "src/sfml_game/JobSystem.h"
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <algorithm>
+
+const int BENCHMARK_GRAIN = 256;    // as PARTICLE_JOB_GRAIN
+
+struct particleStruct
+{
+  float x, y;
+  float vx, vy;
+  float scale, initialScale;
+  float age, lifetime;
+};
+
+struct vertexStruct
+{
+  float x, y;
+  float u, v;
+  unsigned char color[4];
+};
+
+struct bufferStruct
+{
+  std::vector<int> deaths;
+  std::vector<particleStruct> spawns;
+};
+
+static particleStruct newParticle(unsigned int seed)
+{
+  particleStruct particle;
+  particle.x = (float)(seed % 1000);
+  particle.y = (float)((seed / 1000) % 1000);
+  particle.vx = (float)(seed % 200) - 100.0f;
+  particle.vy = (float)((seed / 200) % 200) - 100.0f;
+  particle.scale = particle.initialScale = 1.0f;
+  particle.age = 0.0f;
+  particle.lifetime = 0.5f + (seed % 100) * 0.01f;
+  return particle;
+}
+
+static void animate(std::vector<particleStruct>& particles, std::vector<bufferStruct>& buffers,
+                    std::vector<int>& deaths, std::vector<vertexStruct>& vertices, float delay)
+{
+  JobSystem& jobSystem = JobSystem::getInstance();
+  for (unsigned int w = 0; w < buffers.size(); w++)
+  {
+    buffers[w].deaths.clear();
+    buffers[w].spawns.clear();
+  }
+
+  jobSystem.parallelFor(particles.size(), BENCHMARK_GRAIN, [&](int begin, int end, int worker)
+  {
+    bufferStruct& buffer = buffers[worker];
+    for (int i = begin; i < end; i++)
+    {
+      particleStruct& particle = particles[i];
+      particle.age += delay;
+      if (particle.age >= particle.lifetime)
+      {
+        buffer.deaths.push_back(i);
+        buffer.spawns.push_back(newParticle(i * 2654435761u));
+        continue;
+      }
+      particle.vx *= 0.99f;
+      particle.vy *= 0.99f;
+      particle.x += delay * particle.vx;
+      particle.y += delay * particle.vy;
+      float fade = (particle.lifetime - particle.age) / particle.lifetime;
+      particle.scale = particle.initialScale * sqrtf(fade);
+    }
+  });
+
+  // merge: dead particles removed in order, then the spawns appended
+  deaths.clear();
+  for (unsigned int w = 0; w < buffers.size(); w++)
+    deaths.insert(deaths.end(), buffers[w].deaths.begin(), buffers[w].deaths.end());
+  std::sort(deaths.begin(), deaths.end());
+  unsigned int kept = 0, nextDead = 0;
+  for (unsigned int i = 0; i < particles.size(); i++)
+  {
+    if (nextDead < deaths.size() && deaths[nextDead] == (int)i) nextDead++;
+    else particles[kept++] = particles[i];
+  }
+  particles.resize(kept);
+  for (unsigned int w = 0; w < buffers.size(); w++)
+    particles.insert(particles.end(), buffers[w].spawns.begin(), buffers[w].spawns.end());
+
+  vertices.resize(particles.size() * 4);
+  jobSystem.parallelFor(particles.size(), BENCHMARK_GRAIN, [&](int begin, int end, int)
+  {
+    for (int i = begin; i < end; i++)
+    {
+      const particleStruct& particle = particles[i];
+      vertexStruct* quad = &vertices[i * 4];
+      float middle = 12.0f * particle.scale;
+      unsigned char alpha = (unsigned char)(255 * particle.scale);
+      for (int k = 0; k < 4; k++)
+      {
+        quad[k].x = particle.x + ((k == 1 || k == 2) ? middle : -middle);
+        quad[k].y = particle.y + (k >= 2 ? middle : -middle);
+        quad[k].u = (k == 1 || k == 2) ? 24.0f : 0.0f;
+        quad[k].v = k >= 2 ? 24.0f : 0.0f;
+        quad[k].color[0] = quad[k].color[1] = quad[k].color[2] = 255;
+        quad[k].color[3] = alpha;
+      }
+    }
+  });
+}
+
+int main(int argc, char** argv)
+{
+  int nbParticles = argc > 1 ? atoi(argv[1]) : 100000;
+  int nbFrames = argc > 2 ? atoi(argv[2]) : 200;
+  if (nbParticles <= 0 || nbFrames <= 0)
+  {
+    std::cout << "Usage: " << argv[0] << " [<particles> [<frames>]]" << std::endl;
+    return 1;
+  }
+
+  std::cout << nbParticles << " particles, " << nbFrames << " frames, "
+            << std::thread::hardware_concurrency() << " cores" << std::endl;
+
+  double reference = 0.0;
+  const int threadCounts[] = { 1, 2, 4, 8 };
+  for (int threadCount : threadCounts)
+  {
+    JobSystem::getInstance().start(threadCount);
+
+    std::vector<particleStruct> particles;
+    for (int i = 0; i < nbParticles; i++) particles.push_back(newParticle(i * 2654435761u));
+    std::vector<bufferStruct> buffers(JobSystem::getInstance().getThreadCount());
+    std::vector<int> deaths;
+    std::vector<vertexStruct> vertices;
+
+    // warm up (buffers and vertex array allocated)
+    animate(particles, buffers, deaths, vertices, 1.0f / 60);
+
+    auto begin = std::chrono::steady_clock::now();
+    for (int i = 0; i < nbFrames; i++) animate(particles, buffers, deaths, vertices, 1.0f / 60);
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count() / nbFrames;
+    if (threadCount == 1) reference = ms;
+
+    std::cout << std::setw(2) << threadCount << " threads: " << std::fixed << std::setprecision(3) << ms
+              << " ms per frame, speedup " << std::setprecision(2) << reference / ms << std::endl;
+  }
+  JobSystem::getInstance().stop();
+  return 0;
+}
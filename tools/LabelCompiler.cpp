@@ -0,0 +1,62 @@
+/**  This file is part of Witch Blast.
+  *
+  *  Witch Blast is free software: you can redistribute it and/or modify
+  *  it under the terms of the GNU General Public License as published by
+  *  the Free Software Foundation, either version 3 of the License, or
+  *  (at your option) any later version.
+  *
+  *  Witch Blast is distributed in the hope that it will be useful,
+  *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  *  GNU General Public License for more details.
+  *
+  *  You should have received a copy of the GNU General Public License
+  *  along with Witch Blast.  If not, see <http://www.gnu.org/licenses/>.
+  */
+
+/*
+ *  Compiles the text file of the labels into one label table per language (see src/TextMapper.h).
+ *
+ *  Usage: LabelCompiler <labels.txt> <output directory>
+ *  Writes <output directory>/labels_<language>.bin for every language of the text file.
+ *  The "assets" target of the CMake file packs them in the asset archive.
+ */
+
+#include "src/TextMapper.h"
+
+#include <iostream>
+#include <fstream>
+
+int main(int argc, char** argv)
+{
+  if (argc != 3)
+  {
+    std::cout << "Usage: " << argv[0] << " <labels.txt> <output directory>" << std::endl;
+    return 1;
+  }
+
+  std::ifstream textFile(argv[1]);
+  if (!textFile)
+  {
+    std::cout << "[ERROR] Reading " << argv[1] << std::endl;
+    return 1;
+  }
+
+  std::map<std::string, std::string> tables;
+  tools::TextMapper::compileTextFile(textFile, tables);
+
+  for (auto& table : tables)
+  {
+    std::string fileName = std::string(argv[2]) + "/labels_" + table.first + ".bin";
+    std::ofstream output(fileName.c_str(), std::ios::out | std::ios::trunc | std::ios::binary);
+    output.write(table.second.data(), table.second.size());
+    output.close();
+    if (!output)
+    {
+      std::cout << "[ERROR] Writing " << fileName << std::endl;
+      return 1;
+    }
+    std::cout << fileName << ": " << table.second.size() << " bytes" << std::endl;
+  }
+  return 0;
+}
@@ -0,0 +1,178 @@
+/**  This file is part of Witch Blast.
+  *
+  *  Witch Blast is free software: you can redistribute it and/or modify
+  *  it under the terms of the GNU General Public License as published by
+  *  the Free Software Foundation, either version 3 of the License, or
+  *  (at your option) any later version.
+  *
+  *  Witch Blast is distributed in the hope that it will be useful,
+  *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  *  GNU General Public License for more details.
+  *
+  *  You should have received a copy of the GNU General Public License
+  *  along with Witch Blast.  If not, see <http://www.gnu.org/licenses/>.
+  */
+
+/*
+ *  Batch generation and validation of the standard rooms (see src/RoomRecipes.h).
+ *
+ *  Usage: RoomBenchmark [<rooms per level> [<seed>]]
+ *  Checks the recipe tables, then rolls the room plans of every standard and advanced level,
+ *  each room seeded with its own index. Validates each plan (recipe, layout and its parameters,
+ *  monsters of the level, counts, room capacity), replays a sample of seeds to check the rooms
+ *  are reproducible, checks every recipe is drawn, and prints the time per room (srand included).
+ *  Fails (exit code 1) on the first errors.
+ */
+
+#include "src/RoomRecipes.h"
+#include "src/DungeonMap.h"
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <chrono>
+#include <cstdlib>
+#include <algorithm>
+
+const int NB_STANDARD_LEVELS = 8;
+const int NB_ADVANCED_LEVELS = 6;
+const int MAX_MONSTERS = (MAP_WIDTH - 3) * (MAP_HEIGHT - 3);  // tiles of the random placement
+const int REPLAY_PERIOD = 997;                                // one room replayed every REPLAY_PERIOD
+
+static bool samePlan(const roomPlanStruct& a, const roomPlanStruct& b)
+{
+  if (a.recipe != b.recipe || a.layout != b.layout || a.layoutType != b.layoutType || a.grids != b.grids) return false;
+  if (a.spawns.size() != b.spawns.size()) return false;
+  for (unsigned int i = 0; i < a.spawns.size(); i++)
+    if (a.spawns[i].type != b.spawns[i].type || a.spawns[i].count != b.spawns[i].count) return false;
+  return true;
+}
+
+static int validatePlan(const roomPlanStruct& plan, int nbRecipes, const std::vector<enemyTypeEnum>& monsters)
+{
+  int errors = 0;
+  if (plan.recipe < 0 || plan.recipe >= nbRecipes)
+  {
+    std::cout << "[ERROR] Recipe " << plan.recipe << " out of the table (" << nbRecipes << " recipes)." << std::endl;
+    errors++;
+  }
+  if (plan.layout < RoomLayoutRandom || plan.layout > RoomLayoutChestCentered)
+  {
+    std::cout << "[ERROR] Unknown layout " << plan.layout << "." << std::endl;
+    errors++;
+  }
+  if ((plan.layout == RoomLayoutChest || plan.layout == RoomLayoutChestCentered) && !plan.spawns.empty())
+  {
+    std::cout << "[ERROR] Monsters in a chest room (recipe " << plan.recipe << ")." << std::endl;
+    errors++;
+  }
+  // layout type -1: empty room
+  if (plan.layoutType < -1 || plan.layoutType > ROOM_TYPE_ALL || plan.grids < 0)
+  {
+    std::cout << "[ERROR] Wrong layout parameters (recipe " << plan.recipe << ")." << std::endl;
+    errors++;
+  }
+
+  int total = 0;
+  for (unsigned int i = 0; i < plan.spawns.size(); i++)
+  {
+    if (plan.spawns[i].count <= 0)
+    {
+      std::cout << "[ERROR] Empty spawn (recipe " << plan.recipe << ")." << std::endl;
+      errors++;
+    }
+    if (std::find(monsters.begin(), monsters.end(), plan.spawns[i].type) == monsters.end())
+    {
+      std::cout << "[ERROR] Monster " << plan.spawns[i].type << " not in the level (recipe " << plan.recipe << ")." << std::endl;
+      errors++;
+    }
+    total += plan.spawns[i].count;
+  }
+  if (total > MAX_MONSTERS)
+  {
+    std::cout << "[ERROR] " << total << " monsters, more than the room capacity (recipe " << plan.recipe << ")." << std::endl;
+    errors++;
+  }
+  return errors;
+}
+
+static int benchmarkLevel(int level, bool advanced, int nbRooms, unsigned int seed)
+{
+  int nbRecipes = getRoomRecipeCount(level, advanced);
+  std::vector<enemyTypeEnum> monsters;
+  getRoomRecipeMonsters(level, advanced, monsters);
+  std::vector<int> recipeCount(nbRecipes, 0);
+
+  roomPlanStruct plan;
+  int errors = 0;
+  long totalMonsters = 0;
+
+  // generation only, timed
+  auto begin = std::chrono::steady_clock::now();
+  for (int i = 0; i < nbRooms; i++)
+  {
+    srand(seed + i);
+    rollRoomPlan(level, advanced, plan);
+    if (plan.recipe >= 0 && plan.recipe < nbRecipes) recipeCount[plan.recipe]++;
+    for (unsigned int s = 0; s < plan.spawns.size(); s++) totalMonsters += plan.spawns[s].count;
+  }
+  double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - begin).count() / nbRooms;
+
+  // validation, and replay of a sample of seeds
+  roomPlanStruct replay;
+  for (int i = 0; i < nbRooms && errors < 10; i++)
+  {
+    srand(seed + i);
+    rollRoomPlan(level, advanced, plan);
+    errors += validatePlan(plan, nbRecipes, monsters);
+
+    if (i % REPLAY_PERIOD == 0)
+    {
+      srand(seed + i);
+      rollRoomPlan(level, advanced, replay);
+      if (!samePlan(plan, replay))
+      {
+        std::cout << "[ERROR] Room " << seed + i << " not reproducible." << std::endl;
+        errors++;
+      }
+    }
+  }
+
+  int unused = 0;
+  for (int r = 0; r < nbRecipes; r++)
+    if (recipeCount[r] == 0) unused++;
+  if (unused > 0)
+  {
+    std::cout << "[ERROR] " << unused << " recipe(s) never drawn." << std::endl;
+    errors++;
+  }
+
+  std::cout << (advanced ? "advanced " : "standard ") << level << ": "
+            << std::setw(3) << nbRecipes << " recipes, "
+            << std::fixed << std::setprecision(1) << std::setw(6) << ns << " ns per room, "
+            << std::setprecision(2) << (double)totalMonsters / nbRooms << " monsters per room" << std::endl;
+  return errors;
+}
+
+int main(int argc, char** argv)
+{
+  int nbRooms = argc > 1 ? atoi(argv[1]) : 100000;
+  unsigned int seed = argc > 2 ? (unsigned int)atoi(argv[2]) : 1;
+  if (nbRooms <= 0)
+  {
+    std::cout << "Usage: " << argv[0] << " [<rooms per level> [<seed>]]" << std::endl;
+    return 1;
+  }
+
+  if (!checkRoomRecipes()) return 1;
+
+  int errors = 0;
+  for (int level = 1; level <= NB_STANDARD_LEVELS && errors == 0; level++)
+    errors += benchmarkLevel(level, false, nbRooms, seed);
+  for (int level = 1; level <= NB_ADVANCED_LEVELS && errors == 0; level++)
+    errors += benchmarkLevel(level, true, nbRooms, seed);
+
+  std::cout << (NB_STANDARD_LEVELS + NB_ADVANCED_LEVELS) * nbRooms << " rooms, " << errors << " errors" << std::endl;
+  return errors == 0 ? 0 : 1;
+}
@@ -0,0 +1,364 @@
+/**  This file is part of Witch Blast.
+  *
+  *  Witch Blast is free software: you can redistribute it and/or modify
+  *  it under the terms of the GNU General Public License as published by
+  *  the Free Software Foundation, either version 3 of the License, or
+  *  (at your option) any later version.
+  *
+  *  Witch Blast is distributed in the hope that it will be useful,
+  *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  *  GNU General Public License for more details.
+  *
+  *  You should have received a copy of the GNU General Public License
+  *  along with Witch Blast.  If not, see <http://www.gnu.org/licenses/>.
+  */
+
+
+/*
+ *  Check of the random monster placement (see src/SpawnPlacer.h) on the generated rooms.
+ *
+ *  Usage: SpawnPlacementCheck [<floors per level> [<seed>]]
+ *  Generates floors of every standard and advanced level (GameFloor), then the rooms as the game
+ *  does: standard rooms from the room recipes (src/RoomRecipes.h), key, boss, challenge, temple
+ *  and starting rooms with their own layouts, the player at one of the doors.
+ *  Places the monsters of the room, then walking, flying and large monsters until no tile is left
+ *  (max density).
+ *  Fails (exit code 1) if a placement fails while a suitable tile is free, if two monsters share a
+ *  tile, if a monster is out of its bounds, on a tile it can't stand on or too close to the player,
+ *  or if a free suitable tile was not used.
+ */
+
+#include "src/SpawnPlacer.h"
+#include "src/RoomRecipes.h"
+#include "src/GameFloor.h"
+#include "src/WitchBlastGame.h"
+
+#include <iostream>
+#include <cstdio>
+#include <cstdlib>
+
+const int NB_STANDARD_LEVELS = 8;
+const int NB_ADVANCED_LEVELS = 6;
+
+// The room generation only asks the game for the level, the player position and the player divinity:
+// these members are defined here, on a game object which is never built (they don't use it).
+static int currentLevel = 1;
+static Vector2D playerPosition(0.0f, 0.0f);
+static int playerDivinity = -1;
+
+alignas(WitchBlastGame) static char gameStorage[sizeof(WitchBlastGame)];
+alignas(PlayerEntity) static char playerStorage[sizeof(PlayerEntity)];
+
+WitchBlastGame& game()
+{
+  return *reinterpret_cast<WitchBlastGame*>(gameStorage);
+}
+
+int WitchBlastGame::getLevel()
+{
+  return currentLevel;
+}
+
+Vector2D WitchBlastGame::getPlayerPosition()
+{
+  return playerPosition;
+}
+
+PlayerEntity* WitchBlastGame::getPlayer()
+{
+  return reinterpret_cast<PlayerEntity*>(playerStorage);
+}
+
+divinityStruct PlayerEntity::getDivinity()
+{
+  divinityStruct divinity;
+  divinity.divinity = playerDivinity;
+  divinity.piety = 0;
+  divinity.level = 0;
+  divinity.interventions = 0;
+  divinity.percentsToNextLevels = 0.0f;
+  return divinity;
+}
+
+struct roomStruct
+{
+  bool walkable[MAP_WIDTH][MAP_HEIGHT];
+  bool flyable[MAP_WIDTH][MAP_HEIGHT];
+  bool occupied[MAP_WIDTH][MAP_HEIGHT];
+  bool placed[MAP_WIDTH][MAP_HEIGHT];
+  float xPlayer, yPlayer;
+  std::vector<roomSpawnStruct> spawns;
+  SpawnPlacer placer;
+  bool isBuilt;
+};
+
+static void addSpawn(std::vector<roomSpawnStruct>& spawns, enemyTypeEnum type, int count)
+{
+  roomSpawnStruct spawn;
+  spawn.type = type;
+  spawn.count = count;
+  spawns.push_back(spawn);
+}
+
+// the player enters by one of the doors (the starting room: at the center)
+static void placePlayer(DungeonMap* map)
+{
+  std::vector<Vector2D> doors;
+  if (map->hasNeighbourLeft()) doors.push_back(Vector2D(0.0f, (MAP_HEIGHT / 2) * TILE_HEIGHT + TILE_HEIGHT / 2));
+  if (map->hasNeighbourRight()) doors.push_back(Vector2D(MAP_WIDTH * TILE_WIDTH, (MAP_HEIGHT / 2) * TILE_HEIGHT + TILE_HEIGHT / 2));
+  if (map->hasNeighbourUp()) doors.push_back(Vector2D((MAP_WIDTH / 2) * TILE_WIDTH + TILE_WIDTH / 2, 0.0f));
+  if (map->hasNeighbourDown()) doors.push_back(Vector2D((MAP_WIDTH / 2) * TILE_WIDTH + TILE_WIDTH / 2, MAP_HEIGHT * TILE_HEIGHT));
+
+  if (map->getRoomType() == roomTypeStarting || doors.empty())
+    playerPosition = Vector2D(TILE_WIDTH * MAP_WIDTH * 0.5f, TILE_HEIGHT * MAP_HEIGHT * 0.5f);
+  else
+    playerPosition = doors[rand() % doors.size()];
+}
+
+// generates the room as WitchBlastGame::generateMap, returns false for the rooms without monsters
+static bool generateRoom(DungeonMap* map, int level, bool advanced, roomStruct& room)
+{
+  for (int x = 0; x < MAP_WIDTH; x++)
+    for (int y = 0; y < MAP_HEIGHT; y++)
+    {
+      room.occupied[x][y] = false;
+      room.placed[x][y] = false;
+    }
+  room.spawns.clear();
+
+  switch (map->getRoomType())
+  {
+  case roomTypeStandard:
+    {
+      roomPlanStruct plan;
+      rollRoomPlan(level, advanced, plan);
+      if (plan.layout == RoomLayoutChest || plan.layout == RoomLayoutChestCentered)
+      {
+        map->generateChestRoom();
+        break;
+      }
+      if (plan.layout == RoomLayoutWithoutHoles) map->generateRoomWithoutHoles(plan.layoutType);
+      else map->generateRoomRandom(plan.layoutType);
+      if (plan.grids > 0) map->addRandomGrids(plan.grids);
+      room.spawns = plan.spawns;
+      break;
+    }
+
+  case roomTypeKey:
+    map->generateKeyRoom();
+    room.occupied[MAP_WIDTH / 2][MAP_HEIGHT / 2] = true;
+    if (level == 1)
+    {
+      addSpawn(room.spawns, EnemyTypeRat, 2);
+      addSpawn(room.spawns, EnemyTypeBat, 2);
+    }
+    else
+    {
+      addSpawn(room.spawns, level < 6 ? EnemyTypeRat : EnemyTypeZombie, 5);
+      addSpawn(room.spawns, EnemyTypeBat, 5);
+      for (int i = level < 6 ? 2 : 5; i < level; i++)
+        addSpawn(room.spawns, rand() % 2 == 0 ? EnemyTypeImpBlue : EnemyTypeImpRed, 1);
+    }
+    break;
+
+  case roomTypeBoss:
+    map->generateRoomWithoutHoles(0);
+    if (level == 1) addSpawn(room.spawns, EnemyTypeRat, 2);
+    else if (level > 8)
+    {
+      addSpawn(room.spawns, EnemyTypeCauldron, 2);
+      addSpawn(room.spawns, EnemyTypeImpBlue, 4);
+    }
+    break;
+
+  case roomTypeChallenge:
+  case roomTypeStarting:
+    map->generateRoomWithoutHoles(0);
+    break;
+
+  case roomTypeTemple:
+    playerDivinity = rand() % 2 == 0 ? -1 : rand() % NB_DIVINITY;
+    map->generateTempleRoom();
+    break;
+
+  default:
+    return false;
+  }
+
+  for (int x = 0; x < MAP_WIDTH; x++)
+    for (int y = 0; y < MAP_HEIGHT; y++)
+    {
+      room.walkable[x][y] = map->isWalkable(x, y);
+      room.flyable[x][y] = map->isFlyable(x, y);
+    }
+  room.xPlayer = playerPosition.x;
+  room.yPlayer = playerPosition.y;
+  room.isBuilt = false;
+  return true;
+}
+
+static bool isSuitable(const roomStruct& room, SpawnPlacer::spawnTypeEnum spawnType, int x, int y)
+{
+  if (x < 0 || x >= MAP_WIDTH || y < 0 || y >= MAP_HEIGHT) return false;
+  if (!SpawnPlacer::isInBounds(spawnType, x, y)) return false;
+  if (spawnType == SpawnPlacer::SpawnFlying ? !room.flyable[x][y] : !room.walkable[x][y]) return false;
+
+  float dx = x * TILE_WIDTH + TILE_WIDTH * 0.5f - room.xPlayer;
+  float dy = y * TILE_HEIGHT + TILE_HEIGHT * 0.5f - room.yPlayer;
+  return dx * dx + dy * dy >= SPAWN_MIN_DISTANCE2;
+}
+
+static bool hasFreeTile(const roomStruct& room, SpawnPlacer::spawnTypeEnum spawnType)
+{
+  for (int x = 0; x < MAP_WIDTH; x++)
+    for (int y = 0; y < MAP_HEIGHT; y++)
+      if (!room.occupied[x][y] && isSuitable(room, spawnType, x, y)) return true;
+  return false;
+}
+
+// places a monster (as WitchBlastGame::findPlaceMonsters), returns false if no tile is left
+static bool placeMonster(roomStruct& room, SpawnPlacer::spawnTypeEnum spawnType, const char* roomName, int* errors)
+{
+  if (!room.isBuilt)
+  {
+    room.placer.build(room.walkable, room.flyable, room.occupied, room.xPlayer, room.yPlayer);
+    room.isBuilt = true;
+  }
+
+  IntCoord tile(0, 0);
+  if (!room.placer.take(spawnType, room.occupied, &tile))
+  {
+    if (hasFreeTile(room, spawnType))
+    {
+      std::cout << "[ERROR] " << roomName << ": placement failed with free tiles left for spawn type " << spawnType << ".\n";
+      (*errors)++;
+    }
+    return false;
+  }
+
+  if (tile.x < 0 || tile.x >= MAP_WIDTH || tile.y < 0 || tile.y >= MAP_HEIGHT)
+  {
+    std::cout << "[ERROR] " << roomName << ": monster out of the map (" << tile.x << ", " << tile.y << ").\n";
+    (*errors)++;
+    return true;
+  }
+  if (room.placed[tile.x][tile.y])
+  {
+    std::cout << "[ERROR] " << roomName << ": two monsters on (" << tile.x << ", " << tile.y << ").\n";
+    (*errors)++;
+  }
+  if (!isSuitable(room, spawnType, tile.x, tile.y))
+  {
+    std::cout << "[ERROR] " << roomName << ": unsuitable tile (" << tile.x << ", " << tile.y
+              << ") for spawn type " << spawnType << ".\n";
+    (*errors)++;
+  }
+  room.placed[tile.x][tile.y] = true;
+  return true;
+}
+
+// places the monsters of the room, then fills it until every list is empty, returns the number of errors
+static int checkRoom(roomStruct& room, const char* roomName, int* placedCount)
+{
+  int errors = 0;
+
+  for (unsigned int i = 0; i < room.spawns.size(); i++)
+  {
+    SpawnPlacer::spawnTypeEnum spawnType = SpawnPlacer::getSpawnType(room.spawns[i].type);
+    for (int n = 0; n < room.spawns[i].count; n++)
+    {
+      if (!placeMonster(room, spawnType, roomName, &errors)) break;
+      (*placedCount)++;
+    }
+  }
+
+  // max density
+  bool isFull[SpawnPlacer::NB_SPAWN_TYPES] = { false, false, false };
+  int nbFull = 0;
+  while (nbFull < SpawnPlacer::NB_SPAWN_TYPES)
+  {
+    SpawnPlacer::spawnTypeEnum spawnType = (SpawnPlacer::spawnTypeEnum)(rand() % SpawnPlacer::NB_SPAWN_TYPES);
+    if (isFull[spawnType]) continue;
+
+    // a monster at a fixed position, sometimes, between two random placements
+    if (rand() % 10 == 0)
+    {
+      int x = 1 + rand() % (MAP_WIDTH - 2);
+      int y = 1 + rand() % (MAP_HEIGHT - 2);
+      room.occupied[x][y] = true;
+    }
+
+    if (placeMonster(room, spawnType, roomName, &errors))
+    {
+      (*placedCount)++;
+    }
+    else
+    {
+      isFull[spawnType] = true;
+      nbFull++;
+    }
+  }
+
+  for (int n = 0; n < SpawnPlacer::NB_SPAWN_TYPES; n++)
+    if (hasFreeTile(room, (SpawnPlacer::spawnTypeEnum)n))
+    {
+      std::cout << "[ERROR] " << roomName << ": free tile not used for spawn type " << n << ".\n";
+      errors++;
+    }
+
+  return errors;
+}
+
+static int checkLevel(int level, bool advanced, int nbFloors, int* roomCount, int* placedCount)
+{
+  int errors = 0;
+  currentLevel = level;
+
+  for (int i = 0; i < nbFloors && errors < 20; i++)
+  {
+    GameFloor floor(level);
+    floor.createFloor();
+
+    for (int x = 0; x < FLOOR_WIDTH; x++)
+      for (int y = 0; y < FLOOR_HEIGHT; y++)
+      {
+        DungeonMap* map = floor.getMap(x, y);
+        if (map == NULL) continue;
+
+        placePlayer(map);
+        roomStruct room;
+        if (!generateRoom(map, level, advanced, room)) continue;
+
+        char roomName[64];
+        sprintf(roomName, "Level %d%s, floor %d, room (%d, %d), type %d",
+                level, advanced ? " (advanced)" : "", i, x, y, map->getRoomType());
+        errors += checkRoom(room, roomName, placedCount);
+        (*roomCount)++;
+      }
+  }
+  return errors;
+}
+
+int main(int argc, char** argv)
+{
+  int nbFloors = argc > 1 ? atoi(argv[1]) : 200;
+  unsigned int seed = argc > 2 ? (unsigned int)atoi(argv[2]) : 1;
+  if (nbFloors <= 0)
+  {
+    std::cout << "Usage: " << argv[0] << " [<floors per level> [<seed>]]" << std::endl;
+    return 1;
+  }
+  srand(seed);
+
+  int errors = 0;
+  int roomCount = 0;
+  int placedCount = 0;
+  for (int level = 1; level <= NB_STANDARD_LEVELS && errors == 0; level++)
+    errors += checkLevel(level, false, nbFloors, &roomCount, &placedCount);
+  for (int level = 1; level <= NB_ADVANCED_LEVELS && errors == 0; level++)
+    errors += checkLevel(level, true, nbFloors, &roomCount, &placedCount);
+
+  std::cout << roomCount << " rooms, " << placedCount << " monsters placed, " << errors << " errors" << std::endl;
+  return errors == 0 ? 0 : 1;
+}